@@ -0,0 +1,41 @@
+/*
+ * A tool for decoding of binary message delivery traces.
+ *
+ * Reads a file created by so_5::msg_tracing::binary_trace_storage_t::dump()
+ * and prints traces from all threads ordered by time.
+ *
+ * Usage:
+ *
+ * sample.so_5.binary_msg_trace_decoder <trace-file>
+ */
+
+#include <iostream>
+#include <fstream>
+
+// Main SObjectizer header file.
+#include <so_5/all.hpp>
+
+int main( int argc, char ** argv )
+{
+	if( 2 != argc )
+	{
+		std::cerr << "Usage: " << argv[ 0 ] << " <trace-file>" << std::endl;
+		return 2;
+	}
+
+	try
+	{
+		std::ifstream file{ argv[ 1 ], std::ios::binary };
+		if( !file )
+			throw std::runtime_error( std::string( "unable to open " ) + argv[ 1 ] );
+
+		so_5::msg_tracing::decode_binary_trace( file, std::cout );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
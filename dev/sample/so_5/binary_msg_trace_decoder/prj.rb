@@ -0,0 +1,9 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'so_5/prj.rb'
+	target 'sample.so_5.binary_msg_trace_decoder'
+
+	cpp_source 'main.cpp'
+}
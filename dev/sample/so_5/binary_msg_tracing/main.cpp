@@ -0,0 +1,104 @@
+/*
+ * An example of binary message delivery tracing.
+ *
+ * Traces are stored into ring buffers in memory without any formatting.
+ * The content of ring buffers is written to a file at the end of the work.
+ * This file can be decoded by binary_msg_trace_decoder sample.
+ */
+
+#include <iostream>
+#include <fstream>
+
+// Main SObjectizer header file.
+#include <so_5/all.hpp>
+
+// Signals for ping-pong.
+struct ping final : public so_5::signal_t {};
+struct pong final : public so_5::signal_t {};
+
+// Main example agent.
+class a_example_t final : public so_5::agent_t
+{
+	// Signal for finishing the example.
+	struct finish final : public so_5::signal_t {};
+
+public :
+	a_example_t( context_t ctx )
+		:	so_5::agent_t( std::move(ctx) )
+	{
+		so_subscribe_self().event( &a_example_t::on_finish );
+	}
+
+	virtual void so_evt_start() override
+	{
+		// Limit the work time.
+		so_5::send_delayed< finish >( *this, std::chrono::milliseconds(250) );
+
+		// Create ping-pong pairs which will work on separate threads.
+		for( int i = 0; i != 2; ++i )
+			make_ping_pong_pair(
+				so_5::disp::one_thread::create_private_disp(
+						so_environment() )->binder() );
+	}
+
+private :
+	void on_finish( mhood_t<finish> )
+	{
+		so_deregister_agent_coop_normally();
+	}
+
+	void make_ping_pong_pair( so_5::disp_binder_unique_ptr_t binder )
+	{
+		// A mbox to be used by pinger and ponger agents.
+		const auto mbox = so_environment().create_mbox();
+		// Create a new coop with two ad-hoc agents inside.
+		so_5::introduce_child_coop( *this, std::move(binder),
+			[mbox]( so_5::coop_t & coop ) {
+				auto pinger = coop.define_agent();
+				pinger.on_start( [mbox]{ so_5::send< ping >( mbox ); } )
+					.event( mbox, [mbox]( mhood_t<pong> ) {
+						so_5::send< ping >( mbox );
+					} );
+
+				coop.define_agent().event( mbox, [mbox]( mhood_t<ping> ) {
+						so_5::send< pong >( mbox );
+					} );
+			} );
+	}
+};
+
+int main( int argc, char ** argv )
+{
+	try
+	{
+		const std::string file_name = argc > 1 ? argv[ 1 ] : "msg_trace.bin";
+
+		// Only the last 1000 traces from every thread will be stored.
+		auto storage = so_5::msg_tracing::ring_buffer_trace_storage( 1000u );
+
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop( []( so_5::coop_t & coop ) {
+					coop.make_agent< a_example_t >();
+				} );
+			},
+			[storage]( so_5::environment_params_t & params ) {
+				// Turn binary message delivery tracing on.
+				params.message_delivery_tracer(
+						so_5::msg_tracing::binary_tracer( storage ) );
+			} );
+
+		std::ofstream file{ file_name, std::ios::binary };
+		storage->dump( file );
+		if( !file )
+			throw std::runtime_error( "unable to write trace to " + file_name );
+
+		std::cout << "Trace is stored to " << file_name << std::endl;
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
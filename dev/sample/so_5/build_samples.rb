@@ -19,6 +19,8 @@ MxxRu::Cpp::composite_target {
 	example[ 'chstate_msg_tracing' ]
 	example[ 'selective_msg_tracing' ]
 	example[ 'nohandler_msg_tracing' ]
+	example[ 'binary_msg_tracing' ]
+	example[ 'binary_msg_trace_decoder' ]
 	example[ 'disp' ]
 	example[ 'coop_listener' ]
 	example[ 'exception_logger' ]
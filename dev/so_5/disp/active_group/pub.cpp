@@ -18,6 +18,7 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/h/stdcpp.hpp>
 
@@ -92,6 +93,34 @@ send_thread_activity_stats(
 				stats::suffixes::work_thread_activity(),
 				wt.thread_id(),
 				wt.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_latency(),
+				wt.thread_id(),
+				wt.take_latency_stats() );
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t &,
+	const stats::prefix_t &,
+	work_thread::work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t & collector,
+	const stats::prefix_t & prefix,
+	work_thread::work_thread_with_activity_tracking_t & wt )
+	{
+		collector.add(
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.take_activity_stats() );
 	}
 
 } /* anonymous */
@@ -220,7 +249,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 
 				// New thread should be created.
 				auto thread = std::make_shared< Work_Thread >(
-						m_params.queue_params().lock_factory() );
+						m_params.queue_params() );
 
 				thread->start();
 
@@ -316,6 +345,43 @@ class dispatcher_template_t : public actual_disp_iface_t
 								agent_count );
 					}
 
+				void
+				collect( stats::snapshot_collector_t & collector ) override
+					{
+						std::lock_guard< std::mutex > lock{ m_dispatcher.m_lock };
+
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::disp_active_group_count(),
+								m_dispatcher.m_groups.size() );
+
+						std::size_t agent_count = 0;
+						for( const auto & p : m_dispatcher.m_groups )
+							{
+								const auto prefix = make_work_thread_prefix( p.first );
+
+								collector.add(
+										prefix,
+										stats::suffixes::agent_count(),
+										p.second.m_user_agent );
+
+								collector.add(
+										prefix,
+										stats::suffixes::work_thread_queue_size(),
+										p.second.m_thread->demands_count() );
+
+								collect_thread_activity_stats(
+										collector, prefix, *(p.second.m_thread) );
+
+								agent_count += p.second.m_user_agent;
+							}
+
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								agent_count );
+					}
+
 				void
 				set_data_sources_name_base(
 					const std::string & name_base )
@@ -335,10 +401,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 					const std::string & group_name,
 					const thread_with_refcounter_t & wt )
 					{
-						std::ostringstream ss;
-						ss << m_base_prefix.c_str() << "/wt-" << group_name;
-
-						const stats::prefix_t prefix{ ss.str() };
+						const auto prefix = make_work_thread_prefix( group_name );
 
 						so_5::send< stats::messages::quantity< std::size_t > >(
 								mbox,
@@ -357,6 +420,15 @@ class dispatcher_template_t : public actual_disp_iface_t
 								prefix,
 								*(wt.m_thread) );
 					}
+
+				stats::prefix_t
+				make_work_thread_prefix( const std::string & group_name ) const
+					{
+						std::ostringstream ss;
+						ss << m_base_prefix.c_str() << "/wt-" << group_name;
+
+						return stats::prefix_t{ ss.str() };
+					}
 			};
 
 		//! Parameters for the dispatcher.
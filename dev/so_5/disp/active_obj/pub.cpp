@@ -19,6 +19,7 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/h/stdcpp.hpp>
 
@@ -106,6 +107,34 @@ send_thread_activity_stats(
 				stats::suffixes::work_thread_activity(),
 				wt.thread_id(),
 				wt.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_latency(),
+				wt.thread_id(),
+				wt.take_latency_stats() );
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t &,
+	const stats::prefix_t &,
+	work_thread::work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t & collector,
+	const stats::prefix_t & prefix,
+	work_thread::work_thread_with_activity_tracking_t & wt )
+	{
+		collector.add(
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.take_activity_stats() );
 	}
 
 } /* anonymous */
@@ -206,9 +235,8 @@ class dispatcher_template_t : public actual_disp_iface_t
 						"thread for the agent is already exists",
 						rc_disp_create_failed );
 
-				auto lock_factory = m_params.queue_params().lock_factory();
 				auto thread = std::make_shared< Work_Thread >(
-						std::move(lock_factory) );
+						m_params.queue_params() );
 
 				thread->start();
 				so_5::details::do_with_rollback_on_exception(
@@ -272,6 +300,29 @@ class dispatcher_template_t : public actual_disp_iface_t
 									*p.second );
 					}
 
+				void
+				collect( stats::snapshot_collector_t & collector ) override
+					{
+						std::lock_guard< std::mutex > lock{ m_dispatcher.m_lock };
+
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								m_dispatcher.m_agent_threads.size() );
+
+						for( const auto & p : m_dispatcher.m_agent_threads )
+							{
+								const auto wt_prefix = make_work_thread_prefix( p.first );
+
+								collector.add(
+										wt_prefix,
+										stats::suffixes::work_thread_queue_size(),
+										p.second->demands_count() );
+								collect_thread_activity_stats(
+										collector, wt_prefix, *p.second );
+							}
+					}
+
 				void
 				set_data_sources_name_base(
 					const std::string & name_base )
@@ -290,15 +341,21 @@ class dispatcher_template_t : public actual_disp_iface_t
 					const mbox_t & mbox,
 					const agent_t * agent,
 					Work_Thread & wt )
+					{
+						const auto wt_prefix = make_work_thread_prefix( agent );
+
+						send_demands_count_stats( mbox, wt_prefix, wt );
+						send_thread_activity_stats( mbox, wt_prefix, wt );
+					}
+
+				stats::prefix_t
+				make_work_thread_prefix( const agent_t * agent ) const
 					{
 						std::ostringstream ss;
 						ss << m_base_prefix.c_str() << "/wt-"
 								<< so_5::disp::reuse::ios_helpers::pointer{ agent };
 
-						const stats::prefix_t wt_prefix{ ss.str() };
-
-						send_demands_count_stats( mbox, wt_prefix, wt );
-						send_thread_activity_stats( mbox, wt_prefix, wt );
+						return stats::prefix_t{ ss.str() };
 					}
 			};
 
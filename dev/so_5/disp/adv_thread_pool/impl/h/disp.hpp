@@ -29,6 +29,7 @@
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
@@ -100,9 +101,28 @@ class agent_queue_t
 					:	m_demand( std::move( original ) )
 					,	m_next( nullptr )
 					{}
+
+				//! Access to the actual demand.
+				/*!
+				 * \since
+				 * v.5.5.25
+				 */
+				execution_demand_t &
+				demand()
+					{
+						return m_demand;
+					}
 			};
 
 	public :
+		/*!
+		 * \brief Type of pool for demand nodes.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		using demand_pool_t = so_5::disp::reuse::demand_node_pool_t< demand_t >;
+
 		static const unsigned int thread_safe_worker = 2;
 		static const unsigned int not_thread_safe_worker = 1;
 
@@ -140,7 +160,10 @@ class agent_queue_t
 				bool need_schedule = false;
 				{
 					// Do memory allocation before spinlock locking.
-					auto new_demand = new demand_t( std::move( demand ) );
+					// Since v.5.5.25 a node is taken from the pool of
+					// the current work thread (if there is such pool).
+					auto new_demand = demand_pool_t::allocate_node(
+							std::move( demand ) );
 
 					std::lock_guard< spinlock_t > lock( m_lock );
 
@@ -170,6 +193,57 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue.
+		/*!
+		 * All demands are added under one lock acquisition and the
+		 * queue is scheduled at most once.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		push_many(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				bool need_schedule = false;
+				{
+					// Nodes are allocated and linked before spinlock locking.
+					auto chain = demand_pool_t::allocate_chain( demands, count );
+
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool was_empty = empty();
+
+					m_tail->m_next = chain.first;
+					m_tail = chain.second;
+
+					m_size += count;
+
+					if( was_empty )
+						{
+							// Queue was empty. Need to detect
+							// necessity of queue activation.
+							if( !m_active )
+								if( !is_there_not_thread_safe_worker() )
+								{
+									need_schedule = true;
+									m_active = true;
+								}
+						}
+
+					SO_5_CHECK_INVARIANT( !empty(), this )
+					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
+					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
+				}
+
+				if( need_schedule )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the information about the front demand.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -199,7 +273,9 @@ class agent_queue_t
 				SO_5_CHECK_INVARIANT( !empty(), this );
 				SO_5_CHECK_INVARIANT( !m_active, this );
 
-				delete_head();
+				// Since v.5.5.25 the node is returned to the pool of
+				// the current work thread.
+				demand_pool_t::release_node( extract_head() );
 				if( !m_head.m_next )
 					m_tail = &m_head;
 
@@ -312,12 +388,24 @@ class agent_queue_t
 		inline void
 		delete_head()
 			{
-				auto to_be_deleted = m_head.m_next;
+				delete extract_head();
+			}
+
+		/*!
+		 * \brief Helper method for extraction of queue's head object.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		inline demand_t *
+		extract_head()
+			{
+				auto head = m_head.m_next;
 				m_head.m_next = m_head.m_next->m_next;
 
 				--m_size;
 
-				delete to_be_deleted;
+				return head;
 			}
 	};
 
@@ -357,6 +445,14 @@ struct common_data_t
 		//! Waiting object for long wait.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
 
+		/*!
+		 * \brief Pool of demand nodes for this thread.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		agent_queue_t::demand_pool_t m_demand_pool;
+
 		common_data_t( dispatcher_queue_t & queue )
 			:	m_disp_queue( &queue )
 			,	m_condition{ queue.allocate_condition() }
@@ -382,6 +478,10 @@ class no_activity_tracking_impl_t : protected common_data_t
 		void
 		take_activity_stats( L ) { /* Nothing to do */ }
 
+		template< typename L >
+		void
+		take_latency_stats( L ) { /* Nothing to do */ }
+
 	protected :
 		void
 		work_started() {}
@@ -425,6 +525,24 @@ class with_activity_tracking_impl_t : protected common_data_t
 				lambda( result );
 			}
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		template< typename L >
+		void
+		take_latency_stats( L lambda )
+			{
+				so_5::stats::work_thread_latency_stats_t result;
+
+				result.m_working_histogram =
+						m_work_activity_collector.take_histogram();
+				result.m_waiting_histogram =
+						m_waiting_stats_collector.take_histogram();
+
+				lambda( result );
+			}
+
 	protected :
 		//! Lock for activity statistics.
 		activity_tracking_traits::lock_t m_stats_lock;
@@ -512,6 +630,18 @@ class work_thread_template_t : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Get the stats for the pool of demand nodes.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		so_5::disp::reuse::demand_pool_stats_t
+		demand_pool_stats() const
+			{
+				return this->m_demand_pool.stats();
+			}
+
 	private :
 		//! Thread body method.
 		void
@@ -519,6 +649,9 @@ class work_thread_template_t : public Impl
 			{
 				this->m_thread_id = so_5::query_current_thread_id();
 
+				agent_queue_t::demand_pool_t::binding_t pool_binding{
+						this->m_demand_pool };
+
 				agent_queue_t * agent_queue;
 				while( nullptr != (agent_queue = this->pop_agent_queue()) )
 					{
@@ -245,23 +245,27 @@ class queue_params_t
 		queue_params_t()
 			:	m_lock_factory{}
 			,	m_next_thread_wakeup_threshold{ 0 }
+			,	m_work_stealing{ false }
 			{}
 		//! Copy constructor.
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
 			,	m_next_thread_wakeup_threshold{ o.m_next_thread_wakeup_threshold }
+			,	m_work_stealing{ o.m_work_stealing }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
 			,	m_next_thread_wakeup_threshold{
 					std::move(o.m_next_thread_wakeup_threshold) }
+			,	m_work_stealing{ o.m_work_stealing }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				std::swap( a.m_lock_factory, b.m_lock_factory );
 				std::swap( a.m_next_thread_wakeup_threshold, b.m_next_thread_wakeup_threshold );
+				std::swap( a.m_work_stealing, b.m_work_stealing );
 			}
 
 		//! Copy operator.
@@ -343,6 +347,59 @@ class queue_params_t
 				return m_next_thread_wakeup_threshold;
 			}
 
+		/*!
+		 * \brief Setter for work-stealing mode.
+		 *
+		 * In work-stealing mode every work thread has its own lock-free
+		 * deque of non-empty agent queues. An agent queue which becomes
+		 * non-empty on the context of a work thread is placed into
+		 * the deque of that thread. Idle work threads steal agent queues
+		 * from deques of busy threads. The common queue lock is acquired
+		 * only when a work thread goes to sleep or is being woken up.
+		 *
+		 * This mode can reduce contention on the queue lock when
+		 * a dispatcher has many work threads.
+		 *
+		 * Usage example:
+		 * \code
+			using namespace so_5;
+			using namespace so_5::disp::thread_pool;
+
+			environment_t & env = ...;
+			auto disp = create_private_disp(
+				env,
+				"my-thread-pool",
+				disp_params_t{}
+					.thread_count( 32 )
+					.tune_queue_params(
+						[]( queue_traits::queue_params_t & qp ) {
+							qp.work_stealing( true );
+						} )
+				);
+		 * \endcode
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		queue_params_t &
+		work_stealing( bool value )
+			{
+				m_work_stealing = value;
+				return *this;
+			}
+
+		/*!
+		 * \brief Is work-stealing mode turned on?
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		bool
+		work_stealing() const
+			{
+				return m_work_stealing;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
@@ -355,6 +412,14 @@ class queue_params_t
 		 * v.5.5.16
 		 */
 		std::size_t m_next_thread_wakeup_threshold;
+
+		/*!
+		 * \brief Is work-stealing mode turned on?
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		bool m_work_stealing;
 	};
 
 } /* namespace mpmc_queue_traits */
@@ -69,6 +69,26 @@ class SO_5_TYPE lock_t
 		 */
 		virtual void
 		notify_one() SO_5_NOEXCEPT = 0;
+
+		//! Waiting for notification or for expiration of timeout.
+		/*!
+		 * Spurious wakeups are allowed. The caller must check its
+		 * conditions again after return.
+		 *
+		 * 
+ote The default implementation releases the lock and
+		 * sleeps for a short time (no more than 1ms) without
+		 * any reaction to notify_one(). Standard locks override it
+		 * by more efficient implementation.
+		 *
+		 * ttention Must be called only when object is locked!
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		wait_for_notify_with_timeout(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT;
 	};
 
 //
@@ -230,6 +250,19 @@ class unique_lock_t
 				m_lock.wait_for_notify();
 			}
 
+		/*!
+		 * \brief Waiting for notification but no more than \a timeout.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		inline void
+		wait_for_notify(
+			std::chrono::steady_clock::duration timeout )
+			{
+				m_lock.wait_for_notify_with_timeout( timeout );
+			}
+
 	private :
 		lock_t & m_lock;
 	};
@@ -272,6 +305,91 @@ class lock_guard_t
 		lock_t & m_lock;
 	};
 
+//
+// idle_handler_t
+//
+/*!
+ * \brief An interface of handler to be called by a work thread
+ * when it goes to demand queue for new demands.
+ *
+ * The handler is called by the work thread each time it returns
+ * to the demand queue and before every sleep on an empty queue.
+ * The value returned by on_idle() limits the time of the sleep.
+ * The handler can awake the sleeping thread via waker_t object
+ * passed to attach() (for example if it has new work to be done
+ * before the expiration of the previous timeout).
+ *
+ * It allows to do some service work on a work thread of
+ * a dispatcher (processing of timers, for example) without
+ * a separate thread.
+ *
+ * \note This handler is supported by dispatchers which use the
+ * common work thread implementation (%one_thread, %active_obj,
+ * %active_group, %prio_dedicated_threads::one_per_prio). But it is
+ * intended to be used with %one_thread dispatcher. If several work
+ * threads share the same handler then the handler must be ready to
+ * deal with several wakers and with calls from different threads.
+ *
+ * \attention on_idle() is called on the context of the work thread.
+ * It must not block for a long time.
+ *
+ * \since
+ * v.5.5.25
+ */
+class SO_5_TYPE idle_handler_t
+	{
+	public :
+		//! An interface for waking up of the work thread.
+		class SO_5_TYPE waker_t
+			{
+			protected :
+				~waker_t() = default;
+
+			public :
+				//! Awake the work thread if it sleeps on an empty queue.
+				/*!
+				 * If the work thread is not sleeping it will call on_idle()
+				 * again before the next sleep.
+				 */
+				virtual void
+				wake_up() SO_5_NOEXCEPT = 0;
+			};
+
+		idle_handler_t( const idle_handler_t & ) = delete;
+		idle_handler_t & operator=( const idle_handler_t & ) = delete;
+
+		idle_handler_t() = default;
+		virtual ~idle_handler_t() SO_5_NOEXCEPT = default;
+
+		//! Attach or detach the waker.
+		/*!
+		 * It is called with pointer to actual waker when the demand
+		 * queue starts its service and with nullptr when the queue
+		 * stops its service.
+		 */
+		virtual void
+		attach( waker_t * waker ) SO_5_NOEXCEPT = 0;
+
+		//! Do the service work.
+		/*!
+		 * \return max time to sleep on an empty queue before the next
+		 * call to on_idle().
+		 */
+		virtual std::chrono::steady_clock::duration
+		on_idle() SO_5_NOEXCEPT = 0;
+	};
+
+//
+// idle_handler_shptr_t
+//
+/*!
+ * \brief An alias for shared_ptr for idle handler.
+ *
+ * \since
+ * v.5.5.25
+ */
+using idle_handler_shptr_t = std::shared_ptr< idle_handler_t >;
+
 //
 // queue_params_t
 //
@@ -287,20 +405,28 @@ class queue_params_t
 		//! Default constructor.
 		queue_params_t()
 			:	m_lock_factory{}
+			,	m_lock_free{ false }
+			,	m_idle_handler{}
 			{}
 		//! Copy constructor.
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
+			,	m_lock_free{ o.m_lock_free }
+			,	m_idle_handler{ o.m_idle_handler }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
+			,	m_lock_free{ o.m_lock_free }
+			,	m_idle_handler{ std::move(o.m_idle_handler) }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				using namespace std;
 				swap( a.m_lock_factory, b.m_lock_factory );
+				swap( a.m_lock_free, b.m_lock_free );
+				swap( a.m_idle_handler, b.m_idle_handler );
 			}
 
 		//! Copy operator.
@@ -334,9 +460,116 @@ class queue_params_t
 				return m_lock_factory;
 			}
 
+		/*!
+		 * \brief Setter for lock-free mode of demand queue.
+		 *
+		 * In lock-free mode demands are stored in an intrusive
+		 * lock-free list. Producers never acquire the queue lock
+		 * unless the consumer thread is sleeping on an empty queue.
+		 * The consumer extracts all available demands at once.
+		 *
+		 * List nodes are recycled via bounded pools owned by work
+		 * threads (see so_5::disp::reuse::demand_node_pool_t).
+		 * A node is taken from the pool of the producer thread and
+		 * is returned to the pool of the consumer thread. Because of
+		 * that there is no memory allocation only for demands sent
+		 * from the work thread of the queue itself (for example, when
+		 * an agent sends a message to itself or to another agent on
+		 * the same thread). Every demand from another thread still
+		 * requires an allocation of a node, and surplus nodes are
+		 * deallocated by the consumer when its pool is full.
+		 *
+		 * The lock object created by the lock factory is used only
+		 * for waiting on an empty queue.
+		 *
+		 * \note This mode is supported by %one_thread, %active_obj,
+		 * %active_group and %prio_dedicated_threads::one_per_prio
+		 * dispatchers. Other dispatchers ignore it.
+		 *
+		 * \par Usage example:
+			\code
+			so_5::launch( []( so_5::environment_t & env ) { ... },
+				[]( so_5::environment_params_t & params ) {
+					using namespace so_5::disp::one_thread;
+					params.add_named_dispatcher(
+						"helpers_disp",
+						create_disp( disp_params_t{}.tune_queue_params(
+							[]( queue_traits::queue_params_t & queue_params ) {
+								queue_params.lock_free( true );
+							} ) ) );
+				} );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		queue_params_t &
+		lock_free( bool value )
+			{
+				m_lock_free = value;
+				return *this;
+			}
+
+		/*!
+		 * \brief Is lock-free mode of demand queue turned on?
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		bool
+		lock_free() const
+			{
+				return m_lock_free;
+			}
+
+		/*!
+		 * \brief Setter for idle handler.
+		 *
+		 * \note Only dispatchers which use the common work thread
+		 * implementation support idle handlers. Other dispatchers
+		 * ignore it.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		queue_params_t &
+		idle_handler( idle_handler_shptr_t handler )
+			{
+				m_idle_handler = std::move(handler);
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for idle handler.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		const idle_handler_shptr_t &
+		idle_handler() const
+			{
+				return m_idle_handler;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
+
+		/*!
+		 * \brief Is lock-free mode of demand queue turned on?
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		bool m_lock_free;
+
+		/*!
+		 * \brief Optional idle handler for work thread.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		idle_handler_shptr_t m_idle_handler;
 	};
 
 /*!
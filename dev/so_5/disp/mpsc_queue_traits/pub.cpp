@@ -18,6 +18,8 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <algorithm>
+#include <thread>
 #include <iostream>
 
 namespace so_5 {
@@ -113,6 +115,57 @@ class combined_lock_t : public lock_t
 				m_signaled = false;
 			}
 
+		virtual void
+		wait_for_notify_with_timeout(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT override
+			{
+				using clock = std::chrono::steady_clock;
+
+				m_waiting = true;
+				const auto deadline = clock::now() + timeout;
+				const auto spin_stop_point = (std::min)( deadline,
+						clock::now() +
+							std::chrono::duration_cast< clock::duration >(
+									m_waiting_time ) );
+
+				do
+					{
+						m_spinlock.unlock();
+
+						std::this_thread::yield();
+
+						m_spinlock.lock();
+
+						if( m_signaled )
+							{
+								m_waiting = false;
+								m_signaled = false;
+								return;
+							}
+					}
+				while( spin_stop_point > clock::now() );
+
+				if( deadline > clock::now() )
+					{
+						{
+							std::unique_lock< std::mutex > mlock( m_mutex );
+
+							m_spinlock.unlock();
+
+							m_condition.wait_until( mlock, deadline,
+									[this]{ return m_signaled; } );
+						}
+
+						// The mutex is released before acquiring the spinlock.
+						// Otherwise there can be a deadlock with a notifier
+						// which holds the spinlock.
+						m_spinlock.lock();
+					}
+
+				m_waiting = false;
+				m_signaled = false;
+			}
+
 		//! Notify one waiting thread if it exists.
 		/*!
 		 * \attention Must be called only when object is locked.
@@ -182,6 +235,22 @@ class simple_lock_t : public lock_t
 				m_signaled = false;
 			}
 
+		virtual void
+		wait_for_notify_with_timeout(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT override
+			{
+				so_5::details::invoke_noexcept_code( [&] {
+					// Mutex already locked. We must not try to reacquire it.
+					std::unique_lock< std::mutex > mlock{ m_mutex, std::adopt_lock };
+					m_condition.wait_for( mlock, timeout,
+							[this]{ return m_signaled; } );
+					mlock.release();
+				} );
+
+				// Timeout can be expired. But the flag must be reset anyway.
+				m_signaled = false;
+			}
+
 		virtual void
 		notify_one() SO_5_NOEXCEPT override
 			{
@@ -198,6 +267,26 @@ class simple_lock_t : public lock_t
 
 } /* namespace impl */
 
+//
+// lock_t
+//
+void
+lock_t::wait_for_notify_with_timeout(
+	std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT
+	{
+		// There is no way to receive a notification here. So the
+		// waiting time is limited to allow the caller to check its
+		// conditions again.
+		const std::chrono::steady_clock::duration max_sleep_time =
+				std::chrono::milliseconds(1);
+
+		unlock();
+		so_5::details::invoke_noexcept_code( [&] {
+			std::this_thread::sleep_for( (std::min)( timeout, max_sleep_time ) );
+		} );
+		lock();
+	}
+
 //
 // combined_lock_factory
 //
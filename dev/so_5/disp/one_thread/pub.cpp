@@ -11,6 +11,7 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
@@ -83,6 +84,30 @@ track_activity(
 				stats::suffixes::work_thread_activity(),
 				data.m_work_thread.thread_id(),
 				data.m_work_thread.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				data.m_base_prefix,
+				stats::suffixes::work_thread_latency(),
+				data.m_work_thread.thread_id(),
+				data.m_work_thread.take_latency_stats() );
+	}
+
+inline void
+collect_activity(
+	stats::snapshot_collector_t &,
+	const common_data_t< work_thread::work_thread_no_activity_tracking_t > & )
+	{}
+
+inline void
+collect_activity(
+	stats::snapshot_collector_t & collector,
+	const common_data_t< work_thread::work_thread_with_activity_tracking_t > & data )
+	{
+		collector.add(
+				data.m_base_prefix,
+				stats::suffixes::work_thread_activity(),
+				data.m_work_thread.take_activity_stats() );
 	}
 
 } /* namespace data_source_details */
@@ -133,6 +158,22 @@ class data_source_t
 				data_source_details::track_activity( mbox, *this );
 			}
 
+		void
+		collect( stats::snapshot_collector_t & collector ) override
+			{
+				collector.add(
+						this->m_base_prefix,
+						stats::suffixes::agent_count(),
+						this->m_agents_bound.load( std::memory_order_acquire ) );
+
+				collector.add(
+						this->m_work_thread_prefix,
+						stats::suffixes::work_thread_queue_size(),
+						this->m_work_thread.demands_count() );
+
+				data_source_details::collect_activity( collector, *this );
+			}
+
 		void
 		set_data_sources_name_base(
 			const std::string & name_base,
@@ -208,7 +249,7 @@ class actual_dispatcher_t : public actual_disp_iface_t
 	{
 	public:
 		actual_dispatcher_t( disp_params_t params )
-			:	m_work_thread{ params.queue_params().lock_factory() }
+			:	m_work_thread{ params.queue_params() }
 			,	m_data_source( m_work_thread, m_agents_bound )
 			{}
 
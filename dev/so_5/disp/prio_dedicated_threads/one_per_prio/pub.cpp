@@ -22,6 +22,7 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -66,6 +67,34 @@ send_thread_activity_stats(
 				stats::suffixes::work_thread_activity(),
 				wt.thread_id(),
 				wt.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_latency(),
+				wt.thread_id(),
+				wt.take_latency_stats() );
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t &,
+	const stats::prefix_t &,
+	so_5::disp::reuse::work_thread::work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t & collector,
+	const stats::prefix_t & prefix,
+	so_5::disp::reuse::work_thread::work_thread_with_activity_tracking_t & wt )
+	{
+		collector.add(
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.take_activity_stats() );
 	}
 
 } /* namespace anonymous */
@@ -114,10 +143,8 @@ class dispatcher_template_t : public actual_disp_iface_t
 			{
 				m_threads.reserve( so_5::prio::total_priorities_count );
 				so_5::prio::for_each_priority( [&]( so_5::priority_t ) {
-						auto lock_factory = params.queue_params().lock_factory();
-
 						auto t = so_5::stdcpp::make_unique< Work_Thread >(
-								std::move(lock_factory) );
+								params.queue_params() );
 
 						m_threads.push_back( std::move(t) );
 					} );
@@ -225,6 +252,39 @@ class dispatcher_template_t : public actual_disp_iface_t
 								agents_count );
 					}
 
+				void
+				collect( stats::snapshot_collector_t & collector ) override
+					{
+						std::size_t agents_count = 0;
+
+						so_5::prio::for_each_priority( [&]( priority_t p ) {
+								auto agents = m_dispatcher.m_agents_per_priority[
+										to_size_t(p) ].load( std::memory_order_acquire );
+
+								agents_count += agents;
+
+								auto & wt = *(m_dispatcher.m_threads[ to_size_t(p) ]);
+								const auto prefix = make_work_thread_prefix( p );
+
+								collector.add(
+										prefix,
+										stats::suffixes::work_thread_queue_size(),
+										wt.demands_count() );
+
+								collector.add(
+										prefix,
+										stats::suffixes::agent_count(),
+										agents );
+
+								collect_thread_activity_stats( collector, prefix, wt );
+							} );
+
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								agents_count );
+					}
+
 				void
 				set_data_sources_name_base(
 					const std::string & name_base )
@@ -245,10 +305,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 					std::size_t agents_count,
 					Work_Thread & wt )
 					{
-						std::ostringstream ss;
-						ss << m_base_prefix.c_str() << "/wt-p" << to_size_t(priority);
-
-						const stats::prefix_t prefix{ ss.str() };
+						const auto prefix = make_work_thread_prefix( priority );
 
 						so_5::send< stats::messages::quantity< std::size_t > >(
 								mbox,
@@ -264,6 +321,15 @@ class dispatcher_template_t : public actual_disp_iface_t
 
 						send_thread_activity_stats( mbox, prefix, wt );
 					}
+
+				stats::prefix_t
+				make_work_thread_prefix( priority_t priority ) const
+					{
+						std::ostringstream ss;
+						ss << m_base_prefix.c_str() << "/wt-p" << to_size_t(priority);
+
+						return stats::prefix_t{ ss.str() };
+					}
 			};
 
 		//! Data source for run-time monitoring.
@@ -23,6 +23,7 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -90,6 +91,36 @@ send_thread_activity_stats(
 				stats::suffixes::work_thread_activity(),
 				wt.thread_id(),
 				wt.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_latency(),
+				wt.thread_id(),
+				wt.take_latency_stats() );
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t &,
+	const stats::prefix_t &,
+	so_5::disp::prio_one_thread::reuse::work_thread_no_activity_tracking_t<
+			demand_queue_t > & )
+	{
+		/* Nothing to do */
+	}
+
+void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t & collector,
+	const stats::prefix_t & prefix,
+	so_5::disp::prio_one_thread::reuse::work_thread_with_activity_tracking_t<
+			demand_queue_t > & wt )
+	{
+		collector.add(
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.take_activity_stats() );
 	}
 
 } /* namespace anonymous */
@@ -219,6 +250,45 @@ class dispatcher_template_t : public actual_disp_iface_t
 								m_dispatcher.m_work_thread );
 					}
 
+				void
+				collect( stats::snapshot_collector_t & collector ) override
+					{
+						std::size_t agents_count = 0;
+
+						m_dispatcher.m_demand_queue.handle_stats_for_each_prio(
+							[&]( const demand_queue_t::queue_stats_t & stat ) {
+								const auto prefix = make_priority_prefix(
+										stat.m_priority );
+
+								collector.add(
+										prefix,
+										stats::suffixes::demand_quote(),
+										stat.m_quote );
+
+								collector.add(
+										prefix,
+										stats::suffixes::agent_count(),
+										stat.m_agents_count );
+
+								collector.add(
+										prefix,
+										stats::suffixes::work_thread_queue_size(),
+										stat.m_demands_count );
+
+								agents_count += stat.m_agents_count;
+							} );
+
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								agents_count );
+
+						collect_thread_activity_stats(
+								collector,
+								m_base_prefix,
+								m_dispatcher.m_work_thread );
+					}
+
 				void
 				set_data_sources_name_base(
 					const std::string & name_base )
@@ -240,10 +310,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 					std::size_t agents_count,
 					std::size_t demands_count )
 					{
-						std::ostringstream ss;
-						ss << m_base_prefix.c_str() << "/p" << to_size_t(priority);
-
-						const stats::prefix_t prefix{ ss.str() };
+						const auto prefix = make_priority_prefix( priority );
 
 						so_5::send< stats::messages::quantity< std::size_t > >(
 								mbox,
@@ -263,6 +330,15 @@ class dispatcher_template_t : public actual_disp_iface_t
 								stats::suffixes::work_thread_queue_size(),
 								demands_count );
 					}
+
+				stats::prefix_t
+				make_priority_prefix( priority_t priority ) const
+					{
+						std::ostringstream ss;
+						ss << m_base_prefix.c_str() << "/p" << to_size_t(priority);
+
+						return stats::prefix_t{ ss.str() };
+					}
 			};
 
 		//! Demand queue for the dispatcher.
@@ -123,6 +123,23 @@ class with_activity_tracking_impl_t : protected common_data_t< Demand_Queue >
 				return result;
 			}
 
+		/*!
+		 * \brief Get the latency histograms.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		so_5::stats::work_thread_latency_stats_t
+		take_latency_stats() const
+			{
+				so_5::stats::work_thread_latency_stats_t result;
+
+				result.m_working_histogram = m_working_stats.take_histogram();
+				result.m_waiting_histogram = m_waiting_stats.take_histogram();
+
+				return result;
+			}
+
 	protected :
 		//! Statictics for work activity.
 		so_5::stats::activity_tracking_stuff::stats_collector_t<
@@ -66,6 +66,25 @@ struct demand_t : public execution_demand_t
  */
 using demand_unique_ptr_t = std::unique_ptr< demand_t >;
 
+//
+// destroy_demands_chain
+//
+/*!
+ * \brief Destroy all demands from a chain.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline void
+destroy_demands_chain( demand_t * head )
+	{
+		while( head )
+			{
+				demand_unique_ptr_t t{ head };
+				head = head->m_next;
+			}
+	}
+
 //
 // demand_queue_t
 //
@@ -113,6 +132,45 @@ class demand_queue_t
 
 						m_demand_queue->push( this, std::move( what ) );
 					}
+
+				/*!
+				 * All demands are added under one lock acquisition.
+				 * A sleeping working thread is notified at most once.
+				 *
+				 * \since
+				 * v.5.5.25
+				 */
+				virtual void
+				push_many(
+					execution_demand_t * demands,
+					std::size_t count ) override
+					{
+						if( !count )
+							return;
+
+						// Demands are linked into a chain before locking the queue.
+						demand_t * head = nullptr;
+						demand_t * tail = nullptr;
+						try
+							{
+								for( std::size_t i = 0; i != count; ++i )
+									{
+										demand_t * d = new demand_t{ std::move( demands[ i ] ) };
+										if( tail )
+											tail->m_next = d;
+										else
+											head = d;
+										tail = d;
+									}
+							}
+						catch( ... )
+							{
+								destroy_demands_chain( head );
+								throw;
+							}
+
+						m_demand_queue->push_chain( this, head, tail, count );
+					}
 			};
 
 	public :
@@ -254,12 +312,7 @@ class demand_queue_t
 		void
 		cleanup_queue( queue_for_one_priority_t & queue_info )
 			{
-				auto h = queue_info.m_head;
-				while( h )
-					{
-						demand_unique_ptr_t t{ h };
-						h = h->m_next;
-					}
+				destroy_demands_chain( queue_info.m_head );
 			}
 
 		//! Push a new demand to the queue.
@@ -286,6 +339,38 @@ class demand_queue_t
 					m_current_priority = subqueue;
 			}
 
+		//! Push a chain of demands to the queue.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		push_chain(
+			//! Subqueue for the demands.
+			queue_for_one_priority_t * subqueue,
+			//! The first demand of the chain.
+			demand_t * head,
+			//! The last demand of the chain.
+			demand_t * tail,
+			//! Count of demands in the chain.
+			std::size_t count )
+			{
+				queue_traits::lock_guard_t lock{ *m_lock };
+
+				add_chain_to_queue( *subqueue, head, tail, count );
+
+				if( !m_current_priority )
+					{
+						// Queue was empty. A sleeping working thread must
+						// be notified.
+						m_current_priority = subqueue;
+						lock.notify_one();
+					}
+				else if( m_current_priority < subqueue )
+					// New demand has greater priority than the previous.
+					m_current_priority = subqueue;
+			}
+
 		//! Add a new demand to the tail of the queue specified.
 		void
 		add_demand_to_queue(
@@ -307,6 +392,30 @@ class demand_queue_t
 
 				++(queue.m_demands_count);
 			}
+
+		//! Add a chain of demands to the tail of the queue specified.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		add_chain_to_queue(
+			queue_for_one_priority_t & queue,
+			demand_t * head,
+			demand_t * tail,
+			std::size_t count )
+			{
+				if( queue.m_tail )
+					// Queue is not empty. Tail will be modified.
+					queue.m_tail->m_next = head;
+				else
+					// Queue is empty. The whole description will be modified.
+					queue.m_head = head;
+
+				queue.m_tail = tail;
+
+				queue.m_demands_count += count;
+			}
 	};
 
 } /* namespace impl */
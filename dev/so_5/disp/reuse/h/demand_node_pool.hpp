@@ -0,0 +1,338 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A pool of preallocated nodes for demand queues.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <so_5/rt/h/execution_demand.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+namespace demand_node_pool_details
+{
+
+/*!
+ * \name Access to the link between nodes.
+ *
+ * Link can be an ordinary pointer or an atomic pointer (nodes of
+ * lock-free lists). Atomic link of a free node is not visible for
+ * other threads, so relaxed operations are enough for it.
+ *
+ * \since
+ * v.5.5.25
+ * \{
+ */
+template< typename Node >
+Node *
+next_node( Node * const & link ) SO_5_NOEXCEPT
+	{
+		return link;
+	}
+
+template< typename Node >
+Node *
+next_node( const std::atomic< Node * > & link ) SO_5_NOEXCEPT
+	{
+		return link.load( std::memory_order_relaxed );
+	}
+
+template< typename Node >
+void
+set_next_node( Node *& link, Node * next ) SO_5_NOEXCEPT
+	{
+		link = next;
+	}
+
+template< typename Node >
+void
+set_next_node( std::atomic< Node * > & link, Node * next ) SO_5_NOEXCEPT
+	{
+		link.store( next, std::memory_order_relaxed );
+	}
+/*!
+ * \}
+ */
+
+} /* namespace demand_node_pool_details */
+
+//
+// demand_pool_stats_t
+//
+/*!
+ * \brief Statistics for a pool of demand nodes.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct demand_pool_stats_t
+	{
+		//! Count of allocations satisfied from the pool.
+		std::uint64_t m_hits{ 0 };
+
+		//! Count of allocations which required operator new.
+		std::uint64_t m_misses{ 0 };
+	};
+
+//
+// demand_node_pool_t
+//
+/*!
+ * \brief A pool of nodes for demand queues.
+ *
+ * Every work thread of thread-pool-like dispatchers and every work
+ * thread from so_5::disp::reuse::work_thread (for lock-free mode of
+ * demand queues) owns an instance of that pool. The pool is bound to the work thread for the whole
+ * lifetime of the thread. Nodes for new demands are taken from the pool
+ * of the current thread (if there is such pool) and nodes of processed
+ * demands are returned to the pool of the thread which processed them.
+ *
+ * Because the pool is used only by its work thread there is no need
+ * for any synchronization. Only counters of hits and misses are atomic
+ * because they can be read by run-time monitoring from another thread.
+ *
+ * If the current thread has no pool (e.g. a message is sent from
+ * a thread which doesn't belong to any dispatcher)
+ * then ordinary operator new and operator delete are used.
+ *
+ * \tparam Node type of queue node. Must have public attribute
+ * \a m_next of type Node* or std::atomic<Node*>, a constructor from
+ * execution_demand_t&& and method demand() which returns a reference
+ * to execution_demand_t.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Node >
+class demand_node_pool_t
+	{
+	public :
+		//! Max count of free nodes to be kept in the pool.
+		static const std::size_t default_capacity = 1024;
+
+		demand_node_pool_t() = default;
+		demand_node_pool_t( const demand_node_pool_t & ) = delete;
+		demand_node_pool_t & operator=( const demand_node_pool_t & ) = delete;
+
+		~demand_node_pool_t()
+			{
+				while( m_free )
+					{
+						auto n = m_free;
+						m_free = demand_node_pool_details::next_node( n->m_next );
+						delete n;
+					}
+			}
+
+		//! Get a node for a new demand.
+		Node *
+		allocate( execution_demand_t && demand )
+			{
+				if( m_free )
+					{
+						auto n = m_free;
+						m_free = demand_node_pool_details::next_node( n->m_next );
+						--m_free_count;
+
+						demand_node_pool_details::set_next_node(
+								n->m_next, static_cast< Node * >( nullptr ) );
+						n->demand() = std::move(demand);
+
+						increment( m_hits );
+
+						return n;
+					}
+
+				increment( m_misses );
+
+				return new Node( std::move(demand) );
+			}
+
+		//! Return a node to the pool.
+		void
+		release( Node * n ) SO_5_NOEXCEPT
+			{
+				// Message instance must be released right now.
+				n->demand() = execution_demand_t{};
+
+				if( m_free_count < default_capacity )
+					{
+						demand_node_pool_details::set_next_node( n->m_next, m_free );
+						m_free = n;
+						++m_free_count;
+					}
+				else
+					delete n;
+			}
+
+		//! Get the current values of counters.
+		/*!
+		 * \note Can be called from any thread.
+		 */
+		demand_pool_stats_t
+		stats() const
+			{
+				demand_pool_stats_t result;
+				result.m_hits = m_hits.load( std::memory_order_relaxed );
+				result.m_misses = m_misses.load( std::memory_order_relaxed );
+
+				return result;
+			}
+
+		//! Allocate a node from the pool of the current thread.
+		/*!
+		 * Operator new is used if there is no pool for the current thread.
+		 */
+		static Node *
+		allocate_node( execution_demand_t && demand )
+			{
+				auto pool = current_pool();
+				if( pool )
+					return pool->allocate( std::move(demand) );
+
+				return new Node( std::move(demand) );
+			}
+
+		//! Allocate nodes for several demands and link them into a chain.
+		/*!
+		 * Nodes are taken from the pool of the current thread (if there
+		 * is such pool). Demands are moved into nodes.
+		 *
+		 * \return the first and the last nodes of the chain.
+		 *
+		 * \attention \a count must be greater than zero.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		static std::pair< Node *, Node * >
+		allocate_chain( execution_demand_t * demands, std::size_t count )
+			{
+				Node * first = allocate_node( std::move( demands[ 0 ] ) );
+				Node * last = first;
+				try
+					{
+						for( std::size_t i = 1; i != count; ++i )
+							{
+								auto n = allocate_node( std::move( demands[ i ] ) );
+								demand_node_pool_details::set_next_node( last->m_next, n );
+								last = n;
+							}
+					}
+				catch( ... )
+					{
+						while( first )
+							{
+								auto n = first;
+								first = demand_node_pool_details::next_node( n->m_next );
+								release_node( n );
+							}
+						throw;
+					}
+
+				return std::make_pair( first, last );
+			}
+
+		//! Release a node to the pool of the current thread.
+		/*!
+		 * Operator delete is used if there is no pool for the current thread.
+		 */
+		static void
+		release_node( Node * n ) SO_5_NOEXCEPT
+			{
+				auto pool = current_pool();
+				if( pool )
+					pool->release( n );
+				else
+					delete n;
+			}
+
+		/*!
+		 * \brief Helper for binding a pool to the current thread.
+		 *
+		 * Usage example:
+		 * \code
+			void work_thread_t::body()
+			{
+				demand_pool_t::binding_t pool_binding{ m_demand_pool };
+				...
+			}
+		 * \endcode
+		 */
+		class binding_t
+			{
+			public :
+				binding_t( demand_node_pool_t & pool )
+					{
+						current_pool() = &pool;
+					}
+				~binding_t()
+					{
+						current_pool() = nullptr;
+					}
+
+				binding_t( const binding_t & ) = delete;
+				binding_t & operator=( const binding_t & ) = delete;
+			};
+
+	private :
+		//! Head of the list of free nodes.
+		Node * m_free{ nullptr };
+
+		//! Count of free nodes.
+		std::size_t m_free_count{ 0 };
+
+		//! Count of allocations from the free list.
+		std::atomic< std::uint64_t > m_hits{ 0 };
+
+		//! Count of allocations by operator new.
+		std::atomic< std::uint64_t > m_misses{ 0 };
+
+		//! Increment a counter which is modified only by the owner thread.
+		/*!
+		 * There is no need for atomic read-modify-write operation
+		 * because there is just one writer.
+		 */
+		static void
+		increment( std::atomic< std::uint64_t > & counter )
+			{
+				counter.store(
+						counter.load( std::memory_order_relaxed ) + 1,
+						std::memory_order_relaxed );
+			}
+
+		//! Pool bound to the current thread.
+		static demand_node_pool_t *&
+		current_pool()
+			{
+				static thread_local demand_node_pool_t * pool = nullptr;
+				return pool;
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -13,6 +13,8 @@
 
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
+#include <so_5/disp/reuse/h/work_stealing_ptr_queue.hpp>
+
 #include <deque>
 #include <vector>
 
@@ -35,6 +37,10 @@ namespace reuse
  * - waiting on spinlock for the limited period of time;
  * - then waiting on heavy synchronization object.
  *
+ * \note Since v.5.5.25 all operations are delegated to an instance of
+ * work_stealing_ptr_queue_t if work-stealing mode is turned on in
+ * queue parameters.
+ *
  * \tparam T type of object.
  *
  * \since
@@ -47,20 +53,27 @@ class mpmc_ptr_queue_t
 		mpmc_ptr_queue_t(
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
 			std::size_t thread_count )
-			:	m_lock{ queue_params.lock_factory()() }
+			:	m_work_stealing_queue{ make_work_stealing_queue_if_needed(
+					queue_params, thread_count ) }
+			,	m_lock{ m_work_stealing_queue ? nullptr :
+					queue_params.lock_factory()() }
 			,	m_max_thread_count{ thread_count }
 			,	m_next_thread_wakeup_threshold{
 					queue_params.next_thread_wakeup_threshold() }
 			{
 				// Reserve some space for storing infos about waiting
 				// customer threads.
-				m_waiting_customers.reserve( thread_count );
+				if( !m_work_stealing_queue )
+					m_waiting_customers.reserve( thread_count );
 			}
 
 		//! Initiate shutdown for working threads.
 		inline void
 		shutdown()
 			{
+				if( m_work_stealing_queue )
+					return m_work_stealing_queue->shutdown();
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				m_shutdown = true;
@@ -76,6 +89,9 @@ class mpmc_ptr_queue_t
 		inline T *
 		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
 			{
+				if( m_work_stealing_queue )
+					return m_work_stealing_queue->pop( condition );
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				do
@@ -116,6 +132,9 @@ class mpmc_ptr_queue_t
 		inline T *
 		try_switch_to_another( T * current ) SO_5_NOEXCEPT
 			{
+				if( m_work_stealing_queue )
+					return m_work_stealing_queue->try_switch_to_another( current );
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				if( m_shutdown )
@@ -141,6 +160,9 @@ class mpmc_ptr_queue_t
 		void
 		schedule( T * queue )
 			{
+				if( m_work_stealing_queue )
+					return m_work_stealing_queue->schedule( queue );
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				m_queue.push_back( queue );
@@ -151,11 +173,28 @@ class mpmc_ptr_queue_t
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
 		allocate_condition()
 			{
+				if( m_work_stealing_queue )
+					return m_work_stealing_queue->allocate_condition();
+
 				return m_lock->allocate_condition();
 			}
 
 	private :
+		/*!
+		 * \brief Actual queue for work-stealing mode.
+		 *
+		 * Is nullptr if work-stealing mode is not used.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		const std::unique_ptr< work_stealing_ptr_queue_t< T > >
+				m_work_stealing_queue;
+
 		//! Object's lock.
+		/*!
+		 * \note Is not created if work-stealing mode is used.
+		 */
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
 
 		//! Shutdown flag.
@@ -193,6 +232,26 @@ class mpmc_ptr_queue_t
 		//! Waiting threads.
 		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
 
+		/*!
+		 * \brief Create an actual queue for work-stealing mode if
+		 * this mode is turned on in queue parameters.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		static std::unique_ptr< work_stealing_ptr_queue_t< T > >
+		make_work_stealing_queue_if_needed(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			{
+				std::unique_ptr< work_stealing_ptr_queue_t< T > > result;
+				if( queue_params.work_stealing() )
+					result.reset( new work_stealing_ptr_queue_t< T >{
+							queue_params, thread_count } );
+
+				return result;
+			}
+
 		void
 		pop_and_notify_one_waiting_customer()
 			{
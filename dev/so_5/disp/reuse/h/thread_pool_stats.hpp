@@ -19,8 +19,10 @@
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
 
 namespace so_5 {
 
@@ -184,6 +186,37 @@ class stats_consumer_t
 			const so_5::current_thread_id_t & thread_id,
 			//! Statistics of working thread.
 			const so_5::stats::work_thread_activity_stats_t & stats ) = 0;
+
+		/*!
+		 * \brief Informs consumer about latency histograms of yet another
+		 * working thread.
+		 *
+		 * \note This method is called only if thread activity tracking
+		 * is turned on.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		add_work_thread_latency(
+			//! ID of working thread.
+			const so_5::current_thread_id_t & thread_id,
+			//! Histograms of working thread.
+			const so_5::stats::work_thread_latency_stats_t & stats ) = 0;
+
+		/*!
+		 * \brief Informs consumer about the state of the pool of
+		 * demand nodes of yet another working thread.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		add_work_thread_demand_pool(
+			//! ID of working thread.
+			const so_5::current_thread_id_t & thread_id,
+			//! Statistics of the pool.
+			const demand_pool_stats_t & stats ) = 0;
 	};
 
 /*!
@@ -244,7 +277,8 @@ class data_source_t : public stats::source_t
 			const mbox_t & mbox ) override
 			{
 				// Collecting...
-				collector_t collector( m_wt_activity );
+				collector_t collector(
+						m_wt_activity, m_wt_latency, m_wt_demand_pools );
 				m_supplier.supply( collector );
 
 				// Distributing...
@@ -271,6 +305,35 @@ class data_source_t : public stats::source_t
 								stats );
 					} );
 
+				collector.for_each_thread_latency(
+					[this, &mbox]( const so_5::current_thread_id_t & thread_id,
+						const so_5::stats::work_thread_latency_stats_t & stats ) {
+						so_5::send< stats::messages::work_thread_latency >(
+								mbox,
+								make_work_thread_prefix( thread_id ),
+								stats::suffixes::work_thread_latency(),
+								thread_id,
+								stats );
+					} );
+
+				collector.for_each_thread_demand_pool(
+					[this, &mbox]( const so_5::current_thread_id_t & thread_id,
+						const demand_pool_stats_t & stats ) {
+						const auto prefix = make_work_thread_prefix( thread_id );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								prefix,
+								stats::suffixes::demand_pool_hits(),
+								static_cast< std::size_t >( stats.m_hits ) );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								prefix,
+								stats::suffixes::demand_pool_misses(),
+								static_cast< std::size_t >( stats.m_misses ) );
+					} );
+
 				collector.for_each_queue(
 					[&mbox]( const queue_description_t & queue ) {
 						so_5::send< stats::messages::quantity< std::size_t > >(
@@ -287,6 +350,70 @@ class data_source_t : public stats::source_t
 					} );
 			}
 
+		//! Storing of statistical information into a snapshot.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		collect(
+			stats::snapshot_collector_t & snapshot ) override
+			{
+				// Collecting...
+				collector_t collector(
+						m_wt_activity, m_wt_latency, m_wt_demand_pools );
+				m_supplier.supply( collector );
+
+				// Storing...
+				snapshot.add(
+						m_prefix,
+						stats::suffixes::disp_thread_count(),
+						collector.thread_count() );
+
+				snapshot.add(
+						m_prefix,
+						stats::suffixes::agent_count(),
+						collector.agent_count() );
+
+				collector.for_each_thread_activity(
+					[this, &snapshot]( const so_5::current_thread_id_t & thread_id,
+						const so_5::stats::work_thread_activity_stats_t & stats ) {
+						snapshot.add(
+								make_work_thread_prefix( thread_id ),
+								stats::suffixes::work_thread_activity(),
+								stats );
+					} );
+
+				collector.for_each_thread_demand_pool(
+					[this, &snapshot]( const so_5::current_thread_id_t & thread_id,
+						const demand_pool_stats_t & stats ) {
+						const auto prefix = make_work_thread_prefix( thread_id );
+
+						snapshot.add(
+								prefix,
+								stats::suffixes::demand_pool_hits(),
+								stats.m_hits );
+
+						snapshot.add(
+								prefix,
+								stats::suffixes::demand_pool_misses(),
+								stats.m_misses );
+					} );
+
+				collector.for_each_queue(
+					[&snapshot]( const queue_description_t & queue ) {
+						snapshot.add(
+								queue.m_prefix,
+								stats::suffixes::agent_count(),
+								queue.m_agent_count );
+
+						snapshot.add(
+								queue.m_prefix,
+								stats::suffixes::work_thread_queue_size(),
+								queue.m_queue_size );
+					} );
+			}
+
 		//! Basic prefix for data source names.
 		const stats::prefix_t &
 		prefix() const
@@ -321,6 +448,59 @@ class data_source_t : public stats::source_t
 		using wt_activity_info_container_t =
 				std::vector< wt_activity_info_t >;
 
+		/*!
+		 * \brief Latency histograms for a particular work thread.
+		 * \since
+		 * v.5.5.25
+		 */
+		struct wt_latency_info_t
+			{
+				so_5::current_thread_id_t m_thread_id;
+				stats::work_thread_latency_stats_t m_stats;
+
+				wt_latency_info_t(
+					const so_5::current_thread_id_t & thread_id,
+					const stats::work_thread_latency_stats_t & stats )
+					:	m_thread_id( thread_id )
+					,	m_stats( stats )
+					{}
+			};
+
+		/*!
+		 * \brief Type of storage for work thread latency histograms.
+		 * \since
+		 * v.5.5.25
+		 */
+		using wt_latency_info_container_t =
+				std::vector< wt_latency_info_t >;
+
+		/*!
+		 * \brief Stats for the pool of demand nodes of a particular
+		 * work thread.
+		 * \since
+		 * v.5.5.25
+		 */
+		struct wt_demand_pool_info_t
+			{
+				so_5::current_thread_id_t m_thread_id;
+				demand_pool_stats_t m_stats;
+
+				wt_demand_pool_info_t(
+					const so_5::current_thread_id_t & thread_id,
+					const demand_pool_stats_t & stats )
+					:	m_thread_id( thread_id )
+					,	m_stats( stats )
+					{}
+			};
+
+		/*!
+		 * \brief Type of storage for stats of demand pools.
+		 * \since
+		 * v.5.5.25
+		 */
+		using wt_demand_pool_info_container_t =
+				std::vector< wt_demand_pool_info_t >;
+
 		//! Statistical information supplier.
 		stats_supplier_t & m_supplier;
 
@@ -339,6 +519,30 @@ class data_source_t : public stats::source_t
 		 */
 		wt_activity_info_container_t m_wt_activity;
 
+		/*!
+		 * \brief Container for collecting latency histograms
+		 * from working threads.
+		 *
+		 * This container is stored in data_source itself and will
+		 * be reused on each distribution cycle.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		wt_latency_info_container_t m_wt_latency;
+
+		/*!
+		 * \brief Container for collecting stats of demand pools
+		 * from working threads.
+		 *
+		 * This container is stored in data_source itself and will
+		 * be reused on each distribution cycle.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		wt_demand_pool_info_container_t m_wt_demand_pools;
+
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wnon-virtual-dtor"
@@ -350,11 +554,19 @@ class data_source_t : public stats::source_t
 			public :
 				collector_t(
 					//! Where to store thread activity stats.
-					wt_activity_info_container_t & wt_activity_holder )
+					wt_activity_info_container_t & wt_activity_holder,
+					//! Where to store thread latency histograms.
+					wt_latency_info_container_t & wt_latency_holder,
+					//! Where to store stats of demand pools.
+					wt_demand_pool_info_container_t & wt_demand_pools_holder )
 					:	m_wt_activity( wt_activity_holder )
+					,	m_wt_latency( wt_latency_holder )
+					,	m_wt_demand_pools( wt_demand_pools_holder )
 					{
 						// Old content must be reset.
 						m_wt_activity.clear();
+						m_wt_latency.clear();
+						m_wt_demand_pools.clear();
 					}
 
 				~collector_t()
@@ -407,6 +619,24 @@ class data_source_t : public stats::source_t
 						m_wt_activity.emplace_back( thread_id, stats );
 					}
 
+				virtual void
+				add_work_thread_latency(
+					const so_5::current_thread_id_t & thread_id,
+					const stats::work_thread_latency_stats_t & stats )
+					override
+					{
+						m_wt_latency.emplace_back( thread_id, stats );
+					}
+
+				virtual void
+				add_work_thread_demand_pool(
+					const so_5::current_thread_id_t & thread_id,
+					const demand_pool_stats_t & stats )
+					override
+					{
+						m_wt_demand_pools.emplace_back( thread_id, stats );
+					}
+
 				std::size_t
 				thread_count() const
 					{
@@ -441,12 +671,30 @@ class data_source_t : public stats::source_t
 							lambda( wt.m_thread_id, wt.m_stats );
 					}
 
+				template< typename Lambda >
+				void
+				for_each_thread_latency( Lambda lambda ) const
+					{
+						for( const auto & wt : m_wt_latency )
+							lambda( wt.m_thread_id, wt.m_stats );
+					}
+
+				template< typename Lambda >
+				void
+				for_each_thread_demand_pool( Lambda lambda ) const
+					{
+						for( const auto & wt : m_wt_demand_pools )
+							lambda( wt.m_thread_id, wt.m_stats );
+					}
+
 			private :
 
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
 
 				wt_activity_info_container_t & m_wt_activity;
+				wt_latency_info_container_t & m_wt_latency;
+				wt_demand_pool_info_container_t & m_wt_demand_pools;
 
 				intrusive_ptr_t< queue_description_holder_t > m_queue_desc_head;
 				intrusive_ptr_t< queue_description_holder_t > m_queue_desc_tail;
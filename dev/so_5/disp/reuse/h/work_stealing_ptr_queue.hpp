@@ -0,0 +1,646 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Multi-producer/Multi-consumer queue of pointers based on
+ * per-thread work-stealing deques.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+namespace work_stealing_details
+{
+
+//
+// chase_lev_deque_t
+//
+/*!
+ * \brief Lock-free work-stealing deque of pointers.
+ *
+ * An implementation of dynamic circular work-stealing deque by
+ * D.Chase and Y.Lev with memory orderings from "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" by N.M.Le, A.Pop, A.Cohen and
+ * F.Zappa Nardelli.
+ *
+ * Only the owner thread can call push(). Any thread (including the
+ * owner) can call steal(). Items are extracted by steal() in FIFO order.
+ *
+ * Old buffers are not deallocated until the destruction of the deque
+ * because some thief can still read from them.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< class T >
+class chase_lev_deque_t
+	{
+		//! Circular buffer for the items.
+		class buffer_t
+			{
+			public :
+				buffer_t( std::int64_t capacity )
+					:	m_mask{ capacity - 1 }
+					,	m_items{ new std::atomic< T * >[
+							static_cast< std::size_t >(capacity) ] }
+					{}
+
+				std::int64_t
+				capacity() const
+					{
+						return m_mask + 1;
+					}
+
+				T *
+				get( std::int64_t index ) const
+					{
+						return m_items[ index & m_mask ].load(
+								std::memory_order_relaxed );
+					}
+
+				void
+				put( std::int64_t index, T * item )
+					{
+						m_items[ index & m_mask ].store(
+								item, std::memory_order_relaxed );
+					}
+
+			private :
+				const std::int64_t m_mask;
+				std::unique_ptr< std::atomic< T * >[] > m_items;
+			};
+
+	public :
+		chase_lev_deque_t( const chase_lev_deque_t & ) = delete;
+		chase_lev_deque_t & operator=( const chase_lev_deque_t & ) = delete;
+
+		//! Initializing constructor.
+		/*!
+		 * \note \a initial_capacity must be a power of 2.
+		 */
+		chase_lev_deque_t( std::int64_t initial_capacity = 64 )
+			{
+				m_buffers.emplace_back( new buffer_t{ initial_capacity } );
+				m_buffer.store( m_buffers.back().get(),
+						std::memory_order_relaxed );
+			}
+
+		//! Push a new item to the bottom of the deque.
+		/*!
+		 * \attention Must be called only by the owner thread.
+		 */
+		void
+		push( T * item )
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed );
+				const auto t = m_top.load( std::memory_order_acquire );
+				auto * buf = m_buffer.load( std::memory_order_relaxed );
+
+				if( b - t > buf->capacity() - 1 )
+					buf = grow( buf, b, t );
+
+				buf->put( b, item );
+				std::atomic_thread_fence( std::memory_order_release );
+				m_bottom.store( b + 1, std::memory_order_relaxed );
+			}
+
+		//! Result of steal attempt.
+		enum class steal_result_t
+			{
+				//! An item extracted.
+				success,
+				//! The deque is empty.
+				empty,
+				//! Another thread extracted an item at the same time.
+				/*!
+				 * The deque can still contain some items.
+				 */
+				aborted
+			};
+
+		//! Try to extract an item from the top of the deque.
+		steal_result_t
+		steal( T *& receiver )
+			{
+				auto t = m_top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_acquire );
+
+				if( t < b )
+					{
+						auto * buf = m_buffer.load( std::memory_order_acquire );
+						auto * item = buf->get( t );
+						if( !m_top.compare_exchange_strong( t, t + 1,
+								std::memory_order_seq_cst,
+								std::memory_order_relaxed ) )
+							return steal_result_t::aborted;
+
+						receiver = item;
+						return steal_result_t::success;
+					}
+
+				return steal_result_t::empty;
+			}
+
+		//! Approximate count of items in the deque.
+		/*!
+		 * Can be called from any thread. Value can be outdated immediately.
+		 */
+		std::size_t
+		approx_size() const
+			{
+				const auto t = m_top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_acquire );
+
+				return b > t ? static_cast< std::size_t >( b - t ) : 0u;
+			}
+
+	private :
+		//! Index of the top item (the oldest one).
+		std::atomic< std::int64_t > m_top{ 0 };
+
+		//! Padding to place top and bottom indexes into different
+		//! cache lines because they are modified by different threads.
+		char m_padding[ 64 ];
+
+		//! Index of the next free place at bottom.
+		std::atomic< std::int64_t > m_bottom{ 0 };
+
+		//! The current buffer.
+		std::atomic< buffer_t * > m_buffer{ nullptr };
+
+		//! All buffers which were allocated by that deque.
+		/*!
+		 * Modified only by the owner thread.
+		 */
+		std::vector< std::unique_ptr< buffer_t > > m_buffers;
+
+		//! Replace the current buffer by a new one with the bigger capacity.
+		buffer_t *
+		grow( buffer_t * old_buf, std::int64_t bottom, std::int64_t top )
+			{
+				std::unique_ptr< buffer_t > new_buf{
+						new buffer_t{ old_buf->capacity() * 2 } };
+				for( auto i = top; i != bottom; ++i )
+					new_buf->put( i, old_buf->get( i ) );
+
+				auto * result = new_buf.get();
+				m_buffers.push_back( std::move(new_buf) );
+				m_buffer.store( result, std::memory_order_release );
+
+				return result;
+			}
+	};
+
+//
+// current_worker_t
+//
+/*!
+ * \brief Description of work thread which is running on the current thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct current_worker_t
+	{
+		//! The queue the thread belongs to.
+		const void * m_queue;
+		//! Index of the thread inside the queue.
+		std::size_t m_index;
+	};
+
+/*!
+ * \brief Access to description of the current work thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline current_worker_t &
+current_worker()
+	{
+		static thread_local current_worker_t worker{ nullptr, 0u };
+		return worker;
+	}
+
+} /* namespace work_stealing_details */
+
+//
+// work_stealing_ptr_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of pointers with
+ * work-stealing.
+ *
+ * Every work thread owns a lock-free deque. If an item is scheduled
+ * by a work thread then it is pushed into the deque of that thread.
+ * Items scheduled by other threads go into the shared injection queue.
+ *
+ * A work thread extracts items from its own deque first, then from
+ * the injection queue, then it tries to steal from the siblings' deques.
+ * The common lock is acquired only for going to sleep and for waking
+ * sleeping threads up.
+ *
+ * Has the same interface as mpmc_ptr_queue_t.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< class T >
+class work_stealing_ptr_queue_t
+	{
+		using deque_t = work_stealing_details::chase_lev_deque_t< T >;
+		using steal_result_t = typename deque_t::steal_result_t;
+
+	public :
+		work_stealing_ptr_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_max_thread_count{ thread_count }
+			,	m_next_thread_wakeup_threshold{
+					queue_params.next_thread_wakeup_threshold() }
+			{
+				m_deques.reserve( thread_count );
+				for( std::size_t i = 0; i != thread_count; ++i )
+					m_deques.emplace_back( new deque_t{} );
+
+				m_waiting_customers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		inline void
+		shutdown()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				const auto index = current_worker_index();
+
+				while( !m_shutdown.load( std::memory_order_acquire ) )
+					{
+						T * r = try_find_item( index );
+						if( r )
+							{
+								// There could be non-empty deques and
+								// sleeping workers. But another thread should
+								// be woken up only if there are too many items
+								// for the current one.
+								if( m_sleepers.load( std::memory_order_acquire ) &&
+										is_wakeup_threshold_exceeded() )
+									{
+										std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+												lock{ *m_lock };
+										try_wakeup_someone_if_possible( true );
+									}
+
+								return r;
+							}
+
+						wait_for_items( condition );
+					}
+
+				return nullptr;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		try_switch_to_another( T * current ) SO_5_NOEXCEPT
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				const auto index = current_worker_index();
+
+				T * r = nullptr;
+				if( try_extract_from( *m_deques[ index ], r ) ||
+						try_extract_from_injection_queue( r ) )
+					{
+						// Old non-empty queue must be stored for further
+						// processing. No need to wakeup someone because
+						// the count of scheduled items didn't changed.
+						m_deques[ index ]->push( current );
+						return r;
+					}
+
+				return current;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue )
+			{
+				auto & worker = work_stealing_details::current_worker();
+				if( this == worker.m_queue )
+					{
+						auto & d = *m_deques[ worker.m_index ];
+						d.push( queue );
+
+						std::atomic_thread_fence( std::memory_order_seq_cst );
+						if( m_sleepers.load( std::memory_order_relaxed ) &&
+								d.approx_size() > m_next_thread_wakeup_threshold )
+							{
+								std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+										lock{ *m_lock };
+								try_wakeup_someone_if_possible( true );
+							}
+					}
+				else
+					{
+						std::size_t injection_size;
+						{
+							std::lock_guard< spinlock_t > lock{ m_injection_lock };
+							m_injection_queue.push_back( queue );
+							injection_size = m_injection_queue.size();
+							m_injection_size.store(
+									injection_size, std::memory_order_release );
+						}
+
+						std::atomic_thread_fence( std::memory_order_seq_cst );
+						const auto sleepers = m_sleepers.load(
+								std::memory_order_relaxed );
+						if( sleepers && (
+								injection_size > m_next_thread_wakeup_threshold ||
+								m_max_thread_count == sleepers ) )
+							{
+								std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+										lock{ *m_lock };
+								try_wakeup_someone_if_possible( true );
+							}
+					}
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock->allocate_condition();
+			}
+
+	private :
+		using spinlock_t = so_5::default_spinlock_t;
+
+		//! Object's lock.
+		/*!
+		 * Used only for sleeping and waking up of work threads.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Deques of work threads.
+		std::vector< std::unique_ptr< deque_t > > m_deques;
+
+		//! Counter for assigning indexes to work threads.
+		std::atomic< std::size_t > m_next_worker_index{ 0 };
+
+		//! Lock for the injection queue.
+		spinlock_t m_injection_lock;
+
+		//! Queue for items scheduled by threads outside of the pool.
+		std::deque< T * > m_injection_queue;
+
+		//! Size of the injection queue.
+		/*!
+		 * Allows to check emptiness of the injection queue without
+		 * acquiring m_injection_lock.
+		 */
+		std::atomic< std::size_t > m_injection_size{ 0 };
+
+		//! Count of work threads which are going to sleep or sleeping.
+		std::atomic< std::size_t > m_sleepers{ 0 };
+
+		//! Is some working thread is in wakeup process now.
+		/*!
+		 * Protected by m_lock.
+		 */
+		bool	m_wakeup_in_progress{ false };
+
+		//! Maximum count of working threads to be used with that queue.
+		const std::size_t m_max_thread_count;
+
+		//! Threshold for wake up next working thread if there are
+		//! non-empty agent queues.
+		const std::size_t m_next_thread_wakeup_threshold;
+
+		//! Waiting threads.
+		/*!
+		 * Protected by m_lock.
+		 */
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+
+		//! Get the index of the current work thread.
+		/*!
+		 * The index is assigned at the first call to this method
+		 * on the context of the work thread.
+		 */
+		std::size_t
+		current_worker_index()
+			{
+				auto & worker = work_stealing_details::current_worker();
+				if( this != worker.m_queue )
+					{
+						worker.m_queue = this;
+						worker.m_index = m_next_worker_index.fetch_add(
+								1, std::memory_order_relaxed ) % m_deques.size();
+					}
+
+				return worker.m_index;
+			}
+
+		static bool
+		try_extract_from( deque_t & d, T *& receiver )
+			{
+				steal_result_t r;
+				do
+					{
+						r = d.steal( receiver );
+					}
+				while( steal_result_t::aborted == r );
+
+				return steal_result_t::success == r;
+			}
+
+		bool
+		try_extract_from_injection_queue( T *& receiver )
+			{
+				if( !m_injection_size.load( std::memory_order_acquire ) )
+					return false;
+
+				std::lock_guard< spinlock_t > lock{ m_injection_lock };
+				if( m_injection_queue.empty() )
+					return false;
+
+				receiver = m_injection_queue.front();
+				m_injection_queue.pop_front();
+				m_injection_size.store(
+						m_injection_queue.size(), std::memory_order_release );
+
+				return true;
+			}
+
+		//! An attempt to find an item for the work thread.
+		/*!
+		 * \retval nullptr if there is no items.
+		 */
+		T *
+		try_find_item( std::size_t index )
+			{
+				T * r = nullptr;
+
+				if( try_extract_from( *m_deques[ index ], r ) ||
+						try_extract_from_injection_queue( r ) )
+					return r;
+
+				// Try to steal from siblings.
+				const auto count = m_deques.size();
+				for( std::size_t i = 1; i < count; ++i )
+					if( try_extract_from( *m_deques[ (index + i) % count ], r ) )
+						return r;
+
+				return nullptr;
+			}
+
+		//! Is there some item in any of deques or in the injection queue?
+		bool
+		is_there_any_item() const
+			{
+				// This fence pairs with the fence in schedule(). It guarantees
+				// that a sleeping thread either sees the new item or
+				// the scheduling thread sees the sleeping one.
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				if( m_injection_size.load( std::memory_order_acquire ) )
+					return true;
+
+				for( const auto & d : m_deques )
+					if( d->approx_size() )
+						return true;
+
+				return false;
+			}
+
+		//! Is count of items in all deques and in the injection queue
+		//! greater than m_next_thread_wakeup_threshold?
+		/*!
+		 * Counting is stopped as soon as the threshold is exceeded.
+		 */
+		bool
+		is_wakeup_threshold_exceeded() const
+			{
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				std::size_t items = m_injection_size.load(
+						std::memory_order_acquire );
+				if( items > m_next_thread_wakeup_threshold )
+					return true;
+
+				for( const auto & d : m_deques )
+					{
+						items += d->approx_size();
+						if( items > m_next_thread_wakeup_threshold )
+							return true;
+					}
+
+				return false;
+			}
+
+		//! Wait while some items will be scheduled or shutdown initiated.
+		void
+		wait_for_items( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_sleepers.fetch_add( 1, std::memory_order_seq_cst );
+
+				// There must be the second check for the items because
+				// some item could be scheduled while the current thread
+				// was trying to acquire the lock.
+				if( !m_shutdown.load( std::memory_order_acquire ) &&
+						!is_there_any_item() )
+					{
+						m_waiting_customers.push_back( &condition );
+
+						condition.wait();
+						// If we are here then the current wakeup procedure is
+						// finished.
+						m_wakeup_in_progress = false;
+					}
+
+				m_sleepers.fetch_sub( 1, std::memory_order_seq_cst );
+			}
+
+		void
+		pop_and_notify_one_waiting_customer()
+			{
+				auto & condition = *m_waiting_customers.back();
+				m_waiting_customers.pop_back();
+
+				m_wakeup_in_progress = true;
+				condition.notify();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread is this necessary
+		 * and possible.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		try_wakeup_someone_if_possible( bool has_items )
+			{
+				if( has_items &&
+						!m_waiting_customers.empty() &&
+						!m_wakeup_in_progress )
+					pop_and_notify_one_waiting_customer();
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
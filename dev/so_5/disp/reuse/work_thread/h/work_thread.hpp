@@ -24,6 +24,8 @@
 
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
+
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
@@ -67,6 +69,119 @@ enum class extraction_result_t
 namespace demand_queue_details
 {
 
+/*!
+ * \brief A node of intrusive list for lock-free mode of demand queue.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct demand_node_t
+{
+	//! Next node in the list.
+	std::atomic< demand_node_t * > m_next{ nullptr };
+
+	//! Demand to be processed.
+	execution_demand_t m_demand;
+
+	demand_node_t() = default;
+
+	demand_node_t( execution_demand_t && demand )
+		:	m_demand( std::move(demand) )
+	{}
+
+	//! Access to the demand.
+	/*!
+	 * It is necessary for demand_node_pool_t.
+	 */
+	execution_demand_t &
+	demand() SO_5_NOEXCEPT
+	{
+		return m_demand;
+	}
+};
+
+/*!
+ * \brief Type of pool for nodes of lock-free mode of demand queue.
+ *
+ * Every work thread owns such pool. Nodes for demands sent from a work
+ * thread are taken from the pool of that thread. Nodes of processed
+ * demands are returned to the pool of the consumer thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+using demand_pool_t = so_5::disp::reuse::demand_node_pool_t< demand_node_t >;
+
+/*!
+ * \brief A bunch of demands extracted from demand queue in lock-free mode.
+ *
+ * Has the same interface as demand_container_t for work thread.
+ * Nodes are returned to the node pool of the current thread during
+ * pop_front().
+ *
+ * \since
+ * v.5.5.25
+ */
+class demand_batch_t
+{
+	demand_node_t * m_head{ nullptr };
+	demand_node_t * m_tail{ nullptr };
+	std::size_t m_size{ 0 };
+
+public :
+	demand_batch_t() = default;
+	demand_batch_t( const demand_batch_t & ) = delete;
+	demand_batch_t & operator=( const demand_batch_t & ) = delete;
+
+	~demand_batch_t()
+	{
+		while( !empty() )
+			pop_front();
+	}
+
+	bool
+	empty() const
+	{
+		return nullptr == m_head;
+	}
+
+	std::size_t
+	size() const
+	{
+		return m_size;
+	}
+
+	execution_demand_t &
+	front()
+	{
+		return m_head->m_demand;
+	}
+
+	void
+	pop_front()
+	{
+		auto n = m_head;
+		m_head = n->m_next.load( std::memory_order_relaxed );
+		if( !m_head )
+			m_tail = nullptr;
+		--m_size;
+
+		demand_pool_t::release_node( n );
+	}
+
+	void
+	push_back( demand_node_t * n )
+	{
+		n->m_next.store( nullptr, std::memory_order_relaxed );
+		if( m_tail )
+			m_tail->m_next.store( n, std::memory_order_relaxed );
+		else
+			m_head = n;
+		m_tail = n;
+		++m_size;
+	}
+};
+
 /*!
  * \brief Common data for all implementations of demand_queue.
  *
@@ -87,19 +202,231 @@ struct common_data_t
 	/*!
 		true -- shall do the service, methods push/pop must work.
 		false -- the service is stopped or will be stopped.
+
+		\note Since v.5.5.25 it is atomic because it is read
+		without acquiring m_lock in lock-free mode.
 	*/
-	bool m_in_service{ false };
+	std::atomic< bool > m_in_service{ false };
+
+	/*!
+	 * \name Data for lock-free mode.
+	 * \{
+	 */
+	/*!
+	 * \brief Is lock-free mode used?
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	const bool m_lock_free;
+
+	/*!
+	 * \brief Stub node for intrusive lock-free list.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	demand_node_t m_stub;
+
+	/*!
+	 * \brief The last node pushed to the list.
+	 *
+	 * Modified by producers.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< demand_node_t * > m_head{ &m_stub };
+
+	/*!
+	 * \brief The next node to be extracted from the list.
+	 *
+	 * Modified only by the consumer.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	demand_node_t * m_tail{ &m_stub };
+
+	/*!
+	 * \brief Count of demands in the list.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< std::size_t > m_lock_free_size{ 0 };
+
+	/*!
+	 * \brief Is the consumer going to sleep on an empty list?
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< bool > m_consumer_sleeping{ false };
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \name Data for idle handler.
+	 * \{
+	 */
+	/*!
+	 * \brief Optional idle handler.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	const queue_traits::idle_handler_shptr_t m_idle_handler;
+
+	/*!
+	 * \brief Has the idle handler requested wake up of the consumer?
+	 *
+	 * \note Protected by m_lock.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	bool m_wakeup_requested{ false };
+	/*!
+	 * \}
+	 */
 
 	//! Initializing constructor.
 	common_data_t(
 		//! Lock object to be used by queue.
-		queue_traits::lock_unique_ptr_t lock )
+		queue_traits::lock_unique_ptr_t lock,
+		//! Should the lock-free mode be used?
+		bool lock_free,
+		//! Optional idle handler.
+		queue_traits::idle_handler_shptr_t idle_handler )
 		:	m_lock( std::move(lock) )
+		,	m_lock_free( lock_free )
+		,	m_idle_handler( std::move(idle_handler) )
 	{}
 
 	~common_data_t()
 	{
 		m_demands.clear();
+		clear_lock_free_list();
+	}
+
+	/*!
+	 * \brief Push a node to the intrusive lock-free list.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	push_node( demand_node_t * n ) SO_5_NOEXCEPT
+	{
+		n->m_next.store( nullptr, std::memory_order_relaxed );
+		auto prev = m_head.exchange( n, std::memory_order_seq_cst );
+		prev->m_next.store( n, std::memory_order_release );
+	}
+
+	/*!
+	 * \brief Push a chain of nodes to the intrusive lock-free list.
+	 *
+	 * Nodes from \a first to \a last must be already linked together.
+	 * The whole chain is added to the list by one atomic exchange.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	push_chain( demand_node_t * first, demand_node_t * last ) SO_5_NOEXCEPT
+	{
+		last->m_next.store( nullptr, std::memory_order_relaxed );
+		auto prev = m_head.exchange( last, std::memory_order_seq_cst );
+		prev->m_next.store( first, std::memory_order_release );
+	}
+
+	/*!
+	 * \brief Extract a node from the intrusive lock-free list.
+	 *
+	 * This is a variant of intrusive MPSC queue by Dmitry Vyukov.
+	 *
+	 * \retval nullptr if the list is empty or if a producer is in the
+	 * middle of push operation.
+	 *
+	 * \attention Must be called only by the consumer.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	demand_node_t *
+	pop_node() SO_5_NOEXCEPT
+	{
+		auto tail = m_tail;
+		auto next = tail->m_next.load( std::memory_order_acquire );
+		if( &m_stub == tail )
+		{
+			if( !next )
+				return nullptr;
+
+			m_tail = next;
+			tail = next;
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		if( tail != m_head.load( std::memory_order_acquire ) )
+			// Some producer is in the middle of push operation.
+			return nullptr;
+
+		push_node( &m_stub );
+
+		next = tail->m_next.load( std::memory_order_acquire );
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		return nullptr;
+	}
+
+	/*!
+	 * \brief Is the intrusive lock-free list definitely empty?
+	 *
+	 * Returns false if the list contains some nodes or if some
+	 * producer is in the middle of push operation.
+	 *
+	 * \attention Must be called only by the consumer.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	bool
+	is_lock_free_list_empty() const SO_5_NOEXCEPT
+	{
+		return &m_stub == m_tail &&
+				nullptr == m_stub.m_next.load( std::memory_order_acquire ) &&
+				&m_stub == m_head.load( std::memory_order_seq_cst );
+	}
+
+	/*!
+	 * \brief Destroy all nodes from the intrusive lock-free list.
+	 *
+	 * \attention Must be called only when there is no more producers.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	clear_lock_free_list() SO_5_NOEXCEPT
+	{
+		demand_node_t * n;
+		while( nullptr != (n = pop_node()) )
+			delete n;
+
+		m_lock_free_size.store( 0, std::memory_order_relaxed );
 	}
 };
 
@@ -111,8 +438,11 @@ class no_activity_tracking_impl_t : protected common_data_t
 {
 public :
 	no_activity_tracking_impl_t(
-		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
+		queue_traits::lock_unique_ptr_t lock,
+		bool lock_free,
+		queue_traits::idle_handler_shptr_t idle_handler )
+		:	common_data_t(
+				std::move(lock), lock_free, std::move(idle_handler) )
 	{}
 
 protected :
@@ -131,8 +461,11 @@ class with_activity_tracking_impl_t : protected common_data_t
 {
 public :
 	with_activity_tracking_impl_t(
-		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
+		queue_traits::lock_unique_ptr_t lock,
+		bool lock_free,
+		queue_traits::idle_handler_shptr_t idle_handler )
+		:	common_data_t(
+				std::move(lock), lock_free, std::move(idle_handler) )
 		,	m_waiting_stats( *m_lock )
 	{}
 
@@ -142,6 +475,18 @@ public :
 		return m_waiting_stats.take_stats();
 	}
 
+	/*!
+	 * \brief Get the histogram of waiting periods.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	so_5::stats::latency_histogram_t
+	take_waiting_histogram() const
+	{
+		return m_waiting_stats.take_histogram();
+	}
+
 protected :
 	void
 	wait_started()
@@ -173,17 +518,31 @@ private :
 
 	demand_queue_t is thread safe and is intended to be used by 
 	several concurrent threads.
+
+	\note Since v.5.5.25 there is lock-free mode in which demands
+	are stored in an intrusive lock-free list instead of demand_container_t.
+	In that mode the lock object is used only for waiting on an empty queue.
+
+	\note Since v.5.5.25 there can be an idle handler. It is called
+	by the consumer on every attempt to extract demands and before
+	every sleep on an empty queue. The time of the sleep is limited
+	by the value returned by the idle handler.
 */
 template< typename Impl >
 class queue_template_t
 	:	public event_queue_t
+	,	public queue_traits::idle_handler_t::waker_t
 	,	public Impl
 {
 public:
 	queue_template_t(
 		//! Lock object to be used by queue.
-		queue_traits::lock_unique_ptr_t lock )
-		:	Impl( std::move(lock) )
+		queue_traits::lock_unique_ptr_t lock,
+		//! Should the lock-free mode be used?
+		bool lock_free,
+		//! Optional idle handler.
+		queue_traits::idle_handler_shptr_t idle_handler )
+		:	Impl( std::move(lock), lock_free, std::move(idle_handler) )
 	{}
 
 	/*!
@@ -193,6 +552,12 @@ public:
 	virtual void
 	push( execution_demand_t demand ) override
 	{
+		if( this->m_lock_free )
+		{
+			push_lock_free( std::move(demand) );
+			return;
+		}
+
 		queue_traits::lock_guard_t guard{ *(this->m_lock) };
 
 		if( this->m_in_service )
@@ -209,6 +574,46 @@ public:
 			}
 		}
 	}
+
+	/*!
+	 * All demands are added under one lock acquisition (or by one
+	 * atomic operation in lock-free mode). The consumer is notified
+	 * at most once.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	virtual void
+	push_many(
+		execution_demand_t * demands,
+		std::size_t count ) override
+	{
+		if( !count )
+			return;
+
+		if( this->m_lock_free )
+		{
+			push_many_lock_free( demands, count );
+			return;
+		}
+
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service )
+		{
+			const bool demands_empty_before_service = this->m_demands.empty();
+
+			for( std::size_t i = 0; i != count; ++i )
+				this->m_demands.push_back( std::move( demands[ i ] ) );
+
+			if( demands_empty_before_service )
+			{
+				// May be someone is waiting...
+				// It should be informed about new demands.
+				guard.notify_one();
+			}
+		}
+	}
 	/*!
 	 * \}
 	 */
@@ -232,6 +637,9 @@ public:
 		/*! External demands counter to be updated. */
 		demands_counter_t & external_counter )
 	{
+		if( this->m_idle_handler )
+			return pop_with_idle_handler( demands, external_counter );
+
 		queue_traits::unique_lock_t lock{ *(this->m_lock) };
 		while( true )
 		{
@@ -263,28 +671,157 @@ public:
 		return extraction_result_t::demand_extracted;
 	}
 
+	/*!
+	 * \brief Max count of demands to be extracted at once in lock-free mode.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	static const std::size_t max_lock_free_batch_size = 1024;
+
+	//! Try to extract demands from the queue in lock-free mode.
+	/*!
+		All demands available at the moment are extracted.
+
+		If there is no demands in queue then current thread
+		will sleep until:
+		- the new demand is put in the queue;
+		- a shutdown signal.
+
+		\since
+		v.5.5.25
+	*/
+	extraction_result_t
+	pop(
+		/*! Receiver for extracted demands. */
+		demand_batch_t & demands,
+		/*! External demands counter to be updated. */
+		demands_counter_t & external_counter )
+	{
+		std::chrono::steady_clock::duration idle_timeout{};
+
+		while( true )
+		{
+			if( this->m_idle_handler )
+				idle_timeout = this->m_idle_handler->on_idle();
+
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return extraction_result_t::shutting_down;
+
+			// The count of extracted demands is limited to avoid
+			// endless extraction if producers are faster than the consumer.
+			demand_node_t * n;
+			while( demands.size() < max_lock_free_batch_size &&
+					nullptr != (n = this->pop_node()) )
+				demands.push_back( n );
+
+			if( !demands.empty() )
+			{
+				external_counter.store( demands.size(), std::memory_order_release );
+				this->m_lock_free_size.fetch_sub(
+						demands.size(), std::memory_order_release );
+
+				return extraction_result_t::demand_extracted;
+			}
+
+			if( !this->is_lock_free_list_empty() )
+			{
+				// Some producer is in the middle of push operation.
+				std::this_thread::yield();
+				continue;
+			}
+
+			queue_traits::unique_lock_t lock{ *(this->m_lock) };
+
+			this->m_consumer_sleeping.store( true, std::memory_order_seq_cst );
+
+			// The list must be checked again because a producer
+			// can skip notification if it didn't see the sleeping flag.
+			if( this->m_in_service.load( std::memory_order_acquire ) &&
+					this->is_lock_free_list_empty() )
+			{
+				if( this->m_idle_handler )
+				{
+					if( !this->m_wakeup_requested )
+					{
+						this->wait_started();
+
+						lock.wait_for_notify( idle_timeout );
+
+						this->wait_finished();
+					}
+
+					this->m_wakeup_requested = false;
+				}
+				else
+				{
+					this->wait_started();
+
+					lock.wait_for_notify();
+
+					this->wait_finished();
+				}
+			}
+
+			this->m_consumer_sleeping.store( false, std::memory_order_relaxed );
+		}
+	}
+
 	//! Start demands processing.
 	void
 	start_service()
 	{
-		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+		{
+			queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
-		this->m_in_service = true;
+			this->m_in_service = true;
+		}
+
+		if( this->m_idle_handler )
+			this->m_idle_handler->attach( this );
 	}
 
 	//! Stop demands processing.
 	void
 	stop_service()
 	{
+		if( this->m_idle_handler )
+			this->m_idle_handler->attach( nullptr );
+
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		this->m_in_service = false;
+		if( this->m_lock_free )
+		{
+			// A producer can notify the consumer at the same time.
+			// The consumer must be notified only once, so the sleeping
+			// flag is reset in the same way as in
+			// wake_up_consumer_if_sleeping().
+			if( this->m_consumer_sleeping.exchange(
+					false, std::memory_order_seq_cst ) )
+				lock.notify_one();
+		}
 		// If the demands queue is empty then someone is waiting
 		// for new demands inside pop().
-		if( this->m_demands.empty() )
+		else if( this->m_demands.empty() )
 			lock.notify_one();
 	}
 
+	/*!
+	 * \brief Implementation of waker interface for idle handler.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	virtual void
+	wake_up() SO_5_NOEXCEPT override
+	{
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+
+		this->m_wakeup_requested = true;
+		lock.notify_one();
+	}
+
 	//! Clear demands queue.
 	void
 	clear()
@@ -292,6 +829,9 @@ public:
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		this->m_demands.clear();
+
+		if( this->m_lock_free )
+			this->clear_lock_free_list();
 	}
 
 	/*!
@@ -307,11 +847,150 @@ public:
 	std::size_t
 	demands_count( const demands_counter_t & external_counter )
 	{
+		if( this->m_lock_free )
+			return this->m_lock_free_size.load( std::memory_order_acquire )
+					+ external_counter.load( std::memory_order_acquire );
+
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		return this->m_demands.size()
 				+ external_counter.load( std::memory_order_acquire );
 	}
+
+	/*!
+	 * \brief Is lock-free mode used?
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	bool
+	is_lock_free() const
+	{
+		return this->m_lock_free;
+	}
+
+private :
+	/*!
+	 * \brief Implementation of pop for the case when there is
+	 * an idle handler.
+	 *
+	 * The idle handler is called without acquiring the queue lock
+	 * because it can push new demands to the same queue.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	extraction_result_t
+	pop_with_idle_handler(
+		/*! Receiver for extracted demands. */
+		demand_container_t & demands,
+		/*! External demands counter to be updated. */
+		demands_counter_t & external_counter )
+	{
+		while( true )
+		{
+			const auto idle_timeout = this->m_idle_handler->on_idle();
+
+			queue_traits::unique_lock_t lock{ *(this->m_lock) };
+
+			if( this->m_in_service && !this->m_demands.empty() )
+			{
+				demands.swap( this->m_demands );
+
+				// It's time to update external counter.
+				external_counter.store( demands.size(), std::memory_order_release );
+
+				return extraction_result_t::demand_extracted;
+			}
+			else if( !this->m_in_service )
+				return extraction_result_t::shutting_down;
+
+			// Queue is empty. We should wait for a demand, a shutdown
+			// signal, a wake up request or for the end of idle timeout.
+			// But only if there was no wake up request since the last
+			// call to the idle handler.
+			if( !this->m_wakeup_requested )
+			{
+				this->wait_started();
+
+				lock.wait_for_notify( idle_timeout );
+
+				this->wait_finished();
+			}
+
+			this->m_wakeup_requested = false;
+		}
+	}
+
+	/*!
+	 * \brief Implementation of push for lock-free mode.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	push_lock_free( execution_demand_t && demand )
+	{
+		if( !this->m_in_service.load( std::memory_order_acquire ) )
+			return;
+
+		auto n = demand_pool_t::allocate_node( std::move(demand) );
+
+		this->m_lock_free_size.fetch_add( 1, std::memory_order_release );
+		this->push_node( n );
+
+		wake_up_consumer_if_sleeping();
+	}
+
+	/*!
+	 * \brief Implementation of push_many for lock-free mode.
+	 *
+	 * Nodes for all demands are linked into a chain and the chain
+	 * is added to the list by one atomic operation.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	push_many_lock_free( execution_demand_t * demands, std::size_t count )
+	{
+		if( !this->m_in_service.load( std::memory_order_acquire ) )
+			return;
+
+		const auto chain = demand_pool_t::allocate_chain( demands, count );
+
+		this->m_lock_free_size.fetch_add( count, std::memory_order_release );
+		this->push_chain( chain.first, chain.second );
+
+		wake_up_consumer_if_sleeping();
+	}
+
+	/*!
+	 * \brief Notify the consumer if it is going to sleep on an empty list.
+	 *
+	 * This check pairs with the check of the list emptiness
+	 * in pop(): either the consumer sees the new nodes or we see
+	 * the sleeping flag.
+	 *
+	 * The sleeping flag is reset by the producer which does the
+	 * notification. It guarantees that the consumer is notified only
+	 * once. This is important for combined_lock: the second notification
+	 * before the consumer reacquires the lock leads to a deadlock.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	wake_up_consumer_if_sleeping()
+	{
+		if( this->m_consumer_sleeping.load( std::memory_order_seq_cst ) )
+		{
+			queue_traits::lock_guard_t guard{ *(this->m_lock) };
+			if( this->m_consumer_sleeping.exchange(
+					false, std::memory_order_seq_cst ) )
+				guard.notify_one();
+		}
+	}
 };
 
 } /* namespace demand_queue_details */
@@ -366,6 +1045,16 @@ struct common_data_t
 	//! Demands queue.
 	Demand_Queue m_queue;
 
+	/*!
+	 * \brief Pool of nodes for demand queues in lock-free mode.
+	 *
+	 * Is bound to the working thread for the whole lifetime of the thread.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	demand_queue_details::demand_pool_t m_demand_pool;
+
 	/*!
 	 * \brief ID of working thread.
 	 *
@@ -382,8 +1071,11 @@ struct common_data_t
 	demands_counter_t m_demands_count = { 0 };
 
 	common_data_t(
-		queue_traits::lock_factory_t queue_lock_factory )
-		:	m_queue( queue_lock_factory() )
+		const queue_traits::queue_params_t & queue_params )
+		:	m_queue(
+				queue_params.lock_factory()(),
+				queue_params.lock_free(),
+				queue_params.idle_handler() )
 	{}
 };
 
@@ -398,16 +1090,21 @@ class no_activity_tracking_impl_t
 {
 public :
 	no_activity_tracking_impl_t(
-		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t( std::move(queue_lock_factory) )
+		const queue_traits::queue_params_t & queue_params )
+		:	common_data_t( queue_params )
 	{}
 
 protected :
 	//! Main method for serving block of demands.
+	/*!
+	 * \tparam Demands type of container for demands. It is
+	 * demand_container_t or (since v.5.5.25) demand_batch_t.
+	 */
+	template< typename Demands >
 	void
 	serve_demands_block(
 		//! Bunch of demands to be processed.
-		demand_container_t & demands )
+		Demands & demands )
 	{
 		while( !demands.empty() )
 		{
@@ -434,8 +1131,8 @@ class activity_tracking_impl_t
 
 public :
 	activity_tracking_impl_t(
-		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t( std::move(queue_lock_factory) )
+		const queue_traits::queue_params_t & queue_params )
+		:	common_data_t( queue_params )
 	{}
 
 	/*!
@@ -474,12 +1171,33 @@ public :
 		return result;
 	}
 
+	/*!
+	 * \brief Get the latency histograms.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	so_5::stats::work_thread_latency_stats_t
+	take_latency_stats() const
+	{
+		so_5::stats::work_thread_latency_stats_t result;
+		result.m_working_histogram = m_working_histogram.take();
+		result.m_waiting_histogram = m_queue.take_waiting_histogram();
+
+		return result;
+	}
+
 protected :
 	//! Main method for serving block of demands.
+	/*!
+	 * \tparam Demands type of container for demands. It is
+	 * demand_container_t or (since v.5.5.25) demand_batch_t.
+	 */
+	template< typename Demands >
 	void
 	serve_demands_block(
 		//! Bunch of demands to be processed.
-		demand_container_t & demands )
+		Demands & demands )
 	{
 		auto activity_started_at = so_5::stats::clock_type_t::now();
 
@@ -500,6 +1218,8 @@ protected :
 			demands.pop_front();
 			--m_demands_count;
 
+			m_working_histogram.add( activity_finished_at - activity_started_at );
+
 			{
 				std::lock_guard< activity_tracking_traits::lock_t > lock{ m_stats_lock };
 				so_5::stats::details::update_stats_from_duration(
@@ -535,6 +1255,15 @@ private :
 	 * \brief Activity statistics.
 	 */
 	so_5::stats::activity_stats_t m_activity_stats{};
+
+	/*!
+	 * \brief Histogram of event service times.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	so_5::stats::activity_tracking_stuff::latency_histogram_collector_t
+			m_working_histogram;
 };
 
 /*!
@@ -548,9 +1277,13 @@ class work_thread_template_t : public Impl
 {
 public :
 	work_thread_template_t(
-		//! Factory for creation of lock object for demand queue.
-		queue_traits::lock_factory_t queue_lock_factory )
-		:	Impl( std::move(queue_lock_factory) )
+		//! Parameters for demand queue.
+		/*!
+		 * \note Since v.5.5.25 the whole parameters object is used
+		 * instead of lock factory only.
+		 */
+		const queue_traits::queue_params_t & queue_params )
+		:	Impl( queue_params )
 	{}
 
 	//! Start the working thread.
@@ -634,8 +1367,30 @@ private :
 		// request on every event execution.
 		this->m_thread_id = so_5::query_current_thread_id();
 
+		// Nodes for demands sent to lock-free queues from this thread
+		// will be taken from this pool.
+		demand_queue_details::demand_pool_t::binding_t pool_binding{
+				this->m_demand_pool };
+
+		if( this->m_queue.is_lock_free() )
+			serve_demands< demand_queue_details::demand_batch_t >();
+		else
+			serve_demands< demand_container_t >();
+	}
+
+	//! Main loop of demands processing.
+	/*!
+	 * \tparam Demands type of local container for demands.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	template< typename Demands >
+	void
+	serve_demands()
+	{
 		// Local demands queue.
-		demand_container_t demands;
+		Demands demands;
 
 		auto result = extraction_result_t::no_demands;
 
@@ -436,6 +436,15 @@ class dispatcher_t
 							[&wt, &consumer]( const stats_t & st ) {
 								consumer.add_work_thread_activity( wt.thread_id(), st );
 							} );
+
+						using latency_t = so_5::stats::work_thread_latency_stats_t;
+						wt.take_latency_stats(
+							[&wt, &consumer]( const latency_t & st ) {
+								consumer.add_work_thread_latency( wt.thread_id(), st );
+							} );
+
+						consumer.add_work_thread_demand_pool(
+								wt.thread_id(), wt.demand_pool_stats() );
 					}
 
 				for( auto & q : m_cooperations )
@@ -25,6 +25,7 @@
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
@@ -77,9 +78,28 @@ class agent_queue_t
 					:	execution_demand_t( std::move( original ) )
 					,	m_next( nullptr )
 					{}
+
+				//! Access to the actual demand.
+				/*!
+				 * \since
+				 * v.5.5.25
+				 */
+				execution_demand_t &
+				demand()
+					{
+						return *this;
+					}
 			};
 
 	public :
+		/*!
+		 * \brief Type of pool for demand nodes.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		using demand_pool_t = so_5::disp::reuse::demand_node_pool_t< demand_t >;
+
 		//! Constructor.
 		agent_queue_t(
 			//! Dispatcher queue to work with.
@@ -101,8 +121,10 @@ class agent_queue_t
 		virtual void
 		push( execution_demand_t demand )
 			{
-				std::unique_ptr< demand_t > tail_demand{
-						new demand_t( std::move( demand ) ) };
+				// Since v.5.5.25 a node is taken from the pool of
+				// the current work thread (if there is such pool).
+				auto tail_demand = demand_pool_t::allocate_node(
+						std::move( demand ) );
 
 				bool was_empty;
 
@@ -111,7 +133,7 @@ class agent_queue_t
 
 					was_empty = (nullptr == m_head.m_next);
 
-					m_tail->m_next = tail_demand.release();
+					m_tail->m_next = tail_demand;
 					m_tail = m_tail->m_next;
 
 					++m_size;
@@ -123,6 +145,44 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue.
+		/*!
+		 * All demands are added under one lock acquisition and the
+		 * queue is scheduled at most once.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		push_many(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				// Nodes are allocated and linked before locking.
+				auto chain = demand_pool_t::allocate_chain( demands, count );
+
+				bool was_empty;
+
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					was_empty = (nullptr == m_head.m_next);
+
+					m_tail->m_next = chain.first;
+					m_tail = chain.second;
+
+					m_size += count;
+				}
+
+				// Scheduling of the queue must be done when queue lock
+				// is unlocked.
+				if( was_empty )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the front demand from queue.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -183,13 +243,14 @@ class agent_queue_t
 			//! Count of consequently processed demands from that queue.
 			std::size_t demands_processed )
 			{
-				// Actual deletion of old head must be performed
+				// Actual release of old head must be performed
 				// when m_lock will be released.
-				std::unique_ptr< demand_t > old_head;
+				demand_t * old_head;
+				pop_result_t result;
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
-					old_head = remove_head();
+					old_head = remove_head().release();
 
 					const auto emptyness = m_head.m_next ?
 							emptyness_t::not_empty : emptyness_t::empty;
@@ -197,10 +258,16 @@ class agent_queue_t
 					if( emptyness_t::empty == emptyness )
 						m_tail = &m_head;
 
-					return pop_result_t{
+					result = pop_result_t{
 							detect_continuation( emptyness, demands_processed ),
 							emptyness };
 				}
+
+				// Since v.5.5.25 the node is returned to the pool of
+				// the current work thread.
+				demand_pool_t::release_node( old_head );
+
+				return result;
 			}
 
 		/*!
@@ -323,6 +390,14 @@ struct common_data_t
 		//! Waiting object for long wait.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
 
+		/*!
+		 * \brief Pool of demand nodes for this thread.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		agent_queue_t::demand_pool_t m_demand_pool;
+
 		common_data_t( dispatcher_queue_t & queue )
 			:	m_disp_queue( &queue )
 			,	m_condition{ queue.allocate_condition() }
@@ -347,6 +422,10 @@ class no_activity_tracking_impl_t : protected common_data_t
 		void
 		take_activity_stats( L ) { /* Nothing to do */ }
 
+		template< typename L >
+		void
+		take_latency_stats( L ) { /* Nothing to do */ }
+
 	protected :
 		void
 		work_started() {}
@@ -389,6 +468,24 @@ class with_activity_tracking_impl_t : protected common_data_t
 				lambda( result );
 			}
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		template< typename L >
+		void
+		take_latency_stats( L lambda )
+			{
+				so_5::stats::work_thread_latency_stats_t result;
+
+				result.m_working_histogram =
+						m_work_activity_collector.take_histogram();
+				result.m_waiting_histogram =
+						m_waiting_stats_collector.take_histogram();
+
+				lambda( result );
+			}
+
 	protected :
 		//! Lock for activity statistics.
 		activity_tracking_traits::lock_t m_stats_lock;
@@ -473,6 +570,18 @@ class work_thread_template_t : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Get the stats for the pool of demand nodes.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		so_5::disp::reuse::demand_pool_stats_t
+		demand_pool_stats() const
+			{
+				return this->m_demand_pool.stats();
+			}
+
 	private :
 		//! Thread body method.
 		void
@@ -480,6 +589,9 @@ class work_thread_template_t : public Impl
 			{
 				this->m_thread_id = so_5::query_current_thread_id();
 
+				agent_queue_t::demand_pool_t::binding_t pool_binding{
+						this->m_demand_pool };
+
 				agent_queue_t * agent_queue;
 				while( nullptr != (agent_queue = this->pop_agent_queue()) )
 					{
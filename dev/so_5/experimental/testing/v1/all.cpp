@@ -967,12 +967,9 @@ class special_event_queue_t final : public event_queue_t
 			{}
 
 		void
-		push( execution_demand_t demand ) override
+		wrap_if_necessary( execution_demand_t & demand )
 			{
-				if( !is_ordinary_demand( demand ) )
-					// Demand must go into the original queue without transformations.
-					push_to_queue( std::move(demand) );
-				else
+				if( is_ordinary_demand( demand ) )
 					{
 						// Original message must be wrapped into a special
 						// envelope and original demand must be modified.
@@ -985,9 +982,34 @@ class special_event_queue_t final : public event_queue_t
 						demand.m_message_ref = std::move(new_env);
 						demand.m_demand_handler =
 								agent_t::get_demand_handler_on_enveloped_msg_ptr();
-
-						push_to_queue( std::move(demand) );
 					}
+				// Otherwise demand must go into the original queue
+				// without transformations.
+			}
+
+		void
+		push( execution_demand_t demand ) override
+			{
+				wrap_if_necessary( demand );
+
+				push_to_queue( std::move(demand) );
+			}
+
+		void
+		push_many(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				for( std::size_t i = 0; i != count; ++i )
+					wrap_if_necessary( demands[ i ] );
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( queue_mode_t::buffer == m_mode )
+					for( std::size_t i = 0; i != count; ++i )
+						m_buffer.push_back( std::move(demands[ i ]) );
+				else
+					m_original_queue.get().push_many( demands, count );
 			}
 
 		void
@@ -1001,8 +1023,8 @@ class special_event_queue_t final : public event_queue_t
 
 					m_mode = queue_mode_t::direct;
 
-					for( auto & d : m_buffer )
-						m_original_queue.get().push( std::move(d) );
+					m_original_queue.get().push_many(
+							m_buffer.data(), m_buffer.size() );
 
 					using std::swap;
 					swap( tmp, m_buffer );
@@ -22,6 +22,8 @@
 #include <string>
 #include <memory>
 #include <typeindex>
+#include <cstdint>
+#include <iosfwd>
 
 namespace so_5 {
 
@@ -49,6 +51,59 @@ enum class status_t
 		enabled
 	};
 
+//
+// binary_record_t
+//
+/*!
+ * \brief A binary representation of a trace.
+ *
+ * All fields have fixed size. Strings are represented by pointers.
+ * All those strings have static storage duration (for example,
+ * names of types from std::type_info or literals with names of actions).
+ * Because of that a record can be stored without any copying of strings.
+ * The pointers are resolved only when the stored records are written
+ * somewhere (see binary_trace_storage_t::dump()).
+ *
+ * \since
+ * v.5.5.25
+ */
+struct binary_record_t
+	{
+		//! Time of the trace in nanoseconds since the epoch of steady_clock.
+		std::uint64_t m_timestamp;
+		//! Hash of the ID of thread on which the trace is made.
+		std::uint64_t m_tid;
+		//! ID of mbox or mchain.
+		/*!
+		 * It is the ID of the mbox or mchain the message was sent to.
+		 * If a message is redirected or transformed to another mbox
+		 * the ID of the destination mbox is not stored in the record.
+		 *
+		 * Can be null_mbox_id() if there is no such information.
+		 */
+		mbox_id_t m_mbox_id;
+		//! Name of message type.
+		/*!
+		 * Can be null if there is no such information.
+		 */
+		const char * m_msg_type;
+		//! Pointer to agent.
+		/*!
+		 * Can be null if there is no such information.
+		 */
+		const agent_t * m_agent;
+		//! The first part of the description of action.
+		/*!
+		 * Can be null if there is no such information.
+		 */
+		const char * m_action_1;
+		//! The second part of the description of action.
+		/*!
+		 * Can be null if there is no such information.
+		 */
+		const char * m_action_2;
+	};
+
 //
 // tracer_t
 //
@@ -74,6 +129,23 @@ class SO_5_TYPE tracer_t
 		//! appropriate storage/stream.
 		virtual void
 		trace( const std::string & what ) SO_5_NOEXCEPT = 0;
+
+		//! Store a binary representation of message delivery action.
+		/*!
+		 * This method is called before the creation of the textual
+		 * description. If it returns true then there is no textual
+		 * description and trace() is not called at all.
+		 *
+		 * Default implementation returns false.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual bool
+		trace_binary( const binary_record_t & /*what*/ ) SO_5_NOEXCEPT
+			{
+				return false;
+			}
 	};
 
 //
@@ -119,6 +191,109 @@ std_cerr_tracer();
 SO_5_FUNC tracer_unique_ptr_t
 std_clog_tracer();
 
+//
+// binary_trace_storage_t
+//
+/*!
+ * \brief Interface of storage for binary traces.
+ *
+ * \attention
+ * store() is called on several threads at the same time.
+ *
+ * \since
+ * v.5.5.25
+ */
+class SO_5_TYPE binary_trace_storage_t
+	{
+		binary_trace_storage_t( const binary_trace_storage_t & ) = delete;
+		binary_trace_storage_t & operator=( const binary_trace_storage_t & ) = delete;
+
+	public :
+		binary_trace_storage_t() = default;
+		virtual ~binary_trace_storage_t() SO_5_NOEXCEPT = default;
+
+		//! Store a binary record.
+		virtual void
+		store( const binary_record_t & record ) SO_5_NOEXCEPT = 0;
+
+		//! Write all stored records to a binary stream.
+		/*!
+		 * The result can be decoded by decode_binary_trace().
+		 *
+		 * \note
+		 * This method can be called while traces are being stored.
+		 */
+		virtual void
+		dump( std::ostream & to ) const = 0;
+	};
+
+/*!
+ * \brief A short alias for shared_ptr to binary trace storage.
+ *
+ * \since
+ * v.5.5.25
+ */
+using binary_trace_storage_shptr_t = std::shared_ptr< binary_trace_storage_t >;
+
+/*!
+ * \brief Factory for binary trace storage with a ring buffer for every
+ * thread.
+ *
+ * Every thread gets its own ring buffer on the first trace. After that
+ * records are stored without locks and memory allocations. When a ring
+ * buffer is full the oldest records are overwritten.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC binary_trace_storage_shptr_t
+ring_buffer_trace_storage(
+	//! Capacity of the ring buffer for every thread. Must be greater than 0.
+	std::size_t records_per_thread );
+
+/*!
+ * \brief Factory for tracer which stores binary records into a storage.
+ *
+ * There is no formatting of trace messages at all. So message delivery
+ * tracing can stay on under load.
+ *
+ * Usage example:
+ * \code
+ * auto storage = so_5::msg_tracing::ring_buffer_trace_storage( 10000u );
+ * so_5::launch( [](so_5::environment_t & env) {...},
+ * 	[storage](so_5::environment_params_t & params) {
+ * 		params.message_delivery_tracer(
+ * 			so_5::msg_tracing::binary_tracer( storage ) );
+ * 	} );
+ * std::ofstream file{ "trace.bin", std::ios::binary };
+ * storage->dump( file );
+ * \endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC tracer_unique_ptr_t
+binary_tracer( binary_trace_storage_shptr_t storage );
+
+/*!
+ * \brief Decode a binary trace into a textual form.
+ *
+ * Records from all threads are ordered by their timestamps. Every
+ * record is written as a separate line.
+ *
+ * \throw so_5::exception_t with rc_invalid_binary_trace error code
+ * if content of \a from isn't a valid binary trace.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC void
+decode_binary_trace(
+	//! A stream with the result of binary_trace_storage_t::dump().
+	std::istream & from,
+	//! A stream for the textual representation.
+	std::ostream & to );
+
 /*!
  * \brief A flag for message/signal dichotomy.
  *
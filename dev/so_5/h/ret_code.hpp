@@ -354,6 +354,31 @@ const int rc_priority_quote_illegal_value = 120;
 //! Message delivery tracing is disabled and cannot be used.
 const int rc_msg_tracing_disabled = 140;
 
+/*!
+ * \brief Content of binary message delivery trace can't be decoded.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_invalid_binary_trace = 141;
+
+/*!
+ * \brief Invalid size of storage for binary message delivery traces.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_invalid_binary_trace_storage_size = 142;
+
+/*!
+ * \brief Environment infrastructure doesn't support operations
+ * with cooperations by their ids.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_coop_id_not_supported_by_env_infrastructure = 143;
+
 //! \}
 
 //! \name Error codes for message chains.
@@ -561,6 +586,32 @@ const int rc_scenario_must_be_completed = 182;
  */
 const int rc_stored_state_name_not_found = 183;
 
+/*!
+ * \brief An attempt to create lock-free mchain without size limit.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_lock_free_mchain_must_be_size_limited = 184;
+
+/*!
+ * \brief An attempt to create SPSC mchain with
+ * overflow_reaction_t::remove_oldest.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_remove_oldest_not_supported_by_spsc_mchain = 185;
+
+/*!
+ * \brief An attempt to use negative value for timer slack of
+ * periodic message/signal.
+ *
+ * \since
+ * v.5.5.25
+ */
+const int rc_negative_value_for_timer_slack = 186;
+
 //! \name Common error codes.
 //! \{
 
@@ -119,6 +119,68 @@ namespace timer_thread
 
 } /* namespace timer_thread */
 
+//
+// timer_slack_t
+//
+/*!
+ * \brief Max allowed delay for delivery of a periodic message.
+ *
+ * A periodic message with non-zero slack can be delivered later than
+ * required, but no more than the slack value. It allows to coalesce
+ * periodic messages with the same period: they are delivered by one
+ * shared timer. It greatly reduces the count of timers and the count of
+ * timer thread wakeups if there are many periodic messages with the
+ * same period (heartbeats, for example).
+ *
+ * The slack is applied only to the first delivery. Subsequent deliveries
+ * follow with the specified period.
+ *
+ * Usage example:
+ * \code
+	m_heartbeat = so_5::send_periodic< heartbeat >( *this,
+			std::chrono::seconds(1), std::chrono::seconds(1),
+			so_5::timer_slack( std::chrono::milliseconds(100) ) );
+ * \endcode
+ *
+ * \note Coalescing is supported only by timer threads from SObjectizer
+ * and only by the default multithreaded environment with timer thread.
+ * In other cases the slack is ignored and an ordinary periodic timer
+ * is created.
+ *
+ * \since
+ * v.5.5.25
+ */
+class timer_slack_t
+	{
+	public :
+		explicit timer_slack_t(
+			std::chrono::steady_clock::duration value ) SO_5_NOEXCEPT
+			:	m_value( value )
+			{}
+
+		//! Get the value of the slack.
+		std::chrono::steady_clock::duration
+		value() const SO_5_NOEXCEPT
+			{
+				return m_value;
+			}
+
+	private :
+		std::chrono::steady_clock::duration m_value;
+	};
+
+/*!
+ * \brief Helper function for creation of timer_slack object.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline timer_slack_t
+timer_slack( std::chrono::steady_clock::duration value ) SO_5_NOEXCEPT
+	{
+		return timer_slack_t{ value };
+	}
+
 //
 // timer_thread_stats_t
 //
@@ -216,6 +278,34 @@ class SO_5_TYPE timer_thread_t
 		 */
 		virtual timer_thread_stats_t
 		query_stats() = 0;
+
+		//! Push periodic message which can be coalesced with other
+		//! periodic messages with the same period.
+		/*!
+		 * The first delivery of the message can be delayed, but no more
+		 * than for \a slack.
+		 *
+		 * \note The default implementation ignores \a slack and
+		 * simply calls schedule().
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual timer_id_t
+		schedule_coalesced(
+			//! Type of message to be sheduled.
+			const std::type_index & type_index,
+			//! Mbox for message delivery.
+			const mbox_t & mbox,
+			//! Message to be sent.
+			const message_ref_t & msg,
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Must not be zero.
+			std::chrono::steady_clock::duration period,
+			//! Max allowed delay for the first delivery.
+			timer_slack_t slack );
 	};
 
 //! Auxiliary typedef for timer_thread autopointer.
@@ -301,6 +391,39 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * Activation and deactivation of timers are O(1) operations. Timers which
+ * are deactivated before their expiration are never processed by timer
+ * thread. It makes this mechanism suitable for big amount of timeouts
+ * which are usually cancelled.
+ *
+ * \note Default parameters will be used for timer thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -395,6 +518,47 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with default
+ * parameters.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_thread;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory(
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_thread;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, granularity );
+	}
 /*!
  * \}
  */
@@ -635,6 +799,38 @@ create_timer_list_manager(
 	//! A collector for elapsed timers.
 	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
 		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector,
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -742,6 +938,53 @@ timer_list_manager_factory()
 	{
 		return &create_timer_list_manager;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with default
+ * parameters.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+					error_logger_shptr_t,
+					outliving_reference_t<
+							timer_manager_t::elapsed_timers_collector_t > ) =
+				create_timer_hierarchical_wheel_manager;
+
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory(
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t >,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_manager;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, _2, granularity );
+	}
 /*!
  * \}
  */
@@ -41,6 +41,31 @@ null_mbox_id()
 		return 0ull;
 	}
 
+/*!
+ * \brief A type for cooperation identifier.
+ *
+ * Every cooperation gets an unique id at the moment of its creation.
+ * Ids are never reused during the lifetime of SObjectizer Environment.
+ *
+ * \since
+ * v.5.5.25
+ */
+typedef unsigned long long coop_id_t;
+
+/*!
+ * \brief Default value for null coop_id.
+ *
+ * This value is never used as an id of an actual cooperation.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline coop_id_t
+null_coop_id()
+	{
+		return 0ull;
+	}
+
 /*!
  * \brief Thread safety indicator.
  * \since
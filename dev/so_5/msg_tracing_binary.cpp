@@ -0,0 +1,501 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Implementation of binary message delivery tracing.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#include <so_5/h/msg_tracing.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <so_5/details/h/ios_helpers.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace so_5 {
+
+namespace msg_tracing {
+
+namespace impl {
+
+namespace binary {
+
+//
+// File format.
+//
+// All values are written in the byte order of the host.
+//
+// header:
+//		char[8] magic
+//		uint32 format version
+//		uint32 count of strings
+// strings (count of strings times):
+//		uint64 key (the address of the string in the traced process)
+//		uint32 length
+//		char[length] string
+// uint32 count of threads
+// threads (count of threads times):
+//		uint64 thread id
+//		uint64 count of records
+//		records (count of records times):
+//			uint64[ record_words ] record fields
+//
+
+const char magic[ 8 ] = { 'S', 'O', '5', 'B', 'T', 'R', 'C', '\0' };
+
+const std::uint32_t format_version = 1u;
+
+//! Count of 64-bit words in a record.
+const std::size_t record_words = 7u;
+
+//! Type of record in the storage and in the file.
+using packed_record_t = std::array< std::uint64_t, record_words >;
+
+inline std::uint64_t
+as_uint64( const void * ptr )
+	{
+		return static_cast< std::uint64_t >(
+				reinterpret_cast< std::uintptr_t >( ptr ) );
+	}
+
+inline packed_record_t
+pack( const binary_record_t & r )
+	{
+		return packed_record_t{ {
+				r.m_timestamp,
+				r.m_tid,
+				r.m_mbox_id,
+				as_uint64( r.m_msg_type ),
+				as_uint64( r.m_agent ),
+				as_uint64( r.m_action_1 ),
+				as_uint64( r.m_action_2 ) } };
+	}
+
+// Indexes of fields in packed record.
+const std::size_t timestamp_field = 0u;
+const std::size_t tid_field = 1u;
+const std::size_t mbox_id_field = 2u;
+const std::size_t msg_type_field = 3u;
+const std::size_t agent_field = 4u;
+const std::size_t action_1_field = 5u;
+const std::size_t action_2_field = 6u;
+
+template< typename T >
+void
+write_value( std::ostream & to, const T & v )
+	{
+		to.write( reinterpret_cast< const char * >( &v ), sizeof( v ) );
+	}
+
+template< typename T >
+T
+read_value( std::istream & from )
+	{
+		T v;
+		from.read( reinterpret_cast< char * >( &v ), sizeof( v ) );
+		if( !from )
+			SO_5_THROW_EXCEPTION( rc_invalid_binary_trace,
+					"unexpected end of binary trace" );
+		return v;
+	}
+
+//
+// ring_t
+//
+/*!
+ * \brief Ring buffer for records from one thread.
+ *
+ * There is only one writer: the thread for which ring is created.
+ * Records are written without any locks and memory allocations.
+ *
+ * Reader can read the content of ring in parallel with the writer.
+ * Records which were overwritten during the reading are discarded.
+ */
+class ring_t
+	{
+	public :
+		ring_t( std::uint64_t tid, std::size_t capacity )
+			:	m_tid( tid )
+			,	m_slots( capacity )
+			{}
+
+		std::uint64_t
+		tid() const SO_5_NOEXCEPT { return m_tid; }
+
+		void
+		push( const binary_record_t & record ) SO_5_NOEXCEPT
+			{
+				const auto index = m_published.load( std::memory_order_relaxed );
+
+				// The reader must know that the slot is being overwritten.
+				m_started.store( index + 1u, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_release );
+
+				const auto packed = pack( record );
+				auto & slot = m_slots[ index % m_slots.size() ];
+				for( std::size_t i = 0; i != record_words; ++i )
+					slot[ i ].store( packed[ i ], std::memory_order_relaxed );
+
+				m_published.store( index + 1u, std::memory_order_release );
+			}
+
+		//! Get a copy of all records which are still in the ring.
+		std::vector< packed_record_t >
+		snapshot() const
+			{
+				const auto capacity = static_cast< std::uint64_t >(
+						m_slots.size() );
+
+				const auto last = m_published.load( std::memory_order_acquire );
+				auto first = last > capacity ? last - capacity : 0u;
+
+				std::vector< packed_record_t > result;
+				result.reserve( static_cast< std::size_t >( last - first ) );
+				for( auto index = first; index != last; ++index )
+					{
+						const auto & slot = m_slots[ index % capacity ];
+						packed_record_t r;
+						for( std::size_t i = 0; i != record_words; ++i )
+							r[ i ] = slot[ i ].load( std::memory_order_relaxed );
+						result.push_back( r );
+					}
+
+				// Records which could be overwritten during the copying
+				// must be discarded.
+				std::atomic_thread_fence( std::memory_order_acquire );
+				const auto started = m_started.load( std::memory_order_relaxed );
+				if( started > capacity && started - capacity > first )
+					{
+						const auto to_skip = std::min(
+								started - capacity - first,
+								static_cast< std::uint64_t >( result.size() ) );
+						result.erase( result.begin(),
+								result.begin() + static_cast< std::ptrdiff_t >( to_skip ) );
+					}
+
+				return result;
+			}
+
+	private :
+		using slot_t = std::array< std::atomic< std::uint64_t >, record_words >;
+
+		//! ID of the owner thread.
+		const std::uint64_t m_tid;
+
+		//! Count of records which writing is started.
+		std::atomic< std::uint64_t > m_started{ 0u };
+
+		//! Count of records which are completely written.
+		std::atomic< std::uint64_t > m_published{ 0u };
+
+		//! Space for records.
+		std::vector< slot_t > m_slots;
+	};
+
+//
+// storage_id_counter
+//
+/*!
+ * \brief Counter for unique ids of storages.
+ *
+ * Ids are used instead of addresses of storages in the thread local
+ * cache. Addresses can be reused after destruction of storage.
+ */
+std::atomic< std::uint64_t > storage_id_counter{ 0u };
+
+//
+// thread_ring_cache_t
+//
+/*!
+ * \brief The last ring used by the current thread.
+ */
+struct thread_ring_cache_t
+	{
+		std::uint64_t m_storage_id = 0u;
+		ring_t * m_ring = nullptr;
+	};
+
+thread_local thread_ring_cache_t t_ring_cache;
+
+//
+// ring_buffer_storage_t
+//
+/*!
+ * \brief Implementation of binary trace storage with a ring buffer
+ * for every thread.
+ */
+class ring_buffer_storage_t final : public binary_trace_storage_t
+	{
+	public :
+		ring_buffer_storage_t( std::size_t records_per_thread )
+			:	m_id( ++storage_id_counter )
+			,	m_records_per_thread( records_per_thread )
+			{}
+
+		virtual void
+		store( const binary_record_t & record ) SO_5_NOEXCEPT override
+			{
+				auto & cache = t_ring_cache;
+				if( m_id != cache.m_storage_id )
+					{
+						// A memory allocation is possible only on the first
+						// trace from the thread. If there is no memory the record
+						// will be lost.
+						cache.m_storage_id = 0u;
+						cache.m_ring = nullptr;
+						try
+							{
+								cache.m_ring = &ring_for_thread( record.m_tid );
+								cache.m_storage_id = m_id;
+							}
+						catch( ... )
+							{
+								return;
+							}
+					}
+
+				cache.m_ring->push( record );
+			}
+
+		virtual void
+		dump( std::ostream & to ) const override
+			{
+				// Snapshots of rings must be done before the creation
+				// of the string table.
+				std::vector< std::pair< std::uint64_t, std::vector< packed_record_t > > >
+						threads;
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					for( const auto & r : m_rings )
+						threads.emplace_back( r->tid(), r->snapshot() );
+				}
+
+				// All strings have a static storage duration. So they
+				// can be safely read here.
+				std::set< std::uint64_t > strings;
+				for( const auto & t : threads )
+					for( const auto & r : t.second )
+						for( auto f : { msg_type_field, action_1_field, action_2_field } )
+							if( r[ f ] )
+								strings.insert( r[ f ] );
+
+				to.write( magic, sizeof( magic ) );
+				write_value( to, format_version );
+
+				write_value( to, static_cast< std::uint32_t >( strings.size() ) );
+				for( auto key : strings )
+					{
+						const char * str = reinterpret_cast< const char * >(
+								static_cast< std::uintptr_t >( key ) );
+						const auto len = std::strlen( str );
+
+						write_value( to, key );
+						write_value( to, static_cast< std::uint32_t >( len ) );
+						to.write( str, static_cast< std::streamsize >( len ) );
+					}
+
+				write_value( to, static_cast< std::uint32_t >( threads.size() ) );
+				for( const auto & t : threads )
+					{
+						write_value( to, t.first );
+						write_value( to, static_cast< std::uint64_t >( t.second.size() ) );
+						for( const auto & r : t.second )
+							for( auto w : r )
+								write_value( to, w );
+					}
+			}
+
+	private :
+		//! Unique id of the storage.
+		const std::uint64_t m_id;
+
+		//! Capacity of every ring.
+		const std::size_t m_records_per_thread;
+
+		//! Object lock.
+		/*!
+		 * Protects only the list of rings.
+		 */
+		mutable std::mutex m_lock;
+
+		//! Rings for all threads.
+		/*!
+		 * Rings are not destroyed when threads finish their work.
+		 * It allows to get records from finished threads.
+		 */
+		std::vector< std::unique_ptr< ring_t > > m_rings;
+
+		ring_t &
+		ring_for_thread( std::uint64_t tid )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				// The thread could already have a ring if it used
+				// another storage after this one.
+				auto it = std::find_if( m_rings.begin(), m_rings.end(),
+						[tid]( const std::unique_ptr< ring_t > & r ) {
+							return tid == r->tid();
+						} );
+				if( it != m_rings.end() )
+					return **it;
+
+				m_rings.emplace_back( new ring_t{ tid, m_records_per_thread } );
+				return *(m_rings.back());
+			}
+	};
+
+//
+// binary_tracer_t
+//
+/*!
+ * \brief Tracer which stores only binary records.
+ */
+class binary_tracer_t final : public tracer_t
+	{
+	public :
+		binary_tracer_t( binary_trace_storage_shptr_t storage )
+			:	m_storage( std::move(storage) )
+			{}
+
+		virtual void
+		trace( const std::string & ) SO_5_NOEXCEPT override
+			{
+				// Textual traces are ignored.
+			}
+
+		virtual bool
+		trace_binary( const binary_record_t & what ) SO_5_NOEXCEPT override
+			{
+				m_storage->store( what );
+				return true;
+			}
+
+	private :
+		const binary_trace_storage_shptr_t m_storage;
+	};
+
+} /* namespace binary */
+
+} /* namespace impl */
+
+//
+// Binary message delivery tracing.
+//
+
+SO_5_FUNC binary_trace_storage_shptr_t
+ring_buffer_trace_storage( std::size_t records_per_thread )
+	{
+		if( !records_per_thread )
+			SO_5_THROW_EXCEPTION( rc_invalid_binary_trace_storage_size,
+					"size of ring buffer can't be zero" );
+
+		return std::make_shared< impl::binary::ring_buffer_storage_t >(
+				records_per_thread );
+	}
+
+SO_5_FUNC tracer_unique_ptr_t
+binary_tracer( binary_trace_storage_shptr_t storage )
+	{
+		return tracer_unique_ptr_t{
+				new impl::binary::binary_tracer_t{ std::move(storage) } };
+	}
+
+SO_5_FUNC void
+decode_binary_trace( std::istream & from, std::ostream & to )
+	{
+		using namespace impl::binary;
+
+		char actual_magic[ sizeof( magic ) ];
+		from.read( actual_magic, sizeof( actual_magic ) );
+		if( !from || 0 != std::memcmp( actual_magic, magic, sizeof( magic ) ) )
+			SO_5_THROW_EXCEPTION( rc_invalid_binary_trace,
+					"binary trace doesn't start with the expected signature" );
+
+		const auto version = read_value< std::uint32_t >( from );
+		if( format_version != version )
+			SO_5_THROW_EXCEPTION( rc_invalid_binary_trace,
+					"unsupported version of binary trace: " +
+					std::to_string( version ) );
+
+		std::map< std::uint64_t, std::string > strings;
+		const auto strings_count = read_value< std::uint32_t >( from );
+		for( std::uint32_t i = 0; i != strings_count; ++i )
+			{
+				const auto key = read_value< std::uint64_t >( from );
+				std::string value( read_value< std::uint32_t >( from ), '\0' );
+				from.read( &value[ 0 ], static_cast< std::streamsize >( value.size() ) );
+				if( !from )
+					SO_5_THROW_EXCEPTION( rc_invalid_binary_trace,
+							"unexpected end of binary trace" );
+				strings[ key ] = std::move( value );
+			}
+
+		std::vector< packed_record_t > records;
+		const auto threads_count = read_value< std::uint32_t >( from );
+		for( std::uint32_t t = 0; t != threads_count; ++t )
+			{
+				// Thread id is also stored in every record.
+				(void)read_value< std::uint64_t >( from );
+				const auto count = read_value< std::uint64_t >( from );
+				for( std::uint64_t i = 0; i != count; ++i )
+					{
+						packed_record_t r;
+						for( auto & w : r )
+							w = read_value< std::uint64_t >( from );
+						records.push_back( r );
+					}
+			}
+
+		// Records from different threads are merged by timestamps.
+		std::stable_sort( records.begin(), records.end(),
+				[]( const packed_record_t & a, const packed_record_t & b ) {
+					return a[ timestamp_field ] < b[ timestamp_field ];
+				} );
+
+		auto string_by_key = [&strings]( std::uint64_t key ) -> const std::string & {
+				static const std::string unknown{ "?" };
+				auto it = strings.find( key );
+				return strings.end() != it ? it->second : unknown;
+			};
+
+		using so_5::details::ios_helpers::pointer;
+
+		for( const auto & r : records )
+			{
+				to << "[ts=" << r[ timestamp_field ] << "]"
+						<< "[tid=" << r[ tid_field ] << "]";
+				if( r[ mbox_id_field ] )
+					to << "[mbox_id=" << r[ mbox_id_field ] << "]";
+				if( r[ action_1_field ] && r[ action_2_field ] )
+					to << " " << string_by_key( r[ action_1_field ] )
+							<< "." << string_by_key( r[ action_2_field ] ) << " ";
+				if( r[ msg_type_field ] )
+					to << "[msg_type=" << string_by_key( r[ msg_type_field ] ) << "]";
+				if( r[ agent_field ] )
+					to << "[agent_ptr=" << pointer{ reinterpret_cast< const void * >(
+							static_cast< std::uintptr_t >( r[ agent_field ] ) ) }
+							<< "]";
+				to << "\n";
+			}
+	}
+
+} /* namespace msg_tracing */
+
+} /* namespace so_5 */
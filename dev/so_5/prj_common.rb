@@ -43,6 +43,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		cpp_source 'timers.cpp'
 
 		cpp_source 'msg_tracing.cpp'
+		cpp_source 'msg_tracing_binary.cpp'
 
 		cpp_source 'wrapped_env.cpp'
 
@@ -50,6 +51,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		sources_root( 'rt' ) {
 
 			cpp_source 'message.cpp'
+			cpp_source 'message_slab.cpp'
 			cpp_source 'enveloped_msg.cpp'
 			cpp_source 'handler_makers.cpp'
 
@@ -83,9 +85,11 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'subscr_storage_map_based.cpp'
 				cpp_source 'subscr_storage_hash_table_based.cpp'
 				cpp_source 'subscr_storage_adaptive.cpp'
+				cpp_source 'subscr_storage_frozen.cpp'
 
 				cpp_source 'process_unhandled_exception.cpp'
 
+				cpp_source 'rcu.cpp'
 				cpp_source 'named_local_mbox.cpp'
 				cpp_source 'mbox_core.cpp'
 
@@ -103,6 +107,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 			sources_root( 'stats' ) {
 				cpp_source 'repository.cpp'
 				cpp_source 'std_names.cpp'
+				cpp_source 'snapshot.cpp'
 
 				sources_root( 'impl' ) {
 					cpp_source 'std_controller.cpp'
@@ -110,6 +115,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 					cpp_source 'ds_agent_core_stats.cpp'
 					cpp_source 'ds_mbox_core_stats.cpp'
 					cpp_source 'ds_timer_thread_stats.cpp'
+					cpp_source 'ds_queueing_delay_stats.cpp'
 				}
 			}
 		}
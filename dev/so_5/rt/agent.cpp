@@ -18,6 +18,8 @@
 
 #include <so_5/rt/impl/h/enveloped_msg_details.hpp>
 
+#include <so_5/rt/stats/impl/h/ds_queueing_delay_stats.hpp>
+
 #include <so_5/details/h/abort_on_fatal_error.hpp>
 
 #include <so_5/h/spinlocks.hpp>
@@ -27,6 +29,7 @@
 #include <algorithm>
 #include <sstream>
 #include <cstdlib>
+#include <vector>
 
 namespace so_5
 {
@@ -511,6 +514,8 @@ agent_t::agent_t(
 	,	m_working_thread_id( so_5::query_current_thread_id() )
 	,	m_agent_coop( nullptr )
 	,	m_priority( ctx.options().query_priority() )
+	,	m_queueing_delay_stats(
+			impl::internal_env_iface_t( ctx.env() ).queueing_delay_stats() )
 {
 }
 
@@ -557,6 +562,17 @@ agent_t::so_coop_name() const
 	return m_agent_coop->query_coop_name();
 }
 
+coop_id_t
+agent_t::so_coop_id() const
+{
+	if( nullptr == m_agent_coop )
+		throw exception_t(
+			"agent isn't bound to cooperation yet",
+			rc_agent_has_no_cooperation );
+
+	return m_agent_coop->query_coop_id();
+}
+
 void
 agent_t::so_add_nondestroyable_listener(
 	agent_state_listener_t & state_listener )
@@ -825,8 +841,13 @@ agent_t::so_create_execution_hint(
 void
 agent_t::so_deregister_agent_coop( int dereg_reason )
 {
-	so_environment().deregister_coop(
-			so_coop_name(), dereg_reason );
+	if( nullptr == m_agent_coop )
+		throw exception_t(
+			"agent isn't bound to cooperation yet",
+			rc_agent_has_no_cooperation );
+
+	impl::internal_env_iface_t{ so_environment() }.deregister_coop(
+			*m_agent_coop, coop_dereg_reason_t( dereg_reason ) );
 }
 
 void
@@ -1086,17 +1107,48 @@ agent_t::push_event(
 {
 	const auto handler = select_demand_handler_for_message( *this, message );
 
+	execution_demand_t demand(
+			this,
+			limit,
+			mbox_id,
+			msg_type,
+			message,
+			handler );
+	mark_enqueue_time( demand );
+
 	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
 
 	if( m_event_queue )
-		m_event_queue->push(
-				execution_demand_t(
+		m_event_queue->push( std::move(demand) );
+}
+
+void
+agent_t::push_events(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	std::type_index msg_type,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	std::vector< execution_demand_t > demands;
+	demands.reserve( count );
+
+	for( std::size_t i = 0; i != count; ++i )
+		{
+			demands.emplace_back(
 					this,
 					limit,
 					mbox_id,
 					msg_type,
-					message,
-					handler ) );
+					messages[ i ],
+					select_demand_handler_for_message( *this, messages[ i ] ) );
+			mark_enqueue_time( demands.back() );
+		}
+
+	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	if( m_event_queue )
+		m_event_queue->push_many( demands.data(), demands.size() );
 }
 
 void
@@ -1113,6 +1165,10 @@ agent_t::demand_handler_on_start(
 	try
 	{
 		d.m_receiver->so_evt_start();
+
+		// Since v.5.5.25 the subscription storage can prepare itself
+		// for faster search of event handlers.
+		d.m_receiver->m_subscriptions->freeze();
 	}
 	catch( const std::exception & x )
 	{
@@ -1172,6 +1228,10 @@ agent_t::demand_handler_on_finish(
 		d.m_receiver->return_to_default_state_if_possible();
 	}
 
+	// Since v.5.5.25 queueing delays for the agent aren't needed anymore.
+	if( d.m_receiver->m_queueing_delay_stats )
+		d.m_receiver->m_queueing_delay_stats->forget_agent( d.m_receiver );
+
 	// Cooperation should receive notification about agent deregistration.
 	coop_t::decrement_usage_count( *(d.m_receiver->m_agent_coop) );
 }
@@ -1250,6 +1310,8 @@ agent_t::process_message(
 			d.m_receiver->m_working_thread_id,
 			working_thread_id );
 
+	d.m_receiver->track_queueing_delay( d );
+
 	try
 	{
 		method( invocation_type_t::event, d.m_message_ref );
@@ -1286,6 +1348,8 @@ agent_t::process_service_request(
 						d.m_receiver->m_working_thread_id,
 						working_thread_id );
 
+				d.m_receiver->track_queueing_delay( d );
+
 				// This copy is necessary to prevent deallocation of
 				// event-handler if it is implemented as lambda-function.
 				// Deallocation is possible in such case:
@@ -1324,6 +1388,8 @@ agent_t::process_enveloped_msg(
 
 		if( handler_data )
 		{
+			d.m_receiver->track_queueing_delay( d );
+
 			agent_demand_handler_invoker_t invoker{
 					working_thread_id,
 					d,
@@ -1336,6 +1402,27 @@ agent_t::process_enveloped_msg(
 	} );
 }
 
+void
+agent_t::track_queueing_delay( const execution_demand_t & d ) SO_5_NOEXCEPT
+{
+	// Demand can be created without a timestamp (for example
+	// if it was created outside of push_event).
+	if( m_queueing_delay_stats &&
+			stats::clock_type_t::time_point() != d.m_enqueued_at )
+	{
+		const auto delay = stats::clock_type_t::now() - d.m_enqueued_at;
+		try
+		{
+			m_queueing_delay_stats->record( this, d.m_msg_type, delay );
+		}
+		catch( ... )
+		{
+			// Stats aren't important enough to break the processing
+			// of the demand.
+		}
+	}
+}
+
 void
 agent_t::ensure_operation_is_on_working_thread(
 	const char * operation_name ) const
@@ -98,10 +98,34 @@ coop_t::coop_t(
 	nonempty_name_t name,
 	disp_binder_unique_ptr_t coop_disp_binder,
 	environment_t & env )
-	:	m_coop_name( name.giveout_value() )
+	:	m_id( impl::internal_env_iface_t{ env }.allocate_coop_id() )
+	,	m_anonymous( false )
+	,	m_coop_name( name.giveout_value() )
 	,	m_coop_disp_binder( std::move(coop_disp_binder) )
 	,	m_env( env )
+	,	m_parent_coop_id( null_coop_id() )
 	,	m_parent_coop_ptr( nullptr )
+	,	m_first_child( nullptr )
+	,	m_prev_sibling( nullptr )
+	,	m_next_sibling( nullptr )
+	,	m_registration_status( registration_status_t::coop_not_registered )
+	,	m_exception_reaction( inherit_exception_reaction )
+{
+	m_reference_count = 0l;
+}
+
+coop_t::coop_t(
+	disp_binder_unique_ptr_t coop_disp_binder,
+	environment_t & env )
+	:	m_id( impl::internal_env_iface_t{ env }.allocate_coop_id() )
+	,	m_anonymous( true )
+	,	m_coop_disp_binder( std::move(coop_disp_binder) )
+	,	m_env( env )
+	,	m_parent_coop_id( null_coop_id() )
+	,	m_parent_coop_ptr( nullptr )
+	,	m_first_child( nullptr )
+	,	m_prev_sibling( nullptr )
+	,	m_next_sibling( nullptr )
 	,	m_registration_status( registration_status_t::coop_not_registered )
 	,	m_exception_reaction( inherit_exception_reaction )
 {
@@ -111,13 +135,19 @@ coop_t::coop_t(
 const std::string &
 coop_t::query_coop_name() const
 {
+	if( m_anonymous )
+		// Name of an anonymous coop is created only when it is necessary.
+		std::call_once( m_coop_name_created, [this] {
+				m_coop_name = "__so5_autoname_" + std::to_string( m_id ) + "__";
+			} );
+
 	return m_coop_name;
 }
 
 bool
 coop_t::has_parent_coop() const
 {
-	return !m_parent_coop_name.empty();
+	return !m_parent_coop_name.empty() || null_coop_id() != m_parent_coop_id;
 }
 
 void
@@ -125,6 +155,7 @@ coop_t::set_parent_coop_name(
 	nonempty_name_t name )
 {
 	m_parent_coop_name = name.giveout_value();
+	m_parent_coop_id = null_coop_id();
 }
 
 const std::string &
@@ -135,9 +166,42 @@ coop_t::parent_coop_name() const
 				rc_coop_has_no_parent,
 				query_coop_name() + ": cooperation has no parent cooperation" );
 
+	// The parent could be specified by id only. Its name can be
+	// obtained when the cooperation is registered.
+	if( m_parent_coop_name.empty() && m_parent_coop_ptr )
+		return m_parent_coop_ptr->query_coop_name();
+
 	return m_parent_coop_name;
 }
 
+void
+coop_t::set_parent_coop_id(
+	coop_id_t id )
+{
+	m_parent_coop_id = id;
+	m_parent_coop_name.clear();
+}
+
+void
+coop_t::set_parent_coop_id(
+	coop_id_t id,
+	std::string name )
+{
+	m_parent_coop_id = id;
+	m_parent_coop_name = std::move( name );
+}
+
+coop_id_t
+coop_t::parent_coop_id() const
+{
+	if( !has_parent_coop() )
+		SO_5_THROW_EXCEPTION(
+				rc_coop_has_no_parent,
+				query_coop_name() + ": cooperation has no parent cooperation" );
+
+	return m_parent_coop_id;
+}
+
 namespace
 {
 	/*!
@@ -200,7 +264,8 @@ coop_t::exception_reaction() const
 void
 coop_t::deregister( int reason )
 {
-	environment().deregister_coop( query_coop_name(), reason );
+	impl::internal_env_iface_t{ m_env }.deregister_coop(
+			*this, coop_dereg_reason_t( reason ) );
 }
 
 void
@@ -230,17 +295,36 @@ coop_t::do_add_agent(
 void
 coop_t::do_registration_specific_actions(
 	coop_t * parent_coop )
+{
+	auto activators = prepare_registration();
+	complete_registration( parent_coop, activators );
+}
+
+coop_t::disp_binding_activators_t
+coop_t::prepare_registration()
 {
 	reorder_agents_with_respect_to_priorities();
 	bind_agents_to_coop();
 	define_all_agents();
 
-	bind_agents_to_disp();
+	return bind_agents_to_disp();
+}
+
+void
+coop_t::complete_registration(
+	coop_t * parent_coop,
+	disp_binding_activators_t & activators )
+{
+	activate_agents_bindings( activators );
 
 	m_parent_coop_ptr = parent_coop;
 	if( m_parent_coop_ptr )
+	{
+		// Parent could be specified by name.
+		m_parent_coop_id = m_parent_coop_ptr->m_id;
 		// Parent coop should known about existence of that coop.
 		m_parent_coop_ptr->m_reference_count += 1;
+	}
 
 	// Cooperation should assume that it is registered now.
 	m_registration_status = registration_status_t::coop_registered;
@@ -251,6 +335,12 @@ coop_t::do_registration_specific_actions(
 	m_reference_count += 1;
 }
 
+void
+coop_t::cancel_registration()
+{
+	unbind_agents_from_disp( m_agent_array.end() );
+}
+
 void
 coop_t::do_deregistration_specific_actions(
 	coop_dereg_reason_t dereg_reason )
@@ -300,15 +390,10 @@ coop_t::define_all_agents()
 	}
 }
 
-void
+coop_t::disp_binding_activators_t
 coop_t::bind_agents_to_disp()
 {
-	// All the following actions must be performed on locked m_binding_lock.
-	// It prevents evt_start event from execution until all agents will be
-	// bound to its dispatchers.
-	std::lock_guard< std::mutex > binding_lock{ m_binding_lock };
-
-	std::vector< disp_binding_activator_t > activators;
+	disp_binding_activators_t activators;
 	activators.reserve( m_agent_array.size() );
 
 	// The first stage of binding to dispatcher:
@@ -333,10 +418,22 @@ coop_t::bind_agents_to_disp()
 					rc_agent_to_disp_binding_failed,
 					std::string( "an exception during the first stage of "
 							"binding agent to the dispatcher, cooperation: '" +
-							m_coop_name + "', exception: " + x.what() ) );
+							query_coop_name() + "', exception: " + x.what() ) );
 		}
 	}
 
+	return activators;
+}
+
+void
+coop_t::activate_agents_bindings(
+	disp_binding_activators_t & activators )
+{
+	// All the following actions must be performed on locked m_binding_lock.
+	// It prevents evt_start event from execution until all agents will be
+	// bound to its dispatchers.
+	std::lock_guard< std::mutex > binding_lock{ m_binding_lock };
+
 	// The second stage of binding. Activation of the allocated on
 	// the first stage resources.
 	// Exceptions on that stage would lead to unpredictable application
@@ -352,7 +449,7 @@ coop_t::bind_agents_to_disp()
 			SO_5_LOG_ERROR( m_env, log_stream ) {
 				log_stream << "an exception on the second stage of "
 						"agents to dispatcher binding; cooperation: "
-						<< m_coop_name << ", exception: " << x.what();
+						<< query_coop_name() << ", exception: " << x.what();
 			}
 		} );
 	}
@@ -385,7 +482,7 @@ coop_t::shutdown_all_agents()
 			SO_5_LOG_ERROR( m_env, log_stream ) {
 				log_stream << "Exception during shutting cooperation agents down. "
 						"Work cannot be continued. Cooperation: '"
-						<< m_coop_name << "'. Exception: " << x.what();
+						<< query_coop_name() << "'. Exception: " << x.what();
 			}
 		} ); 
 	}
@@ -421,7 +518,7 @@ coop_t::final_deregister_coop()
 {
 	unbind_agents_from_disp( m_agent_array.end() );
 
-	impl::internal_env_iface_t{ m_env }.final_deregister_coop( m_coop_name );
+	impl::internal_env_iface_t{ m_env }.final_deregister_coop( *this );
 }
 
 coop_t *
@@ -20,6 +20,7 @@
 #include <so_5/rt/stats/impl/h/ds_mbox_core_stats.hpp>
 #include <so_5/rt/stats/impl/h/ds_agent_core_stats.hpp>
 #include <so_5/rt/stats/impl/h/ds_timer_thread_stats.hpp>
+#include <so_5/rt/stats/impl/h/ds_queueing_delay_stats.hpp>
 
 #include <so_5/rt/h/env_infrastructures.hpp>
 
@@ -41,6 +42,7 @@ environment_params_t::environment_params_t()
 	,	m_error_logger( create_stderr_logger() )
 	,	m_work_thread_activity_tracking(
 			work_thread_activity_tracking_t::unspecified )
+	,	m_queueing_delay_tracking( false )
 	,	m_infrastructure_factory( env_infrastructures::default_mt::factory() )
 	,	m_event_queue_hook( make_empty_event_queue_hook_unique_ptr() )
 {
@@ -61,6 +63,7 @@ environment_params_t::environment_params_t(
 			std::move( other.m_message_delivery_tracer_filter ) )
 	,	m_work_thread_activity_tracking(
 			work_thread_activity_tracking_t::unspecified )
+	,	m_queueing_delay_tracking( other.m_queueing_delay_tracking )
 	,	m_queue_locks_defaults_manager( std::move( other.m_queue_locks_defaults_manager ) )
 	,	m_infrastructure_factory( std::move(other.m_infrastructure_factory) )
 	,	m_event_queue_hook( std::move(other.m_event_queue_hook) )
@@ -98,6 +101,8 @@ environment_params_t::swap( environment_params_t & other )
 	std::swap( m_work_thread_activity_tracking,
 			other.m_work_thread_activity_tracking );
 
+	std::swap( m_queueing_delay_tracking, other.m_queueing_delay_tracking );
+
 	std::swap( m_queue_locks_defaults_manager, other.m_queue_locks_defaults_manager );
 
 	std::swap( m_infrastructure_factory, other.m_infrastructure_factory );
@@ -186,6 +191,35 @@ class core_data_sources_t
 				m_timer_thread;
 	};
 
+/*!
+ * \brief Type of holder for data source with queueing delays.
+ *
+ * \since
+ * v.5.5.25
+ */
+using queueing_delay_stats_holder_t =
+		stats::auto_registered_source_holder_t<
+				stats::impl::ds_queueing_delay_stats_t >;
+
+/*!
+ * \brief Helper function for creation of data source for queueing
+ * delays if queueing delay tracking is turned on.
+ *
+ * \since
+ * v.5.5.25
+ */
+std::unique_ptr< queueing_delay_stats_holder_t >
+make_queueing_delay_stats_if_necessary(
+	bool tracking,
+	outliving_reference_t< stats::repository_t > ds_repository )
+	{
+		std::unique_ptr< queueing_delay_stats_holder_t > result;
+		if( tracking )
+			result.reset( new queueing_delay_stats_holder_t{ ds_repository } );
+
+		return result;
+	}
+
 /*!
  * \brief Helper function for creation of appropriate manager
  * object if necessary.
@@ -341,12 +375,28 @@ struct environment_t::internals_t
 	const bool m_autoshutdown_disabled;
 
 	/*!
-	 * \brief A counter for automatically generated cooperation names.
+	 * \brief A counter for cooperation ids.
+	 *
+	 * \note
+	 * Before v.5.5.25 it was a counter for automatically generated
+	 * cooperation names.
 	 *
 	 * \since
 	 * v.5.5.1
 	 */
-	std::atomic_uint_fast64_t m_autoname_counter = { 0 }; 
+	std::atomic_uint_fast64_t m_coop_id_counter = { 0 };
+
+	/*!
+	 * \brief Does environment infrastructure work with names of
+	 * cooperations only?
+	 *
+	 * It is set when the infrastructure throws an exception with
+	 * rc_coop_id_not_supported_by_env_infrastructure error code.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< bool > m_infrastructure_uses_coop_names = { false };
 
 	/*!
 	 * \brief Data sources for core objects.
@@ -390,6 +440,17 @@ struct environment_t::internals_t
 	 */
 	event_queue_hook_unique_ptr_t m_event_queue_hook;
 
+	/*!
+	 * \brief Data source for queueing delays.
+	 *
+	 * \note
+	 * It is nullptr if queueing delay tracking is turned off.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	std::unique_ptr< queueing_delay_stats_holder_t > m_queueing_delay_stats;
+
 	//! Constructor.
 	internals_t(
 		environment_t & env,
@@ -429,6 +490,10 @@ struct environment_t::internals_t
 		,	m_event_queue_hook(
 				ensure_event_queue_hook_exists(
 					params.so5__giveout_event_queue_hook() ) )
+		,	m_queueing_delay_stats(
+				make_queueing_delay_stats_if_necessary(
+					params.queueing_delay_tracking(),
+					outliving_mutable(m_infrastructure->stats_repository()) ) )
 	{}
 };
 
@@ -466,6 +531,37 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( std::move(nonempty_name) );
 }
 
+mbox_t
+environment_t::create_mbox(
+	const mbox_params_t & params )
+{
+	return m_impl->m_mbox_core->create_mbox( params );
+}
+
+mbox_t
+environment_t::create_mbox(
+	nonempty_name_t nonempty_name,
+	const mbox_params_t & params )
+{
+	return m_impl->m_mbox_core->create_mbox(
+			std::move(nonempty_name), params );
+}
+
+mbox_t
+environment_t::create_mbox(
+	const mbox_name_handle_t & mbox_name )
+{
+	return m_impl->m_mbox_core->create_mbox( mbox_name, mbox_params_t{} );
+}
+
+mbox_t
+environment_t::create_mbox(
+	const mbox_name_handle_t & mbox_name,
+	const mbox_params_t & params )
+{
+	return m_impl->m_mbox_core->create_mbox( mbox_name, params );
+}
+
 mchain_t
 environment_t::create_mchain(
 	const mchain_params_t & params )
@@ -533,19 +629,35 @@ environment_t::create_coop(
 	autoname_indicator_t (*)(),
 	disp_binder_unique_ptr_t disp_binder )
 {
-	auto counter = ++(m_impl->m_autoname_counter);
-	nonempty_name_t name( "__so5_autoname_" + std::to_string(counter) + "__" );
 	return coop_unique_ptr_t( new coop_t(
-			std::move(name),
 			std::move(disp_binder),
 			self_ref() ) );
 }
 
-void
+coop_id_t
 environment_t::register_coop(
 	coop_unique_ptr_t agent_coop )
 {
+	const coop_id_t id = agent_coop ?
+			agent_coop->query_coop_id() : null_coop_id();
+
 	m_impl->m_infrastructure->register_coop( std::move( agent_coop ) );
+
+	return id;
+}
+
+std::vector< coop_id_t >
+environment_t::register_coops(
+	std::vector< coop_unique_ptr_t > coops )
+{
+	std::vector< coop_id_t > ids;
+	ids.reserve( coops.size() );
+	for( const auto & c : coops )
+		ids.push_back( c ? c->query_coop_id() : null_coop_id() );
+
+	m_impl->m_infrastructure->register_coops( std::move( coops ) );
+
+	return ids;
 }
 
 void
@@ -557,8 +669,26 @@ environment_t::deregister_coop(
 			std::move(name), coop_dereg_reason_t( reason ) );
 }
 
-so_5::timer_id_t
-environment_t::schedule_timer(
+void
+environment_t::deregister_coop(
+	coop_id_t id,
+	int reason )
+{
+	m_impl->m_infrastructure->deregister_coop(
+			id, coop_dereg_reason_t( reason ) );
+}
+
+namespace
+{
+
+/*!
+ * \brief Check arguments of schedule_timer() call.
+ *
+ * \since
+ * v.5.5.25
+ */
+void
+ensure_valid_timer_params(
 	const std::type_index & type_wrapper,
 	const message_ref_t & msg,
 	const mbox_t & mbox,
@@ -593,6 +723,19 @@ environment_t::schedule_timer(
 					"unable to schedule timer for mutable message and "
 					"MPMC mbox, msg_type=" + std::string(type_wrapper.name()) );
 	}
+}
+
+} /* namespace anonymous */
+
+so_5::timer_id_t
+environment_t::schedule_timer(
+	const std::type_index & type_wrapper,
+	const message_ref_t & msg,
+	const mbox_t & mbox,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+{
+	ensure_valid_timer_params( type_wrapper, msg, mbox, pause, period );
 
 	return m_impl->m_infrastructure->schedule_timer(
 			type_wrapper,
@@ -602,6 +745,40 @@ environment_t::schedule_timer(
 			period );
 }
 
+so_5::timer_id_t
+environment_t::schedule_timer(
+	const std::type_index & type_wrapper,
+	const message_ref_t & msg,
+	const mbox_t & mbox,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period,
+	timer_slack_t slack )
+{
+	ensure_valid_timer_params( type_wrapper, msg, mbox, pause, period );
+
+	if( slack.value() < std::chrono::steady_clock::duration::zero() )
+		SO_5_THROW_EXCEPTION(
+				so_5::rc_negative_value_for_timer_slack,
+				"an attempt to call schedule_timer() with negative slack value" );
+
+	// Coalescing has no sense for delayed messages.
+	if( std::chrono::steady_clock::duration::zero() == period )
+		return m_impl->m_infrastructure->schedule_timer(
+				type_wrapper,
+				msg,
+				mbox,
+				pause,
+				period );
+
+	return m_impl->m_infrastructure->schedule_coalesced_timer(
+			type_wrapper,
+			msg,
+			mbox,
+			pause,
+			period,
+			slack );
+}
+
 void
 environment_t::single_timer(
 	const std::type_index & type_wrapper,
@@ -892,17 +1069,90 @@ internal_env_iface_t::ready_to_deregister_notify(
 	m_env.m_impl->m_infrastructure->ready_to_deregister_notify( coop );
 }
 
+namespace
+{
+
+/*!
+ * \brief Perform an action with a cooperation by its id or by its name
+ * if the environment infrastructure doesn't support ids.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename By_Id, typename By_Name >
+auto
+call_by_id_or_name(
+	std::atomic< bool > & uses_names,
+	By_Id by_id,
+	By_Name by_name ) -> decltype( by_id() )
+{
+	if( !uses_names.load( std::memory_order_acquire ) )
+	{
+		try
+		{
+			return by_id();
+		}
+		catch( const exception_t & x )
+		{
+			if( rc_coop_id_not_supported_by_env_infrastructure !=
+					x.error_code() )
+				throw;
+
+			uses_names.store( true, std::memory_order_release );
+		}
+	}
+
+	return by_name();
+}
+
+} /* namespace anonymous */
+
+void
+internal_env_iface_t::deregister_coop(
+	const coop_t & coop,
+	coop_dereg_reason_t dereg_reason )
+{
+	auto & infrastructure = *(m_env.m_impl->m_infrastructure);
+
+	call_by_id_or_name(
+		m_env.m_impl->m_infrastructure_uses_coop_names,
+		[&] {
+			infrastructure.deregister_coop( coop.query_coop_id(), dereg_reason );
+		},
+		[&] {
+			infrastructure.deregister_coop(
+					nonempty_name_t( coop.query_coop_name() ), dereg_reason );
+		} );
+}
+
 void
 internal_env_iface_t::final_deregister_coop(
-	const std::string & coop_name )
+	coop_t & coop )
 {
-	bool any_cooperation_alive = 
-			m_env.m_impl->m_infrastructure->final_deregister_coop( coop_name );
+	auto & infrastructure = *(m_env.m_impl->m_infrastructure);
+
+	const bool any_cooperation_alive = call_by_id_or_name(
+		m_env.m_impl->m_infrastructure_uses_coop_names,
+		[&] {
+			return infrastructure.final_deregister_coop( coop.query_coop_id() );
+		},
+		[&] {
+			// The name must be copied because the cooperation will be
+			// destroyed during the final deregistration.
+			return infrastructure.final_deregister_coop(
+					std::string( coop.query_coop_name() ) );
+		} );
 
 	if( !any_cooperation_alive && !m_env.m_impl->m_autoshutdown_disabled )
 		m_env.stop();
 }
 
+coop_id_t
+internal_env_iface_t::allocate_coop_id()
+{
+	return ++(m_env.m_impl->m_coop_id_counter);
+}
+
 bool
 internal_env_iface_t::is_msg_tracing_enabled() const
 {
@@ -942,6 +1192,13 @@ internal_env_iface_t::event_queue_on_bind(
 	return m_env.m_impl->m_event_queue_hook->on_bind( agent, original_queue );
 }
 
+stats::impl::ds_queueing_delay_stats_t *
+internal_env_iface_t::queueing_delay_stats() const SO_5_NOEXCEPT
+{
+	const auto & holder = m_env.m_impl->m_queueing_delay_stats;
+	return holder ? &(holder->get()) : nullptr;
+}
+
 void
 internal_env_iface_t::event_queue_on_unbind(
 	agent_t * agent,
@@ -1121,6 +1121,16 @@ class SO_5_TYPE agent_t
 		const std::string &
 		so_coop_name() const;
 
+		//! Id of the agent's cooperation.
+		/*!
+		 * \throw so_5::exception_t If the agent doesn't belong to any cooperation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		coop_id_t
+		so_coop_id() const;
+
 		//! Add a state listener to the agent.
 		/*!
 		 * A programmer should guarantee that the lifetime of
@@ -1180,6 +1190,25 @@ class SO_5_TYPE agent_t
 			agent.push_event( limit, mbox_id, msg_type, message );
 		}
 
+		//! Push several events of the same type to the agent's event queue.
+		/*!
+		 * All events are pushed into the event queue by one operation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		static inline void
+		call_push_events(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t * messages,
+			std::size_t count )
+		{
+			agent.push_events( limit, mbox_id, msg_type, messages, count );
+		}
+
 		/*!
 		 * \since
 		 * v.5.3.0
@@ -2711,6 +2740,16 @@ class SO_5_TYPE agent_t
 		 */
 		const priority_t m_priority;
 
+		/*!
+		 * \brief Data source for queueing delays.
+		 *
+		 * It is nullptr if queueing delay tracking is turned off.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		stats::impl::ds_queueing_delay_stats_t * const m_queueing_delay_stats;
+
 		//! Make an agent reference.
 		/*!
 		 * This is an internal SObjectizer method. It is called when
@@ -2846,6 +2885,53 @@ class SO_5_TYPE agent_t
 			std::type_index msg_type,
 			//! Event message.
 			const message_ref_t & message );
+
+		/*!
+		 * \brief Push several events into the event queue.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		push_events(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for this event.
+			mbox_id_t mbox_id,
+			//! Message type for events.
+			std::type_index msg_type,
+			//! Event messages.
+			const message_ref_t * messages,
+			//! Count of event messages.
+			std::size_t count );
+
+		/*!
+		 * \brief Store the time of pushing to an event queue
+		 * if queueing delay tracking is turned on.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		mark_enqueue_time( execution_demand_t & demand ) const
+			{
+				if( m_queueing_delay_stats )
+					demand.m_enqueued_at = stats::clock_type_t::now();
+			}
+
+		/*!
+		 * \brief Store the queueing delay for a demand if queueing
+		 * delay tracking is turned on.
+		 *
+		 * Must be called just before the start of the demand processing.
+		 *
+		 * \note A failure of storing the value is ignored.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		track_queueing_delay( const execution_demand_t & demand ) SO_5_NOEXCEPT;
 		/*!
 		 * \}
 		 */
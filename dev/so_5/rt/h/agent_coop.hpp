@@ -297,10 +297,52 @@ class SO_5_TYPE coop_t
 			//! SObjectizer Environment.
 			environment_t & env );
 
+		//! Constructor for an anonymous cooperation.
+		/*!
+		 * An anonymous cooperation is identified by its id only.
+		 * The name for such cooperation is created only when it is
+		 * requested by query_coop_name().
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		coop_t(
+			//! Default dispatcher binding.
+			disp_binder_unique_ptr_t coop_disp_binder,
+			//! SObjectizer Environment.
+			environment_t & env );
+
 		//! Get cooperation name.
+		/*!
+		 * \note
+		 * Since v.5.5.25 the name of an anonymous cooperation is
+		 * created at the first call to that method.
+		 */
 		const std::string &
 		query_coop_name() const;
 
+		//! Get cooperation id.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		coop_id_t
+		query_coop_id() const
+		{
+			return m_id;
+		}
+
+		//! Is this cooperation anonymous?
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		bool
+		is_anonymous() const
+		{
+			return m_anonymous;
+		}
+
 		//! Add agent to cooperation.
 		/*!
 		 * Cooperation takes care about agent lifetime.
@@ -443,10 +485,62 @@ class SO_5_TYPE coop_t
 		 *
 		 * \brief Get name of the parent cooperation.
 		 *
-		 * \throw exception_t if the parent cooperation name is not set.
+		 * \note
+		 * Since v.5.5.25 the parent cooperation can be specified by id
+		 * only (see set_parent_coop_id()). In that case the name of the
+		 * parent is known only after the registration of the cooperation
+		 * and an empty string is returned before the registration.
+		 * Helpers like so_5::create_child_coop() and
+		 * so_5::introduce_child_coop() specify both id and name of
+		 * the parent.
+		 *
+		 * \throw exception_t if the parent cooperation is not set.
 		 */
 		const std::string &
 		parent_coop_name() const;
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Set id of the parent cooperation.
+		 *
+		 * It is a cheaper way to specify the parent cooperation than
+		 * the parent's name because there is no need to search
+		 * the parent by its name during the registration.
+		 */
+		void
+		set_parent_coop_id(
+			coop_id_t id );
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Set id and name of the parent cooperation.
+		 *
+		 * The parent is searched by \a id during the registration.
+		 * The \a name is returned by parent_coop_name().
+		 */
+		void
+		set_parent_coop_id(
+			coop_id_t id,
+			std::string name );
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Get id of the parent cooperation.
+		 *
+		 * \note
+		 * If the parent cooperation is specified by name then
+		 * null_coop_id() is returned until the cooperation is registered.
+		 *
+		 * \throw exception_t if the parent cooperation is not set.
+		 */
+		coop_id_t
+		parent_coop_id() const;
 		/*!
 		 * \}
 		 */
@@ -847,7 +941,7 @@ class SO_5_TYPE coop_t
 		 * \note This method is just a shorthand for:
 			\code
 			so_5::coop_t & coop = ...;
-			coop.environment().deregister_coop( coop.query_coop_name(), reason );
+			coop.environment().deregister_coop( coop.query_coop_id(), reason );
 			\endcode
 		 */
 		void
@@ -895,6 +989,16 @@ class SO_5_TYPE coop_t
 		//! Typedef for the agent information container.
 		typedef std::vector< agent_with_disp_binder_t > agent_array_t;
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Typedef for the container of activators of
+		 * agents bindings.
+		 */
+		typedef std::vector< disp_binding_activator_t >
+				disp_binding_activators_t;
+
 		/*!
 		 * \since
 		 * v.5.2.3
@@ -935,8 +1039,38 @@ class SO_5_TYPE coop_t
 		 */
 		typedef std::vector< resource_deleter_t > resource_deleter_vector_t;
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Cooperation id.
+		 */
+		const coop_id_t m_id;
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Is this cooperation anonymous?
+		 */
+		const bool m_anonymous;
+
 		//! Cooperation name.
-		const std::string m_coop_name;
+		/*!
+		 * \note
+		 * Since v.5.5.25 it is empty for an anonymous cooperation
+		 * until the first call to query_coop_name().
+		 */
+		mutable std::string m_coop_name;
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief A flag for the creation of the name of
+		 * an anonymous cooperation.
+		 */
+		mutable std::once_flag m_coop_name_created;
 
 		//! Default agent to the dispatcher binder.
 		disp_binder_ref_t m_coop_disp_binder;
@@ -964,10 +1098,22 @@ class SO_5_TYPE coop_t
 		 *
 		 * \brief Name of the parent cooperation.
 		 *
-		 * Empty value means than there is no parent cooperation.
+		 * Empty value means than there is no parent cooperation
+		 * or the parent cooperation is specified by id.
 		 */
 		std::string m_parent_coop_name;
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Id of the parent cooperation.
+		 *
+		 * Receives actual value during the registration if the parent
+		 * cooperation is specified by name.
+		 */
+		coop_id_t m_parent_coop_id;
+
 		/*!
 		 * \since
 		 * v.5.2.3.
@@ -979,6 +1125,37 @@ class SO_5_TYPE coop_t
 		 */
 		coop_t * m_parent_coop_ptr;
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The first child cooperation.
+		 *
+		 * Children of a cooperation form an intrusive double-linked list.
+		 * This list is maintained by coop_repository and is protected
+		 * by the lock of the repository shard where this cooperation
+		 * is stored.
+		 */
+		coop_t * m_first_child;
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The previous sibling in the list of children of
+		 * the parent cooperation.
+		 */
+		coop_t * m_prev_sibling;
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The next sibling in the list of children of
+		 * the parent cooperation.
+		 */
+		coop_t * m_next_sibling;
+
 		/*!
 		 * \since
 		 * v.5.2.3
@@ -1096,6 +1273,53 @@ class SO_5_TYPE coop_t
 			//! Contains nullptr if there is no parent cooperation.
 			coop_t * agent_coop );
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The first part of cooperation registration.
+		 *
+		 * Agents are defined and resources in dispatchers are allocated
+		 * for them. But agents are not activated yet.
+		 *
+		 * If an exception is thrown then all allocated resources are
+		 * released.
+		 *
+		 * \return activators for agents bindings.
+		 */
+		disp_binding_activators_t
+		prepare_registration();
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The second part of cooperation registration.
+		 *
+		 * Agents are activated and the cooperation is marked as registered.
+		 *
+		 * An exception from binding activator leads to call to abort().
+		 */
+		void
+		complete_registration(
+			//! Pointer to the parent cooperation.
+			//! Contains nullptr if there is no parent cooperation.
+			coop_t * parent_coop,
+			//! Activators returned by prepare_registration().
+			disp_binding_activators_t & activators );
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Cancel the registration after successful
+		 * prepare_registration().
+		 *
+		 * Releases resources allocated in dispatchers.
+		 */
+		void
+		cancel_registration();
+
 		/*!
 		 * \since
 		 * v.5.2.3
@@ -1130,9 +1354,25 @@ class SO_5_TYPE coop_t
 		define_all_agents();
 
 		//! Bind agents to the dispatcher.
-		void
+		/*!
+		 * \note
+		 * Since v.5.5.25 it is the first stage of binding only.
+		 * Resources in dispatchers are allocated, but bindings are
+		 * activated by activate_agents_bindings().
+		 */
+		disp_binding_activators_t
 		bind_agents_to_disp();
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief The second stage of binding agents to the dispatcher.
+		 */
+		void
+		activate_agents_bindings(
+			disp_binding_activators_t & activators );
+
 		//! Unbind agent from the dispatcher.
 		/*!
 		 * Unbinds all agents in range [m_agent_array.begin(), it).
@@ -11,6 +11,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <so_5/h/declspec.hpp>
 
@@ -56,6 +57,30 @@ class SO_5_TYPE coop_listener_t
 			//! Cooperation which was registered.
 			const std::string & coop_name ) = 0;
 
+		//! Hook for the registration of several cooperations at once.
+		/*!
+		 * Method will be called right after the successful registration
+		 * of all cooperations passed to environment_t::register_coops().
+		 *
+		 * Default implementation calls on_registered() for every
+		 * cooperation. It can be redefined if a listener can handle
+		 * the whole batch more efficiently.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		on_registered_bulk(
+			//! SObjectizer Environment.
+			environment_t & so_env,
+			//! Cooperations which were registered.
+			//! Parents always precede their children.
+			const std::vector< std::string > & coop_names )
+		{
+			for( const auto & n : coop_names )
+				on_registered( so_env, n );
+		}
+
 		//! Hook for the cooperation deregistration event.
 		/*!
 		 * Method will be called right after full cooperation deregistration.
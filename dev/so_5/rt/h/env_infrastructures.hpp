@@ -47,6 +47,127 @@ namespace default_mt {
 SO_5_FUNC environment_infrastructure_factory_t
 factory();
 
+//
+// params_t
+//
+/*!
+ * \brief Parameters for the default multithreading environment.
+ *
+ * By default there is one thread for the final deregistration of
+ * coops. A pool of several threads can be used if there are a lot of
+ * coops (or coops with a lot of agents) which are deregistered at the
+ * same time. A parent coop is finally deregistered only after all its
+ * children regardless of the count of threads.
+ *
+ * By default the timer thread is used for timers. The timer thread
+ * is created by timer thread factory from environment_params_t.
+ *
+ * If a timer manager factory is specified then there won't be
+ * a separate timer thread. Timers will be handled by timer manager
+ * and expired timers will be processed by the work thread of the
+ * default dispatcher: every time it goes to the event queue for new
+ * events and when it sleeps on the empty queue. In that case timer
+ * thread factory from environment_params_t is not used.
+ *
+ * \attention Long-running event handlers on the default dispatcher
+ * delay processing of timers in that mode.
+ *
+ * Usage example:
+ * \code
+   so_5::launch(
+			[](so_5::environment_t & env) { ... },
+			[](so_5::environment_params_t & params) {
+				params.infrastructure_factory(
+						so_5::env_infrastructures::default_mt::factory(
+								so_5::env_infrastructures::default_mt::params_t{}
+										.timer_manager( so_5::timer_heap_manager_factory() ) ) );
+				...
+			} );
+ * \endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+class params_t
+	{
+		//! Timer manager factory for environment.
+		/*!
+		 * Empty by default. It means that the timer thread will be used.
+		 */
+		timer_manager_factory_t m_timer_factory;
+
+		//! Count of threads for the final deregistration of coops.
+		std::size_t m_final_dereg_thread_count{ 1u };
+
+	public :
+		//! Setter for timer_manager factory.
+		params_t &
+		timer_manager( timer_manager_factory_t factory ) SO_5_OVERLOAD_FOR_REF
+			{
+				m_timer_factory = std::move(factory);
+				return *this;
+			}
+
+#if !defined( SO_5_NO_SUPPORT_FOR_RVALUE_REFERENCE_OVERLOADING )
+		//! Setter for timer_manager factory.
+		params_t &&
+		timer_manager( timer_manager_factory_t factory ) SO_5_OVERLOAD_FOR_RVALUE_REF
+			{
+				m_timer_factory = std::move(factory);
+				return std::move(*this);
+			}
+#endif
+
+		//! Getter for timer_manager factory.
+		const timer_manager_factory_t &
+		timer_manager() const
+			{
+				return m_timer_factory;
+			}
+
+		//! Setter for count of threads for the final deregistration of coops.
+		/*!
+		 * \note Value 0 is treated as 1.
+		 */
+		params_t &
+		final_dereg_thread_count( std::size_t count ) SO_5_OVERLOAD_FOR_REF
+			{
+				m_final_dereg_thread_count = count;
+				return *this;
+			}
+
+#if !defined( SO_5_NO_SUPPORT_FOR_RVALUE_REFERENCE_OVERLOADING )
+		//! Setter for count of threads for the final deregistration of coops.
+		/*!
+		 * \note Value 0 is treated as 1.
+		 */
+		params_t &&
+		final_dereg_thread_count( std::size_t count ) SO_5_OVERLOAD_FOR_RVALUE_REF
+			{
+				m_final_dereg_thread_count = count;
+				return std::move(*this);
+			}
+#endif
+
+		//! Getter for count of threads for the final deregistration of coops.
+		std::size_t
+		final_dereg_thread_count() const
+			{
+				return m_final_dereg_thread_count;
+			}
+	};
+
+// NOTE: implemented in so_5/rt/impl/mt_env_infrastructure.cpp
+/*!
+ * \brief A factory for creation the default multitheading
+ * environment infrastructure with the specified parameters.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC environment_infrastructure_factory_t
+factory( params_t && params );
+
 } /* namespace default_mt */
 
 namespace simple_mtsafe {
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <so_5/h/compiler_features.hpp>
 #include <so_5/h/declspec.hpp>
@@ -394,6 +395,53 @@ class SO_5_TYPE environment_params_t
 						work_thread_activity_tracking_t::off );
 			}
 
+		/*!
+		 * \brief Set queueing delay tracking flag for the whole
+		 * SObjectizer Environment.
+		 *
+		 * If this flag is set then every demand for an agent is marked
+		 * by a timestamp when it is pushed to an event queue. The time
+		 * between pushing and the start of processing is collected for
+		 * every pair (agent, message type) and is distributed via
+		 * run-time monitoring as so_5::stats::messages::queueing_delay
+		 * messages.
+		 *
+		 * Queueing delay tracking is turned off by default.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		environment_params_t &
+		queueing_delay_tracking( bool flag )
+			{
+				m_queueing_delay_tracking = flag;
+				return *this;
+			}
+
+		/*!
+		 * \brief Get queueing delay tracking flag for the whole
+		 * SObjectizer Environment.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		bool
+		queueing_delay_tracking() const
+			{
+				return m_queueing_delay_tracking;
+			}
+
+		//! Helper for turning queueing delay tracking on.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		environment_params_t &
+		turn_queueing_delay_tracking_on()
+			{
+				return queueing_delay_tracking( true );
+			}
+
 		//! Set manager for queue locks defaults.
 		/*!
 		 * \since
@@ -647,6 +695,13 @@ class SO_5_TYPE environment_params_t
 		 */
 		work_thread_activity_tracking_t m_work_thread_activity_tracking;
 
+		/*!
+		 * \brief Queueing delay tracking for the whole Environment.
+		 * \since
+		 * v.5.5.25
+		 */
+		bool m_queueing_delay_tracking;
+
 		/*!
 		 * \brief Manager for defaults of queue locks.
 		 *
@@ -820,6 +875,60 @@ class SO_5_TYPE environment_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		//! Create an anonymous mbox with the specified parameters.
+		/*!
+		 * \note always creates a new mbox.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		mbox_t
+		create_mbox(
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
+		//! Create named mbox with the specified parameters.
+		/*!
+		 * If \a mbox_name is unique then a new mbox will be created.
+		 * If not the reference to existing mbox will be returned and
+		 * \a params will be ignored.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			nonempty_name_t mbox_name,
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
+		//! Create named mbox with name from a handle.
+		/*!
+		 * Works like create_mbox(nonempty_name_t) but doesn't calculate
+		 * the hash value of the name.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			const mbox_name_handle_t & mbox_name );
+
+		//! Create named mbox with name from a handle and with the
+		//! specified parameters.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			const mbox_name_handle_t & mbox_name,
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
 		/*!
 		 * \deprecated Will be removed in v.5.6.0. Use create_mbox() instead.
 		 */
@@ -1027,12 +1136,63 @@ class SO_5_TYPE environment_t
 		 *
 		 * If all these actions are successful then the cooperation is
 		 * marked as registered.
+		 *
+		 * \note
+		 * Since v.5.5.25 the id of the registered cooperation is returned.
+		 * This id can be used for deregistration of the cooperation
+		 * without a search by name:
+		 * \code
+			auto id = env.register_coop( env.create_coop( so_5::autoname ) );
+			...
+			env.deregister_coop( id, so_5::dereg_reason::normal );
+		 * \endcode
 		 */
-		void
+		coop_id_t
 		register_coop(
 			//! Cooperation to be registered.
 			coop_unique_ptr_t agent_coop );
 
+		//! Register several cooperations at once.
+		/*!
+		 * All cooperations are registered as a single operation:
+		 * names are checked, agents are defined and bound to dispatchers
+		 * under one acquisition of the cooperation index locks. The
+		 * cooperation listener receives one coop_listener_t::on_registered_bulk()
+		 * call for the whole batch.
+		 *
+		 * Either all cooperations are registered or none of them.
+		 *
+		 * A cooperation from the batch can be a child of another
+		 * cooperation from the same batch. But the parent must precede
+		 * its children in \a coops.
+		 *
+		 * Usage example:
+		 * \code
+			std::vector< so_5::coop_unique_ptr_t > coops;
+			auto parent = env.create_coop( "parent" );
+			...
+			coops.push_back( std::move( parent ) );
+			for( int i = 0; i != 1000; ++i )
+			{
+				auto child = env.create_coop( so_5::autoname );
+				child->set_parent_coop_name( "parent" );
+				...
+				coops.push_back( std::move( child ) );
+			}
+			auto ids = env.register_coops( std::move( coops ) );
+		 * \endcode
+		 *
+		 * \return ids of registered cooperations in the same order
+		 * as cooperations in \a coops.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		std::vector< coop_id_t >
+		register_coops(
+			//! Cooperations to be registered.
+			std::vector< coop_unique_ptr_t > coops );
+
 		/*!
 		 * \brief Register single agent as a cooperation.
 		 *
@@ -1286,6 +1446,21 @@ class SO_5_TYPE environment_t
 			nonempty_name_t name,
 			//! Deregistration reason.
 			int reason );
+
+		//! Deregister the cooperation by its id.
+		/*!
+		 * It is the same as deregister_coop(nonempty_name_t,int) but
+		 * the cooperation is searched by its id.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		deregister_coop(
+			//! Id of the cooperation to be deregistered.
+			coop_id_t id,
+			//! Deregistration reason.
+			int reason );
 		/*!
 		 * \}
 		 */
@@ -1900,6 +2075,38 @@ class SO_5_TYPE environment_t
 			*/
 			std::chrono::steady_clock::duration period );
 
+		//! Schedule periodic timer event which can be coalesced with
+		//! other periodic timers with the same period.
+		/*!
+		 * The first delivery of the message can be postponed for no
+		 * more than \a slack. It allows the timer thread to serve
+		 * several periodic messages with one timer.
+		 *
+		 * \attention
+		 * Values of \a pause, \a period and \a slack should be non-negative.
+		 *
+		 * \note
+		 * Slack is ignored if the timer mechanism of the environment
+		 * doesn't support coalescing of timers.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		so_5::timer_id_t
+		schedule_timer(
+			//! Message type.
+			const std::type_index & type_wrapper,
+			//! Message to be sent after timeout.
+			const message_ref_t & msg,
+			//! Mbox to which message will be delivered.
+			const mbox_t & mbox,
+			//! Timeout before the first delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period of the delivery repetition.
+			std::chrono::steady_clock::duration period,
+			//! Allowed postponement of the first delivery.
+			timer_slack_t slack );
+
 		//! Schedule a single shot timer event.
 		/*!
 		 * \attention
@@ -2197,13 +2404,20 @@ public :
 	//! Constructor for the case of creation a cooperation without parent.
 	introduce_coop_helper_t( environment_t & env )
 		:	m_env( env )
+		,	m_parent_coop_id( null_coop_id() )
 		,	m_parent_coop_name( nullptr )
 	{}
 	//! Constructor for the case of creation of child cooperation.
+	/*!
+	 * \note
+	 * Since v.5.5.25 the parent is specified by id and name.
+	 */
 	introduce_coop_helper_t(
 		environment_t & env,
+		coop_id_t parent_coop_id,
 		const std::string & parent_coop_name )
 		:	m_env( env )
+		,	m_parent_coop_id( parent_coop_id )
 		,	m_parent_coop_name( &parent_coop_name )
 	{}
 
@@ -2306,11 +2520,23 @@ public :
 private :
 	//! Environment for creation of cooperation.
 	environment_t & m_env;
-	//! Optional name of parent cooperation.
+	//! Optional id of parent cooperation.
+	/*!
+	 * Value null_coop_id() means that there is no parent.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	const coop_id_t m_parent_coop_id;
+
+	//! Name of parent cooperation.
 	/*!
-	 * Value nullptr means that there is no parent.
+	 * It is nullptr if there is no parent.
+	 *
+	 * \since
+	 * v.5.5.25
 	 */
-	const std::string * m_parent_coop_name;
+	const std::string * const m_parent_coop_name;
 
 	template< typename Coop_Name, typename Lambda >
 	void
@@ -2320,8 +2546,8 @@ private :
 		Lambda && lambda )
 	{
 		auto coop = m_env.create_coop( name, std::move( binder ) );
-		if( m_parent_coop_name )
-			coop->set_parent_coop_name( *m_parent_coop_name );
+		if( null_coop_id() != m_parent_coop_id )
+			coop->set_parent_coop_id( m_parent_coop_id, *m_parent_coop_name );
 		lambda( *coop );
 		m_env.register_coop( std::move( coop ) );
 	}
@@ -2370,7 +2596,7 @@ create_child_coop(
 {
 	auto coop = owner.so_environment().create_coop(
 			std::forward< Args >(args)... );
-	coop->set_parent_coop_name( owner.so_coop_name() );
+	coop->set_parent_coop_id( owner.so_coop_id(), owner.so_coop_name() );
 
 	return coop;
 }
@@ -2405,7 +2631,8 @@ create_child_coop(
 {
 	auto coop = parent.environment().create_coop(
 			std::forward< Args >(args)... );
-	coop->set_parent_coop_name( parent.query_coop_name() );
+	coop->set_parent_coop_id(
+			parent.query_coop_id(), parent.query_coop_name() );
 
 	return coop;
 }
@@ -2447,6 +2674,7 @@ introduce_child_coop(
 {
 	details::introduce_coop_helper_t{
 			owner.so_environment(),
+			owner.so_coop_id(),
 			owner.so_coop_name() }.introduce( std::forward< Args >(args)... );
 }
 
@@ -2487,6 +2715,7 @@ introduce_child_coop(
 {
 	details::introduce_coop_helper_t{
 			parent.environment(),
+			parent.query_coop_id(),
 			parent.query_coop_name() }.introduce( std::forward< Args >(args)... );
 }
 
@@ -21,8 +21,12 @@
 
 #include <so_5/h/declspec.hpp>
 
+#include <so_5/h/exception.hpp>
+
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace so_5 {
 
@@ -54,6 +58,17 @@ using environment_infrastructure_deleter_fnptr_t =
  * This class defines the interface of environment_infrastructure.
  * All environment_infrastructure implementations must inherit this interface.
  *
+ * \note
+ * Since v.5.5.25 cooperations are identified by ids. There are new
+ * methods deregister_coop(coop_id_t, coop_dereg_reason_t) and
+ * final_deregister_coop(coop_id_t). Their default implementations throw
+ * an exception with rc_coop_id_not_supported_by_env_infrastructure
+ * error code. If it is thrown SObjectizer switches to the old methods
+ * deregister_coop(nonempty_name_t, coop_dereg_reason_t) and
+ * final_deregister_coop(std::string). So custom implementations written
+ * for the previous versions still work. But
+ * environment_t::deregister_coop(coop_id_t, int) can't be used with them.
+ *
  * \since
  * v.5.5.19
  */
@@ -156,6 +171,30 @@ class SO_5_TYPE environment_infrastructure_t
 			//! Cooperation to be registered.
 			coop_unique_ptr_t coop ) = 0;
 
+		//! Register several cooperations at once.
+		/*!
+		 * Either all cooperations are registered or none of them.
+		 *
+		 * \note
+		 * Default implementation registers cooperations one by one
+		 * via register_coop(). It doesn't provide the all-or-nothing
+		 * guarantee: if registration of some cooperation fails then
+		 * the previous cooperations remain registered. All standard
+		 * environment infrastructures override this method.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		register_coops(
+			//! Cooperations to be registered.
+			//! A parent must precede its children.
+			std::vector< coop_unique_ptr_t > coops )
+			{
+				for( auto & c : coops )
+					register_coop( std::move(c) );
+			}
+
 		//! Deregister cooperation.
 		virtual void
 		deregister_coop(
@@ -164,6 +203,30 @@ class SO_5_TYPE environment_infrastructure_t
 			//! Deregistration reason.
 			coop_dereg_reason_t dereg_reason ) = 0;
 
+		//! Deregister cooperation by its id.
+		/*!
+		 * \note
+		 * Default implementation throws an exception with
+		 * rc_coop_id_not_supported_by_env_infrastructure error code
+		 * because the name of a named cooperation can't be found by its id
+		 * without the repository of cooperations.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		deregister_coop(
+			//! Id of cooperation which being deregistered.
+			coop_id_t id,
+			//! Deregistration reason.
+			coop_dereg_reason_t /*dereg_reason*/ )
+			{
+				throw exception_t(
+						"deregistration of coop by id isn't supported, id: " +
+								std::to_string( id ),
+						rc_coop_id_not_supported_by_env_infrastructure );
+			}
+
 		//! Notification about cooperation for which the final dereg step
 		//! can be performed.
 		virtual void
@@ -173,6 +236,37 @@ class SO_5_TYPE environment_infrastructure_t
 
 		//! Do final actions of the cooperation deregistration.
 		/*!
+		 * \note
+		 * Default implementation throws an exception with
+		 * rc_coop_id_not_supported_by_env_infrastructure error code.
+		 * In that case final_deregister_coop(std::string) is used.
+		 *
+		 * \retval true there are some live cooperations.
+		 * \retval false there is no more live cooperations.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual bool
+		final_deregister_coop(
+			//! Id of cooperation to be deregistered.
+			coop_id_t coop_id )
+			{
+				throw exception_t(
+						"final deregistration of coop by id isn't supported, "
+						"id: " + std::to_string( coop_id ),
+						rc_coop_id_not_supported_by_env_infrastructure );
+			}
+
+		//! Do final actions of the cooperation deregistration.
+		/*!
+		 * It is used only if final_deregister_coop(coop_id_t) isn't
+		 * overridden.
+		 *
+		 * \note
+		 * Since v.5.5.25 default implementation throws an exception with
+		 * rc_coop_id_not_supported_by_env_infrastructure error code.
+		 *
 		 * \retval true there are some live cooperations.
 		 * \retval false there is no more live cooperations.
 		 */
@@ -184,7 +278,13 @@ class SO_5_TYPE environment_infrastructure_t
 			 * Cooperation name must be passed by value because
 			 * reference can become invalid during work of this method.
 			 */
-			std::string coop_name ) = 0;
+			std::string coop_name )
+			{
+				throw exception_t(
+						"final deregistration of coop isn't implemented, "
+						"coop: " + coop_name,
+						rc_coop_id_not_supported_by_env_infrastructure );
+			}
 
 		//! Initiate a timer (delayed or periodic message).
 		virtual so_5::timer_id_t
@@ -195,6 +295,28 @@ class SO_5_TYPE environment_infrastructure_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) = 0;
 
+		//! Initiate a periodic message which can be coalesced with
+		//! other periodic messages with the same period.
+		/*!
+		 * Default implementation ignores \a slack and creates an ordinary
+		 * periodic timer.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual so_5::timer_id_t
+		schedule_coalesced_timer(
+			const std::type_index & type_wrapper,
+			const message_ref_t & msg,
+			const mbox_t & mbox,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period,
+			timer_slack_t slack )
+			{
+				(void)slack;
+				return schedule_timer( type_wrapper, msg, mbox, pause, period );
+			}
+
 		//! Initiate a delayed message.
 		virtual void
 		single_timer(
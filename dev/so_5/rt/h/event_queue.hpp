@@ -38,6 +38,29 @@ class SO_5_TYPE event_queue_t
 		//! Enqueue new event to the queue.
 		virtual void
 		push( execution_demand_t demand ) = 0;
+
+		//! Enqueue several events to the queue.
+		/*!
+		 * Demands are moved from \a demands into the queue in the
+		 * order of their appearance.
+		 *
+		 * \note Default implementation simply calls push() for every
+		 * demand. Derived classes can redefine it to enqueue all demands
+		 * by one operation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		push_many(
+			//! Pointer to the first demand.
+			execution_demand_t * demands,
+			//! Count of demands.
+			std::size_t count )
+			{
+				for( std::size_t i = 0; i != count; ++i )
+					push( std::move( demands[ i ] ) );
+			}
 	};
 
 namespace rt
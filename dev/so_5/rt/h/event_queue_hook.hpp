@@ -56,6 +56,11 @@ using event_queue_hook_deleter_fnptr_t = void (*)(event_queue_hook_t *) /*SO_5_N
  *   for releasing any resources allocated for a custom queue created or
  *   used in on_bind() method.
  *
+ * \note Since v.5.5.25 event_queue_t has push_many() method. Its default
+ * implementation calls push() for every demand. A custom event_queue
+ * should redefine push_many() and forward it to the original queue.
+ * Otherwise demands will be pushed to the original queue one by one.
+ *
  * \since
  * v.5.5.24
  */
@@ -19,6 +19,8 @@
 
 #include <so_5/rt/h/message.hpp>
 
+#include <so_5/rt/stats/h/work_thread_activity.hpp>
+
 namespace so_5
 {
 
@@ -72,6 +74,15 @@ struct execution_demand_t
 	message_ref_t m_message_ref;
 	//! Demand handler.
 	demand_handler_pfn_t m_demand_handler;
+	//! Time when the demand was pushed to an event queue.
+	/*!
+	 * It is set only if queueing delay tracking is turned on.
+	 * Otherwise it holds the default value.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	stats::clock_type_t::time_point m_enqueued_at;
 
 	//! Default constructor.
 	execution_demand_t()
@@ -80,6 +91,7 @@ struct execution_demand_t
 		,	m_mbox_id( 0 )
 		,	m_msg_type( typeid(void) )
 		,	m_demand_handler( nullptr )
+		,	m_enqueued_at()
 		{}
 
 	execution_demand_t(
@@ -95,6 +107,7 @@ struct execution_demand_t
 		,	m_msg_type( msg_type )
 		,	m_message_ref( std::move( message_ref ) )
 		,	m_demand_handler( demand_handler )
+		,	m_enqueued_at()
 		{}
 
 	/*!
@@ -50,5 +50,15 @@ class agent_demand_handler_invoker_t;
 
 } /* namespace enveloped_msg */
 
+namespace stats {
+
+namespace impl {
+
+class ds_queueing_delay_stats_t;
+
+} /* namespace impl */
+
+} /* namespace stats */
+
 } /* namespace so_5 */
 
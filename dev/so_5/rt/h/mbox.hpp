@@ -623,6 +623,72 @@ enum class mbox_type_t
 		multi_producer_single_consumer
 	};
 
+//
+// local_mbox_sync_t
+//
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Type of synchronization of subscribers of a local mbox.
+ */
+enum class local_mbox_sync_t
+	{
+		//! Subscribers are protected by a reader-writer spinlock.
+		//! The lock is acquired in read mode by every send.
+		rw_spinlock,
+		//! Subscribers are stored in an immutable snapshot which is
+		//! replaced on every change of subscriptions (read-copy-update).
+		//! A send doesn't acquire any lock.
+		/*!
+		 * This type is intended for mboxes with many concurrent senders
+		 * and rare changes of subscriptions. Every subscription and
+		 * unsubscription copies all subscribers of the mbox and waits
+		 * for the completion of deliveries started before it.
+		 *
+		 * \attention A delivery filter for such mbox must not
+		 * change subscriptions to the same mbox.
+		 */
+		rcu
+	};
+
+//
+// mbox_params_t
+//
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Parameters for creation of a local mbox.
+ *
+ * \par Usage example:
+	\code
+	auto mbox = env.create_mbox(
+			so_5::mbox_params_t{}.sync( so_5::local_mbox_sync_t::rcu ) );
+	\endcode
+ */
+class mbox_params_t
+	{
+		//! Type of synchronization of subscribers.
+		local_mbox_sync_t m_sync = { local_mbox_sync_t::rw_spinlock };
+
+	public :
+		//! Set type of synchronization of subscribers.
+		mbox_params_t &
+		sync( local_mbox_sync_t v )
+			{
+				m_sync = v;
+				return *this;
+			}
+
+		//! Get type of synchronization of subscribers.
+		local_mbox_sync_t
+		sync() const
+			{
+				return m_sync;
+			}
+	};
+
 //
 // abstract_message_box_t
 //
@@ -836,6 +902,22 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 				this->do_deliver_message( msg_type, message, 1 );
 			}
 
+		//! Deliver several messages of the same type for all subscribers.
+		/*!
+		 * \note This is a just a wrapper for do_deliver_messages.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		inline void
+		deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count ) const
+			{
+				this->do_deliver_messages( msg_type, messages, count, 1 );
+			}
+
 		/*!
 		 * \since
 		 * v.5.3.0.
@@ -928,6 +1010,35 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int overlimit_reaction_deep ) const = 0;
 
+		/*!
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers with respect to message limits.
+		 *
+		 * The result must be the same as for the serie of
+		 * do_deliver_message() calls for every message. But an
+		 * implementation can do search for subscribers only once and
+		 * can push all messages to the event queue of a subscriber by
+		 * one operation.
+		 *
+		 * \note
+		 * To keep source-code compatibility with previous versions
+		 * this method is not pure virtual. Its implementation simply
+		 * calls do_deliver_message() for every message.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		do_deliver_messages(
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Pointer to the first message instance to be delivered.
+			const message_ref_t * messages,
+			//! Count of message instances.
+			std::size_t count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int overlimit_reaction_deep ) const;
+
 		/*!
 		 * \since
 		 * v.5.5.4
@@ -18,9 +18,11 @@
 
 #include <so_5/details/h/invoke_noexcept_code.hpp>
 #include <so_5/details/h/remaining_time_counter.hpp>
+#include <so_5/details/h/at_scope_exit.hpp>
 
 #include <chrono>
 #include <functional>
+#include <vector>
 
 namespace so_5 {
 
@@ -266,6 +268,49 @@ enum class overflow_reaction_t
 		remove_oldest
 	};
 
+//
+// synchronization_t
+//
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief A kind of synchronization to be used by message chain.
+ */
+enum class synchronization_t
+	{
+		//! All operations with chain are protected by the chain's mutex.
+		mutex_based,
+		//! Lock-free queue for many producers and many consumers is used.
+		/*!
+		 * Producers and consumers do not acquire the chain's mutex
+		 * while there are messages and free space in the chain.
+		 * A consumer spins for some time on empty chain before going to
+		 * sleep.
+		 *
+		 * \note Can be used only for size-limited chains. Storage for
+		 * the chain is always preallocated, the value of memory_usage_t
+		 * is ignored.
+		 */
+		lock_free_mpmc,
+		//! Wait-free ring buffer for one producer and one consumer is used.
+		/*!
+		 * This is the cheapest kind of synchronization but it can be used
+		 * only if there is only one thread which sends messages to the
+		 * chain and only one thread which receives messages from it.
+		 * Note that timer thread is a producer if delayed or periodic
+		 * messages are sent to the chain.
+		 *
+		 * \note Can be used only for size-limited chains. Storage for
+		 * the chain is always preallocated, the value of memory_usage_t
+		 * is ignored. overflow_reaction_t::remove_oldest is not supported.
+		 *
+		 * \attention The usage of such chain from several producers or
+		 * from several consumers leads to undefined behavior.
+		 */
+		lock_free_spsc
+	};
+
 //
 // capacity_t
 //
@@ -499,6 +544,33 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Max time to wait on empty queue.
 			mchain_props::duration_t empty_queue_timeout ) = 0;
 
+		//! Extract several messages at once.
+		/*!
+		 * Waits no more than \a empty_queue_timeout for the first message.
+		 * Then extracts messages which are already in the chain until
+		 * \a max_demands messages are extracted or the chain becomes empty.
+		 *
+		 * The default implementation calls extract() for every message.
+		 * Implementations of message chains can extract all messages
+		 * under a single lock.
+		 *
+		 * \return status of extraction of the first message.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual mchain_props::extraction_status_t
+		extract(
+			//! Destination for extracted messages.
+			//! Must have space for at least \a max_demands items.
+			mchain_props::demand_t * dest,
+			//! Max count of messages to be extracted.
+			std::size_t max_demands,
+			//! Receiver for count of extracted messages.
+			std::size_t & extracted,
+			//! Max time to wait on empty queue.
+			mchain_props::duration_t empty_queue_timeout );
+
 		//! Cast message chain to message box.
 		so_5::mbox_t
 		as_mbox();
@@ -647,6 +719,14 @@ class mchain_params_t
 		//! Is message delivery tracing disabled explicitly?
 		bool m_msg_tracing_disabled = { false };
 
+		//! A kind of synchronization for the chain.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		mchain_props::synchronization_t m_synchronization =
+				{ mchain_props::synchronization_t::mutex_based };
+
 	public :
 		//! Initializing constructor.
 		mchain_params_t(
@@ -709,6 +789,41 @@ class mchain_params_t
 			{
 				return m_msg_tracing_disabled;
 			}
+
+		//! Set a kind of synchronization for the chain.
+		/*!
+		 * \par Usage example:
+			\code
+			so_5::environment_t & env = ...;
+			auto chain = env.create_mchain(
+				so_5::make_limited_without_waiting_mchain_params(
+					1000,
+					so_5::mchain_props::memory_usage_t::preallocated,
+					so_5::mchain_props::overflow_reaction_t::drop_newest )
+				.synchronization(
+					so_5::mchain_props::synchronization_t::lock_free_mpmc ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		mchain_params_t &
+		synchronization( mchain_props::synchronization_t value )
+			{
+				m_synchronization = value;
+				return *this;
+			}
+
+		//! Get a kind of synchronization for the chain.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		mchain_props::synchronization_t
+		synchronization() const
+			{
+				return m_synchronization;
+			}
 	};
 
 /*!
@@ -964,6 +1079,180 @@ receive(
 		return mchain_receive_result_t{ 0u, 0u, status };
 	}
 
+namespace mchain_props {
+
+namespace details {
+
+/*!
+ * \brief An implementation of receive of a batch of messages.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Bunch >
+inline mchain_receive_result_t
+receive_batch_impl(
+	const so_5::mchain_t & chain,
+	duration_t waiting_timeout,
+	demand_t * buffer,
+	std::size_t buffer_size,
+	const Bunch & bunch )
+	{
+		std::size_t extracted = 0u;
+		const auto status = chain->extract(
+				buffer, buffer_size, extracted, waiting_timeout );
+
+		// Messages must not be held in the buffer after the return.
+		// Even if some handler throws. Unhandled messages are lost
+		// in that case.
+		auto release_messages = so_5::details::at_scope_exit( [&] {
+				for( std::size_t i = 0u; i != extracted; ++i )
+					buffer[ i ] = demand_t{};
+			} );
+
+		std::size_t handled = 0u;
+		for( std::size_t i = 0u; i != extracted; ++i )
+			{
+				auto & d = buffer[ i ];
+				if( bunch.handle( d.m_msg_type, d.m_message_ref, d.m_demand_type ) )
+					++handled;
+			}
+
+		return mchain_receive_result_t{ extracted, handled, status };
+	}
+
+} /* namespace details */
+
+} /* namespace mchain_props */
+
+//
+// receive_batch
+//
+/*!
+ * \brief Receive and handle a batch of messages from message chain.
+ *
+ * Waits no more than \a waiting_timeout for the first message. Then all
+ * messages which are already in the chain are extracted at once (but no more
+ * than size of \a buffer). All of them are extracted under a single lock of
+ * the chain. Then handlers for extracted messages are called, the chain is
+ * not locked at that time.
+ *
+ * The \a buffer is owned by the caller and can be reused for several
+ * calls to receive_batch(). It doesn't hold messages after the return
+ * from receive_batch().
+ *
+ * \note The status in the result is the status of extraction of the
+ * first message. If at least one message is extracted then it is
+ * extraction_status_t::msg_extracted even if the chain was closed
+ * after that.
+ *
+ * \attention It is an error if there are more than one handler for the
+ * same message type in \a handlers.
+ *
+ * \attention If a handler throws then the exception is propagated from
+ * receive_batch(). All messages from the batch which were extracted
+ * after the message for that handler are lost: they are already removed
+ * from the chain and are destroyed without handling.
+ *
+ * \par Usage examples:
+	\code
+	so_5::mchain_t ch = env.create_mchain(...);
+
+	so_5::mchain_props::demand_t buffer[ 64 ];
+	for(;;)
+	{
+		auto r = so_5::receive_batch( ch, so_5::infinite_wait, buffer,
+				[]( const my_message & m ) {...},
+				[]( const my_another_message & m ) {...} );
+		if( so_5::mchain_props::extraction_status_t::chain_closed == r.status() )
+			break;
+	}
+	\endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+template<
+	std::size_t Buffer_Size,
+	typename Timeout,
+	typename... Handlers >
+inline mchain_receive_result_t
+receive_batch(
+	//! Message chain from which messages must be extracted.
+	const so_5::mchain_t & chain,
+	//! Maximum timeout for waiting for message on empty chain.
+	Timeout waiting_timeout,
+	//! Buffer for extracted messages.
+	mchain_props::demand_t (&buffer)[ Buffer_Size ],
+	//! Handlers for message processing.
+	Handlers &&... handlers )
+	{
+		using namespace so_5::details;
+		using namespace so_5::mchain_props;
+		using namespace so_5::mchain_props::details;
+
+		handlers_bunch_t< sizeof...(handlers) > bunch;
+		fill_handlers_bunch( bunch, 0,
+				std::forward< Handlers >(handlers)... );
+
+		return receive_batch_impl(
+				chain,
+				actual_timeout( waiting_timeout ),
+				buffer,
+				Buffer_Size,
+				bunch );
+	}
+
+/*!
+ * \brief Receive and handle a batch of messages from message chain.
+ *
+ * A version for buffer in the form of std::vector. The size (not the
+ * capacity) of the vector is used as the max count of messages to be
+ * extracted.
+ *
+ * \attention If a handler throws then the rest of the batch is lost
+ * in the same way as for the version with an array as the buffer.
+ *
+ * \par Usage examples:
+	\code
+	so_5::mchain_t ch = env.create_mchain(...);
+
+	std::vector< so_5::mchain_props::demand_t > buffer( 64 );
+	auto r = so_5::receive_batch( ch, std::chrono::milliseconds(200), buffer,
+			[]( const my_message & m ) {...} );
+	\endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Timeout, typename... Handlers >
+inline mchain_receive_result_t
+receive_batch(
+	//! Message chain from which messages must be extracted.
+	const so_5::mchain_t & chain,
+	//! Maximum timeout for waiting for message on empty chain.
+	Timeout waiting_timeout,
+	//! Buffer for extracted messages.
+	std::vector< mchain_props::demand_t > & buffer,
+	//! Handlers for message processing.
+	Handlers &&... handlers )
+	{
+		using namespace so_5::details;
+		using namespace so_5::mchain_props;
+		using namespace so_5::mchain_props::details;
+
+		handlers_bunch_t< sizeof...(handlers) > bunch;
+		fill_handlers_bunch( bunch, 0,
+				std::forward< Handlers >(handlers)... );
+
+		return receive_batch_impl(
+				chain,
+				actual_timeout( waiting_timeout ),
+				buffer.data(),
+				buffer.size(),
+				bunch );
+	}
+
 //
 // mchain_bulk_processing_params_t
 //
@@ -19,6 +19,8 @@
 
 #include <iterator>
 #include <array>
+#include <vector>
+#include <algorithm>
 
 namespace so_5 {
 
@@ -273,6 +275,16 @@ class actual_select_notificator_t : public select_notificator_t
 			}
 
 	public :
+		//! Default constructor.
+		/*!
+		 * The list of notified select_cases is empty.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		actual_select_notificator_t()
+			{}
+
 		/*!
 		 * \brief Initializing constructor.
 		 *
@@ -327,6 +339,39 @@ class actual_select_notificator_t : public select_notificator_t
 				push_to_notified_chain( what );
 			}
 
+		/*!
+		 * \brief Remove specified select_case object from the chain of
+		 * 'notified select_cases'.
+		 *
+		 * Does nothing if \a what is not in the chain.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		remove_from_ready_chain( select_case_t & what ) SO_5_NOEXCEPT
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				select_case_t * c = m_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &what )
+							{
+								if( prev )
+									prev->set_next( what.giveout_next() );
+								else
+									m_tail = what.giveout_next();
+								return;
+							}
+
+						prev = c;
+						c = next;
+					}
+			}
+
 		/*!
 		 * \brief Wait for any notified select_case.
 		 *
@@ -359,47 +404,98 @@ class actual_select_notificator_t : public select_notificator_t
 #endif
 
 //
-// select_actions_performer_t
+// cases_holder_select_context_t
 //
 /*!
- * \brief Helper class for performing select-specific operations.
+ * \brief A context for one select operation on select_cases from
+ * a select_cases_holder.
+ *
+ * All select_cases are seen as notified at the start of select
+ * operation. All of them are removed from mchains at the end of select
+ * operation.
  *
  * \tparam Holder type of actual select_cases_holder_t.
  *
  * \since
- * v.5.5.16
+ * v.5.5.25
  */
 template< typename Holder >
-class select_actions_performer_t
+class cases_holder_select_context_t
 	{
-		const mchain_select_params_t & m_params;
 		const Holder & m_select_cases;
 		actual_select_notificator_t m_notificator;
 
 		std::size_t m_closed_chains = 0;
+
+	public :
+		cases_holder_select_context_t( const Holder & select_cases )
+			:	m_select_cases( select_cases )
+			,	m_notificator( select_cases.begin(), select_cases.end() )
+			{}
+		~cases_holder_select_context_t()
+			{
+				for( auto & c : m_select_cases )
+					c.on_select_finish();
+			}
+
+		actual_select_notificator_t &
+		notificator() { return m_notificator; }
+
+		std::size_t
+		cases_count() const { return m_select_cases.size(); }
+
+		std::size_t
+		closed_chains() const { return m_closed_chains; }
+
+		void
+		on_chain_closed( select_case_t & ) { ++m_closed_chains; }
+	};
+
+//
+// select_actions_performer_t
+//
+/*!
+ * \brief Helper class for performing select-specific operations.
+ *
+ * \tparam Context type of context of select operation. It must provide
+ * access to notificator, count of select_cases and count of closed chains.
+ * And it must be informed about closed chains.
+ *
+ * \note Since v.5.5.25 the context of select operation is a template
+ * parameter. It allows to use the same implementation for ordinary
+ * select and for select on so_5::mchain_set_t.
+ *
+ * \since
+ * v.5.5.16
+ */
+template< typename Context >
+class select_actions_performer_t
+	{
+		const mchain_select_params_t & m_params;
+		Context & m_context;
+
 		std::size_t m_extracted_messages = 0;
 		std::size_t m_handled_messages = 0;
 		extraction_status_t m_status;
-		bool m_can_continue = { true };
+		bool m_can_continue;
 
 	public :
 		select_actions_performer_t(
 			const mchain_select_params_t & params,
-			const Holder & select_cases )
+			Context & context )
 			:	m_params( params )
-			,	m_select_cases( select_cases )
-			,	m_notificator( select_cases.begin(), select_cases.end() )
+			,	m_context( context )
+				// All mchains can be closed by previous select operations
+				// on the same mchain_set.
+			,	m_can_continue(
+					m_context.closed_chains() != m_context.cases_count() )
 			{}
-		~select_actions_performer_t()
-			{
-				for( auto & c : m_select_cases )
-					c.on_select_finish();
-			}
 
 		void
 		handle_next( const duration_t & wait_time )
 			{
-				select_case_t * ready_chain = m_notificator.wait( wait_time );
+				select_case_t * ready_chain =
+						m_context.notificator().wait( wait_time );
 				if( !ready_chain )
 					{
 						m_status = extraction_status_t::no_messages;
@@ -422,7 +518,7 @@ class select_actions_performer_t
 						m_extracted_messages,
 						m_handled_messages,
 						m_extracted_messages ? extraction_status_t::msg_extracted :
-								( m_closed_chains == m_select_cases.size() ?
+								( m_context.closed_chains() == m_context.cases_count() ?
 								  	extraction_status_t::chain_closed :
 									extraction_status_t::no_messages )
 					};
@@ -437,7 +533,19 @@ class select_actions_performer_t
 						auto * current = ready_chain;
 						ready_chain = current->giveout_next();
 
-						const auto result = current->try_receive( m_notificator );
+						mchain_receive_result_t result;
+						try
+							{
+								result = current->try_receive( m_context.notificator() );
+							}
+						catch( ... )
+							{
+								// The current select_case and all not handled
+								// select_cases must not be lost.
+								m_context.notificator().return_to_ready_chain( *current );
+								return_to_ready_chain( ready_chain );
+								throw;
+							}
 						m_status = result.status();
 
 						if( extraction_status_t::msg_extracted == m_status )
@@ -448,11 +556,11 @@ class select_actions_performer_t
 								// The mchain from 'current' can contain more
 								// messages. We should return this case to 'ready_chain'
 								// of the notificator.
-								m_notificator.return_to_ready_chain( *current );
+								m_context.notificator().return_to_ready_chain( *current );
 							}
 						else if( extraction_status_t::chain_closed == m_status )
 							{
-								++m_closed_chains;
+								m_context.on_chain_closed( *current );
 
 								// Since v.5.5.17 chain_closed handler must be
 								// used on chain_closed event.
@@ -465,13 +573,29 @@ class select_actions_performer_t
 
 						update_can_continue_flag();
 					}
+
+				// Not handled select_cases must be returned to the notificator.
+				// They can be handled by the next select operation on
+				// the same mchain_set.
+				return_to_ready_chain( ready_chain );
+			}
+
+		void
+		return_to_ready_chain( select_case_t * ready_chain ) SO_5_NOEXCEPT
+			{
+				while( ready_chain )
+					{
+						auto * current = ready_chain;
+						ready_chain = current->giveout_next();
+						m_context.notificator().return_to_ready_chain( *current );
+					}
 			}
 
 		void
 		update_can_continue_flag()
 			{
 				auto fn = [this] {
-					if( m_closed_chains == m_select_cases.size() )
+					if( m_context.closed_chains() == m_context.cases_count() )
 						return false;
 
 					if( m_params.to_handle() &&
@@ -492,39 +616,40 @@ class select_actions_performer_t
 			}
 	};
 
-template< typename Holder >
+template< typename Context >
 mchain_receive_result_t
 do_adv_select_with_total_time(
 	const mchain_select_params_t & params,
-	const Holder & select_cases )
+	Context & context )
 	{
 		using namespace so_5::details;
 
-		select_actions_performer_t< Holder > performer{ params, select_cases };
+		select_actions_performer_t< Context > performer{ params, context };
 
 		remaining_time_counter_t time_counter{ params.total_time() };
-		do
+		while( performer.can_continue() )
 			{
 				performer.handle_next( time_counter.remaining() );
 				time_counter.update();
+				if( !time_counter )
+					break;
 			}
-		while( time_counter && performer.can_continue() );
 
 		return performer.make_result();
 	}
 
-template< typename Holder >
+template< typename Context >
 mchain_receive_result_t
 do_adv_select_without_total_time(
 	const mchain_select_params_t & params,
-	const Holder & select_cases )
+	Context & context )
 	{
 		using namespace so_5::details;
 
-		select_actions_performer_t< Holder > performer{ params, select_cases };
+		select_actions_performer_t< Context > performer{ params, context };
 
 		remaining_time_counter_t wait_time{ params.empty_timeout() };
-		do
+		while( performer.can_continue() )
 			{
 				performer.handle_next( wait_time.remaining() );
 				if( extraction_status_t::msg_extracted == performer.last_status() )
@@ -542,8 +667,10 @@ do_adv_select_without_total_time(
 					// 2) some chain is closed. Wait time should be updated and
 					//    next wait attempt must be performed.
 					wait_time.update();
+
+				if( !wait_time )
+					break;
 			}
-		while( wait_time && performer.can_continue() );
 
 		return performer.make_result();
 	}
@@ -551,6 +678,26 @@ do_adv_select_without_total_time(
 //
 // perform_select
 //
+/*!
+ * \brief Helper function with implementation of main select action.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Context >
+mchain_receive_result_t
+perform_select_with_context(
+	//! Parameters for advanced select.
+	const mchain_select_params_t & params,
+	//! Context of select operation.
+	Context & context )
+	{
+		if( is_infinite_wait_timevalue( params.total_time() ) )
+			return do_adv_select_without_total_time( params, context );
+		else
+			return do_adv_select_with_total_time( params, context );
+	}
+
 /*!
  * \brief Helper function with implementation of main select action.
  *
@@ -565,10 +712,9 @@ perform_select(
 	//! Select cases.
 	const Cases_Holder & cases_holder )
 	{
-		if( is_infinite_wait_timevalue( params.total_time() ) )
-			return do_adv_select_without_total_time( params, cases_holder );
-		else
-			return do_adv_select_with_total_time( params, cases_holder );
+		cases_holder_select_context_t< Cases_Holder > context{ cases_holder };
+
+		return perform_select_with_context( params, context );
 	}
 
 } /* namespace details */
@@ -925,5 +1071,238 @@ select(
 				prepared.cases() );
 	}
 
+//
+// mchain_set_t
+//
+/*!
+ * \brief Persistent set of select_cases for repeated select operations.
+ *
+ * Ordinary select() and select() for prepared_select_t register
+ * every select_case in its mchain at the start of a select operation and
+ * remove them at the end. It means that the cost of every select
+ * operation is proportional to the count of mchains, not to the count of
+ * mchains with messages. This could be significant if select is performed
+ * in a loop on hundreds or thousands of mchains.
+ *
+ * mchain_set_t keeps select_cases registered in mchains between select
+ * operations. If a mchain becomes non-empty between select operations its
+ * select_case is stored in the list of ready select_cases and will be
+ * handled by the next select. Because of that every select on mchain_set_t
+ * deals only with ready mchains.
+ *
+ * Usage example:
+ * \code
+	so_5::mchain_set_t chains{
+		case_( ch1, some_handlers... ),
+		case_( ch2, more_handlers... ) };
+	...
+	chains.add( case_( ch3, yet_more_handlers... ) );
+	...
+	while( !some_condition )
+	{
+		auto r = so_5::select(
+				so_5::from_all().extract_n(10).empty_timeout(200ms),
+				chains );
+		...
+	}
+	...
+	chains.remove( ch2 );
+ * \endcode
+ *
+ * \attention mchain_set_t is not thread safe. All operations on it
+ * (including select) must be performed from one thread at a time.
+ *
+ * \attention The behaviour is not defined if a mchain is used in different
+ * select_cases of one mchain_set_t.
+ *
+ * \note This type is not copyable and not moveable.
+ *
+ * \since
+ * v.5.5.25
+ */
+class mchain_set_t
+	{
+		template< typename Context >
+		friend class mchain_props::details::select_actions_performer_t;
+
+		//! All select_cases of the set.
+		std::vector< mchain_props::select_case_unique_ptr_t > m_cases;
+
+		//! Notificator for all select_cases of the set.
+		/*!
+		 * Holds the list of ready select_cases between select operations.
+		 */
+		mchain_props::details::actual_select_notificator_t m_notificator;
+
+		//! The list of select_cases for closed mchains.
+		/*!
+		 * Items of that list are linked via select_case_t::set_next().
+		 */
+		mchain_props::select_case_t * m_closed_cases = nullptr;
+
+		//! Count of closed mchains.
+		std::size_t m_closed_chains = 0;
+
+		/*!
+		 * \name Methods to be used by select operation.
+		 * \{
+		 */
+		mchain_props::details::actual_select_notificator_t &
+		notificator() { return m_notificator; }
+
+		std::size_t
+		cases_count() const { return m_cases.size(); }
+
+		std::size_t
+		closed_chains() const { return m_closed_chains; }
+
+		void
+		on_chain_closed( mchain_props::select_case_t & what )
+			{
+				what.set_next( m_closed_cases );
+				m_closed_cases = &what;
+				++m_closed_chains;
+			}
+		/*!
+		 * \}
+		 */
+
+		//! Remove select_case from the list of closed select_cases.
+		void
+		remove_from_closed( mchain_props::select_case_t & what ) SO_5_NOEXCEPT
+			{
+				mchain_props::select_case_t * c = m_closed_cases;
+				mchain_props::select_case_t * prev = nullptr;
+				while( c )
+					{
+						if( c == &what )
+							{
+								if( prev )
+									prev->set_next( what.giveout_next() );
+								else
+									m_closed_cases = what.giveout_next();
+								--m_closed_chains;
+								return;
+							}
+
+						prev = c;
+						c = c->query_next();
+					}
+			}
+
+	public :
+		mchain_set_t( const mchain_set_t & ) = delete;
+		mchain_set_t &
+		operator=( const mchain_set_t & ) = delete;
+
+		//! Default constructor.
+		/*!
+		 * Creates an empty set.
+		 */
+		mchain_set_t()
+			{}
+
+		//! Initializing constructor.
+		template< typename... Cases >
+		mchain_set_t(
+			mchain_props::select_case_unique_ptr_t first_case,
+			Cases &&... other_cases )
+			{
+				m_cases.reserve( 1u + sizeof...(other_cases) );
+
+				add( std::move(first_case) );
+				using expander = int[];
+				(void)expander{ 0,
+						(add( std::forward< Cases >(other_cases) ), 0)... };
+			}
+
+		~mchain_set_t()
+			{
+				for( auto & c : m_cases )
+					c->on_select_finish();
+			}
+
+		//! Add another select_case to the set.
+		/*!
+		 * The new select_case will be checked by the next select operation.
+		 */
+		void
+		add( mchain_props::select_case_unique_ptr_t c )
+			{
+				m_cases.push_back( std::move(c) );
+				m_notificator.return_to_ready_chain( *(m_cases.back()) );
+			}
+
+		//! Remove select_case for the specified mchain from the set.
+		/*!
+		 * Does nothing if there is no select_case for \a chain.
+		 */
+		void
+		remove( const mchain_t & chain ) SO_5_NOEXCEPT
+			{
+				auto it = std::find_if( m_cases.begin(), m_cases.end(),
+						[&chain]( const mchain_props::select_case_unique_ptr_t & c ) {
+							return c->chain() == chain;
+						} );
+				if( it == m_cases.end() )
+					return;
+
+				auto & c = **it;
+				// select_case must be removed from mchain first. After that
+				// it can't be placed into the list of ready select_cases.
+				c.on_select_finish();
+				m_notificator.remove_from_ready_chain( c );
+				remove_from_closed( c );
+
+				m_cases.erase( it );
+			}
+
+		//! Get count of select_cases in the set.
+		std::size_t
+		size() const { return m_cases.size(); }
+
+		//! Is the set empty?
+		bool
+		empty() const { return m_cases.empty(); }
+	};
+
+/*!
+ * \brief A select operation on select_cases from mchain_set.
+ *
+ * The cost of that select operation is proportional to the count of
+ * ready mchains only. See so_5::mchain_set_t for more details.
+ *
+ * Usage example:
+ * \code
+	so_5::mchain_set_t chains;
+	for( auto & ch : chains_to_listen )
+		chains.add( case_( ch, some_handlers... ) );
+	...
+	while( !some_condition )
+	{
+		auto r = so_5::select(
+				so_5::from_all().handle_n(10).empty_timeout(200ms),
+				chains );
+		...
+	}
+ * \endcode
+ *
+ * \note If all mchains from the set are closed then select returns
+ * immediately with extraction_status_t::chain_closed status.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline mchain_receive_result_t
+select(
+	//! Parameters for advanced select.
+	const mchain_select_params_t & params,
+	//! Set of select_cases.
+	mchain_set_t & chains )
+	{
+		return mchain_props::details::perform_select_with_context(
+				params, chains );
+	}
+
 } /* namespace so_5 */
 
@@ -15,6 +15,7 @@
 #include <so_5/h/types.hpp>
 
 #include <so_5/rt/h/agent_ref_fwd.hpp>
+#include <so_5/rt/h/message_slab.hpp>
 
 #include <type_traits>
 #include <typeindex>
@@ -329,6 +330,40 @@ class SO_5_TYPE signal_t
 		~signal_t() SO_5_NOEXCEPT override = default;
 };
 
+//
+// slab_message_t
+//
+/*!
+ * \brief A base class for small messages which should be allocated
+ * from the slab.
+ *
+ * Instances of classes derived from slab_message_t are allocated
+ * by message_slab::allocate() and deallocated by message_slab::deallocate().
+ * It means that memory of such message is returned to the slab when the last
+ * message_ref_t to it is released.
+ *
+ * Usage example:
+ * \code
+	struct msg_tick final : public so_5::slab_message_t
+	{
+		std::uint64_t m_counter;
+
+		msg_tick( std::uint64_t counter ) : m_counter{ counter } {}
+	};
+ * \endcode
+ *
+ * \note Messages bigger than message_slab::max_block_size are
+ * allocated by the global operator new.
+ *
+ * \since
+ * v.5.5.25
+ */
+class slab_message_t
+	:	public message_t
+	,	public details::message_allocation_mixin_t< true >
+{
+};
+
 //
 // user_type_message_t
 //
@@ -342,7 +377,12 @@ class SO_5_TYPE signal_t
  * v.5.5.9
  */
 template< typename T >
-struct user_type_message_t : public message_t
+struct user_type_message_t
+	:	public message_t
+		// Since v.5.5.25 instances can be allocated from the slab.
+		// See so_5::use_slab_allocation for details.
+	,	public details::message_allocation_mixin_t<
+				use_slab_allocation< T >::value >
 {
 	//! Instance of user message.
 	/*!
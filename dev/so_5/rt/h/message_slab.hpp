@@ -0,0 +1,145 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Slab allocator for small message instances.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+#include <so_5/h/compiler_features.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace so_5
+{
+
+namespace message_slab
+{
+
+/*!
+ * \brief Max size of block which can be allocated from the slab.
+ *
+ * Bigger blocks are allocated by the global operator new.
+ *
+ * \since
+ * v.5.5.25
+ */
+const std::size_t max_block_size = 256;
+
+/*!
+ * \brief Allocate a block for a message instance.
+ *
+ * Blocks are taken from the cache of the current thread. If that cache is
+ * empty then a bunch of blocks is taken from the global depot. If the
+ * global depot is empty then the global operator new is used.
+ *
+ * \attention Memory must be deallocated by message_slab::deallocate()
+ * with the same \a size value.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC void *
+allocate( std::size_t size );
+
+/*!
+ * \brief Return a block to the slab.
+ *
+ * A block is returned to the cache of the current thread. It means
+ * that the message can be destroyed on a different thread than it was
+ * created. If the cache of the current thread is full then a part of it
+ * is moved to the global depot.
+ *
+ * \since
+ * v.5.5.25
+ */
+SO_5_FUNC void
+deallocate( void * block, std::size_t size ) SO_5_NOEXCEPT;
+
+} /* namespace message_slab */
+
+namespace details
+{
+
+//
+// message_allocation_mixin_t
+//
+/*!
+ * \brief A mixin for message envelope which redefines
+ * allocation/deallocation of instances.
+ *
+ * Default implementation is empty. It means that global operators
+ * new and delete are used.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< bool Use_Slab >
+struct message_allocation_mixin_t
+	{};
+
+/*!
+ * \brief Specialization for the case when slab allocation is used.
+ *
+ * \since
+ * v.5.5.25
+ */
+template<>
+struct message_allocation_mixin_t< true >
+	{
+		static void *
+		operator new( std::size_t size )
+			{
+				return message_slab::allocate( size );
+			}
+
+		static void
+		operator delete( void * block, std::size_t size ) SO_5_NOEXCEPT
+			{
+				message_slab::deallocate( block, size );
+			}
+	};
+
+} /* namespace details */
+
+//
+// use_slab_allocation
+//
+/*!
+ * \brief A marker for enabling slab allocation for messages of user types.
+ *
+ * By default every message instance is allocated by the global
+ * operator new. For small messages that can be a bottleneck. Slab
+ * allocation can be turned on for a message of user type (e.g. type
+ * which is not derived from message_t) by specialization of that template:
+ *
+ * \code
+	struct position { double m_x, m_y; };
+
+	namespace so_5 {
+		template<> struct use_slab_allocation< position > : public std::true_type {};
+	}
+
+	// Instances of user_type_message_t<position> will be allocated from slab.
+	so_5::send< position >( mbox, 1.0, 2.0 );
+ * \endcode
+ *
+ * \note For messages derived from message_t so_5::slab_message_t should
+ * be used as a base class instead.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename T >
+struct use_slab_allocation : public std::false_type
+	{};
+
+} /* namespace so_5 */
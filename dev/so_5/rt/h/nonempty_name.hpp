@@ -10,6 +10,7 @@
 #pragma once
 
 #include <string>
+#include <functional>
 
 #include <so_5/h/ret_code.hpp>
 #include <so_5/h/exception.hpp>
@@ -90,6 +91,65 @@ class nonempty_name_t
 		std::string m_nonempty_name;
 };
 
+//
+// mbox_name_handle_t
+//
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief A name of mbox with precalculated hash value.
+ *
+ * Creation of a named mbox requires calculation of the hash value of
+ * mbox name. If the same name is used many times then it is better to
+ * create a handle for it once and pass the handle to
+ * environment_t::create_mbox(). The hash value won't be calculated
+ * again in that case.
+ *
+ * \par Usage example:
+	\code
+	const so_5::mbox_name_handle_t name{ "notifications" };
+	...
+	auto mbox = env.create_mbox( name );
+	\endcode
+ */
+class mbox_name_handle_t
+{
+	public:
+		explicit mbox_name_handle_t( nonempty_name_t name )
+			:	m_name( name.giveout_value() )
+			,	m_hash( std::hash< std::string >{}( m_name ) )
+		{}
+
+		//! Get the name.
+		const std::string &
+		query_name() const
+		{
+			return m_name;
+		}
+
+		//! Get the hash value for the name.
+		std::size_t
+		hash() const
+		{
+			return m_hash;
+		}
+
+		friend bool
+		operator==( const mbox_name_handle_t & a, const mbox_name_handle_t & b )
+		{
+			return a.m_hash == b.m_hash && a.m_name == b.m_name;
+		}
+
+	private:
+		//! Name.
+		std::string m_name;
+
+		//! Hash value for the name.
+		std::size_t m_hash;
+};
+
 namespace rt
 {
 
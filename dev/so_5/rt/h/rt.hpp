@@ -25,5 +25,6 @@
 
 #include <so_5/rt/stats/h/std_names.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/tuple_as_message.hpp>
@@ -16,6 +16,9 @@
 
 #include <so_5/h/compiler_features.hpp>
 
+#include <iterator>
+#include <vector>
+
 namespace so_5
 {
 
@@ -77,6 +80,36 @@ namespace impl
 							pause,
 							period );
 				}
+
+			/*!
+			 * \since
+			 * v.5.5.25
+			 */
+			template< typename... Args >
+			SO_5_NODISCARD static timer_id_t
+			send_periodic(
+				so_5::environment_t & env,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period,
+				timer_slack_t slack,
+				Args &&... args )
+				{
+					auto msg = so_5::details::make_message_instance< Message >(
+							std::forward< Args >( args )...);
+					ensure_message_with_actual_data( msg.get() );
+					change_message_mutability(
+							*msg,
+							message_payload_type< Message >::mutability() );
+
+					return env.schedule_timer( 
+							message_payload_type< Message >::subscription_type_index(),
+							message_ref_t( msg.release() ),
+							to,
+							pause,
+							period,
+							slack );
+				}
 		};
 
 	template< class Message >
@@ -112,6 +145,27 @@ namespace impl
 				{
 					return env.schedule_timer< actual_signal_type >( to, pause, period );
 				}
+
+			/*!
+			 * \since
+			 * v.5.5.25
+			 */
+			SO_5_NODISCARD static timer_id_t
+			send_periodic(
+				so_5::environment_t & env,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period,
+				timer_slack_t slack )
+				{
+					return env.schedule_timer(
+							message_payload_type< Message >::subscription_type_index(),
+							message_ref_t(),
+							to,
+							pause,
+							period,
+							slack );
+				}
 		};
 
 	template< class Message >
@@ -305,6 +359,84 @@ send( Target && to, mhood_t< Message > /*what*/ )
 						typename message_payload_type<Message>::subscription_type >();
 	}
 
+/*!
+ * \brief A utility function for creating and delivering a batch of
+ * messages of the same type.
+ *
+ * A new instance of \a Message is created for every item from
+ * the range [\a first, \a last). The item is passed to the constructor
+ * of \a Message. Then all instances are delivered by one call to
+ * abstract_message_box_t::deliver_messages(). It allows an mbox to
+ * search subscribers only once and to push all messages to the event
+ * queue of a subscriber by one operation.
+ *
+ * Message limits are controlled for every message from the batch
+ * as if messages are sent one by one.
+ *
+ * \note Signals can't be sent this way.
+ *
+ * \tparam Message type of message to be sent.
+ * \tparam Target identification of request processor (see so_5::send()).
+ * \tparam Input_It type of input iterator.
+ *
+ * \par Usage sample:
+ * \code
+	struct price_update { std::string m_ticker; double m_price; };
+
+	std::vector< price_update > updates = ...;
+	so_5::send_batch< price_update >( mbox, updates.begin(), updates.end() );
+ * \endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Message, typename Target, typename Input_It >
+void
+send_batch( Target && to, Input_It first, Input_It last )
+	{
+		std::vector< message_ref_t > messages;
+		for(; first != last; ++first )
+			{
+				auto msg = so_5::details::make_message_instance< Message >( *first );
+				change_message_mutability(
+						*msg,
+						message_payload_type< Message >::mutability() );
+
+				messages.emplace_back( msg.release() );
+			}
+
+		if( !messages.empty() )
+			send_functions_details::arg_to_mbox( std::forward<Target>(to) )->
+					deliver_messages(
+							message_payload_type< Message >::subscription_type_index(),
+							messages.data(),
+							messages.size() );
+	}
+
+/*!
+ * \brief A utility function for creating and delivering a batch of
+ * messages of the same type from a container.
+ *
+ * \par Usage sample:
+ * \code
+	std::vector< price_update > updates = ...;
+	so_5::send_batch< price_update >( mbox, updates );
+ * \endcode
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Message, typename Target, typename Container >
+void
+send_batch( Target && to, const Container & items )
+	{
+		using std::begin;
+		using std::end;
+
+		send_batch< Message >(
+				std::forward<Target>(to), begin( items ), end( items ) );
+	}
+
 /*!
  * \since
  * v.5.5.1
@@ -742,6 +874,94 @@ send_periodic(
 				std::forward< Args >(args)... );
 	}
 
+/*!
+ * \brief A utility function for creating and delivering a periodic message
+ * which can be coalesced with other periodic messages.
+ *
+ * The first delivery of the message can be postponed for no more than
+ * \a slack. It allows the timer thread to serve several periodic messages
+ * with the same period by one timer. It reduces the count of timers and
+ * wakeups of the timer thread if there are a lot of periodic messages.
+ *
+ * Usage example:
+ * \code
+	// Many periodic messages with the same period will be served by
+	// a few timers.
+	for( auto & a : agents )
+		timers.push_back( so_5::send_periodic< check_status >(
+				env, a->so_direct_mbox(),
+				std::chrono::seconds(1),
+				std::chrono::seconds(1),
+				so_5::timer_slack( std::chrono::milliseconds(50) ) ) );
+ * \endcode
+ *
+ * \note
+ * Slack is ignored if the timer mechanism of the environment doesn't
+ * support coalescing of timers.
+ *
+ * \attention
+ * Values of \a pause, \a period and \a slack should be non-negative.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Message, typename... Args >
+SO_5_NODISCARD timer_id_t
+send_periodic(
+	//! An environment to be used for timer.
+	so_5::environment_t & env,
+	//! Mbox for the message to be sent to.
+	const so_5::mbox_t & to,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Period of message repetitions.
+	std::chrono::steady_clock::duration period,
+	//! Allowed postponement of the first delivery.
+	timer_slack_t slack,
+	//! Message constructor parameters.
+	Args&&... args )
+	{
+		return so_5::impl::instantiator_and_sender< Message >::send_periodic(
+				env, to, pause, period, slack, std::forward< Args >( args )... );
+	}
+
+/*!
+ * \brief A utility function for creating and delivering a periodic message
+ * which can be coalesced with other periodic messages to the specified
+ * destination.
+ *
+ * Agent, ad-hoc agent or mchain can be used as \a target.
+ *
+ * \attention
+ * Values of \a pause, \a period and \a slack should be non-negative.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Message, typename Target, typename... Args >
+SO_5_NODISCARD timer_id_t
+send_periodic(
+	//! A destination for the periodic message.
+	Target && target,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Period of message repetitions.
+	std::chrono::steady_clock::duration period,
+	//! Allowed postponement of the first delivery.
+	timer_slack_t slack,
+	//! Message constructor parameters.
+	Args&&... args )
+	{
+		using namespace send_functions_details;
+		return send_periodic< Message >(
+				arg_to_env( target ),
+				arg_to_mbox( target ),
+				pause,
+				period,
+				slack,
+				std::forward< Args >(args)... );
+	}
+
 /*!
  * \brief A utility function for delivering a periodic
  * from an existing message hood.
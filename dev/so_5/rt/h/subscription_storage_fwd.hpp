@@ -194,6 +194,55 @@ adaptive_subscription_storage_factory(
 	//! A factory for creating large storage.
 	const subscription_storage_factory_t & large_storage_factory );
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Factory for subscription storage which is frozen after
+ * the start of the agent.
+ *
+ * \par Description
+ * All subscriptions are stored in a storage created by
+ * \a mutable_storage_factory. After the completion of
+ * agent_t::so_evt_start() subscriptions are compiled into an immutable
+ * open-addressing table. Event handlers are searched in that table
+ * while subscriptions aren't changed.
+ *
+ * A change of subscriptions after so_evt_start() drops the compiled
+ * table and the storage works as the mutable storage after that.
+ *
+ * This storage is intended for agents which make all their
+ * subscriptions in so_define_agent() or so_evt_start().
+ *
+ * \par Usage example:
+\code
+class my_agent : public so_5::agent_t
+{
+public :
+	my_agent( context_t ctx )
+		:	so_5::agent_t( ctx + so_5::frozen_subscription_storage_factory() )
+	{...}
+	...
+};
+\endcode
+ */
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory(
+	//! A factory for creating storage for all subscriptions.
+	const subscription_storage_factory_t & mutable_storage_factory );
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Factory for subscription storage which is frozen after
+ * the start of the agent.
+ *
+ * \note The default subscription storage is used as the mutable storage.
+ */
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory();
+
 namespace rt 
 {
 
@@ -18,6 +18,8 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <functional>
+#include <initializer_list>
 
 namespace so_5
 {
@@ -28,6 +30,68 @@ namespace impl
 namespace coop_repository_details
 {
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Special guard to acquire locks of several shards.
+ *
+ * Locks are acquired in the order of their addresses. It prevents
+ * deadlocks between threads which need locks of the same shards.
+ * The same lock can be specified several times. Null pointers
+ * are ignored.
+ *
+ * \tparam Max_Locks max count of different locks.
+ */
+template< std::size_t Max_Locks >
+class shards_lock_guard_t
+{
+	public :
+		shards_lock_guard_t( std::initializer_list< std::mutex * > locks )
+			:	shards_lock_guard_t( locks.begin(), locks.end() )
+		{}
+
+		template< typename It >
+		shards_lock_guard_t( It first, It last )
+		{
+			for(; first != last; ++first )
+				if( *first && end() == std::find( begin(), end(), *first ) )
+					m_locks[ m_count++ ] = *first;
+
+			// There are just a few items. A simple insertion sort is
+			// used instead of std::sort (the latter leads to false
+			// -Warray-bounds warnings with some compilers).
+			for( auto i = begin() + 1; i < end(); ++i )
+				for( auto j = i;
+						j != begin() && std::less< std::mutex * >{}( *j, *(j - 1) );
+						--j )
+					std::swap( *j, *(j - 1) );
+
+			for( auto l = begin(); l != end(); ++l )
+				(*l)->lock();
+		}
+
+		~shards_lock_guard_t()
+		{
+			for( auto l = end(); l != begin(); )
+				(*(--l))->unlock();
+		}
+
+		shards_lock_guard_t( const shards_lock_guard_t & ) = delete;
+		shards_lock_guard_t &
+		operator=( const shards_lock_guard_t & ) = delete;
+
+	private :
+		std::array< std::mutex *, Max_Locks > m_locks;
+		std::size_t m_count = 0u;
+
+		std::mutex **
+		begin() { return m_locks.data(); }
+
+		std::mutex **
+		end() { return m_locks.data() + m_count; }
+};
+
 /*!
  * \since
  * v.5.2.3
@@ -39,6 +103,12 @@ namespace coop_repository_details
  * in version 5.2.3. And since that version deregistration of cooperation
  * is more complex process then in previous versions.
  *
+ * \note
+ * Since v.5.5.25 there is no global lock for the whole deregistration.
+ * Cooperations are marked as deregistering one by one under the locks
+ * of their shards. A cooperation which is already marked (for example by
+ * a parallel deregistration of another part of the tree) is skipped.
+ *
  * \attention On some stages of deregistration an exception leads to
  * call to abort().
  */
@@ -49,8 +119,8 @@ public :
 	deregistration_processor_t(
 		//! Owner of all data.
 		coop_repository_basis_t & core,
-		//! Name of root cooperation to be deregistered.
-		const std::string & root_coop_name,
+		//! Id of root cooperation to be deregistered.
+		coop_id_t root_coop_id,
 		//! Deregistration reason.
 		coop_dereg_reason_t dereg_reason );
 
@@ -62,8 +132,8 @@ private :
 	//! Owner of all data to be handled.
 	coop_repository_basis_t & m_core;
 
-	//! Name of root cooperation to be deregistered.
-	const std::string & m_root_coop_name;
+	//! Id of root cooperation to be deregistered.
+	const coop_id_t m_root_coop_id;
 
 	//! Deregistration reason.
 	/*!
@@ -74,8 +144,12 @@ private :
 	//! Cooperations to be deregistered.
 	std::vector< coop_ref_t > m_coops_to_dereg;
 
-	//! Names of cooperations to be deregistered.
-	std::vector< std::string > m_coops_names_to_process;
+	//! Ids of children of a cooperation.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	std::vector< coop_id_t > m_children_ids;
 
 	void
 	first_stage();
@@ -87,17 +161,17 @@ private :
 	second_stage();
 
 	coop_ref_t
-	ensure_root_coop_exists() const;
+	ensure_root_coop_exists_and_mark_it();
 
 	void
-	collect_and_modity_coop_info(
-		const coop_ref_t & root_coop );
+	collect_and_modity_coop_info();
 
 	void
-	collect_coops();
+	collect_children_ids( const coop_t & parent );
 
 	void
-	modify_registered_and_deregistered_maps();
+	mark_child_if_necessary(
+		coop_id_t child_id );
 
 	void
 	initiate_abort_on_exception(
@@ -106,10 +180,10 @@ private :
 
 deregistration_processor_t::deregistration_processor_t(
 	coop_repository_basis_t & core,
-	const std::string & root_coop_name,
+	coop_id_t root_coop_id,
 	coop_dereg_reason_t dereg_reason )
 	:	m_core( core )
-	,	m_root_coop_name( root_coop_name )
+	,	m_root_coop_id( root_coop_id )
 	,	m_root_coop_dereg_reason( std::move( dereg_reason ) )
 {}
 
@@ -125,14 +199,12 @@ deregistration_processor_t::process()
 void
 deregistration_processor_t::first_stage()
 {
-	std::lock_guard< std::mutex > lock( m_core.lock() );
+	coop_ref_t coop = ensure_root_coop_exists_and_mark_it();
 
-	if( m_core.m_deregistered_coop.end() ==
-			m_core.m_deregistered_coop.find( m_root_coop_name ) )
+	if( coop )
 	{
-		coop_ref_t coop = ensure_root_coop_exists();
-
-		collect_and_modity_coop_info( coop );
+		m_coops_to_dereg.push_back( std::move( coop ) );
+		collect_and_modity_coop_info();
 	}
 }
 
@@ -171,35 +243,49 @@ deregistration_processor_t::second_stage()
 }
 
 coop_ref_t
-deregistration_processor_t::ensure_root_coop_exists() const
+deregistration_processor_t::ensure_root_coop_exists_and_mark_it()
 {
-	// It is an error if the cooperation is not registered.
-	auto it = m_core.m_registered_coop.find( m_root_coop_name );
+	auto & shard = m_core.shard_for( m_root_coop_id );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
-	if( m_core.m_registered_coop.end() == it )
+	// It is an error if the cooperation is not registered.
+	auto it = shard.m_coops.find( m_root_coop_id );
+	if( shard.m_coops.end() == it )
 	{
 		SO_5_THROW_EXCEPTION(
 			rc_coop_has_not_found_among_registered_coop,
-			"coop with name '" + m_root_coop_name +
-			"' not found among registered cooperations" );
+			"coop with id " + std::to_string( m_root_coop_id ) +
+			" not found among registered cooperations" );
 	}
 
-	return it->second;
+	// Nothing to do if the cooperation is already being deregistered.
+	if( it->second.m_deregistering )
+		return coop_ref_t();
+
+	it->second.m_deregistering = true;
+	++m_core.m_deregistered_coop_count;
+	--m_core.m_registered_coop_count;
+
+	return it->second.m_coop;
 }
 
 void
-deregistration_processor_t::collect_and_modity_coop_info(
-	const coop_ref_t & root_coop )
+deregistration_processor_t::collect_and_modity_coop_info()
 {
 	// Exceptions must lead to abort at this deregistration stage.
 	try
 	{
-		m_coops_to_dereg.push_back( root_coop );
-		m_coops_names_to_process.push_back( m_root_coop_name );
+		// Vector can grow during the loop.
+		for( std::size_t i = 0; i != m_coops_to_dereg.size(); ++i )
+		{
+			// Copy of the ref is necessary because vector can be reallocated.
+			const coop_ref_t parent = m_coops_to_dereg[ i ];
 
-		collect_coops();
+			collect_children_ids( *parent );
 
-		modify_registered_and_deregistered_maps();
+			for( const auto id : m_children_ids )
+				mark_child_if_necessary( id );
+		}
 	}
 	catch( const std::exception & x )
 	{
@@ -208,56 +294,48 @@ deregistration_processor_t::collect_and_modity_coop_info(
 }
 
 void
-deregistration_processor_t::collect_coops()
+deregistration_processor_t::collect_children_ids(
+	const coop_t & parent )
 {
-	for( size_t i = 0; i != m_coops_names_to_process.size(); ++i )
-	{
-		const coop_repository_basis_t::parent_child_coop_names_t relation(
-				m_coops_names_to_process[ i ], std::string() );
+	m_children_ids.clear();
 
-		for( auto f = m_core.m_parent_child_relations.lower_bound( relation );
-				f != m_core.m_parent_child_relations.end() &&
-						f->first == m_coops_names_to_process[ i ];
-				++f )
-		{
-			auto it = m_core.m_registered_coop.find( f->second );
-			if( it != m_core.m_registered_coop.end() )
-			{
-				m_coops_to_dereg.push_back( it->second );
-				m_coops_names_to_process.push_back( it->first );
-			}
-			else
-			{
-				// Child cooperation is not found in list of
-				// registered cooperation.
-				// It is not an error if the child cooperation is
-				// in deregistration procedure right now.
-				auto it_dereg = m_core.m_deregistered_coop.find( f->second );
-				if( it_dereg == m_core.m_deregistered_coop.end() )
-				{
-					// This is an error: cooperation is not registered
-					// and is not in deregistration phase.
-					SO_5_THROW_EXCEPTION(
-							rc_unexpected_error,
-							f->second + ": cooperation not registered, but "
-								"declared as child for: '" + f->first + "'" );
-				}
-			}
-		}
-	}
+	// The list of children is protected by the lock of parent's shard.
+	// Parent is already marked as deregistering, so new children can't
+	// be added to that list.
+	auto & shard = m_core.shard_for( parent.query_coop_id() );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
+
+	coop_private_iface_t::for_each_child( parent,
+			[this]( const coop_t & child ) {
+				m_children_ids.push_back( child.query_coop_id() );
+			} );
 }
 
 void
-deregistration_processor_t::modify_registered_and_deregistered_maps()
-{
-	std::for_each(
-			m_coops_names_to_process.begin(),
-			m_coops_names_to_process.end(),
-			[this]( const std::string & n ) {
-				auto it = m_core.m_registered_coop.find( n );
-				m_core.m_deregistered_coop.insert( *it );
-				m_core.m_registered_coop.erase( it );
-			} );
+deregistration_processor_t::mark_child_if_necessary(
+	coop_id_t child_id )
+{
+	auto & shard = m_core.shard_for( child_id );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
+
+	auto it = shard.m_coops.find( child_id );
+
+	// Child cooperation could be already deregistered completely
+	// after the list of children has been collected. It is not an error.
+	// Ids are not reused so there can't be another coop with the same id.
+	if( shard.m_coops.end() == it )
+		return;
+
+	// It is not an error if the child cooperation is
+	// in deregistration procedure right now.
+	if( !it->second.m_deregistering )
+	{
+		it->second.m_deregistering = true;
+		++m_core.m_deregistered_coop_count;
+		--m_core.m_registered_coop_count;
+
+		m_coops_to_dereg.push_back( it->second.m_coop );
+	}
 }
 
 void
@@ -269,12 +347,393 @@ deregistration_processor_t::initiate_abort_on_exception(
 		{
 			log_stream << "Exception during cooperation deregistration. "
 					"Work cannot be continued. Cooperation: '"
-					<< m_root_coop_name << "'. Exception: '"
+					<< m_coops_to_dereg.front()->query_coop_name()
+					<< "'. Exception: '"
 					<< x.what() << "'";
 		}
 	} );
 }
 
+namespace
+{
+
+	/*!
+	 * \since
+	 * v.5.5.25
+	 *
+	 * \brief Extract the id from the name of an anonymous coop.
+	 *
+	 * \return null_coop_id() if \a name is not a name of
+	 * an anonymous coop.
+	 *
+	 * \note
+	 * The format of name is defined by coop_t::query_coop_name().
+	 */
+	coop_id_t
+	anonymous_coop_id_from_name( const std::string & name )
+	{
+		static const std::string prefix = "__so5_autoname_";
+		static const std::string suffix = "__";
+		// Longer values can't be stored in coop_id_t.
+		const std::size_t max_digits = 19u;
+
+		if( name.size() <= prefix.size() + suffix.size() ||
+				name.size() > prefix.size() + suffix.size() + max_digits ||
+				0 != name.compare( 0, prefix.size(), prefix ) ||
+				0 != name.compare( name.size() - suffix.size(),
+						suffix.size(), suffix ) )
+			return null_coop_id();
+
+		coop_id_t id = null_coop_id();
+		for( auto i = prefix.size(); i != name.size() - suffix.size(); ++i )
+		{
+			const char c = name[ i ];
+			if( c < '0' || c > '9' )
+				return null_coop_id();
+
+			id = id * 10u + static_cast< coop_id_t >( c - '0' );
+		}
+
+		return id;
+	}
+
+} /* namespace anonymous */
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Helper class for doing all actions related to
+ * registration of several cooperations at once.
+ *
+ * Registration is performed by the following steps:
+ * - names of cooperations are checked for uniqueness inside the batch.
+ *   Ids of parents specified by names are found. There is no locks
+ *   of shards on that step;
+ * - locks of all necessary shards are acquired at once;
+ * - cooperations are checked against the cooperation index;
+ * - cooperations are stored in the index and prepared for registration
+ *   one by one. Agents are defined and resources in dispatchers are
+ *   allocated on that step;
+ * - agents of all cooperations are activated.
+ *
+ * An exception on any step before the activation leads to rollback
+ * of all the actions already taken. So no one cooperation is registered
+ * in that case.
+ */
+class bulk_registration_processor_t
+{
+public :
+	//! Constructor.
+	bulk_registration_processor_t(
+		//! Owner of all data.
+		coop_repository_basis_t & core,
+		//! Cooperations to be registered.
+		const std::vector< coop_ref_t > & coops );
+
+	//! Do all necessary actions.
+	void
+	process();
+
+private :
+	using shard_t = coop_repository_basis_t::shard_t;
+
+	//! Information about a cooperation to be registered.
+	struct item_t
+	{
+		//! Shard for the cooperation.
+		shard_t * m_shard = nullptr;
+		//! Shard for the name of the cooperation.
+		//! Null for an anonymous cooperation.
+		shard_t * m_name_shard = nullptr;
+		//! Shard for an anonymous cooperation with the same name.
+		//! Null if the name can't be a name of anonymous cooperation.
+		shard_t * m_anonymous_shard = nullptr;
+		//! Shard for the parent cooperation.
+		//! Null if there is no parent.
+		shard_t * m_parent_shard = nullptr;
+		//! Id of the parent cooperation.
+		coop_id_t m_parent_id = null_coop_id();
+		//! Is the parent registered by the same batch?
+		bool m_parent_in_batch = false;
+		//! Pointer to the parent cooperation.
+		coop_t * m_parent = nullptr;
+		//! Activators of agents bindings.
+		coop_private_iface_t::disp_binding_activators_t m_activators;
+	};
+
+	//! Owner of all data to be handled.
+	coop_repository_basis_t & m_core;
+
+	//! Cooperations to be registered.
+	const std::vector< coop_ref_t > & m_coops;
+
+	//! Information about every cooperation.
+	std::vector< item_t > m_items;
+
+	//! Count of cooperations stored in the cooperation index.
+	std::size_t m_stored = 0u;
+
+	//! Count of cooperations prepared for registration.
+	std::size_t m_prepared = 0u;
+
+	void
+	check_batch_and_find_parents();
+
+	std::vector< std::mutex * >
+	collect_locks() const;
+
+	void
+	check_against_index();
+
+	void
+	store_and_prepare();
+
+	void
+	store( std::size_t index );
+
+	void
+	rollback();
+
+	void
+	remove( std::size_t index );
+
+	void
+	complete();
+};
+
+bulk_registration_processor_t::bulk_registration_processor_t(
+	coop_repository_basis_t & core,
+	const std::vector< coop_ref_t > & coops )
+	:	m_core( core )
+	,	m_coops( coops )
+	,	m_items( coops.size() )
+{}
+
+void
+bulk_registration_processor_t::process()
+{
+	check_batch_and_find_parents();
+
+	const auto locks = collect_locks();
+	shards_lock_guard_t< coop_repository_basis_t::shard_count > lock{
+			locks.begin(), locks.end() };
+
+	check_against_index();
+	store_and_prepare();
+	complete();
+}
+
+void
+bulk_registration_processor_t::check_batch_and_find_parents()
+{
+	// Only preceding cooperations can be found in these maps.
+	std::unordered_map< std::string, std::size_t > names;
+	std::unordered_map< coop_id_t, std::size_t > ids;
+
+	for( std::size_t i = 0; i != m_coops.size(); ++i )
+	{
+		const coop_t & coop = *m_coops[ i ];
+		auto & item = m_items[ i ];
+
+		item.m_shard = &m_core.shard_for( coop.query_coop_id() );
+
+		if( !coop.is_anonymous() )
+		{
+			if( !names.emplace( coop.query_coop_name(), i ).second )
+				SO_5_THROW_EXCEPTION(
+					rc_coop_with_specified_name_is_already_registered,
+					"coop with name \"" + coop.query_coop_name() +
+					"\" is present several times" );
+
+			item.m_name_shard = &m_core.shard_for_name( coop.query_coop_name() );
+			item.m_anonymous_shard =
+					m_core.shard_for_anonymous_name( coop.query_coop_name() );
+		}
+
+		if( coop.has_parent_coop() )
+		{
+			item.m_parent_id = coop.parent_coop_id();
+			if( null_coop_id() == item.m_parent_id )
+			{
+				const auto & parent_name = coop.parent_coop_name();
+				auto it = names.find( parent_name );
+				if( names.end() != it )
+					item.m_parent_id = m_coops[ it->second ]->query_coop_id();
+				else
+				{
+					item.m_parent_id = m_core.find_coop_id( parent_name );
+					if( null_coop_id() == item.m_parent_id )
+						SO_5_THROW_EXCEPTION(
+							rc_parent_coop_not_found,
+							"parent coop with name \"" + parent_name +
+							"\" is not registered" );
+				}
+			}
+
+			auto it = ids.find( item.m_parent_id );
+			if( ids.end() != it )
+			{
+				item.m_parent_in_batch = true;
+				item.m_parent = m_coops[ it->second ].get();
+			}
+			else
+				item.m_parent_shard = &m_core.shard_for( item.m_parent_id );
+		}
+
+		ids.emplace( coop.query_coop_id(), i );
+	}
+
+	// A named cooperation can't take the name of an anonymous
+	// cooperation from the same batch.
+	for( std::size_t i = 0; i != m_coops.size(); ++i )
+		if( m_items[ i ].m_anonymous_shard )
+		{
+			const auto & name = m_coops[ i ]->query_coop_name();
+			auto it = ids.find( anonymous_coop_id_from_name( name ) );
+			if( ids.end() != it && m_coops[ it->second ]->is_anonymous() )
+				SO_5_THROW_EXCEPTION(
+					rc_coop_with_specified_name_is_already_registered,
+					"coop with name \"" + name +
+					"\" is present several times" );
+		}
+}
+
+std::vector< std::mutex * >
+bulk_registration_processor_t::collect_locks() const
+{
+	std::vector< std::mutex * > locks;
+	locks.reserve( m_items.size() * 4u );
+
+	auto add = [&locks]( shard_t * shard ) {
+			if( shard )
+				locks.push_back( &shard->m_lock );
+		};
+
+	for( const auto & item : m_items )
+	{
+		add( item.m_shard );
+		add( item.m_name_shard );
+		add( item.m_anonymous_shard );
+		add( item.m_parent_shard );
+	}
+
+	return locks;
+}
+
+void
+bulk_registration_processor_t::check_against_index()
+{
+	if( !m_coops.empty() )
+		m_core.ensure_registration_allowed( *m_coops.front() );
+
+	for( std::size_t i = 0; i != m_coops.size(); ++i )
+	{
+		const coop_t & coop = *m_coops[ i ];
+		auto & item = m_items[ i ];
+
+		if( item.m_name_shard )
+			m_core.ensure_new_coop_name_unique(
+					*item.m_name_shard,
+					item.m_anonymous_shard,
+					coop.query_coop_name() );
+
+		if( !item.m_parent_in_batch )
+			item.m_parent = m_core.find_parent_coop_if_necessary(
+					item.m_parent_shard, item.m_parent_id, coop );
+	}
+}
+
+void
+bulk_registration_processor_t::store_and_prepare()
+{
+	so_5::details::do_with_rollback_on_exception(
+		[this] {
+			for( std::size_t i = 0; i != m_coops.size(); ++i )
+			{
+				store( i );
+				++m_stored;
+
+				m_items[ i ].m_activators =
+						coop_private_iface_t::prepare_registration( *m_coops[ i ] );
+				++m_prepared;
+			}
+		},
+		[this] { rollback(); } );
+}
+
+void
+bulk_registration_processor_t::store( std::size_t index )
+{
+	const auto & coop = m_coops[ index ];
+	auto & item = m_items[ index ];
+
+	item.m_shard->m_coops.emplace( coop->query_coop_id(),
+			coop_repository_basis_t::coop_info_t{ coop, false } );
+
+	// All changes must be reverted if name or parent-child relation
+	// can't be stored.
+	so_5::details::do_with_rollback_on_exception(
+		[&] {
+			if( item.m_name_shard )
+				item.m_name_shard->m_names.emplace(
+						coop->query_coop_name(),
+						coop->query_coop_id() );
+			if( item.m_parent )
+				coop_private_iface_t::add_child( *item.m_parent, *coop );
+		},
+		[&] {
+			if( item.m_name_shard )
+				item.m_name_shard->m_names.erase( coop->query_coop_name() );
+			item.m_shard->m_coops.erase( coop->query_coop_id() );
+		} );
+
+	++m_core.m_registered_coop_count;
+	m_core.m_total_agent_count += coop->query_agent_count();
+}
+
+void
+bulk_registration_processor_t::rollback()
+{
+	// Children must be removed before their parents.
+	for( auto i = m_stored; i != 0; --i )
+	{
+		if( i <= m_prepared )
+			coop_private_iface_t::cancel_registration( *m_coops[ i - 1 ] );
+
+		remove( i - 1 );
+	}
+}
+
+void
+bulk_registration_processor_t::remove( std::size_t index )
+{
+	const auto & coop = m_coops[ index ];
+	auto & item = m_items[ index ];
+
+	m_core.m_total_agent_count -= coop->query_agent_count();
+	--m_core.m_registered_coop_count;
+
+	if( item.m_parent )
+		coop_private_iface_t::remove_child( *item.m_parent, *coop );
+
+	if( item.m_name_shard )
+		item.m_name_shard->m_names.erase( coop->query_coop_name() );
+
+	item.m_shard->m_coops.erase( coop->query_coop_id() );
+}
+
+void
+bulk_registration_processor_t::complete()
+{
+	// Parents are activated before their children.
+	for( std::size_t i = 0; i != m_coops.size(); ++i )
+		coop_private_iface_t::complete_registration(
+				*m_coops[ i ],
+				m_items[ i ].m_parent,
+				m_items[ i ].m_activators );
+}
+
 } /* namespace agent_core_details */
 
 coop_repository_basis_t::coop_repository_basis_t(
@@ -282,7 +741,9 @@ coop_repository_basis_t::coop_repository_basis_t(
 	coop_listener_unique_ptr_t coop_listener )
 	:	m_so_environment( so_environment )
 	,	m_deregistration_started( false )
-	,	m_total_agent_count{ 0 }
+	,	m_registered_coop_count{ 0u }
+	,	m_deregistered_coop_count{ 0u }
+	,	m_total_agent_count{ 0u }
 	,	m_coop_listener( std::move( coop_listener ) )
 {
 }
@@ -313,6 +774,7 @@ namespace
 			coop_t & m_coop;
 	};
 
+
 } /* namespace anonymous */
 
 void
@@ -338,22 +800,58 @@ coop_repository_basis_t::register_coop(
 
 	try
 	{
-		// All the following actions should be taken under the lock.
-		std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+		// Parent can be specified by name. Its id must be found.
+		coop_id_t parent_id = null_coop_id();
+		if( coop_ref->has_parent_coop() )
+		{
+			parent_id = coop_ref->parent_coop_id();
+			if( null_coop_id() == parent_id )
+			{
+				parent_id = find_coop_id( coop_ref->parent_coop_name() );
+				if( null_coop_id() == parent_id )
+					SO_5_THROW_EXCEPTION(
+						rc_parent_coop_not_found,
+						"parent coop with name \"" +
+							coop_ref->parent_coop_name() +
+							"\" is not registered" );
+			}
+		}
 
-		if( m_deregistration_started )
-			SO_5_THROW_EXCEPTION(
-					rc_unable_to_register_coop_during_shutdown,
-					coop_ref->query_coop_name() +
-					": a new cooperation cannot be started during "
-					"environment shutdown" );
+		auto & shard = shard_for( coop_ref->query_coop_id() );
+		shard_t * parent_shard = null_coop_id() != parent_id ?
+				&shard_for( parent_id ) : nullptr;
+		// Anonymous coop doesn't go to the index of names.
+		shard_t * name_shard = coop_ref->is_anonymous() ?
+				nullptr : &shard_for_name( coop_ref->query_coop_name() );
+		// The name of a named coop can have the format of names of
+		// anonymous coops. Such name must not conflict with a live
+		// anonymous coop.
+		shard_t * anonymous_shard = name_shard ?
+				shard_for_anonymous_name( coop_ref->query_coop_name() ) :
+				nullptr;
+
+		// All the following actions should be taken under the locks
+		// of the shard of the coop, the shard of the parent coop and
+		// the shards for the coop's name.
+		coop_repository_details::shards_lock_guard_t< 4 > lock{
+				&shard.m_lock,
+				parent_shard ? &parent_shard->m_lock : nullptr,
+				name_shard ? &name_shard->m_lock : nullptr,
+				anonymous_shard ? &anonymous_shard->m_lock : nullptr };
+
+		ensure_registration_allowed( *coop_ref );
 
 		// Name should be unique.
-		ensure_new_coop_name_unique( coop_ref->query_coop_name() );
+		if( name_shard )
+			ensure_new_coop_name_unique(
+					*name_shard, anonymous_shard, coop_ref->query_coop_name() );
 		// Process parent coop.
-		coop_t * parent = find_parent_coop_if_necessary( *coop_ref );
+		coop_t * parent = find_parent_coop_if_necessary(
+				parent_shard, parent_id, *coop_ref );
 
 		next_coop_reg_step__update_registered_coop_map(
+				shard,
+				name_shard,
 				coop_ref,
 				parent );
 	}
@@ -375,18 +873,111 @@ coop_repository_basis_t::register_coop(
 	}
 
 	do_coop_reg_notification_if_necessary(
-		coop_ref->query_coop_name(),
+		*coop_ref,
 		coop_private_iface_t::reg_notificators( *coop_ref ) );
 }
 
+namespace
+{
+	/*!
+	 * \since
+	 * v.5.5.25
+	 *
+	 * \brief Special guard to increment and decrement usage counters
+	 * of several cooperations.
+	 */
+	class coops_usage_counter_guard_t
+	{
+		public :
+			coops_usage_counter_guard_t(
+				const std::vector< coop_ref_t > & coops )
+				:	m_coops( coops )
+			{
+				for( auto & c : m_coops )
+					coop_t::increment_usage_count( *c );
+			}
+			~coops_usage_counter_guard_t()
+			{
+				for( auto & c : m_coops )
+					coop_t::decrement_usage_count( *c );
+			}
+
+		private :
+			const std::vector< coop_ref_t > & m_coops;
+	};
+
+} /* namespace anonymous */
+
+void
+coop_repository_basis_t::register_coops(
+	std::vector< coop_unique_ptr_t > coops )
+{
+	for( const auto & c : coops )
+		if( nullptr == c.get() )
+			SO_5_THROW_EXCEPTION(
+				rc_zero_ptr_to_coop,
+				"zero ptr to coop passed" );
+
+	// Cooperation objects should life to the end of this routine.
+	std::vector< coop_ref_t > coop_refs;
+	coop_refs.reserve( coops.size() );
+	for( auto & c : coops )
+		coop_refs.emplace_back( c.release(), coop_deleter_t() );
+
+	// Usage counters for cooperations should be incremented right now,
+	// and decremented at exit point.
+	coops_usage_counter_guard_t coops_usage_guard( coop_refs );
+
+	try
+	{
+		coop_repository_details::bulk_registration_processor_t processor(
+				*this, coop_refs );
+
+		processor.process();
+	}
+	catch( const exception_t & )
+	{
+		throw;
+	}
+	catch( const std::exception & ex )
+	{
+		SO_5_THROW_EXCEPTION(
+			rc_coop_define_agent_failed,
+			ex.what() );
+	}
+	catch( ... )
+	{
+		SO_5_THROW_EXCEPTION(
+			rc_coop_define_agent_failed,
+			"unknown exception is caught" );
+	}
+
+	do_coops_reg_notification_if_necessary( coop_refs );
+}
+
 void
 coop_repository_basis_t::deregister_coop(
 	nonempty_name_t name,
 	coop_dereg_reason_t dereg_reason )
+{
+	const coop_id_t id = find_coop_id( name.query_name() );
+	if( null_coop_id() == id )
+		SO_5_THROW_EXCEPTION(
+			rc_coop_has_not_found_among_registered_coop,
+			"coop with name '" + name.query_name() +
+			"' not found among registered cooperations" );
+
+	deregister_coop( id, std::move( dereg_reason ) );
+}
+
+void
+coop_repository_basis_t::deregister_coop(
+	coop_id_t id,
+	coop_dereg_reason_t dereg_reason )
 {
 	coop_repository_details::deregistration_processor_t processor(
 			*this,
-			name.query_name(),
+			id,
 			std::move( dereg_reason ) );
 
 	processor.process();
@@ -394,32 +985,47 @@ coop_repository_basis_t::deregister_coop(
 
 coop_repository_basis_t::final_deregistration_resul_t
 coop_repository_basis_t::final_deregister_coop(
-	std::string coop_name )
+	coop_id_t coop_id )
 {
-	final_remove_result_t remove_result;
+	final_remove_result_t remove_result =
+			finaly_remove_cooperation_info( coop_id );
 
-	bool has_live_coops = false;
-	bool need_signal_dereg_finished = false;
-	{
-		std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+	const bool has_live_coops = has_live_coop();
 
-		remove_result = finaly_remove_cooperation_info( coop_name );
+	// If we are inside shutdown process and this is the last
+	// cooperation then a special flag should be set.
+	const bool need_signal_dereg_finished =
+			!has_live_coops &&
+			m_deregistration_started.load( std::memory_order_acquire );
 
-		// If we are inside shutdown process and this is the last
-		// cooperation then a special flag should be set.
-		need_signal_dereg_finished =
-			m_deregistration_started && m_deregistered_coop.empty();
-
-		has_live_coops = !m_registered_coop.empty() ||
-				!m_deregistered_coop.empty();
+	if( need_signal_dereg_finished )
+	{
+		// Someone could wait for the end of deregistration on
+		// a condition variable. The lock must be acquired to
+		// prevent the lost of the notification.
+		std::lock_guard< std::mutex > lock( m_deregistration_state_lock );
 	}
 
+	// The name of an anonymous coop is created only if it is necessary.
+	// It must be done before destruction of the coop.
+	const bool need_notification = remove_result.m_coop &&
+			is_coop_dereg_notification_necessary(
+					remove_result.m_notifications );
+	const std::string coop_name = need_notification ?
+			remove_result.m_coop->query_coop_name() : std::string();
+
 	// Cooperation must be destroyed.
 	remove_result.m_coop.reset();
 
-	do_coop_dereg_notification_if_necessary(
-			coop_name,
-			remove_result.m_notifications );
+	if( need_notification )
+		do_coop_dereg_notification_if_necessary(
+				coop_name,
+				remove_result.m_notifications );
+
+	// Parent can be finally deregistered only after complete
+	// destruction of the child.
+	if( remove_result.m_parent )
+		coop_t::decrement_usage_count( *remove_result.m_parent );
 
 	return { has_live_coops, need_signal_dereg_finished };
 }
@@ -429,21 +1035,37 @@ coop_repository_basis_t::deregister_all_coop() SO_5_NOEXCEPT
 {
 	// Because VC++ 12.0 doesn't support noexcept we use invoke_noexcept_code.
 	return so_5::details::invoke_noexcept_code( [this] {
-		std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+		{
+			std::lock_guard< std::mutex > lock( m_deregistration_state_lock );
+			// New coops can't be registered since this point.
+			m_deregistration_started.store( true, std::memory_order_release );
+		}
 
-		for( auto & info : m_registered_coop )
-			coop_private_iface_t::do_deregistration_specific_actions(
-					*(info.second),
-					coop_dereg_reason_t( dereg_reason::shutdown ) );
-				
-		m_deregistered_coop.insert(
-			m_registered_coop.begin(),
-			m_registered_coop.end() );
+		std::vector< coop_ref_t > coops;
+		for( auto & shard : m_shards )
+		{
+			coops.clear();
+			{
+				std::lock_guard< std::mutex > lock( shard.m_lock );
+
+				for( auto & info : shard.m_coops )
+					if( !info.second.m_deregistering )
+					{
+						info.second.m_deregistering = true;
+						++m_deregistered_coop_count;
+						--m_registered_coop_count;
+
+						coops.push_back( info.second.m_coop );
+					}
+			}
 
-		m_registered_coop.clear();
-		m_deregistration_started = true;
+			for( auto & coop : coops )
+				coop_private_iface_t::do_deregistration_specific_actions(
+						*coop,
+						coop_dereg_reason_t( dereg_reason::shutdown ) );
+		}
 
-		return m_deregistered_coop.size();
+		return m_deregistered_coop_count.load( std::memory_order_acquire );
 	} );
 }
 
@@ -453,11 +1075,11 @@ coop_repository_basis_t::initiate_deregistration()
 	initiate_deregistration_result_t result =
 			initiate_deregistration_result_t::already_in_progress;
 	{
-		std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+		std::lock_guard< std::mutex > lock( m_deregistration_state_lock );
 
-		if( !m_deregistration_started )
+		if( !m_deregistration_started.load( std::memory_order_acquire ) )
 		{
-			m_deregistration_started = true;
+			m_deregistration_started.store( true, std::memory_order_release );
 			result = initiate_deregistration_result_t::initiated_first_time;
 		}
 	}
@@ -474,22 +1096,99 @@ coop_repository_basis_t::environment()
 environment_infrastructure_t::coop_repository_stats_t
 coop_repository_basis_t::query_stats()
 {
-	std::unique_lock< std::mutex > lock( m_coop_operations_lock );
-
 	return {
-			m_registered_coop.size(),
-			m_deregistered_coop.size(),
-			m_total_agent_count,
+			m_registered_coop_count.load( std::memory_order_acquire ),
+			m_deregistered_coop_count.load( std::memory_order_acquire ),
+			m_total_agent_count.load( std::memory_order_acquire ),
 			0u
 		};
 }
 
+coop_repository_basis_t::shard_t &
+coop_repository_basis_t::shard_for( coop_id_t coop_id )
+{
+	return m_shards[ coop_id % shard_count ];
+}
+
+coop_repository_basis_t::shard_t &
+coop_repository_basis_t::shard_for_name( const std::string & coop_name )
+{
+	return m_shards[ std::hash< std::string >{}( coop_name ) % shard_count ];
+}
+
+coop_repository_basis_t::shard_t *
+coop_repository_basis_t::shard_for_anonymous_name(
+	const std::string & coop_name )
+{
+	const coop_id_t id =
+			coop_repository_details::anonymous_coop_id_from_name( coop_name );
+	return null_coop_id() != id ? &shard_for( id ) : nullptr;
+}
+
+coop_id_t
+coop_repository_basis_t::find_coop_id( const std::string & coop_name )
+{
+	{
+		auto & name_shard = shard_for_name( coop_name );
+		std::lock_guard< std::mutex > lock( name_shard.m_lock );
+
+		auto it = name_shard.m_names.find( coop_name );
+		if( name_shard.m_names.end() != it )
+			return it->second;
+	}
+
+	// It can be a name of an anonymous coop.
+	// But only if there is an anonymous coop with that id.
+	const coop_id_t id =
+			coop_repository_details::anonymous_coop_id_from_name( coop_name );
+	if( null_coop_id() != id )
+	{
+		auto & shard = shard_for( id );
+		std::lock_guard< std::mutex > lock( shard.m_lock );
+
+		auto it = shard.m_coops.find( id );
+		if( shard.m_coops.end() != it && it->second.m_coop->is_anonymous() )
+			return id;
+	}
+
+	return null_coop_id();
+}
+
+void
+coop_repository_basis_t::ensure_registration_allowed(
+	const coop_t & coop ) const
+{
+	// This flag is set before deregister_all_coop() acquires
+	// locks of shards. So a coop can't be added to the shard
+	// which is already processed by deregister_all_coop().
+	if( m_deregistration_started.load( std::memory_order_acquire ) )
+		SO_5_THROW_EXCEPTION(
+				rc_unable_to_register_coop_during_shutdown,
+				coop.query_coop_name() +
+				": a new cooperation cannot be started during "
+				"environment shutdown" );
+}
+
 void
 coop_repository_basis_t::ensure_new_coop_name_unique(
+	const shard_t & name_shard,
+	const shard_t * anonymous_shard,
 	const std::string & coop_name ) const
 {
-	if( m_registered_coop.end() != m_registered_coop.find( coop_name ) ||
-		m_deregistered_coop.end() != m_deregistered_coop.find( coop_name ) )
+	bool already_registered =
+			name_shard.m_names.end() != name_shard.m_names.find( coop_name );
+
+	// Such name could be a name of a live anonymous coop.
+	if( !already_registered && anonymous_shard )
+	{
+		auto it = anonymous_shard->m_coops.find(
+				coop_repository_details::anonymous_coop_id_from_name(
+						coop_name ) );
+		already_registered = anonymous_shard->m_coops.end() != it &&
+				it->second.m_coop->is_anonymous();
+	}
+
+	if( already_registered )
 	{
 		SO_5_THROW_EXCEPTION(
 			rc_coop_with_specified_name_is_already_registered,
@@ -499,22 +1198,26 @@ coop_repository_basis_t::ensure_new_coop_name_unique(
 
 coop_t *
 coop_repository_basis_t::find_parent_coop_if_necessary(
+	const shard_t * parent_shard,
+	coop_id_t parent_coop_id,
 	const coop_t & coop_to_be_registered ) const
 {
-	if( coop_to_be_registered.has_parent_coop() )
+	if( parent_shard )
 	{
-		auto it = m_registered_coop.find(
-				coop_to_be_registered.parent_coop_name() );
-		if( m_registered_coop.end() == it )
+		auto it = parent_shard->m_coops.find( parent_coop_id );
+		// Parent must be registered and must not be in deregistration.
+		if( parent_shard->m_coops.end() == it || it->second.m_deregistering )
 		{
+			const auto & parent_name = coop_to_be_registered.parent_coop_name();
 			SO_5_THROW_EXCEPTION(
 				rc_parent_coop_not_found,
-				"parent coop with name \"" +
-					coop_to_be_registered.parent_coop_name() +
-					"\" is not registered" );
+				( parent_name.empty() ?
+					"parent coop with id " + std::to_string( parent_coop_id ) :
+					"parent coop with name \"" + parent_name + "\"" ) +
+				" is not registered" );
 		}
 
-		return it->second.get();
+		return it->second.m_coop.get();
 	}
 
 	return nullptr;
@@ -522,14 +1225,26 @@ coop_repository_basis_t::find_parent_coop_if_necessary(
 
 void
 coop_repository_basis_t::next_coop_reg_step__update_registered_coop_map(
+	shard_t & shard,
+	shard_t * name_shard,
 	const coop_ref_t & coop_ref,
 	coop_t * parent_coop_ptr )
 {
-	m_registered_coop[ coop_ref->query_coop_name() ] = coop_ref;
+	shard.m_coops.emplace( coop_ref->query_coop_id(),
+			coop_info_t{ coop_ref, false } );
+	if( name_shard )
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				name_shard->m_names.emplace(
+						coop_ref->query_coop_name(),
+						coop_ref->query_coop_id() );
+			},
+			[&] { shard.m_coops.erase( coop_ref->query_coop_id() ); } );
+	++m_registered_coop_count;
 	m_total_agent_count += coop_ref->query_agent_count();
 
 	// In case of error cooperation info should be removed
-	// from m_registered_coop.
+	// from the shard.
 	so_5::details::do_with_rollback_on_exception(
 		[&] {
 			next_coop_reg_step__parent_child_relation(
@@ -538,7 +1253,10 @@ coop_repository_basis_t::next_coop_reg_step__update_registered_coop_map(
 		},
 		[&] {
 			m_total_agent_count -= coop_ref->query_agent_count();
-			m_registered_coop.erase( coop_ref->query_coop_name() );
+			--m_registered_coop_count;
+			if( name_shard )
+				name_shard->m_names.erase( coop_ref->query_coop_name() );
+			shard.m_coops.erase( coop_ref->query_coop_id() );
 		} );
 }
 
@@ -554,17 +1272,17 @@ coop_repository_basis_t::next_coop_reg_step__parent_child_relation(
 
 	if( parent_coop_ptr )
 	{
-		const parent_child_coop_names_t names{
-				parent_coop_ptr->query_coop_name(),
-				coop_ref->query_coop_name() };
+		// The lock of parent's shard is acquired by the caller.
+		coop_private_iface_t::add_child( *parent_coop_ptr, *coop_ref );
 
-		m_parent_child_relations.insert( names );
-
-		// In case of error cooperation relation info should be removed
-		// from m_parent_child_relations.
+		// In case of error cooperation should be removed
+		// from the list of parent's children.
 		so_5::details::do_with_rollback_on_exception(
 			[&] { do_actions(); },
-			[&] { m_parent_child_relations.erase( names ); } );
+			[&] {
+				coop_private_iface_t::remove_child(
+						*parent_coop_ptr, *coop_ref );
+			} );
 	}
 	else
 		// It is a very simple case. There is no need for additional
@@ -574,49 +1292,103 @@ coop_repository_basis_t::next_coop_reg_step__parent_child_relation(
 
 coop_repository_basis_t::final_remove_result_t
 coop_repository_basis_t::finaly_remove_cooperation_info(
-	const std::string & coop_name )
+	coop_id_t coop_id )
 {
-	auto it = m_deregistered_coop.find( coop_name );
-	if( it != m_deregistered_coop.end() )
+	auto & shard = shard_for( coop_id );
+
+	coop_ref_t removed_coop;
 	{
-		coop_ref_t removed_coop = it->second;
-		m_deregistered_coop.erase( it );
-		m_total_agent_count -= removed_coop->query_agent_count();
+		std::lock_guard< std::mutex > lock( shard.m_lock );
 
-		coop_t * parent =
-				coop_private_iface_t::parent_coop_ptr( *removed_coop );
-		if( parent )
-		{
-			m_parent_child_relations.erase(
-					parent_child_coop_names_t(
-							parent->query_coop_name(),
-							coop_name ) );
+		auto it = shard.m_coops.find( coop_id );
+		if( it == shard.m_coops.end() || !it->second.m_deregistering )
+			return final_remove_result_t{};
 
-			coop_t::decrement_usage_count( *parent );
-		}
+		removed_coop = it->second.m_coop;
+		// There is nothing more to do for an anonymous coop.
+		if( removed_coop->is_anonymous() )
+			shard.m_coops.erase( it );
+	}
 
-		return final_remove_result_t{
-				removed_coop,
-				info_for_dereg_notification_t{
-						coop_private_iface_t::dereg_reason(
-								*removed_coop ),
-						coop_private_iface_t::dereg_notificators(
-								*removed_coop ) } };
+	if( !removed_coop->is_anonymous() )
+	{
+		// Name must be removed from the index at the same time with
+		// the coop itself. The coop can't disappear between the locks
+		// because only this method removes coops marked as deregistering.
+		const auto & coop_name = removed_coop->query_coop_name();
+		auto & name_shard = shard_for_name( coop_name );
+		coop_repository_details::shards_lock_guard_t< 2 > lock{
+				&shard.m_lock, &name_shard.m_lock };
+
+		shard.m_coops.erase( coop_id );
+		name_shard.m_names.erase( coop_name );
 	}
-	else
-		return final_remove_result_t{};
+
+	--m_deregistered_coop_count;
+	m_total_agent_count -= removed_coop->query_agent_count();
+
+	coop_t * parent =
+			coop_private_iface_t::parent_coop_ptr( *removed_coop );
+	if( parent )
+	{
+		// Parent is alive because its usage count is not decremented yet.
+		auto & parent_shard = shard_for( parent->query_coop_id() );
+		std::lock_guard< std::mutex > lock( parent_shard.m_lock );
+
+		coop_private_iface_t::remove_child( *parent, *removed_coop );
+	}
+
+	auto notifications = info_for_dereg_notification_t{
+			coop_private_iface_t::dereg_reason( *removed_coop ),
+			coop_private_iface_t::dereg_notificators( *removed_coop ) };
+
+	return final_remove_result_t{
+			std::move( removed_coop ),
+			std::move( notifications ),
+			parent };
 }
 
 void
 coop_repository_basis_t::do_coop_reg_notification_if_necessary(
-	const std::string & coop_name,
+	const coop_t & coop,
 	const coop_reg_notificators_container_ref_t & notificators ) const
 {
+	// The name of an anonymous coop is created only if it is necessary.
 	if( m_coop_listener.get() )
-		m_coop_listener->on_registered( m_so_environment, coop_name );
+		m_coop_listener->on_registered(
+				m_so_environment, coop.query_coop_name() );
 
 	if( notificators )
-		notificators->call_all( m_so_environment, coop_name );
+		notificators->call_all( m_so_environment, coop.query_coop_name() );
+}
+
+void
+coop_repository_basis_t::do_coops_reg_notification_if_necessary(
+	const std::vector< coop_ref_t > & coops ) const
+{
+	if( m_coop_listener.get() )
+	{
+		std::vector< std::string > names;
+		names.reserve( coops.size() );
+		for( const auto & c : coops )
+			names.push_back( c->query_coop_name() );
+
+		m_coop_listener->on_registered_bulk( m_so_environment, names );
+	}
+
+	for( const auto & c : coops )
+	{
+		const auto notificators = coop_private_iface_t::reg_notificators( *c );
+		if( notificators )
+			notificators->call_all( m_so_environment, c->query_coop_name() );
+	}
+}
+
+bool
+coop_repository_basis_t::is_coop_dereg_notification_necessary(
+	const info_for_dereg_notification_t & notification_info ) const
+{
+	return m_coop_listener.get() || notification_info.m_notificators;
 }
 
 void
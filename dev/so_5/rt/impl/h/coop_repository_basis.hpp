@@ -12,10 +12,12 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
 #include <memory>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 
@@ -43,6 +45,7 @@ namespace coop_repository_details
 {
 
 class deregistration_processor_t;
+class bulk_registration_processor_t;
 
 } /* namespace coop_repository_details */
 
@@ -58,6 +61,14 @@ class deregistration_processor_t;
 class coop_private_iface_t
 {
 	public :
+		/*!
+		 * \brief Type of container for activators of agents bindings.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		using disp_binding_activators_t = coop_t::disp_binding_activators_t;
+
 		inline static void
 		do_deregistration_specific_actions(
 			coop_t & coop,
@@ -75,6 +86,39 @@ class coop_private_iface_t
 			coop.do_registration_specific_actions( parent_coop );
 		}
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		inline static disp_binding_activators_t
+		prepare_registration( coop_t & coop )
+		{
+			return coop.prepare_registration();
+		}
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		inline static void
+		complete_registration(
+			coop_t & coop,
+			coop_t * parent_coop,
+			disp_binding_activators_t & activators )
+		{
+			coop.complete_registration( parent_coop, activators );
+		}
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		inline static void
+		cancel_registration( coop_t & coop )
+		{
+			coop.cancel_registration();
+		}
+
 		inline static coop_t *
 		parent_coop_ptr( const coop_t & coop )
 		{
@@ -98,6 +142,56 @@ class coop_private_iface_t
 		{
 			return coop.dereg_reason();
 		}
+
+		/*!
+		 * \brief Add a child to the list of children of the parent.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		inline static void
+		add_child( coop_t & parent, coop_t & child )
+		{
+			child.m_prev_sibling = nullptr;
+			child.m_next_sibling = parent.m_first_child;
+			if( parent.m_first_child )
+				parent.m_first_child->m_prev_sibling = &child;
+			parent.m_first_child = &child;
+		}
+
+		/*!
+		 * \brief Remove a child from the list of children of the parent.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		inline static void
+		remove_child( coop_t & parent, coop_t & child )
+		{
+			if( child.m_prev_sibling )
+				child.m_prev_sibling->m_next_sibling = child.m_next_sibling;
+			else
+				parent.m_first_child = child.m_next_sibling;
+
+			if( child.m_next_sibling )
+				child.m_next_sibling->m_prev_sibling = child.m_prev_sibling;
+
+			child.m_prev_sibling = child.m_next_sibling = nullptr;
+		}
+
+		/*!
+		 * \brief Call a lambda for every child of the coop.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		template< typename Lambda >
+		static void
+		for_each_child( const coop_t & parent, Lambda && lambda )
+		{
+			for( auto c = parent.m_first_child; c; c = c->m_next_sibling )
+				lambda( *c );
+		}
 };
 
 //
@@ -116,6 +210,8 @@ class SO_5_TYPE coop_repository_basis_t
 
 	friend class so_5::impl::coop_repository_details::
 			deregistration_processor_t;
+	friend class so_5::impl::coop_repository_details::
+			bulk_registration_processor_t;
 
 public:
 	coop_repository_basis_t(
@@ -130,6 +226,23 @@ public:
 		//! Cooperation to be registered.
 		coop_unique_ptr_t agent_coop );
 
+	//! Register several cooperations at once.
+	/*!
+	 * All cooperations are registered under the same locks of
+	 * the cooperation index. If an exception is thrown then
+	 * no one cooperation from \a coops is registered.
+	 *
+	 * A parent cooperation can be registered by the same call. But it
+	 * must precede its children in \a coops.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	register_coops(
+		//! Cooperations to be registered.
+		std::vector< coop_unique_ptr_t > coops );
+
 	//! Deregister cooperation.
 	void
 	deregister_coop(
@@ -138,6 +251,18 @@ public:
 		//! Deregistration reason.
 		coop_dereg_reason_t dereg_reason );
 
+	//! Deregister cooperation by its id.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	void
+	deregister_coop(
+		//! Id of cooperation which being deregistered.
+		coop_id_t id,
+		//! Deregistration reason.
+		coop_dereg_reason_t dereg_reason );
+
 	/*!
 	 * Type for return value of final_deregister_coop method.
 	 *
@@ -169,14 +294,8 @@ public:
 	 */
 	final_deregistration_resul_t
 	final_deregister_coop(
-		//! Cooperation name to be deregistered.
-		/*!
-		 * \attention
-		 * This must be a copy of cooperation name.
-		 * Because if it is a reference to the cooperation name that
-		 * reference will become invalid during execution of this method.
-		 */
-		std::string coop_name );
+		//! Id of cooperation to be deregistered.
+		coop_id_t coop_id );
 
 	//! Deregisted all cooperations.
 	/*!
@@ -238,39 +357,91 @@ public:
 	/*!
 	 * Get access to repository's mutex.
 	 *
+	 * \note
+	 * Since v.5.5.25 this mutex doesn't protect operations on
+	 * cooperations. It is used only for changing of the deregistration
+	 * state and for waiting on condition variables related to
+	 * the deregistration.
+	 *
 	 * \since
 	 * v.5.5.19
 	 */
 	std::mutex &
 	lock()
 		{
-			return m_coop_operations_lock;
+			return m_deregistration_state_lock;
 		}
 
-protected:
-	//! Typedef for map from cooperation name to the cooperation.
-	typedef std::map< std::string, coop_ref_t > coop_map_t;
+	/*!
+	 * \brief Is there any registered or deregistering coop?
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	bool
+	has_live_coop() const
+		{
+			// The order is important: a coop is counted as deregistering
+			// before it is removed from the count of registered coops.
+			return 0u != m_registered_coop_count.load( std::memory_order_acquire ) ||
+					0u != m_deregistered_coop_count.load( std::memory_order_acquire );
+		}
 
+protected:
 	/*!
+	 * \brief Information about a cooperation inside the repository.
+	 *
 	 * \since
-	 * v.5.2.3
+	 * v.5.5.25
+	 */
+	struct coop_info_t
+		{
+			//! Cooperation itself.
+			coop_ref_t m_coop;
+			//! Is the cooperation in deregistration process?
+			bool m_deregistering;
+		};
+
+	/*!
+	 * \brief A shard of the cooperation index.
 	 *
-	 * \brief Typedef for pair of names of parent and child cooperations.
+	 * Every cooperation is stored in the shard selected by the
+	 * cooperation id. Operations on cooperations from different shards
+	 * don't block each other.
 	 *
-	 * \a first -- name of parent.
-	 * \a second -- name of child.
+	 * The lock of the shard also protects the list of children
+	 * of every cooperation stored in that shard.
+	 *
+	 * Names of named cooperations are stored separately in the shards
+	 * selected by the hash of the name. Anonymous cooperations don't
+	 * go to the index of names at all.
+	 *
+	 * \since
+	 * v.5.5.25
 	 */
-	typedef std::pair< std::string, std::string >
-		parent_child_coop_names_t;
+	struct shard_t
+		{
+			//! Object lock.
+			std::mutex m_lock;
+			//! Cooperations from that shard.
+			std::unordered_map< coop_id_t, coop_info_t > m_coops;
+			//! Names of cooperations from that shard.
+			std::unordered_map< std::string, coop_id_t > m_names;
+		};
 
+	//! Count of shards in the cooperation index.
 	/*!
 	 * \since
-	 * v.5.2.3
-	 *
-	 * \brief Typedef for set of parent-child names pairs.
+	 * v.5.5.25
 	 */
-	typedef std::set< parent_child_coop_names_t >
-		parent_child_coop_relation_t;
+	static const std::size_t shard_count = 64u;
+
+	//! Type of cooperation index.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	using shards_t = std::array< shard_t, shard_count >;
 
 	/*!
 	 * \since
@@ -341,6 +512,19 @@ protected:
 			coop_ref_t m_coop;
 			//! Deregistration notifications.
 			info_for_dereg_notification_t m_notifications;
+			//! Parent of the cooperation.
+			/*!
+			 * Usage count of the parent must be decremented only after
+			 * the destruction of the cooperation. It guarantees that
+			 * a parent is finally deregistered only after all its children
+			 * even if final deregistration is performed by several threads.
+			 *
+			 * Null if there is no parent.
+			 *
+			 * \since
+			 * v.5.5.25
+			 */
+			coop_t * m_parent = nullptr;
 
 			//! Empty constructor.
 			final_remove_result_t()
@@ -349,9 +533,11 @@ protected:
 			//! Initializing constructor.
 			final_remove_result_t(
 				coop_ref_t coop,
-				info_for_dereg_notification_t notifications )
+				info_for_dereg_notification_t notifications,
+				coop_t * parent )
 				:	m_coop( std::move( coop ) )
 				,	m_notifications( std::move( notifications ) )
+				,	m_parent( parent )
 				{}
 
 			//! Copy constructor.
@@ -359,6 +545,7 @@ protected:
 				const final_remove_result_t & o )
 				:	m_coop( o.m_coop )
 				,	m_notifications( o.m_notifications )
+				,	m_parent( o.m_parent )
 				{}
 
 			//! Move constructor.
@@ -366,6 +553,7 @@ protected:
 				final_remove_result_t && o )
 				:	m_coop( std::move( o.m_coop ) )
 				,	m_notifications( std::move( o.m_notifications ) )
+				,	m_parent( o.m_parent )
 				{}
 
 			//! Copy operator.
@@ -382,65 +570,162 @@ protected:
 				{
 					m_coop.swap( o.m_coop );
 					m_notifications.swap( o.m_notifications );
+					std::swap( m_parent, o.m_parent );
 				}
 		};
 
 	//! SObjectizer Environment to work with.
 	environment_t & m_so_environment;
 
-	//! Lock for operations on cooperations.
-	std::mutex m_coop_operations_lock;
+	//! Lock for changing of the deregistration state.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	std::mutex m_deregistration_state_lock;
 
 	//! Indicator for all cooperation deregistration.
-	bool m_deregistration_started;
+	std::atomic< bool > m_deregistration_started;
 
-	//! Map of registered cooperations.
-	coop_map_t m_registered_coop;
+	//! Index of all cooperations.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	shards_t m_shards;
+
+	//! Count of registered cooperations.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< std::size_t > m_registered_coop_count;
 
-	//! Map of cooperations being deregistered.
-	coop_map_t m_deregistered_coop;
+	//! Count of cooperations being deregistered.
+	/*!
+	 * \since
+	 * v.5.5.25
+	 */
+	std::atomic< std::size_t > m_deregistered_coop_count;
 
 	//! Total count of agents.
 	/*!
 	 * \since
 	 * v.5.5.4
 	 */
-	std::size_t m_total_agent_count;
+	std::atomic< std::size_t > m_total_agent_count;
 
 	//! Cooperation actions listener.
 	coop_listener_unique_ptr_t m_coop_listener;
 
 	/*!
+	 * \brief Get the shard for the cooperation id.
+	 *
 	 * \since
-	 * v.5.2.3
+	 * v.5.5.25
+	 */
+	shard_t &
+	shard_for( coop_id_t coop_id );
+
+	/*!
+	 * \brief Get the shard for the cooperation name.
 	 *
-	 * \brief Information about parent and child cooperations
-	 * relationship.
+	 * \since
+	 * v.5.5.25
 	 */
-	parent_child_coop_relation_t m_parent_child_relations;
+	shard_t &
+	shard_for_name( const std::string & coop_name );
+
+	/*!
+	 * \brief Get the shard for an anonymous cooperation which could
+	 * have the name specified.
+	 *
+	 * \return nullptr if \a coop_name doesn't have the format of names
+	 * of anonymous cooperations.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	shard_t *
+	shard_for_anonymous_name( const std::string & coop_name );
+
+	/*!
+	 * \brief Find id of cooperation by its name.
+	 *
+	 * The name of an anonymous cooperation is also recognized.
+	 *
+	 * \note
+	 * Acquires the locks of the necessary shards by itself.
+	 *
+	 * \return null_coop_id() if there is no such cooperation.
+	 *
+	 * \since
+	 * v.5.5.25
+	 */
+	coop_id_t
+	find_coop_id( const std::string & coop_name );
+
+	/*!
+	 * \since
+	 * v.5.5.25
+	 *
+	 * \brief Ensures that a new cooperation can be registered.
+	 *
+	 * \throw exception_t if the deregistration of all cooperations
+	 * is started.
+	 *
+	 * \attention
+	 * Must be called when the lock of the shard for \a coop
+	 * is acquired.
+	 */
+	void
+	ensure_registration_allowed(
+		const coop_t & coop ) const;
 
 	/*!
 	 * \since
 	 * v.5.2.3
 	 *
 	 * \brief Ensures that name of new cooperation is unique.
+	 *
+	 * Since v.5.5.25 it also ensures that there is no live anonymous
+	 * cooperation with the same name.
+	 *
+	 * \note
+	 * An anonymous cooperation isn't checked against names of named
+	 * cooperations. If an anonymous cooperation is registered after
+	 * a named cooperation with the same name then only the named one
+	 * can be found by that name.
+	 *
+	 * \attention
+	 * Must be called when the locks of \a name_shard and
+	 * \a anonymous_shard are acquired.
 	 */
 	void
 	ensure_new_coop_name_unique(
+		const shard_t & name_shard,
+		//! Shard for an anonymous cooperation with the same name.
+		//! Null if the name can't be a name of anonymous cooperation.
+		const shard_t * anonymous_shard,
 		const std::string & coop_name ) const;
 
 	/*!
 	 * \since
 	 * v.5.2.3
 	 *
-	 * \brief Checks that parent cooperation is registered if its name
+	 * \brief Checks that parent cooperation is registered if it
 	 * is set for the cooperation specified.
 	 *
-	 * \retval nullptr if no parent cooperation name set. Otherwise the
+	 * \retval nullptr if no parent cooperation set. Otherwise the
 	 * pointer to parent cooperation is returned.
+	 *
+	 * \attention
+	 * Must be called when the lock of \a parent_shard is acquired.
 	 */
 	coop_t *
 	find_parent_coop_if_necessary(
+		const shard_t * parent_shard,
+		coop_id_t parent_coop_id,
 		const coop_t & coop_to_be_registered ) const;
 
 	/*!
@@ -454,6 +739,11 @@ protected:
 	 */
 	void
 	next_coop_reg_step__update_registered_coop_map(
+		//! Shard for the cooperation.
+		shard_t & shard,
+		//! Shard for the name of the cooperation.
+		//! Equal to nullptr if \a coop is anonymous.
+		shard_t * name_shard,
 		//! Cooperation to be registered.
 		const coop_ref_t & coop_ref,
 		//! Pointer to parent cooperation.
@@ -486,11 +776,14 @@ protected:
 	 * If parent cooperation exists then parent-child relation
 	 * is handled appropriatelly.
 	 *
-	 * Information about cooperation is removed from m_deregistered_coop.
+	 * Information about cooperation is removed from the cooperation index.
+	 *
+	 * \note
+	 * Acquires the locks of the necessary shards by itself.
 	 */
 	final_remove_result_t
 	finaly_remove_cooperation_info(
-		const std::string & coop_name );
+		coop_id_t coop_id );
 
 	/*!
 	 * \since
@@ -501,9 +794,34 @@ protected:
 	 */
 	void
 	do_coop_reg_notification_if_necessary(
-		const std::string & coop_name,
+		const coop_t & coop,
 		const coop_reg_notificators_container_ref_t & notificators ) const;
 
+	/*!
+	 * \since
+	 * v.5.5.25
+	 *
+	 * \brief Do all job related to sending notification about
+	 * registration of several cooperations at once.
+	 */
+	void
+	do_coops_reg_notification_if_necessary(
+		const std::vector< coop_ref_t > & coops ) const;
+
+	/*!
+	 * \since
+	 * v.5.5.25
+	 *
+	 * \brief Is there anyone to be notified about
+	 * cooperation deregistration?
+	 *
+	 * The name of an anonymous cooperation is not created if there
+	 * is nobody to be notified.
+	 */
+	bool
+	is_coop_dereg_notification_necessary(
+		const info_for_dereg_notification_t & notification_info ) const;
+
 	/*!
 	 * \since
 	 * v.5.2.3
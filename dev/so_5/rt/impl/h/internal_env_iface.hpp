@@ -59,11 +59,41 @@ class SO_5_TYPE internal_env_iface_t
 			//! Cooperation which is ready to be deregistered.
 			coop_t * coop );
 
+		//! Initiate deregistration of a cooperation.
+		/*!
+		 * The cooperation is deregistered by its id. If the environment
+		 * infrastructure doesn't support ids then the name of the
+		 * cooperation is used.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		void
+		deregister_coop(
+			//! Cooperation to be deregistered.
+			const coop_t & coop,
+			//! Deregistration reason.
+			coop_dereg_reason_t dereg_reason );
+
 		//! Do the final actions of a cooperation deregistration.
+		/*!
+		 * \note
+		 * Since v.5.5.25 the cooperation is specified by a reference
+		 * because its name is necessary if the environment infrastructure
+		 * doesn't support ids of cooperations.
+		 */
 		void
 		final_deregister_coop(
-			//! Cooperation name to be deregistered.
-			const std::string & coop_name );
+			//! Cooperation to be deregistered.
+			coop_t & coop );
+
+		//! Get a new unique id for a cooperation.
+		/*!
+		 * \since
+		 * v.5.5.25
+		 */
+		coop_id_t
+		allocate_coop_id();
 
 		//! Is message delivery tracing enabled?
 		bool
@@ -92,6 +122,16 @@ class SO_5_TYPE internal_env_iface_t
 		so_5::disp::mpmc_queue_traits::lock_factory_t
 		default_mpmc_queue_lock_factory() const;
 
+		//! Get the data source for queueing delays.
+		/*!
+		 * \retval nullptr if queueing delay tracking is turned off.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		stats::impl::ds_queueing_delay_stats_t *
+		queueing_delay_stats() const SO_5_NOEXCEPT;
+
 		/*!
 		 * \name Methods for working with event_queue_hooks
 		 * \{
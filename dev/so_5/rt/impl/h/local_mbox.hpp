@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include <so_5/h/types.hpp>
@@ -26,6 +30,7 @@
 #include <so_5/rt/impl/h/agent_ptr_compare.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
+#include <so_5/rt/impl/h/rcu.hpp>
 
 namespace so_5
 {
@@ -681,6 +686,266 @@ public :
 		}
 };
 
+//
+// messages_table_t
+//
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Map from message type to subscribers.
+ *
+ * A flat table which is optimized for search of subscribers during
+ * message delivery.
+ *
+ * Items are stored in a vector. If there are just a few message types
+ * the vector is scanned linearly. When the count of message types
+ * exceeds small_table_limit an open-addressing hash table with linear
+ * probing is built over the vector. The hash table is keyed by
+ * std::type_index::hash_code().
+ *
+ * \note Iterators are invalidated by emplace() and erase().
+ */
+class messages_table_t
+{
+public :
+	//! Type of table item.
+	using value_type =
+			std::pair< std::type_index, subscriber_adaptive_container_t >;
+
+	using iterator = std::vector< value_type >::iterator;
+	using const_iterator = std::vector< value_type >::const_iterator;
+
+	iterator
+	begin() { return m_items.begin(); }
+
+	iterator
+	end() { return m_items.end(); }
+
+	const_iterator
+	begin() const { return m_items.begin(); }
+
+	const_iterator
+	end() const { return m_items.end(); }
+
+	std::size_t
+	size() const { return m_items.size(); }
+
+	bool
+	empty() const { return m_items.empty(); }
+
+	iterator
+	find( const std::type_index & msg_type )
+		{
+			return m_items.begin() + static_cast< std::ptrdiff_t >(
+					find_index( msg_type ) );
+		}
+
+	const_iterator
+	find( const std::type_index & msg_type ) const
+		{
+			return m_items.begin() + static_cast< std::ptrdiff_t >(
+					find_index( msg_type ) );
+		}
+
+	//! Add a new item.
+	/*!
+	 * \attention There must not be an item for \a msg_type in the table.
+	 */
+	void
+	emplace(
+		const std::type_index & msg_type,
+		subscriber_adaptive_container_t && subscribers )
+		{
+			const auto hash = msg_type.hash_code();
+
+			ensure_capacity_for_one_more();
+			m_hashes.reserve( m_items.size() + 1 );
+
+			m_items.emplace_back( msg_type, subscriber_adaptive_container_t{} );
+			m_items.back().second.swap( subscribers );
+			m_hashes.push_back( hash );
+
+			if( !m_slots.empty() && m_items.size() * 2 <= m_slots.size() )
+				insert_slot( m_items.size() - 1 );
+			else if( m_items.size() > small_table_limit )
+				{
+					try
+						{
+							rebuild_slots();
+						}
+					catch( ... )
+						{
+							m_items.pop_back();
+							m_hashes.pop_back();
+							throw;
+						}
+				}
+		}
+
+	void
+	erase( iterator it ) SO_5_NOEXCEPT
+		{
+			const auto index = static_cast< std::size_t >( it - m_items.begin() );
+			const auto last = m_items.size() - 1;
+
+			if( !m_slots.empty() )
+				{
+					remove_slot( index );
+					if( index != last )
+						m_slots[ slot_of( last ) ] = index + 1;
+				}
+
+			if( index != last )
+				{
+					// The last item is moved to the free place.
+					// Swap is used because it doesn't throw.
+					m_items[ index ].first = m_items[ last ].first;
+					m_items[ index ].second.swap( m_items[ last ].second );
+					m_hashes[ index ] = m_hashes[ last ];
+				}
+
+			m_items.pop_back();
+			m_hashes.pop_back();
+
+			if( m_items.size() <= small_table_limit )
+				m_slots.clear();
+		}
+
+private :
+	//! Max count of items to be scanned linearly.
+	static const std::size_t small_table_limit = 4;
+
+	//! Items of the table.
+	std::vector< value_type > m_items;
+
+	//! Hash codes of message types from m_items.
+	std::vector< std::size_t > m_hashes;
+
+	//! Hash table.
+	/*!
+	 * Contains index of an item in m_items plus 1 or 0 for empty slot.
+	 * Its size is always a power of 2.
+	 *
+	 * Is empty if m_items is scanned linearly.
+	 */
+	std::vector< std::size_t > m_slots;
+
+	std::size_t
+	mask() const { return m_slots.size() - 1; }
+
+	std::size_t
+	find_index( const std::type_index & msg_type ) const
+		{
+			if( m_slots.empty() )
+				{
+					for( std::size_t i = 0; i != m_items.size(); ++i )
+						if( m_items[ i ].first == msg_type )
+							return i;
+				}
+			else
+				{
+					const auto hash = msg_type.hash_code();
+					for( auto slot = hash & mask(); m_slots[ slot ];
+							slot = (slot + 1) & mask() )
+						{
+							const auto index = m_slots[ slot ] - 1;
+							if( m_hashes[ index ] == hash &&
+									m_items[ index ].first == msg_type )
+								return index;
+						}
+				}
+
+			return m_items.size();
+		}
+
+	//! Index of slot which refers to the item with \a index.
+	std::size_t
+	slot_of( std::size_t index ) const
+		{
+			auto slot = m_hashes[ index ] & mask();
+			while( m_slots[ slot ] != index + 1 )
+				slot = (slot + 1) & mask();
+
+			return slot;
+		}
+
+	void
+	insert_slot( std::size_t index ) SO_5_NOEXCEPT
+		{
+			auto slot = m_hashes[ index ] & mask();
+			while( m_slots[ slot ] )
+				slot = (slot + 1) & mask();
+
+			m_slots[ slot ] = index + 1;
+		}
+
+	//! Remove the slot for the item with \a index.
+	/*!
+	 * Subsequent slots of the same probe sequence are shifted back.
+	 */
+	void
+	remove_slot( std::size_t index ) SO_5_NOEXCEPT
+		{
+			auto hole = slot_of( index );
+			for( auto slot = (hole + 1) & mask(); m_slots[ slot ];
+					slot = (slot + 1) & mask() )
+				{
+					const auto home = m_hashes[ m_slots[ slot ] - 1 ] & mask();
+					// The item can be moved to the hole only if its home
+					// slot isn't in the cyclic range (hole, slot].
+					const bool home_in_range = hole < slot ?
+							(hole < home && home <= slot) :
+							(hole < home || home <= slot);
+					if( !home_in_range )
+						{
+							m_slots[ hole ] = m_slots[ slot ];
+							hole = slot;
+						}
+				}
+
+			m_slots[ hole ] = 0;
+		}
+
+	void
+	rebuild_slots()
+		{
+			std::size_t capacity = 16;
+			while( capacity < m_items.size() * 2 )
+				capacity *= 2;
+
+			std::vector< std::size_t > slots( capacity, 0u );
+			m_slots.swap( slots );
+
+			for( std::size_t i = 0; i != m_items.size(); ++i )
+				insert_slot( i );
+		}
+
+	//! Grow m_items if there is no room for a new item.
+	/*!
+	 * Move constructor of subscriber_adaptive_container_t isn't
+	 * noexcept and std::vector would copy items during reallocation.
+	 * Because of that items are swapped into the new storage manually.
+	 */
+	void
+	ensure_capacity_for_one_more()
+		{
+			if( m_items.size() < m_items.capacity() )
+				return;
+
+			std::vector< value_type > items;
+			items.reserve( m_items.empty() ? 2 : m_items.size() * 2 );
+			for( auto & i : m_items )
+				{
+					items.emplace_back( i.first, subscriber_adaptive_container_t{} );
+					items.back().second.swap( i.second );
+				}
+
+			m_items.swap( items );
+		}
+};
+
 //
 // data_t
 //
@@ -703,19 +968,122 @@ struct data_t
 		//! Object lock.
 		mutable default_rw_spinlock_t m_lock;
 
+		//! Map of subscribers to messages.
+		messages_table_t m_subscribers;
+
 		/*!
 		 * \since
-		 * v.5.4.0
+		 * v.5.5.25
+		 *
+		 * \brief Call \a reader for the map of subscribers.
 		 *
-		 * \brief Map from message type to subscribers.
+		 * The map is protected by the object lock in read mode.
 		 */
-		typedef std::map<
-						std::type_index,
-						subscriber_adaptive_container_t >
-				messages_table_t;
+		template< typename Reader >
+		void
+		read_subscribers( Reader && reader ) const
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
 
-		//! Map of subscribers to messages.
-		messages_table_t m_subscribers;
+				reader( static_cast< const messages_table_t & >( m_subscribers ) );
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Call \a modifier for the map of subscribers.
+		 *
+		 * The map is protected by the object lock in write mode.
+		 */
+		template< typename Modifier >
+		void
+		modify_subscribers( Modifier && modifier )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+
+				modifier( m_subscribers );
+			}
+	};
+
+//
+// rcu_data_t
+//
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief A collection of data required for local mbox with
+ * read-copy-update synchronization.
+ *
+ * The map of subscribers is immutable. A modification creates a copy
+ * of the map, changes it and replaces the pointer to the current map.
+ * The old map is destroyed after the end of all read-side sections
+ * which could see it.
+ *
+ * A sender doesn't acquire any lock, it just loads the pointer to
+ * the current map. But each modification of subscriptions copies
+ * the whole map and waits for the completion of current deliveries.
+ */
+struct rcu_data_t
+	{
+		rcu_data_t( mbox_id_t id )
+			:	m_id{ id }
+			,	m_subscribers{ new messages_table_t() }
+			{}
+
+		~rcu_data_t()
+			{
+				delete m_subscribers.load( std::memory_order_relaxed );
+			}
+
+		rcu_data_t( const rcu_data_t & ) = delete;
+		rcu_data_t &
+		operator=( const rcu_data_t & ) = delete;
+
+		//! ID of this mbox.
+		const mbox_id_t m_id;
+
+		//! Lock for serialization of modifications.
+		std::mutex m_modification_lock;
+
+		//! The current map of subscribers to messages.
+		std::atomic< const messages_table_t * > m_subscribers;
+
+		//! Call \a reader for the current map of subscribers.
+		template< typename Reader >
+		void
+		read_subscribers( Reader && reader ) const
+			{
+				rcu::read_section_t section;
+
+				reader( *m_subscribers.load( std::memory_order_seq_cst ) );
+			}
+
+		//! Call \a modifier for a copy of the current map of subscribers.
+		/*!
+		 * The copy becomes the current map after that.
+		 */
+		template< typename Modifier >
+		void
+		modify_subscribers( Modifier && modifier )
+			{
+				std::lock_guard< std::mutex > lock( m_modification_lock );
+
+				const auto old = m_subscribers.load( std::memory_order_relaxed );
+				std::unique_ptr< messages_table_t > fresh{
+						new messages_table_t( *old ) };
+
+				modifier( *fresh );
+
+				m_subscribers.store( fresh.release(), std::memory_order_seq_cst );
+
+				// There can be readers of the old map yet.
+				rcu::synchronize();
+
+				delete old;
+			}
 	};
 
 } /* namespace local_mbox_details */
@@ -731,11 +1099,17 @@ struct data_t
  *
  * \tparam Tracing_Base base class with implementation of message
  * delivery tracing methods.
+ *
+ * \tparam Data type with mbox data and implementation of access
+ * to subscribers. It is local_mbox_details::data_t or
+ * local_mbox_details::rcu_data_t. This parameter is added in v.5.5.25.
  */
-template< typename Tracing_Base >
+template<
+	typename Tracing_Base,
+	typename Data = local_mbox_details::data_t >
 class local_mbox_template
 	:	public abstract_message_box_t
-	,	private local_mbox_details::data_t
+	,	private Data
 	,	private Tracing_Base
 	{
 	public:
@@ -745,14 +1119,14 @@ class local_mbox_template
 			mbox_id_t id,
 			//! Optional parameters for Tracing_Base's constructor.
 			Tracing_Args &&... args )
-			:	local_mbox_details::data_t{ id }
+			:	Data{ id }
 			,	Tracing_Base{ std::forward< Tracing_Args >(args)... }
 			{}
 
 		virtual mbox_id_t
 		id() const override
 			{
-				return m_id;
+				return this->m_id;
 			}
 
 		virtual void
@@ -790,7 +1164,7 @@ class local_mbox_template
 		query_name() const override
 			{
 				std::ostringstream s;
-				s << "<mbox:type=MPMC:id=" << m_id << ">";
+				s << "<mbox:type=MPMC:id=" << this->m_id << ">";
 
 				return s.str();
 			}
@@ -823,6 +1197,59 @@ class local_mbox_template
 						invocation_type_t::event );
 			}
 
+		/*!
+		 * \note Subscribers are searched only once. All accepted
+		 * messages are pushed to the event queue of a subscriber
+		 * by one operation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				for( std::size_t i = 0; i != count; ++i )
+					ensure_immutable_message( msg_type, messages[ i ] );
+
+				// Messages accepted for the current subscriber.
+				std::vector< message_ref_t > accepted;
+				accepted.reserve( count );
+
+				this->read_subscribers(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( msg_type );
+						if( it != subscribers.end() )
+							{
+								for( const auto & a : it->second )
+									{
+										accepted.clear();
+										do_deliver_messages_to_subscriber(
+												a,
+												msg_type,
+												messages,
+												count,
+												overlimit_reaction_deep,
+												accepted );
+									}
+							}
+						else
+							for( std::size_t i = 0; i != count; ++i )
+								{
+									typename Tracing_Base::deliver_op_tracer tracer{
+											*this, // as Tracing_base
+											*this, // as abstract_message_box_t
+											"deliver_message",
+											msg_type, messages[ i ], overlimit_reaction_deep };
+
+									tracer.no_subscribers();
+								}
+					} );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -904,33 +1331,34 @@ class local_mbox_template
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
-				{
-					// There isn't such message type yet.
-					local_mbox_details::subscriber_adaptive_container_t container;
-					container.insert( maker() );
-
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
-				}
-				else
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Agent is already in subscribers list.
-						// But its state must be updated.
-						changer( *pos );
-					}
-					else
-						// There is no subscriber in the container.
-						// It must be added.
-						agents.insert( maker() );
-				}
+				this->modify_subscribers(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( type_wrapper );
+						if( it == subscribers.end() )
+						{
+							// There isn't such message type yet.
+							local_mbox_details::subscriber_adaptive_container_t container;
+							container.insert( maker() );
+
+							subscribers.emplace( type_wrapper, std::move( container ) );
+						}
+						else
+						{
+							auto & agents = it->second;
+
+							auto pos = agents.find( subscriber );
+							if( pos != agents.end() )
+							{
+								// Agent is already in subscribers list.
+								// But its state must be updated.
+								changer( *pos );
+							}
+							else
+								// There is no subscriber in the container.
+								// It must be added.
+								agents.insert( maker() );
+						}
+					} );
 			}
 
 		template< typename Info_Changer >
@@ -940,28 +1368,29 @@ class local_mbox_template
 			agent_t * subscriber,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Subscriber is found and must be modified.
-						changer( *pos );
+				this->modify_subscribers(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( type_wrapper );
+						if( it != subscribers.end() )
+						{
+							auto & agents = it->second;
+
+							auto pos = agents.find( subscriber );
+							if( pos != agents.end() )
+							{
+								// Subscriber is found and must be modified.
+								changer( *pos );
 
-						// If info about subscriber becomes empty after modification
-						// then subscriber info must be removed.
-						if( pos->empty() )
-							agents.erase( pos );
-					}
+								// If info about subscriber becomes empty after modification
+								// then subscriber info must be removed.
+								if( pos->empty() )
+									agents.erase( pos );
+							}
 
-					if( agents.empty() )
-						m_subscribers.erase( it );
-				}
+							if( agents.empty() )
+								subscribers.erase( it );
+						}
+					} );
 			}
 
 		void
@@ -972,22 +1401,23 @@ class local_mbox_template
 			unsigned int overlimit_reaction_deep,
 			invocation_type_t invocation_type ) const
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
-					{
-						for( const auto & a : it->second )
-							do_deliver_message_to_subscriber(
-									a,
-									tracer,
-									msg_type,
-									message,
-									overlimit_reaction_deep,
-									invocation_type );
-					}
-				else
-					tracer.no_subscribers();
+				this->read_subscribers(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( msg_type );
+						if( it != subscribers.end() )
+							{
+								for( const auto & a : it->second )
+									do_deliver_message_to_subscriber(
+											a,
+											tracer,
+											msg_type,
+											message,
+											overlimit_reaction_deep,
+											invocation_type );
+							}
+						else
+							tracer.no_subscribers();
+					} );
 			}
 
 		void
@@ -1035,6 +1465,78 @@ class local_mbox_template
 							agent_info.subscriber_pointer(), delivery_status );
 			}
 
+		void
+		do_deliver_messages_to_subscriber(
+			const local_mbox_details::subscriber_info_t & agent_info,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep,
+			std::vector< message_ref_t > & accepted ) const
+			{
+				using namespace so_5::message_limit::impl;
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						const message_ref_t & message = messages[ i ];
+
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, message, overlimit_reaction_deep };
+
+						const auto delivery_status =
+								agent_info.must_be_delivered(
+										message,
+										[]( const message_ref_t & m ) -> message_t & {
+											return *m;
+										} );
+
+						if( delivery_possibility_t::must_be_delivered == delivery_status )
+							try_to_deliver_to_agent(
+									this->m_id,
+									invocation_type_t::event,
+									agent_info.subscriber_reference(),
+									agent_info.limit(),
+									msg_type,
+									message,
+									overlimit_reaction_deep,
+									tracer.overlimit_tracer(),
+									[&] {
+										tracer.push_to_queue( agent_info.subscriber_pointer() );
+
+										accepted.push_back( message );
+									} );
+						else
+							tracer.message_rejected(
+									agent_info.subscriber_pointer(), delivery_status );
+					}
+
+				if( accepted.empty() )
+					return;
+
+				try
+					{
+						agent_t::call_push_events(
+								agent_info.subscriber_reference(),
+								agent_info.limit(),
+								this->m_id,
+								msg_type,
+								accepted.data(),
+								accepted.size() );
+					}
+				catch( ... )
+					{
+						// Messages have been counted by try_to_deliver_to_agent
+						// but they are not in the event queue.
+						if( agent_info.limit() )
+							agent_info.limit()->m_count -=
+									static_cast< unsigned int >( accepted.size() );
+						throw;
+					}
+			}
+
 		void
 		do_deliver_service_request_impl(
 			typename Tracing_Base::deliver_op_tracer const & tracer,
@@ -1046,32 +1548,33 @@ class local_mbox_template
 
 				msg_service_request_base_t::dispatch_wrapper( message,
 					[&] {
-						read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
-
-						auto it = m_subscribers.find( msg_type );
-
-						if( it == m_subscribers.end() )
-							{
-								tracer.no_subscribers();
-
-								SO_5_THROW_EXCEPTION(
-										so_5::rc_no_svc_handlers,
-										std::string( "no service handlers (no subscribers for message)"
-										", msg_type: " ) + msg_type.name() );
-							}
-
-						if( 1 != it->second.size() )
-							SO_5_THROW_EXCEPTION(
-									so_5::rc_more_than_one_svc_handler,
-									std::string( "more than one service handler found"
-											", msg_type: " ) + msg_type.name() );
-
-						do_deliver_service_request_to_subscriber(
-								tracer,
-								*(it->second.begin()),
-								msg_type,
-								message,
-								overlimit_reaction_deep );
+						this->read_subscribers(
+							[&]( const local_mbox_details::messages_table_t & subscribers ) {
+								auto it = subscribers.find( msg_type );
+
+								if( it == subscribers.end() )
+									{
+										tracer.no_subscribers();
+
+										SO_5_THROW_EXCEPTION(
+												so_5::rc_no_svc_handlers,
+												std::string( "no service handlers (no subscribers for message)"
+												", msg_type: " ) + msg_type.name() );
+									}
+
+								if( 1 != it->second.size() )
+									SO_5_THROW_EXCEPTION(
+											so_5::rc_more_than_one_svc_handler,
+											std::string( "more than one service handler found"
+													", msg_type: " ) + msg_type.name() );
+
+								do_deliver_service_request_to_subscriber(
+										tracer,
+										*(it->second.begin()),
+										msg_type,
+										message,
+										overlimit_reaction_deep );
+							} );
 					} );
 			}
 
@@ -1110,7 +1613,7 @@ class local_mbox_template
 									agent_t::call_push_event(
 											agent_info.subscriber_reference(),
 											agent_info.limit(),
-											m_id,
+											this->m_id,
 											msg_type,
 											message );
 								} );
@@ -1171,6 +1674,30 @@ using local_mbox_without_tracing =
 using local_mbox_with_tracing =
 	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Alias for local mbox with read-copy-update synchronization
+ * and without message delivery tracing.
+ */
+using rcu_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::rcu_data_t >;
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Alias for local mbox with read-copy-update synchronization
+ * and with message delivery tracing.
+ */
+using rcu_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::rcu_data_t >;
+
 } /* namespace impl */
 
 } /* namespace so_5 */
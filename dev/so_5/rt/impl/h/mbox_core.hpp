@@ -12,6 +12,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <mutex>
@@ -94,6 +95,49 @@ class mbox_core_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Create local anonymous mbox with the specified parameters.
+		 */
+		mbox_t
+		create_mbox(
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Create local named mbox with the specified parameters.
+		 *
+		 * \note \a params are ignored if mbox with name \a mbox_name
+		 * is present.
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			nonempty_name_t mbox_name,
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Create local named mbox with name from a handle.
+		 *
+		 * \note \a params are ignored if mbox with name \a mbox_name
+		 * is present.
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			const mbox_name_handle_t & mbox_name,
+			//! Parameters for the new mbox.
+			const mbox_params_t & params );
+
 		/*!
 		 * \since
 		 * v.5.4.0
@@ -117,7 +161,7 @@ class mbox_core_t
 		void
 		destroy_mbox(
 			//! Mbox name.
-			const std::string & name );
+			const mbox_name_handle_t & name );
 
 		/*!
 		 * \brief Create a custom mbox.
@@ -162,9 +206,6 @@ class mbox_core_t
 		 */
 		outliving_reference_t< so_5::msg_tracing::holder_t > m_msg_tracing_stuff;
 
-		//! Named mbox map's lock.
-		std::mutex m_dictionary_lock;
-
 		//! Named mbox information.
 		struct named_mbox_info_t
 		{
@@ -186,12 +227,70 @@ class mbox_core_t
 			mbox_t m_mbox;
 		};
 
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Hasher which uses precalculated hash value of mbox name.
+		 */
+		struct name_handle_hash_t
+		{
+			std::size_t
+			operator()( const mbox_name_handle_t & name ) const
+			{
+				return name.hash();
+			}
+		};
+
 		//! Typedef for the map from the mbox name to the mbox information.
-		typedef std::map< std::string, named_mbox_info_t >
+		typedef std::unordered_map<
+				mbox_name_handle_t,
+				named_mbox_info_t,
+				name_handle_hash_t >
 			named_mboxes_dictionary_t;
 
-		//! Named mboxes.
-		named_mboxes_dictionary_t m_named_mboxes_dictionary;
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief A part of dictionary of named mboxes with its own lock.
+		 */
+		struct dictionary_shard_t
+		{
+			//! Shard's lock.
+			std::mutex m_lock;
+
+			//! Named mboxes.
+			named_mboxes_dictionary_t m_mboxes;
+		};
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Count of shards in dictionary of named mboxes.
+		 */
+		static const std::size_t dictionary_shards_count = 32;
+
+		/*!
+		 * \brief Dictionary of named mboxes.
+		 *
+		 * \note Since v.5.5.25 the dictionary is divided into shards.
+		 * A shard for a name is selected by the hash value of the name.
+		 */
+		dictionary_shard_t m_dictionary[ dictionary_shards_count ];
+
+		/*!
+		 * \since
+		 * v.5.5.25
+		 *
+		 * \brief Get the shard for the mbox name.
+		 */
+		dictionary_shard_t &
+		shard_for( const mbox_name_handle_t & name )
+		{
+			return m_dictionary[ name.hash() % dictionary_shards_count ];
+		}
 
 		/*!
 		 * \since
@@ -210,7 +309,7 @@ class mbox_core_t
 		mbox_t
 		create_named_mbox(
 			//! Mbox name.
-			nonempty_name_t nonempty_name,
+			const mbox_name_handle_t & name,
 			//! Functional object to create new instance of mbox.
 			//! Must have a prototype: mbox_t factory().
 			const std::function< mbox_t() > & factory );
@@ -432,46 +432,49 @@ class mchain_template
 			{
 				std::unique_lock< std::mutex > lock{ m_lock };
 
-				// If queue is empty we must wait for some time.
-				bool queue_empty = m_queue.is_empty();
-				if( queue_empty )
-					{
-						if( details::status::closed == m_status )
-							// Waiting for new messages has no sence because
-							// chain is closed.
-							return extraction_status_t::chain_closed;
+				const auto status = wait_for_not_empty_queue(
+						lock, empty_queue_timeout );
+				if( extraction_status_t::msg_extracted != status )
+					return status;
 
-						auto predicate = [this, &queue_empty]() -> bool {
-								queue_empty = m_queue.is_empty();
-								return !queue_empty ||
-										details::status::closed == m_status;
-							};
+				return extract_demand_from_not_empty_queue( dest );
+			}
 
-						// Count of sleeping thread must be incremented before
-						// going to sleep and decremented right after.
-						++m_threads_to_wakeup;
-						auto decrement_threads = so_5::details::at_scope_exit(
-								[this] { --m_threads_to_wakeup; } );
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_demands,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
+				if( !max_demands )
+					return extraction_status_t::no_messages;
 
-						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
-							// A wait with finite timeout must be performed.
-							m_underflow_cond.wait_for(
-									lock, empty_queue_timeout, predicate );
-						else
-							// Wait until arrival of any message or closing of chain.
-							m_underflow_cond.wait( lock, predicate );
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				const auto status = wait_for_not_empty_queue(
+						lock, empty_queue_timeout );
+				if( extraction_status_t::msg_extracted != status )
+					return status;
+
+				// If queue was full then someone can wait on it.
+				const bool queue_was_full = m_queue.is_full();
+				do
+					{
+						auto & d = dest[ extracted ];
+						d = std::move( m_queue.front() );
+						m_queue.pop_front();
+						++extracted;
+
+						this->trace_extracted_demand( *this, d );
 					}
+				while( extracted != max_demands && !m_queue.is_empty() );
 
-				// If queue is still empty nothing can be extracted and
-				// we must stop operation.
-				if( queue_empty )
-					return details::status::open == m_status ?
-							// The chain is still open so there must be this result
-							extraction_status_t::no_messages :
-							// The chain is closed and there must be different result
-							extraction_status_t::chain_closed;
+				if( queue_was_full )
+					m_overflow_cond.notify_all();
 
-				return extract_demand_from_not_empty_queue( dest );
+				return extraction_status_t::msg_extracted;
 			}
 
 		virtual bool
@@ -479,7 +482,6 @@ class mchain_template
 			{
 				return m_queue.is_empty();
 			}
-
 		virtual std::size_t
 		size() const override
 			{
@@ -812,6 +814,64 @@ class mchain_template
 						demand_type );
 			}
 
+		/*!
+		 * \brief Wait for a message in the empty queue.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 *
+		 * \retval extraction_status_t::msg_extracted if the queue
+		 * is not empty and a message can be extracted from it.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		extraction_status_t
+		wait_for_not_empty_queue(
+			std::unique_lock< std::mutex > & lock,
+			duration_t empty_queue_timeout )
+			{
+				// If queue is empty we must wait for some time.
+				bool queue_empty = m_queue.is_empty();
+				if( queue_empty )
+					{
+						if( details::status::closed == m_status )
+							// Waiting for new messages has no sence because
+							// chain is closed.
+							return extraction_status_t::chain_closed;
+
+						auto predicate = [this, &queue_empty]() -> bool {
+								queue_empty = m_queue.is_empty();
+								return !queue_empty ||
+										details::status::closed == m_status;
+							};
+
+						// Count of sleeping thread must be incremented before
+						// going to sleep and decremented right after.
+						++m_threads_to_wakeup;
+						auto decrement_threads = so_5::details::at_scope_exit(
+								[this] { --m_threads_to_wakeup; } );
+
+						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
+							// A wait with finite timeout must be performed.
+							m_underflow_cond.wait_for(
+									lock, empty_queue_timeout, predicate );
+						else
+							// Wait until arrival of any message or closing of chain.
+							m_underflow_cond.wait( lock, predicate );
+					}
+
+				// If queue is still empty nothing can be extracted and
+				// we must stop operation.
+				if( queue_empty )
+					return details::status::open == m_status ?
+							// The chain is still open so there must be this result
+							extraction_status_t::no_messages :
+							// The chain is closed and there must be different result
+							extraction_status_t::chain_closed;
+
+				return extraction_status_t::msg_extracted;
+			}
+
 		/*!
 		 * \brief Implementation of extract operation for the case when
 		 * message queue is not empty.
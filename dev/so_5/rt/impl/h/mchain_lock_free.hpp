@@ -0,0 +1,1159 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \file
+ * \brief Implementation details for lock-free message chains.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/mchain_details.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <so_5/details/h/remaining_time_counter.hpp>
+#include <so_5/details/h/abort_on_fatal_error.hpp>
+#include <so_5/details/h/invoke_noexcept_code.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// cache_line_size
+//
+/*!
+ * \brief Size of cache line to be used for separation of hot data.
+ *
+ * \since
+ * v.5.5.25
+ */
+const std::size_t cache_line_size = 64;
+
+//
+// lock_free_mpmc_demand_queue
+//
+/*!
+ * \brief Bounded lock-free queue of demands for many producers and
+ * many consumers.
+ *
+ * This is an implementation of bounded MPMC queue by Dmitry Vyukov.
+ * Every cell has a sequence number which tells whether the cell is
+ * ready for writing or for reading at the current position.
+ *
+ * Positions are never wrapped, an index of a cell is calculated as
+ * position modulo capacity. Because of that capacity needn't to be
+ * a power of two.
+ *
+ * \since
+ * v.5.5.25
+ */
+class lock_free_mpmc_demand_queue
+	{
+	public :
+		//! Can items be extracted only by one thread?
+		static const bool single_consumer = false;
+
+		//! Initializing constructor.
+		lock_free_mpmc_demand_queue(
+			const capacity_t & capacity )
+			:	m_capacity{ capacity.max_size() }
+			,	m_cells{ new cell_t[ capacity.max_size() ] }
+			{
+				for( std::size_t i = 0; i != m_capacity; ++i )
+					m_cells[ i ].m_sequence.store( i, std::memory_order_relaxed );
+			}
+
+		lock_free_mpmc_demand_queue(
+			const lock_free_mpmc_demand_queue & ) = delete;
+		lock_free_mpmc_demand_queue &
+		operator=( const lock_free_mpmc_demand_queue & ) = delete;
+
+		//! An attempt to add a new item to the end of the queue.
+		/*!
+		 * \retval false if the queue is full.
+		 */
+		bool
+		try_push(
+			//! A demand to be stored.
+			//! It is not modified if the queue is full.
+			demand_t && demand,
+			//! Receives true if the queue was empty before the push.
+			//! Can be nullptr if this information is not needed.
+			bool * was_empty )
+			{
+				cell_t * cell;
+				auto pos = m_enqueue_pos.load( std::memory_order_relaxed );
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const auto seq = cell->m_sequence.load(
+								std::memory_order_acquire );
+						const auto diff = static_cast< std::ptrdiff_t >( seq - pos );
+						if( 0 == diff )
+							{
+								if( m_enqueue_pos.compare_exchange_weak(
+										pos, pos + 1, std::memory_order_relaxed ) )
+									break;
+							}
+						else if( diff < 0 )
+							return false;
+						else
+							pos = m_enqueue_pos.load( std::memory_order_relaxed );
+					}
+
+				cell->m_demand = std::move(demand);
+				cell->m_sequence.store( pos + 1, std::memory_order_release );
+
+				if( was_empty )
+					*was_empty = pos == m_dequeue_pos.load( std::memory_order_acquire );
+
+				return true;
+			}
+
+		//! An attempt to extract the front item from the queue.
+		/*!
+		 * \retval false if the queue is empty.
+		 */
+		bool
+		try_pop( demand_t & dest )
+			{
+				cell_t * cell;
+				auto pos = m_dequeue_pos.load( std::memory_order_relaxed );
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const auto seq = cell->m_sequence.load(
+								std::memory_order_acquire );
+						const auto diff = static_cast< std::ptrdiff_t >(
+								seq - (pos + 1) );
+						if( 0 == diff )
+							{
+								if( m_dequeue_pos.compare_exchange_weak(
+										pos, pos + 1, std::memory_order_relaxed ) )
+									break;
+							}
+						else if( diff < 0 )
+							return false;
+						else
+							pos = m_dequeue_pos.load( std::memory_order_relaxed );
+					}
+
+				dest = std::move( cell->m_demand );
+				cell->m_sequence.store( pos + m_capacity, std::memory_order_release );
+
+				return true;
+			}
+
+		//! Size of the queue.
+		/*!
+		 * \note The value can be out of date if there are
+		 * concurrent operations with the queue.
+		 */
+		std::size_t
+		size() const
+			{
+				const auto head = m_dequeue_pos.load( std::memory_order_acquire );
+				const auto tail = m_enqueue_pos.load( std::memory_order_acquire );
+
+				if( tail <= head )
+					return 0u;
+
+				const auto result = tail - head;
+				return result < m_capacity ? result : m_capacity;
+			}
+
+		//! Max size of the queue.
+		std::size_t
+		capacity() const { return m_capacity; }
+
+	private :
+		//! Type of one cell of the queue.
+		struct cell_t
+			{
+				//! Position for which the cell is ready.
+				std::atomic< std::size_t > m_sequence;
+				//! Value in the cell.
+				demand_t m_demand;
+			};
+
+		//! Max size of the queue.
+		const std::size_t m_capacity;
+
+		//! Queue's storage.
+		const std::unique_ptr< cell_t[] > m_cells;
+
+		char m_pad_before_enqueue[ cache_line_size ];
+
+		//! Position for the next push operation.
+		std::atomic< std::size_t > m_enqueue_pos{ 0u };
+
+		char m_pad_before_dequeue[ cache_line_size - sizeof(std::size_t) ];
+
+		//! Position for the next pop operation.
+		std::atomic< std::size_t > m_dequeue_pos{ 0u };
+
+		char m_pad_after_dequeue[ cache_line_size - sizeof(std::size_t) ];
+	};
+
+//
+// lock_free_spsc_demand_queue
+//
+/*!
+ * \brief Bounded wait-free queue of demands for one producer and
+ * one consumer.
+ *
+ * A ring buffer with head and tail positions. The tail is modified only
+ * by the producer, the head is modified only by the consumer.
+ *
+ * Every side holds a cached copy of the position of the other side.
+ * The actual position is read only when the cached value shows that
+ * the queue is full (for the producer) or empty (for the consumer).
+ * It means that cache lines with positions are not transferred between
+ * cores on every operation.
+ *
+ * \attention try_push() must be called only by one thread at a time.
+ * The same is true for try_pop().
+ *
+ * \since
+ * v.5.5.25
+ */
+class lock_free_spsc_demand_queue
+	{
+	public :
+		//! Can items be extracted only by one thread?
+		static const bool single_consumer = true;
+
+		//! Initializing constructor.
+		lock_free_spsc_demand_queue(
+			const capacity_t & capacity )
+			:	m_capacity{ capacity.max_size() }
+			,	m_items{ new demand_t[ capacity.max_size() ] }
+			{}
+
+		lock_free_spsc_demand_queue(
+			const lock_free_spsc_demand_queue & ) = delete;
+		lock_free_spsc_demand_queue &
+		operator=( const lock_free_spsc_demand_queue & ) = delete;
+
+		//! An attempt to add a new item to the end of the queue.
+		/*!
+		 * \retval false if the queue is full.
+		 */
+		bool
+		try_push(
+			//! A demand to be stored.
+			//! It is not modified if the queue is full.
+			demand_t && demand,
+			//! Receives true if the queue was empty before the push.
+			//! Can be nullptr if this information is not needed.
+			bool * was_empty )
+			{
+				const auto tail = m_tail.load( std::memory_order_relaxed );
+				if( tail - m_cached_head == m_capacity )
+					{
+						m_cached_head = m_head.load( std::memory_order_acquire );
+						if( tail - m_cached_head == m_capacity )
+							return false;
+					}
+
+				m_items[ tail % m_capacity ] = std::move(demand);
+
+				if( was_empty )
+					{
+						// The consumer can't go past the tail, so this check
+						// is precise until the new tail is published.
+						if( m_cached_head != tail )
+							m_cached_head = m_head.load( std::memory_order_acquire );
+						*was_empty = m_cached_head == tail;
+					}
+
+				m_tail.store( tail + 1, std::memory_order_release );
+
+				return true;
+			}
+
+		//! An attempt to extract the front item from the queue.
+		/*!
+		 * \retval false if the queue is empty.
+		 */
+		bool
+		try_pop( demand_t & dest )
+			{
+				const auto head = m_head.load( std::memory_order_relaxed );
+				if( head == m_cached_tail )
+					{
+						m_cached_tail = m_tail.load( std::memory_order_acquire );
+						if( head == m_cached_tail )
+							return false;
+					}
+
+				dest = std::move( m_items[ head % m_capacity ] );
+				m_head.store( head + 1, std::memory_order_release );
+
+				return true;
+			}
+
+		//! Size of the queue.
+		/*!
+		 * \note The value can be out of date if there are
+		 * concurrent operations with the queue.
+		 */
+		std::size_t
+		size() const
+			{
+				const auto head = m_head.load( std::memory_order_acquire );
+				const auto tail = m_tail.load( std::memory_order_acquire );
+
+				return tail <= head ? 0u : tail - head;
+			}
+
+		//! Max size of the queue.
+		std::size_t
+		capacity() const { return m_capacity; }
+
+	private :
+		//! Max size of the queue.
+		const std::size_t m_capacity;
+
+		//! Queue's storage.
+		const std::unique_ptr< demand_t[] > m_items;
+
+		char m_pad_before_producer[ cache_line_size ];
+
+		//! Position for the next push operation.
+		/*!
+		 * Modified only by the producer.
+		 */
+		std::atomic< std::size_t > m_tail{ 0u };
+		//! The last known value of m_head.
+		/*!
+		 * Used only by the producer.
+		 */
+		std::size_t m_cached_head{ 0u };
+
+		char m_pad_before_consumer[ cache_line_size - 2 * sizeof(std::size_t) ];
+
+		//! Position for the next pop operation.
+		/*!
+		 * Modified only by the consumer.
+		 */
+		std::atomic< std::size_t > m_head{ 0u };
+		//! The last known value of m_tail.
+		/*!
+		 * Used only by the consumer.
+		 */
+		std::size_t m_cached_tail{ 0u };
+
+		char m_pad_after_consumer[ cache_line_size - 2 * sizeof(std::size_t) ];
+	};
+
+//
+// adaptive_spin_limit_t
+//
+/*!
+ * \brief Limit of spinning before going to sleep on empty chain.
+ *
+ * The limit is doubled if a message was received during spinning and is
+ * halved if spinning was useless. It means that consumers spin longer
+ * if messages arrive often and do not burn CPU if messages are rare.
+ *
+ * \note Races on update of the limit are not important.
+ *
+ * \since
+ * v.5.5.25
+ */
+class adaptive_spin_limit_t
+	{
+		static const unsigned int min_limit = 16u;
+		static const unsigned int max_limit = 4096u;
+
+		std::atomic< unsigned int > m_limit{ 256u };
+
+	public :
+		unsigned int
+		current() const
+			{
+				return m_limit.load( std::memory_order_relaxed );
+			}
+
+		void
+		on_success()
+			{
+				const auto v = current();
+				if( v < max_limit )
+					m_limit.store( v * 2u, std::memory_order_relaxed );
+			}
+
+		void
+		on_failure()
+			{
+				const auto v = current();
+				if( v > min_limit )
+					m_limit.store( v / 2u, std::memory_order_relaxed );
+			}
+	};
+
+} /* namespace details */
+
+//
+// lock_free_mchain_template
+//
+/*!
+ * \brief Template-based implementation of message chain with
+ * lock-free queue of demands.
+ *
+ * Producers and consumers work with the queue without acquiring any
+ * lock. The chain's lock is used only for:
+ *
+ * - sleeping of consumers on empty chain and of producers on full chain.
+ *   Consumers spin for some time before going to sleep;
+ * - registration of select_cases for multi chain select;
+ * - closing of the chain.
+ *
+ * A producer acquires the lock only if there are sleeping consumers or
+ * waiting select operations. A consumer acquires the lock only if there
+ * are producers waiting for free space in the chain.
+ *
+ * \note A message sent concurrently with close() can be stored to
+ * the chain even if close_mode_t::drop_content is used.
+ *
+ * If Queue allows only one consumer then close() with
+ * close_mode_t::drop_content doesn't remove demands from the queue by
+ * itself. The chain is marked instead and the demands are removed by
+ * the consumer at the next extraction attempt.
+ *
+ * \tparam Queue type of lock-free demand queue for message chain.
+ * \tparam Tracing_Base type with message tracing implementation details.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< typename Queue, typename Tracing_Base >
+class lock_free_mchain_template
+	:	public abstract_message_chain_t
+	,	private Tracing_Base
+	{
+	public :
+		//! Initializing constructor.
+		template< typename... Tracing_Args >
+		lock_free_mchain_template(
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for Tracing_Base's constructor.
+			Tracing_Args &&... tracing_args )
+			:	Tracing_Base( std::forward<Tracing_Args>(tracing_args)... )
+			,	m_env( env )
+			,	m_id( id )
+			,	m_capacity( params.capacity() )
+			,	m_not_empty_notificator( params.not_empty_notificator() )
+			,	m_queue( params.capacity() )
+			{}
+
+		virtual mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			const so_5::message_limit::control_block_t * /*limit*/,
+			agent_t * /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_subscriptions,
+						"mchain doesn't suppor subscription" );
+			}
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & /*msg_type*/,
+			agent_t * /*subscriber*/ ) override
+			{}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mchain:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		virtual mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*overlimit_reaction_deep*/ ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_message() lost const in v.5.6.0.
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::event );
+			}
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*overlimit_reaction_deep*/ ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_service_request() lost const in v.5.6.0.
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::service_request );
+			}
+
+		void
+		do_deliver_enveloped_msg(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*overlimit_reaction_deep*/ ) override
+			{
+				try_to_store_message_to_queue(
+						msg_type,
+						message,
+						invocation_type_t::enveloped_msg );
+			}
+
+		/*!
+		 * \attention Will throw an exception because delivery
+		 * filter is not applicable to MPSC-mboxes.
+		 */
+		virtual void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			agent_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_delivery_filters,
+						"set_delivery_filter is called for mchain" );
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			agent_t & /*subscriber*/ ) SO_5_NOEXCEPT override
+			{}
+
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout ) override
+			{
+				if( try_extract( dest ) )
+					return on_demand_extracted( dest );
+
+				if( details::is_no_wait_timevalue( empty_queue_timeout ) )
+					return is_closed() ?
+							extraction_status_t::chain_closed :
+							extraction_status_t::no_messages;
+
+				// Spinning for some time before going to sleep.
+				const auto spin_limit = m_spin_limit.current();
+				pause_backoff_t backoff;
+				for( unsigned int i = 0; i != spin_limit && !is_closed(); ++i )
+					{
+						backoff();
+						if( try_extract( dest ) )
+							{
+								m_spin_limit.on_success();
+								return on_demand_extracted( dest );
+							}
+					}
+				m_spin_limit.on_failure();
+
+				const auto status = wait_and_extract( dest, empty_queue_timeout );
+				if( extraction_status_t::msg_extracted == status )
+					return on_demand_extracted( dest );
+
+				return status;
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_demands,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
+				if( !max_demands )
+					return extraction_status_t::no_messages;
+
+				const auto status = extract( dest[ 0 ], empty_queue_timeout );
+				if( extraction_status_t::msg_extracted == status )
+					{
+						extracted = 1u;
+
+						// Other demands are extracted without waiting.
+						// Sleeping producers are notified only once for all of them.
+						while( extracted != max_demands &&
+								try_extract( dest[ extracted ] ) )
+							{
+								this->trace_extracted_demand( *this, dest[ extracted ] );
+								++extracted;
+							}
+
+						if( 1u != extracted )
+							notify_sleeping_producers();
+					}
+
+				return status;
+			}
+
+		virtual bool
+		empty() const override
+			{
+				return 0u == size();
+			}
+
+		virtual std::size_t
+		size() const override
+			{
+				return is_content_dropped() ? 0u : m_queue.size();
+			}
+
+		virtual void
+		close( close_mode_t mode ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( is_closed() )
+					return;
+
+				m_closed.store( true, std::memory_order_release );
+
+				if( close_mode_t::drop_content == mode )
+					{
+						if( Queue::single_consumer )
+							// Demands will be removed by the consumer.
+							m_content_dropped.store( true, std::memory_order_release );
+						else
+							drop_content();
+					}
+
+				// All waiting parties must be informed that no new
+				// messages will be here.
+				notify_multi_chain_select_ops();
+				m_underflow_cond.notify_all();
+				m_overflow_cond.notify_all();
+			}
+
+		virtual environment_t &
+		environment() const override
+			{
+				return m_env;
+			}
+
+	protected :
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			select_case_t & select_case ) override
+			{
+				if( try_extract( dest ) )
+					return on_demand_extracted( dest );
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				// select_case must be registered before the next attempt.
+				// Otherwise a notification from a producer can be lost.
+				select_case.set_next( m_select_tail );
+				m_select_tail = &select_case;
+				m_has_select_cases.store( true, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				const bool extracted = try_extract( dest );
+				if( extracted || is_closed() )
+					{
+						// select_case is still at the head of the queue.
+						m_select_tail = select_case.giveout_next();
+						if( !m_select_tail )
+							m_has_select_cases.store( false, std::memory_order_relaxed );
+
+						lock.unlock();
+
+						if( extracted )
+							return on_demand_extracted( dest );
+						else
+							return extraction_status_t::chain_closed;
+					}
+
+				return extraction_status_t::no_messages;
+			}
+
+		virtual void
+		remove_from_select(
+			select_case_t & select_case ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				select_case_t * c = m_select_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &select_case )
+							{
+								if( prev )
+									prev->set_next( next );
+								else
+									m_select_tail = next;
+
+								if( !m_select_tail )
+									m_has_select_cases.store(
+											false, std::memory_order_relaxed );
+
+								return;
+							}
+
+						prev = c;
+						c = next;
+					}
+			}
+
+		virtual void
+		do_deliver_message_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t & message ) override
+			{
+				const auto invocation_type =
+						message_t::kind_t::enveloped_msg == message_kind( message ) ?
+						invocation_type_t::enveloped_msg : invocation_type_t::event;
+
+				try_to_store_message_from_timer_to_queue(
+						msg_type,
+						message,
+						invocation_type );
+			}
+
+	private :
+		//! SObjectizer Environment for which message chain is created.
+		environment_t & m_env;
+
+		//! Mbox ID for chain.
+		const mbox_id_t m_id;
+
+		//! Chain capacity.
+		const capacity_t m_capacity;
+
+		//! Optional notificator for 'not_empty' condition.
+		const not_empty_notification_func_t m_not_empty_notificator;
+
+		//! Chain's demands queue.
+		Queue m_queue;
+
+		//! Is the chain closed?
+		std::atomic< bool > m_closed{ false };
+
+		//! Must the content of the chain be dropped by the consumer?
+		/*!
+		 * Used only if Queue allows only one consumer.
+		 */
+		std::atomic< bool > m_content_dropped{ false };
+
+		//! Limit for spinning on empty chain.
+		details::adaptive_spin_limit_t m_spin_limit;
+
+		//! Count of consumers sleeping on empty chain.
+		std::atomic< std::size_t > m_sleeping_consumers{ 0u };
+
+		//! Count of producers sleeping on full chain.
+		std::atomic< std::size_t > m_sleeping_producers{ 0u };
+
+		//! Is there any select_case in m_select_tail?
+		/*!
+		 * It is modified only when m_lock is acquired. But it is read
+		 * by producers without acquiring the lock.
+		 */
+		std::atomic< bool > m_has_select_cases{ false };
+
+		//! Chain's lock.
+		std::mutex m_lock;
+
+		//! Condition variable for waiting on empty queue.
+		std::condition_variable m_underflow_cond;
+		//! Condition variable for waiting on full queue.
+		std::condition_variable m_overflow_cond;
+
+		//! A queue of multi-chain selects in which this chain is used.
+		select_case_t * m_select_tail = nullptr;
+
+		bool
+		is_closed() const
+			{
+				return m_closed.load( std::memory_order_acquire );
+			}
+
+		bool
+		is_content_dropped() const
+			{
+				return Queue::single_consumer &&
+						m_content_dropped.load( std::memory_order_acquire );
+			}
+
+		//! Remove all demands from the queue.
+		void
+		drop_content()
+			{
+				demand_t demand;
+				while( m_queue.try_pop( demand ) )
+					this->trace_demand_drop_on_close( *this, demand );
+			}
+
+		//! An attempt to extract a demand on the consumer side.
+		/*!
+		 * \retval false if there is no demand to be extracted.
+		 */
+		bool
+		try_extract( demand_t & dest )
+			{
+				if( is_content_dropped() )
+					{
+						drop_content();
+						return false;
+					}
+
+				return m_queue.try_pop( dest );
+			}
+
+		//! Sleeping on empty chain with an attempt to extract a demand.
+		extraction_status_t
+		wait_and_extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout )
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				// Count of sleeping consumers must be incremented before
+				// the next attempt to extract a demand. Otherwise
+				// a notification from a producer can be lost.
+				++m_sleeping_consumers;
+				auto decrement_consumers = so_5::details::at_scope_exit(
+						[this] { --m_sleeping_consumers; } );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				const bool infinite_wait =
+						details::is_infinite_wait_timevalue( empty_queue_timeout );
+				so_5::details::remaining_time_counter_t time_counter{
+						empty_queue_timeout };
+
+				auto predicate = [this] {
+						return 0u != m_queue.size() || is_closed();
+					};
+
+				for(;;)
+					{
+						if( try_extract( dest ) )
+							return extraction_status_t::msg_extracted;
+
+						if( is_closed() )
+							return extraction_status_t::chain_closed;
+
+						if( infinite_wait )
+							m_underflow_cond.wait( lock, predicate );
+						else
+							{
+								if( !time_counter )
+									return extraction_status_t::no_messages;
+
+								m_underflow_cond.wait_for(
+										lock, time_counter.remaining(), predicate );
+								time_counter.update();
+							}
+					}
+			}
+
+		//! Get a receiver for 'queue was empty' flag.
+		/*!
+		 * This flag is necessary only for 'not_empty' notificator.
+		 * An attempt to detect the emptiness of the queue is not performed
+		 * at all if there is no notificator.
+		 */
+		bool *
+		was_empty_receiver( bool & was_empty ) const
+			{
+				return m_not_empty_notificator ? &was_empty : nullptr;
+			}
+
+		//! Sleeping on full chain with an attempt to store a demand.
+		/*!
+		 * \retval true if the demand is stored.
+		 */
+		bool
+		wait_and_push(
+			demand_t & demand,
+			bool * was_empty )
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				++m_sleeping_producers;
+				auto decrement_producers = so_5::details::at_scope_exit(
+						[this] { --m_sleeping_producers; } );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				so_5::details::remaining_time_counter_t time_counter{
+						m_capacity.overflow_timeout() };
+
+				auto predicate = [this] {
+						return m_queue.size() < m_queue.capacity() || is_closed();
+					};
+
+				for(;;)
+					{
+						if( is_closed() )
+							return false;
+
+						if( m_queue.try_push( std::move(demand), was_empty ) )
+							return true;
+
+						if( !time_counter )
+							return false;
+
+						m_overflow_cond.wait_for(
+								lock, time_counter.remaining(), predicate );
+						time_counter.update();
+					}
+			}
+
+		//! Actual implementation of pushing message to the queue.
+		void
+		try_to_store_message_to_queue(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type )
+			{
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type };
+
+				// Message cannot be stored to closed chain.
+				if( is_closed() )
+					return;
+
+				demand_t demand{ msg_type, message, demand_type };
+				bool was_empty = false;
+				bool * const was_empty_ptr = was_empty_receiver( was_empty );
+
+				bool stored = m_queue.try_push( std::move(demand), was_empty_ptr );
+				if( !stored && m_capacity.is_overflow_timeout_defined() )
+					{
+						stored = wait_and_push( demand, was_empty_ptr );
+						if( !stored && is_closed() )
+							return;
+					}
+
+				if( !stored )
+					{
+						const auto reaction = m_capacity.overflow_reaction();
+						if( overflow_reaction_t::drop_newest == reaction )
+							{
+								tracer.overflow_drop_newest();
+								return;
+							}
+						else if( overflow_reaction_t::remove_oldest == reaction )
+							push_with_removing_oldest( tracer, demand, was_empty_ptr );
+						else if( overflow_reaction_t::throw_exception == reaction )
+							{
+								tracer.overflow_throw_exception();
+								SO_5_THROW_EXCEPTION(
+										rc_msg_chain_overflow,
+										"an attempt to push message to full mchain "
+										"with overflow_reaction_t::throw_exception policy" );
+							}
+						else
+							abort_on_overflow( tracer, msg_type );
+					}
+
+				complete_store_message_to_queue( tracer, was_empty );
+			}
+
+		/*!
+		 * \brief An implementation of storing another message to
+		 * chain for the case of delated/periodic messages.
+		 *
+		 * There is no waiting on full chain and
+		 * overflow_reaction_t::throw_exception is replaced by
+		 * overflow_reaction_t::drop_newest. The same rules are used
+		 * for ordinary mchain.
+		 */
+		void
+		try_to_store_message_from_timer_to_queue(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type )
+			{
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type };
+
+				// Message cannot be stored to closed chain.
+				if( is_closed() )
+					return;
+
+				demand_t demand{ msg_type, message, demand_type };
+				bool was_empty = false;
+				bool * const was_empty_ptr = was_empty_receiver( was_empty );
+
+				if( !m_queue.try_push( std::move(demand), was_empty_ptr ) )
+					{
+						const auto reaction = m_capacity.overflow_reaction();
+						if( overflow_reaction_t::drop_newest == reaction ||
+								overflow_reaction_t::throw_exception == reaction )
+							{
+								tracer.overflow_drop_newest();
+								return;
+							}
+						else if( overflow_reaction_t::remove_oldest == reaction )
+							push_with_removing_oldest( tracer, demand, was_empty_ptr );
+						else
+							abort_on_overflow( tracer, msg_type );
+					}
+
+				complete_store_message_to_queue( tracer, was_empty );
+			}
+
+		//! Store a demand by removing the oldest demands from the chain.
+		void
+		push_with_removing_oldest(
+			typename Tracing_Base::deliver_op_tracer & tracer,
+			demand_t & demand,
+			bool * was_empty )
+			{
+				demand_t oldest;
+				do
+					{
+						if( m_queue.try_pop( oldest ) )
+							{
+								tracer.overflow_remove_oldest( oldest );
+								oldest = demand_t{};
+							}
+					}
+				while( !m_queue.try_push( std::move(demand), was_empty ) );
+			}
+
+		//! Reaction to overflow_reaction_t::abort_app.
+		void
+		abort_on_overflow(
+			typename Tracing_Base::deliver_op_tracer & tracer,
+			const std::type_index & msg_type )
+			{
+				so_5::details::abort_on_fatal_error( [&] {
+						tracer.overflow_throw_exception();
+						SO_5_LOG_ERROR( m_env, log_stream ) {
+							log_stream << "overflow_reaction_t::abort_app "
+									"will be performed for mchain (id="
+									<< m_id << "), msg_type: "
+									<< msg_type.name()
+									<< ". Application will be aborted"
+									<< std::endl;
+						}
+					} );
+			}
+
+		//! The last part of storing a message into chain.
+		void
+		complete_store_message_to_queue(
+			typename Tracing_Base::deliver_op_tracer & tracer,
+			bool was_empty )
+			{
+				tracer.stored( m_queue );
+
+				if( was_empty && m_not_empty_notificator )
+					so_5::details::invoke_noexcept_code(
+						[this] { m_not_empty_notificator(); } );
+
+				// Sleeping consumers and waiting select operations must
+				// be notified. The lock is acquired only if there are
+				// such waiting parties.
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_sleeping_consumers.load( std::memory_order_relaxed ) ||
+						m_has_select_cases.load( std::memory_order_relaxed ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+
+						notify_multi_chain_select_ops();
+						m_underflow_cond.notify_one();
+					}
+			}
+
+		//! Actions to be performed after extraction of a demand.
+		extraction_status_t
+		on_demand_extracted( demand_t & dest )
+			{
+				this->trace_extracted_demand( *this, dest );
+
+				notify_sleeping_producers();
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		//! Wake up producers waiting for free space in the chain.
+		void
+		notify_sleeping_producers()
+			{
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_sleeping_producers.load( std::memory_order_relaxed ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+						m_overflow_cond.notify_all();
+					}
+			}
+
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		notify_multi_chain_select_ops() SO_5_NOEXCEPT
+			{
+				if( m_select_tail )
+					{
+						auto old = m_select_tail;
+						m_select_tail = nullptr;
+						m_has_select_cases.store( false, std::memory_order_relaxed );
+						old->notify();
+					}
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
+
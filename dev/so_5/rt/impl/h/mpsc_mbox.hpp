@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <so_5/h/types.hpp>
 #include <so_5/h/exception.hpp>
 #include <so_5/h/spinlocks.hpp>
@@ -137,6 +139,46 @@ class limitless_mpsc_mbox_template
 				} );
 			}
 
+		/*!
+		 * \note All messages are pushed to the event queue of the
+		 * consumer by one operation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_Base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, messages[ i ], overlimit_reaction_deep };
+
+						if( m_subscriptions_count )
+							tracer.push_to_queue( m_single_consumer );
+						else
+							tracer.no_subscribers();
+					}
+
+				if( m_subscriptions_count )
+					agent_t::call_push_events(
+							*m_single_consumer,
+							message_limit::control_block_t::none(),
+							m_id,
+							msg_type,
+							messages,
+							count );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -361,6 +403,89 @@ class limitful_mpsc_mbox_template
 				} );
 			}
 
+		/*!
+		 * \note Message limit is searched only once. All messages
+		 * accepted by the message limit are pushed to the event queue
+		 * of the consumer by one operation.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				auto limit = m_limits.find( msg_type );
+				if( !limit )
+					{
+						// There is no limit for that message type.
+						base_type::do_deliver_messages(
+								msg_type, messages, count, overlimit_reaction_deep );
+						return;
+					}
+
+				using namespace so_5::message_limit::impl;
+
+				// Messages accepted by the message limit.
+				std::vector< message_ref_t > accepted;
+				accepted.reserve( count );
+
+				read_lock_guard_t< default_rw_spinlock_t > lock{ this->m_lock };
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						const message_ref_t & message = messages[ i ];
+
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_Base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, message, overlimit_reaction_deep };
+
+						if( this->m_subscriptions_count )
+							try_to_deliver_to_agent(
+									this->m_id,
+									invocation_type_t::event,
+									*(this->m_single_consumer),
+									limit,
+									msg_type,
+									message,
+									overlimit_reaction_deep,
+									tracer.overlimit_tracer(),
+									[&] {
+										tracer.push_to_queue( this->m_single_consumer );
+
+										accepted.push_back( message );
+									} );
+						else
+							tracer.no_subscribers();
+					}
+
+				if( accepted.empty() )
+					return;
+
+				try
+					{
+						agent_t::call_push_events(
+								*(this->m_single_consumer),
+								limit,
+								this->m_id,
+								msg_type,
+								accepted.data(),
+								accepted.size() );
+					}
+				catch( ... )
+					{
+						// Messages have been counted by try_to_deliver_to_agent
+						// but they are not in the event queue.
+						limit->m_count -= static_cast< unsigned int >( accepted.size() );
+						throw;
+					}
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
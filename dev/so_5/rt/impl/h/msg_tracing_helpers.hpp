@@ -27,6 +27,9 @@
 
 #include <sstream>
 #include <tuple>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 #if defined( SO_5_MSVC )
 	#pragma warning(push)
@@ -194,6 +197,15 @@ fill_trace_data_1( actual_trace_data_t & d, current_thread_id_t tid )
 		d.set_tid( tid );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	current_thread_id_t tid )
+	{
+		r.m_tid = std::hash< std::thread::id >{}(
+				raw_id_from_current_thread_id( tid ) );
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, mbox_identification id )
 	{
@@ -209,6 +221,14 @@ fill_trace_data_1( actual_trace_data_t & d, mbox_identification id )
 						so_5::msg_tracing::msg_source_type_t::unknown } );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	mbox_identification id )
+	{
+		r.m_mbox_id = id.m_id;
+	}
+
 
 inline void
 make_trace_to_1( std::ostream & s, mchain_identification id )
@@ -225,6 +245,14 @@ fill_trace_data_1( actual_trace_data_t & d, mchain_identification id )
 						so_5::msg_tracing::msg_source_type_t::mchain } );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	mchain_identification id )
+	{
+		r.m_mbox_id = id.m_id;
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -244,6 +272,14 @@ fill_trace_data_1(
 						so_5::msg_tracing::msg_source_type_t::mbox } );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	const mbox_as_msg_source & mbox )
+	{
+		r.m_mbox_id = mbox.m_mbox.id();
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -260,6 +296,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const mbox_as_msg_destination & /*mbox*/ )
+	{
+		// The id of the source mbox must be kept in the record.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const abstract_message_chain_t & chain )
 	{
@@ -274,6 +318,14 @@ fill_trace_data_1(
 		fill_trace_data_1( d, mchain_identification{ chain.id() } );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	const abstract_message_chain_t & chain )
+	{
+		r.m_mbox_id = chain.id();
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -290,6 +342,14 @@ fill_trace_data_1(
 		d.set_msg_type( msg_type.m_type );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	const original_msg_type msg_type )
+	{
+		r.m_msg_type = msg_type.m_type.name();
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -306,6 +366,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const type_of_removed_msg /*msg_type*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -322,6 +390,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const type_of_transformed_msg /*msg_type*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const agent_t * agent )
 	{
@@ -334,6 +410,14 @@ fill_trace_data_1( actual_trace_data_t & d, const agent_t * agent )
 		d.set_agent( agent );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	const agent_t * agent )
+	{
+		r.m_agent = agent;
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const state_t * state )
 	{
@@ -348,6 +432,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const state_t * /*state*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const event_handler_data_t * handler )
 	{
@@ -367,6 +459,14 @@ fill_trace_data_1(
 		d.set_event_handler_data_ptr( handler );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const event_handler_data_t * /*handler*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1(
 	std::ostream & s,
@@ -383,6 +483,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const so_5::message_limit::control_block_t * /*limit*/ )
+	{
+		// Just for compilation.
+	}
+
 inline std::tuple<const void *, const void *>
 detect_message_pointers( const message_ref_t & message )
 	{
@@ -455,6 +563,14 @@ fill_trace_data_1(
 			}
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const message_ref_t & /*message*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const overlimit_deep limit )
 	{
@@ -469,6 +585,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const overlimit_deep /*limit*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const composed_action_name name )
 	{
@@ -485,6 +609,15 @@ fill_trace_data_1(
 						name.m_1, name.m_2 } );
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & r,
+	const composed_action_name name )
+	{
+		r.m_action_1 = name.m_1;
+		r.m_action_2 = name.m_2;
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, const text_separator text )
 	{
@@ -499,6 +632,14 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	const text_separator /*text*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to_1( std::ostream & s, chain_size size )
 	{
@@ -513,12 +654,23 @@ fill_trace_data_1(
 		// Just for compilation.
 	}
 
+inline void
+fill_binary_record_1(
+	so_5::msg_tracing::binary_record_t & /*r*/,
+	chain_size /*size*/ )
+	{
+		// Just for compilation.
+	}
+
 inline void
 make_trace_to( std::ostream & ) {}
 
 inline void
 fill_trace_data( actual_trace_data_t & ) {}
 
+inline void
+fill_binary_record( so_5::msg_tracing::binary_record_t & ) {}
+
 template< typename A, typename... Other >
 void
 make_trace_to( std::ostream & s, A && a, Other &&... other )
@@ -535,6 +687,17 @@ fill_trace_data( actual_trace_data_t & d, A && a, Other &&... other )
 		fill_trace_data( d, std::forward< Other >(other)... );
 	}
 
+template< typename A, typename... Other >
+void
+fill_binary_record(
+	so_5::msg_tracing::binary_record_t & r,
+	A && a,
+	Other &&... other )
+	{
+		fill_binary_record_1( r, std::forward< A >(a) );
+		fill_binary_record( r, std::forward< Other >(other)... );
+	}
+
 template< typename... Args >
 void
 make_trace(
@@ -560,6 +723,18 @@ make_trace(
 
 				if( need_trace )
 					{
+						// Since v.5.5.25 the tracer can accept binary records.
+						// In that case there is no need for text formatting.
+						so_5::msg_tracing::binary_record_t record{};
+						record.m_timestamp = static_cast< std::uint64_t >(
+								std::chrono::duration_cast< std::chrono::nanoseconds >(
+									std::chrono::steady_clock::now().time_since_epoch() )
+										.count() );
+						fill_binary_record( record, tid, std::forward<Args>(args)... );
+
+						if( msg_tracing_stuff.tracer().trace_binary( record ) )
+							return;
+
 						// Trace message should go to the tracer.
 						std::ostringstream s;
 
@@ -21,8 +21,16 @@
 
 #include <so_5/rt/stats/impl/h/std_controller.hpp>
 
+#include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
+
+#include <so_5/rt/impl/h/st_env_infrastructure_reuse.hpp>
+
 #include <so_5/h/timers.hpp>
 
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace so_5 {
 
 namespace env_infrastructures {
@@ -49,7 +57,9 @@ class coop_repo_t final : protected ::so_5::impl::coop_repository_basis_t
 			//! SObjectizer Environment.
 			environment_t & env,
 			//! Cooperation action listener.
-			coop_listener_unique_ptr_t coop_listener );
+			coop_listener_unique_ptr_t coop_listener,
+			//! Count of threads for the final deregistration.
+			std::size_t final_dereg_thread_count );
 
 		//! Do initialization.
 		void
@@ -59,13 +69,15 @@ class coop_repo_t final : protected ::so_5::impl::coop_repository_basis_t
 		/*!
 		 * Initiates deregistration of all agents. Waits for complete
 		 * deregistration for all of them. Waits for termination of
-		 * cooperation deregistration thread.
+		 * cooperation deregistration threads.
 		 */
 		void
 		finish();
 
 		using coop_repository_basis_t::register_coop;
 
+		using coop_repository_basis_t::register_coops;
+
 		using coop_repository_basis_t::deregister_coop;
 
 		//! Notification about readiness of the cooperation deregistration.
@@ -80,13 +92,8 @@ class coop_repo_t final : protected ::so_5::impl::coop_repository_basis_t
 		 */
 		bool
 		final_deregister_coop(
-			//! Cooperation name to be deregistered.
-			/*!
-			 * \note
-			 * Cooperation name must be passed by value because
-			 * reference can become invalid during work of this method.
-			*/
-			std::string coop_name );
+			//! Id of cooperation to be deregistered.
+			coop_id_t coop_id );
 
 		//! Initiate start of the cooperation deregistration.
 		void
@@ -134,16 +141,142 @@ class coop_repo_t final : protected ::so_5::impl::coop_repository_basis_t
 		 * \since
 		 * v.5.5.13
 		 *
-		 * \brief A separate thread for doing the final deregistration.
+		 * \brief Separate threads for doing the final deregistration.
+		 *
+		 * \note Actual threads are started inside start() method.
+		 *
+		 * \note Before v.5.5.25 there was just one thread.
+		 */
+		std::vector< std::thread > m_final_dereg_threads;
+
+		/*!
+		 * \since
+		 * v.5.5.25
 		 *
-		 * \note Actual thread is started inside start() method.
+		 * \brief Count of threads for the final deregistration.
 		 */
-		std::thread m_final_dereg_thread;
+		const std::size_t m_final_dereg_thread_count;
 		/*!
 		 * \}
 		 */
 	};
 
+//
+// disp_driven_timer_t
+//
+/*!
+ * \brief An implementation of timer_thread interface without
+ * a dedicated thread.
+ *
+ * Timers are handled by timer_manager. Processing of expired timers
+ * is performed by a work thread of a dispatcher via idle handler
+ * mechanism.
+ *
+ * \note It is intended to be used with one_thread dispatcher only.
+ *
+ * \since
+ * v.5.5.25
+ */
+class disp_driven_timer_t final
+	:	public timer_thread_t
+	,	public so_5::disp::mpsc_queue_traits::idle_handler_t
+	{
+	public :
+		disp_driven_timer_t(
+			//! Logger to be used by timer manager.
+			error_logger_shptr_t error_logger,
+			//! Factory for creation of timer manager.
+			const timer_manager_factory_t & timer_manager_factory );
+
+		/*!
+		 * \name Implementation of timer_thread interface.
+		 * \{
+		 */
+		virtual void
+		start() override;
+
+		virtual void
+		finish() override;
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override;
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override;
+
+		virtual timer_thread_stats_t
+		query_stats() override;
+		/*!
+		 * \}
+		 */
+
+		/*!
+		 * \name Implementation of idle_handler interface.
+		 * \{
+		 */
+		virtual void
+		attach( waker_t * waker ) SO_5_NOEXCEPT override;
+
+		virtual std::chrono::steady_clock::duration
+		on_idle() SO_5_NOEXCEPT override;
+		/*!
+		 * \}
+		 */
+
+	private :
+		//! Object lock.
+		std::mutex m_lock;
+
+		//! Logger for errors inside timer processing.
+		const error_logger_shptr_t m_error_logger;
+
+		//! Collector for elapsed timers.
+		/*!
+		 * \note It is filled under m_lock but processed without it.
+		 * It is safe because on_idle() is called only by one work thread.
+		 */
+		::so_5::env_infrastructures::st_reusable_stuff::actual_elapsed_timers_collector_t
+				m_timers_collector;
+
+		//! Actual timer manager.
+		const timer_manager_unique_ptr_t m_timer_manager;
+
+		//! Waker for the work thread.
+		/*!
+		 * nullptr if the work thread is not started yet or
+		 * already stopped.
+		 */
+		waker_t * m_waker{ nullptr };
+
+		//! Time point at which the work thread will wake up by itself.
+		std::chrono::steady_clock::time_point m_wakeup_at;
+
+		//! Has timer been finished?
+		/*!
+		 * Expired timers are not processed after finish().
+		 */
+		bool m_finished{ false };
+
+		//! Wake up the work thread if the new timer is expired
+		//! before the wake up time.
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		void
+		wake_up_if_necessary(
+			std::chrono::steady_clock::duration pause ) SO_5_NOEXCEPT;
+	};
+
 //
 // mt_env_infrastructure_t
 //
@@ -163,11 +296,18 @@ class mt_env_infrastructure_t
 			//! Parameters for the default dispatcher,
 			so_5::disp::one_thread::disp_params_t default_disp_params,
 			//! Timer thread to be used by environment.
-			timer_thread_unique_ptr_t timer_thread,
+			/*!
+			 * \note Since v.5.5.25 it is a shared_ptr because
+			 * the timer can also be used as idle handler for the
+			 * default dispatcher.
+			 */
+			std::shared_ptr< timer_thread_t > timer_thread,
 			//! Cooperation action listener.
 			coop_listener_unique_ptr_t coop_listener,
 			//! Run-time stats distribution mbox.
-			mbox_t stats_distribution_mbox );
+			mbox_t stats_distribution_mbox,
+			//! Count of threads for the final deregistration of coops.
+			std::size_t final_dereg_thread_count );
 
 		virtual void
 		launch( env_init_t init_fn ) override;
@@ -179,18 +319,27 @@ class mt_env_infrastructure_t
 		register_coop(
 			coop_unique_ptr_t coop ) override;
 
+		virtual void
+		register_coops(
+			std::vector< coop_unique_ptr_t > coops ) override;
+
 		virtual void
 		deregister_coop(
 			nonempty_name_t name,
 			coop_dereg_reason_t dereg_reason ) override;
 
+		virtual void
+		deregister_coop(
+			coop_id_t id,
+			coop_dereg_reason_t dereg_reason ) override;
+
 		virtual void
 		ready_to_deregister_notify(
 			coop_t * coop ) override;
 
 		virtual bool
 		final_deregister_coop(
-			std::string coop_name ) override;
+			coop_id_t coop_id ) override;
 
 		virtual so_5::timer_id_t
 		schedule_timer(
@@ -200,6 +349,15 @@ class mt_env_infrastructure_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override;
 
+		virtual so_5::timer_id_t
+		schedule_coalesced_timer(
+			const std::type_index & type_wrapper,
+			const message_ref_t & msg,
+			const mbox_t & mbox,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period,
+			timer_slack_t slack ) override;
+
 		virtual void
 		single_timer(
 			const std::type_index & type_wrapper,
@@ -232,7 +390,10 @@ class mt_env_infrastructure_t
 		dispatcher_unique_ptr_t m_default_dispatcher;
 
 		//! Timer thread to be used by the environment.
-		timer_thread_unique_ptr_t m_timer_thread;
+		/*!
+		 * \note Since v.5.5.25 it is a shared_ptr.
+		 */
+		std::shared_ptr< timer_thread_t > m_timer_thread;
 
 		//! Repository of registered cooperations.
 		coop_repo_t m_coop_repo;
@@ -40,7 +40,7 @@ class named_local_mbox_t
 		friend class impl::mbox_core_t;
 
 		named_local_mbox_t(
-			const std::string & name,
+			const mbox_name_handle_t & name,
 			const mbox_t & mbox,
 			impl::mbox_core_t & mbox_core );
 
@@ -73,6 +73,13 @@ class named_local_mbox_t
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const override;
 
+		virtual void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override;
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -92,7 +99,10 @@ class named_local_mbox_t
 
 	private:
 		//! Mbox name.
-		const std::string m_name;
+		/*!
+		 * \note It is stored with the hash value since v.5.5.25.
+		 */
+		const mbox_name_handle_t m_name;
 
 		//! An utility for this mbox.
 		impl::mbox_core_ref_t m_mbox_core;
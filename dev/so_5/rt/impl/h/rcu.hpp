@@ -0,0 +1,83 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Simple epoch-based read-copy-update support.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace rcu
+{
+
+//! Enter a read-side critical section.
+/*!
+ * Announces the current epoch for the current thread.
+ * Read-side sections can be nested.
+ *
+ * \note Every call must be paired with leave_read_section().
+ */
+void
+enter_read_section();
+
+//! Leave a read-side critical section.
+void
+leave_read_section() SO_5_NOEXCEPT;
+
+//! Wait for the completion of all read-side sections which have been
+//! started before the call.
+/*!
+ * A writer replaces a pointer to shared data by a pointer to a new
+ * version of the data, calls synchronize() and only then destroys the
+ * old version. It is guaranteed that no reader sees the old version
+ * after the return from synchronize().
+ *
+ * \attention Must not be called from a read-side section. It leads
+ * to a deadlock.
+ */
+void
+synchronize() SO_5_NOEXCEPT;
+
+//
+// read_section_t
+//
+/*!
+ * \brief A helper for entering and leaving a read-side section
+ * in RAII style.
+ */
+class read_section_t
+	{
+	public :
+		read_section_t()
+			{
+				enter_read_section();
+			}
+		~read_section_t()
+			{
+				leave_read_section();
+			}
+
+		read_section_t( const read_section_t & ) = delete;
+		read_section_t &
+		operator=( const read_section_t & ) = delete;
+	};
+
+} /* namespace rcu */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
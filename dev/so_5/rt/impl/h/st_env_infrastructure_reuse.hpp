@@ -27,6 +27,7 @@
 #include <so_5/rt/stats/h/prefix.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 #include <so_5/rt/h/env_infrastructures.hpp>
@@ -123,6 +124,17 @@ class real_activity_tracker_t final
 				result.m_working_stats = m_working.take_stats();
 				result.m_waiting_stats = m_waiting.take_stats();
 
+				return result;
+			}
+
+		stats::work_thread_latency_stats_t
+		take_latency_stats() const
+			{
+				stats::work_thread_latency_stats_t result;
+
+				result.m_working_histogram = m_working.take_histogram();
+				result.m_waiting_histogram = m_waiting.take_histogram();
+
 				return result;
 			}
 	};
@@ -150,6 +162,42 @@ send_thread_activity_stats(
 				stats::suffixes::work_thread_activity(),
 				thread_id,
 				activity_tracker.take_activity_stats() );
+
+		so_5::send< stats::messages::work_thread_latency >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_latency(),
+				thread_id,
+				activity_tracker.take_latency_stats() );
+	}
+
+/*!
+ * \since
+ * v.5.5.25
+ */
+inline void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t &,
+	const stats::prefix_t &,
+	fake_activity_tracker_t & )
+	{
+		/* Nothing to do */
+	}
+
+/*!
+ * \since
+ * v.5.5.25
+ */
+inline void
+collect_thread_activity_stats(
+	stats::snapshot_collector_t & collector,
+	const stats::prefix_t & prefix,
+	real_activity_tracker_t & activity_tracker )
+	{
+		collector.add(
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				activity_tracker.take_activity_stats() );
 	}
 
 //
@@ -174,17 +222,6 @@ class coop_repo_t final
 			coop_listener_unique_ptr_t coop_listener )
 			:	coop_repository_basis_t( env, std::move(coop_listener) )
 			{}
-
-		//! Is there any live coop?
-		bool
-		has_live_coop()
-			{
-				// A lock is necessary here because coop_repo can be used
-				// in thread-safe environment where access to environment from
-				// different thread is allowed.
-				std::lock_guard< std::mutex > l{ lock() };
-				return !( m_registered_coop.empty() && m_deregistered_coop.empty() );
-			}
 	};
 
 //
@@ -437,6 +474,27 @@ class default_disp_impl_t final
 								m_dispatcher.get().activity_tracker() );
 					}
 
+				void
+				collect( stats::snapshot_collector_t & collector ) override
+					{
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								m_dispatcher.get().agents_bound() );
+
+						const auto evt_queue_stats =
+								m_dispatcher.get().event_queue().query_stats();
+						collector.add(
+								m_base_prefix,
+								stats::suffixes::work_thread_queue_size(),
+								evt_queue_stats.m_demands_count );
+
+						collect_thread_activity_stats(
+								collector,
+								m_base_prefix,
+								m_dispatcher.get().activity_tracker() );
+					}
+
 				void
 				set_data_sources_name_base(
 					const std::string & name_base )
@@ -653,6 +711,23 @@ class stats_controller_t final
 				} );
 			}
 
+		virtual void
+		take_snapshot(
+			stats::snapshot_collector_t & collector ) override
+			{
+				this->lock_and_perform( [&] {
+					collector.clear();
+
+					auto s = m_head;
+					while( s )
+						{
+							s->collect( collector );
+
+							s = source_list_next( *s );
+						}
+				} );
+			}
+
 		// Implementation of repository_t interface.
 		virtual void
 		add( stats::source_t & what ) override
@@ -201,6 +201,20 @@ class subscription_storage_t
 		virtual std::size_t
 		query_subscriptions_count() const = 0;
 
+		//! A hint that the initial subscriptions are made.
+		/*!
+		 * This method is called after the completion of
+		 * agent_t::so_evt_start(). A storage can prepare its content
+		 * for faster search of event handlers.
+		 *
+		 * Default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		freeze() {}
+
 	protected :
 		agent_t *
 		owner() const;
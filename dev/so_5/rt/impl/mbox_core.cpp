@@ -10,6 +10,7 @@
 #include <so_5/rt/impl/h/named_local_mbox.hpp>
 #include <so_5/rt/impl/h/mpsc_mbox.hpp>
 #include <so_5/rt/impl/h/mchain_details.hpp>
+#include <so_5/rt/impl/h/mchain_lock_free.hpp>
 
 #include <algorithm>
 
@@ -32,9 +33,34 @@ mbox_core_t::mbox_core_t(
 
 mbox_t
 mbox_core_t::create_mbox()
+{
+	return create_mbox( mbox_params_t{} );
+}
+
+mbox_t
+mbox_core_t::create_mbox(
+	nonempty_name_t mbox_name )
+{
+	return create_mbox( std::move(mbox_name), mbox_params_t{} );
+}
+
+mbox_t
+mbox_core_t::create_mbox(
+	const mbox_params_t & params )
 {
 	auto id = ++m_mbox_id_counter;
-	if( !m_msg_tracing_stuff.get().is_msg_tracing_enabled() )
+	const bool tracing = m_msg_tracing_stuff.get().is_msg_tracing_enabled();
+
+	if( local_mbox_sync_t::rcu == params.sync() )
+	{
+		if( !tracing )
+			return mbox_t{ new rcu_local_mbox_without_tracing{ id } };
+		else
+			return mbox_t{
+					new rcu_local_mbox_with_tracing{ id, m_msg_tracing_stuff } };
+	}
+
+	if( !tracing )
 		return mbox_t{ new local_mbox_without_tracing{ id } };
 	else
 		return mbox_t{ new local_mbox_with_tracing{ id, m_msg_tracing_stuff } };
@@ -42,11 +68,20 @@ mbox_core_t::create_mbox()
 
 mbox_t
 mbox_core_t::create_mbox(
-	nonempty_name_t mbox_name )
+	nonempty_name_t mbox_name,
+	const mbox_params_t & params )
+{
+	return create_mbox( mbox_name_handle_t{ std::move(mbox_name) }, params );
+}
+
+mbox_t
+mbox_core_t::create_mbox(
+	const mbox_name_handle_t & mbox_name,
+	const mbox_params_t & params )
 {
 	return create_named_mbox(
-			std::move(mbox_name),
-			[this]() { return create_mbox(); } );
+			mbox_name,
+			[this, &params]() { return create_mbox( params ); } );
 }
 
 namespace {
@@ -106,18 +141,18 @@ mbox_core_t::create_mpsc_mbox(
 
 void
 mbox_core_t::destroy_mbox(
-	const std::string & name )
+	const mbox_name_handle_t & name )
 {
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
+	auto & shard = shard_for( name );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
-	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( name );
+	named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( name );
 
-	if( m_named_mboxes_dictionary.end() != it )
+	if( shard.m_mboxes.end() != it )
 	{
 		const unsigned int ref_count = --(it->second.m_external_ref_count);
 		if( 0 == ref_count )
-			m_named_mboxes_dictionary.erase( it );
+			shard.m_mboxes.erase( it );
 	}
 }
 
@@ -132,7 +167,10 @@ mbox_core_t::create_custom_mbox(
 
 namespace {
 
-template< typename Q, typename... A >
+template<
+	template<class, class> class Chain,
+	typename Q,
+	typename... A >
 mchain_t
 make_mchain(
 	outliving_reference_t< so_5::msg_tracing::holder_t > tracer,
@@ -147,13 +185,13 @@ make_mchain(
 		if( tracer.get().is_msg_tracing_enabled()
 				&& !params.msg_tracing_disabled() )
 			return mchain_t{
-					new mchain_template< Q, E >{
+					new Chain< Q, E >{
 						std::forward<A>(args)...,
 						params,
 						tracer } };
 		else
 			return mchain_t{
-					new mchain_template< Q, D >{
+					new Chain< Q, D >{
 						std::forward<A>(args)..., params } };
 	}
 
@@ -169,37 +207,67 @@ mbox_core_t::create_mchain(
 
 	auto id = ++m_mbox_id_counter;
 
+	if( synchronization_t::mutex_based != params.synchronization() )
+	{
+		if( params.capacity().unlimited() )
+			SO_5_THROW_EXCEPTION(
+					rc_lock_free_mchain_must_be_size_limited,
+					"lock-free mchain can't be created without size limit" );
+
+		if( synchronization_t::lock_free_mpmc == params.synchronization() )
+			return make_mchain<
+						lock_free_mchain_template, lock_free_mpmc_demand_queue >(
+					m_msg_tracing_stuff, params, env, id );
+
+		// Only the consumer can extract demands from SPSC queue.
+		// So the producer can't remove the oldest one.
+		if( overflow_reaction_t::remove_oldest ==
+				params.capacity().overflow_reaction() )
+			SO_5_THROW_EXCEPTION(
+					rc_remove_oldest_not_supported_by_spsc_mchain,
+					"SPSC mchain doesn't support remove_oldest overflow reaction" );
+
+		return make_mchain<
+					lock_free_mchain_template, lock_free_spsc_demand_queue >(
+				m_msg_tracing_stuff, params, env, id );
+	}
+
 	if( params.capacity().unlimited() )
-		return make_mchain< unlimited_demand_queue >(
+		return make_mchain< mchain_template, unlimited_demand_queue >(
 				m_msg_tracing_stuff, params, env, id );
 	else if( memory_usage_t::dynamic == params.capacity().memory_usage() )
-		return make_mchain< limited_dynamic_demand_queue >(
+		return make_mchain< mchain_template, limited_dynamic_demand_queue >(
 				m_msg_tracing_stuff, params, env, id );
 	else
-		return make_mchain< limited_preallocated_demand_queue >(
+		return make_mchain< mchain_template, limited_preallocated_demand_queue >(
 				m_msg_tracing_stuff, params, env, id );
 }
 
 mbox_core_stats_t
 mbox_core_t::query_stats()
 {
-	std::lock_guard< std::mutex > lock{ m_dictionary_lock };
+	mbox_core_stats_t result{ 0u };
+
+	for( auto & shard : m_dictionary )
+	{
+		std::lock_guard< std::mutex > lock{ shard.m_lock };
+		result.m_named_mbox_count += shard.m_mboxes.size();
+	}
 
-	return mbox_core_stats_t{ m_named_mboxes_dictionary.size() };
+	return result;
 }
 
 mbox_t
 mbox_core_t::create_named_mbox(
-	nonempty_name_t nonempty_name,
+	const mbox_name_handle_t & name,
 	const std::function< mbox_t() > & factory )
 {
-	const std::string & name = nonempty_name.query_name();
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
+	auto & shard = shard_for( name );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
-	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( name );
+	named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( name );
 
-	if( m_named_mboxes_dictionary.end() != it )
+	if( shard.m_mboxes.end() != it )
 	{
 		++(it->second.m_external_ref_count);
 		return mbox_t(
@@ -212,7 +280,7 @@ mbox_core_t::create_named_mbox(
 	// There is no mbox with such name. New mbox should be created.
 	mbox_t mbox_ref = factory();
 
-	m_named_mboxes_dictionary[ name ] = named_mbox_info_t( mbox_ref );
+	shard.m_mboxes[ name ] = named_mbox_info_t( mbox_ref );
 
 	return mbox_t( new named_local_mbox_t( name, mbox_ref, *this ) );
 }
@@ -20,8 +20,13 @@
 
 #include <so_5/disp/one_thread/h/pub.hpp>
 
+#include <so_5/details/h/abort_on_fatal_error.hpp>
+#include <so_5/details/h/rollback_on_exception.hpp>
+
 #include <so_5/h/stdcpp.hpp>
 
+#include <algorithm>
+
 namespace so_5 {
 
 namespace env_infrastructures {
@@ -35,8 +40,11 @@ namespace impl {
 //
 coop_repo_t::coop_repo_t(
 	environment_t & env,
-	coop_listener_unique_ptr_t coop_listener )
+	coop_listener_unique_ptr_t coop_listener,
+	std::size_t final_dereg_thread_count )
 	:	coop_repository_basis_t( env, std::move(coop_listener) )
+	,	m_final_dereg_thread_count(
+			(std::max)( final_dereg_thread_count, std::size_t{ 1u } ) )
 	{}
 
 void
@@ -45,14 +53,28 @@ coop_repo_t::start()
 	// mchain for final coop deregs must be created.
 	m_final_dereg_chain = environment().create_mchain(
 			make_unlimited_mchain_params().disable_msg_tracing() );
-	// A separate thread for doing the final dereg must be started.
-	m_final_dereg_thread = std::thread{ [this] {
-		// Process dereg demands until chain will be closed.
-		receive( from( m_final_dereg_chain ),
-			[]( coop_t * coop ) {
-				coop_t::call_final_deregister_coop( coop );
-			} );
-	} };
+	// Separate threads for doing the final dereg must be started.
+	// All of them take demands from the same mchain. A parent coop
+	// can't be in this mchain until all its children are destroyed.
+	// So the order of final deregistration is preserved.
+	m_final_dereg_threads.reserve( m_final_dereg_thread_count );
+	so_5::details::do_with_rollback_on_exception(
+		[this] {
+			for( std::size_t i = 0; i != m_final_dereg_thread_count; ++i )
+				m_final_dereg_threads.emplace_back( [this] {
+					// Process dereg demands until chain will be closed.
+					receive( from( m_final_dereg_chain ),
+						[]( coop_t * coop ) {
+							coop_t::call_final_deregister_coop( coop );
+						} );
+				} );
+		},
+		[this] {
+			close_drop_content( m_final_dereg_chain );
+			for( auto & t : m_final_dereg_threads )
+				t.join();
+			m_final_dereg_threads.clear();
+		} );
 }
 
 void
@@ -64,9 +86,11 @@ coop_repo_t::finish()
 	// Deregistration of all cooperations should be finished.
 	wait_all_coop_to_deregister();
 
-	// Notify a dedicated thread and wait while it will be stopped.
+	// Notify dedicated threads and wait while they will be stopped.
 	close_retain_content( m_final_dereg_chain );
-	m_final_dereg_thread.join();
+	for( auto & t : m_final_dereg_threads )
+		t.join();
+	m_final_dereg_threads.clear();
 }
 
 void
@@ -78,10 +102,10 @@ coop_repo_t::ready_to_deregister_notify(
 
 bool
 coop_repo_t::final_deregister_coop(
-	std::string coop_name )
+	coop_id_t coop_id )
 {
 	const auto result =
-			coop_repository_basis_t::final_deregister_coop( std::move(coop_name) );
+			coop_repository_basis_t::final_deregister_coop( coop_id );
 
 	if( result.m_total_deregistration_completed )
 		m_deregistration_finished_cond.notify_one();
@@ -105,7 +129,7 @@ coop_repo_t::wait_for_start_deregistration()
 	std::unique_lock< std::mutex > lck( this->lock() );
 
 	m_deregistration_started_cond.wait( lck,
-			[this] { return m_deregistration_started; } );
+			[this] { return m_deregistration_started.load(); } );
 }
 
 void
@@ -116,7 +140,7 @@ coop_repo_t::wait_all_coop_to_deregister()
 	// Must wait for a signal is there are cooperations in
 	// the deregistration process.
 	m_deregistration_finished_cond.wait( lck,
-			[this] { return m_deregistered_coop.empty(); } );
+			[this] { return !has_live_coop(); } );
 }
 
 environment_infrastructure_t::coop_repository_stats_t
@@ -134,21 +158,214 @@ coop_repo_t::query_stats()
 		};
 }
 
+namespace disp_driven_timer_details {
+
+//
+// mtsafe_timer_t
+//
+/*!
+ * \brief A wrapper for timer from timer manager which does
+ * release of timer under the lock of disp_driven_timer.
+ *
+ * Timer managers are not thread safe. But timer_id can be released
+ * from any thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+class mtsafe_timer_t final : public timer_t
+	{
+	public :
+		mtsafe_timer_t(
+			std::mutex & lock,
+			timer_id_t actual_timer )
+			:	m_lock( lock )
+			,	m_actual_timer( std::move(actual_timer) )
+			{}
+		virtual ~mtsafe_timer_t() SO_5_NOEXCEPT override
+			{
+				release();
+			}
+
+		virtual bool
+		is_active() const SO_5_NOEXCEPT override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				return m_actual_timer.is_active();
+			}
+
+		virtual void
+		release() SO_5_NOEXCEPT override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_actual_timer.release();
+			}
+
+	private :
+		std::mutex & m_lock;
+		timer_id_t m_actual_timer;
+	};
+
+} /* namespace disp_driven_timer_details */
+
+//
+// disp_driven_timer_t
+//
+disp_driven_timer_t::disp_driven_timer_t(
+	error_logger_shptr_t error_logger,
+	const timer_manager_factory_t & timer_manager_factory )
+	:	m_error_logger( error_logger )
+	,	m_timer_manager( timer_manager_factory(
+				std::move(error_logger),
+				outliving_mutable( m_timers_collector ) ) )
+	{}
+
+void
+disp_driven_timer_t::start()
+	{
+		// Nothing to do. The processing of timers is started when
+		// the work thread calls on_idle() for the first time.
+	}
+
+void
+disp_driven_timer_t::finish()
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_finished = true;
+	}
+
+timer_id_t
+disp_driven_timer_t::schedule(
+	const std::type_index & type_index,
+	const mbox_t & mbox,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+
+		auto timer = m_timer_manager->schedule(
+				type_index, mbox, msg, pause, period );
+
+		wake_up_if_necessary( pause );
+
+		return timer_id_t{
+				so_5::intrusive_ptr_t< timer_t >{
+						new disp_driven_timer_details::mtsafe_timer_t{
+								m_lock, std::move(timer) } } };
+	}
+
+void
+disp_driven_timer_t::schedule_anonymous(
+	const std::type_index & type_index,
+	const mbox_t & mbox,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+
+		m_timer_manager->schedule_anonymous(
+				type_index, mbox, msg, pause, period );
+
+		wake_up_if_necessary( pause );
+	}
+
+timer_thread_stats_t
+disp_driven_timer_t::query_stats()
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		return m_timer_manager->query_stats();
+	}
+
+void
+disp_driven_timer_t::attach( waker_t * waker ) SO_5_NOEXCEPT
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_waker = waker;
+	}
+
+std::chrono::steady_clock::duration
+disp_driven_timer_t::on_idle() SO_5_NOEXCEPT
+	{
+		// Max waiting time if there is no timers.
+		const std::chrono::steady_clock::duration max_timeout =
+				std::chrono::minutes(1);
+
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+			if( m_finished )
+				{
+					m_wakeup_at = std::chrono::steady_clock::now() + max_timeout;
+					return max_timeout;
+				}
+
+			m_timer_manager->process_expired_timers();
+		}
+
+		if( !m_timers_collector.empty() )
+			try
+				{
+					// Messages must be sent without holding the lock
+					// because receivers can schedule new timers.
+					m_timers_collector.process();
+				}
+			catch( const std::exception & x )
+				{
+					so_5::details::abort_on_fatal_error( [&] {
+						SO_5_LOG_ERROR( *m_error_logger, stream ) {
+							stream << "exception has been thrown and caught during "
+									"processing of elapsed timers on a work thread "
+									"of dispatcher, application will be aborted. "
+									"Exception: " << x.what();
+						}
+					} );
+				}
+
+		std::lock_guard< std::mutex > lock{ m_lock };
+
+		const auto timeout =
+				m_timer_manager->timeout_before_nearest_timer( max_timeout );
+		m_wakeup_at = std::chrono::steady_clock::now() + timeout;
+
+		return timeout;
+	}
+
+void
+disp_driven_timer_t::wake_up_if_necessary(
+	std::chrono::steady_clock::duration pause ) SO_5_NOEXCEPT
+	{
+		if( m_waker )
+			{
+				const auto expires_at = std::chrono::steady_clock::now() + pause;
+				if( expires_at < m_wakeup_at )
+					{
+						// The work thread must recalculate the time of sleep.
+						m_wakeup_at = expires_at;
+						m_waker->wake_up();
+					}
+			}
+	}
+
 //
 // mt_env_infrastructure_t
 //
 mt_env_infrastructure_t::mt_env_infrastructure_t(
 	environment_t & env,
 	so_5::disp::one_thread::disp_params_t default_disp_params,
-	timer_thread_unique_ptr_t timer_thread,
+	std::shared_ptr< timer_thread_t > timer_thread,
 	coop_listener_unique_ptr_t coop_listener,
-	mbox_t stats_distribution_mbox )
+	mbox_t stats_distribution_mbox,
+	std::size_t final_dereg_thread_count )
 	:	m_env( env )
 	,	m_default_dispatcher(
 				so_5::disp::one_thread::create_disp(
 						std::move(default_disp_params) ) )
 	,	m_timer_thread( std::move(timer_thread) )
-	,	m_coop_repo( env, std::move(coop_listener) )
+	,	m_coop_repo(
+				env,
+				std::move(coop_listener),
+				final_dereg_thread_count )
 	,	m_stats_controller( std::move(stats_distribution_mbox) )
 	{
 	}
@@ -173,6 +390,13 @@ mt_env_infrastructure_t::register_coop(
 		m_coop_repo.register_coop( std::move(coop) );
 	}
 
+void
+mt_env_infrastructure_t::register_coops(
+	std::vector< coop_unique_ptr_t > coops )
+	{
+		m_coop_repo.register_coops( std::move(coops) );
+	}
+
 void
 mt_env_infrastructure_t::deregister_coop(
 	nonempty_name_t name,
@@ -181,6 +405,14 @@ mt_env_infrastructure_t::deregister_coop(
 		m_coop_repo.deregister_coop( std::move(name), dereg_reason );
 	}
 
+void
+mt_env_infrastructure_t::deregister_coop(
+	coop_id_t id,
+	coop_dereg_reason_t dereg_reason )
+	{
+		m_coop_repo.deregister_coop( id, dereg_reason );
+	}
+
 void
 mt_env_infrastructure_t::ready_to_deregister_notify(
 	coop_t * coop )
@@ -190,9 +422,9 @@ mt_env_infrastructure_t::ready_to_deregister_notify(
 
 bool
 mt_env_infrastructure_t::final_deregister_coop(
-	std::string coop_name )
+	coop_id_t coop_id )
 	{
-		return m_coop_repo.final_deregister_coop( std::move(coop_name) );
+		return m_coop_repo.final_deregister_coop( coop_id );
 	}
 
 so_5::timer_id_t
@@ -211,6 +443,24 @@ mt_env_infrastructure_t::schedule_timer(
 				period );
 	}
 
+so_5::timer_id_t
+mt_env_infrastructure_t::schedule_coalesced_timer(
+	const std::type_index & type_wrapper,
+	const message_ref_t & msg,
+	const mbox_t & mbox,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period,
+	timer_slack_t slack )
+	{
+		return m_timer_thread->schedule_coalesced(
+				type_wrapper,
+				mbox,
+				msg,
+				pause,
+				period,
+				slack );
+	}
+
 void
 mt_env_infrastructure_t::single_timer(
 	const std::type_index & type_wrapper,
@@ -334,24 +584,51 @@ mt_env_infrastructure_t::run_user_supplied_init_and_wait_for_stop(
 SO_5_FUNC environment_infrastructure_factory_t
 factory()
 	{
-		return [](
+		return factory( params_t{} );
+	}
+
+SO_5_FUNC environment_infrastructure_factory_t
+factory( params_t && infrastructure_params )
+	{
+		return [infrastructure_params](
 				environment_t & env,
 				environment_params_t & params,
 				mbox_t stats_distribution_mbox )
 		{
-			// Timer thread is necessary for that environment.
-			auto timer =
-					so_5::internal_timer_helpers::create_appropriate_timer_thread(
-							params.so5__error_logger(),
-							params.so5__giveout_timer_thread_factory() );
+			std::shared_ptr< timer_thread_t > timer;
+			auto default_disp_params = params.default_disp_params();
+
+			if( !infrastructure_params.timer_manager() )
+				// Timer thread is necessary for that environment.
+				timer = so_5::internal_timer_helpers::create_appropriate_timer_thread(
+						params.so5__error_logger(),
+						params.so5__giveout_timer_thread_factory() );
+			else
+			{
+				// There is no timer thread. Timers will be processed on
+				// the work thread of the default dispatcher.
+				auto disp_driven_timer = std::make_shared< impl::disp_driven_timer_t >(
+						params.so5__error_logger(),
+						infrastructure_params.timer_manager() );
+
+				default_disp_params.tune_queue_params(
+					[&disp_driven_timer](
+						so_5::disp::one_thread::queue_traits::queue_params_t & p )
+					{
+						p.idle_handler( disp_driven_timer );
+					} );
+
+				timer = std::move(disp_driven_timer);
+			}
 
 			// Now the environment object can be created.
 			auto obj = new impl::mt_env_infrastructure_t(
 					env,
-					params.default_disp_params(),
+					std::move(default_disp_params),
 					std::move(timer),
 					params.so5__giveout_coop_listener(),
-					std::move(stats_distribution_mbox) );
+					std::move(stats_distribution_mbox),
+					infrastructure_params.final_dereg_thread_count() );
 
 			return environment_infrastructure_unique_ptr_t(
 					obj,
@@ -17,7 +17,7 @@ namespace impl
 //
 
 named_local_mbox_t::named_local_mbox_t(
-	const std::string & name,
+	const mbox_name_handle_t & name,
 	const mbox_t & mbox,
 	impl::mbox_core_t & mbox_core )
 	:
@@ -58,7 +58,7 @@ named_local_mbox_t::unsubscribe_event_handlers(
 std::string
 named_local_mbox_t::query_name() const
 {
-	return m_name;
+	return m_name.query_name();
 }
 
 mbox_type_t
@@ -76,6 +76,17 @@ named_local_mbox_t::do_deliver_message(
 	m_mbox->do_deliver_message( msg_type, message, overlimit_reaction_deep );
 }
 
+void
+named_local_mbox_t::do_deliver_messages(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep ) const
+{
+	m_mbox->do_deliver_messages(
+			msg_type, messages, count, overlimit_reaction_deep );
+}
+
 void
 named_local_mbox_t::do_deliver_service_request(
 	const std::type_index & msg_type,
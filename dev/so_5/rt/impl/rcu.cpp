@@ -0,0 +1,201 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Simple epoch-based read-copy-update support.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#include <so_5/rt/impl/h/rcu.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace rcu
+{
+
+namespace
+{
+
+//
+// thread_record_t
+//
+/*!
+ * \brief Information about read-side section of a thread.
+ *
+ * Records are never deallocated. A record of a finished thread
+ * is reused by a new thread.
+ */
+struct thread_record_t
+	{
+		//! Epoch announced by the reader.
+		/*!
+		 * Zero if the reader is outside a read-side section.
+		 */
+		std::atomic< std::uint64_t > m_epoch{ 0 };
+
+		//! Is this record used by some thread?
+		std::atomic< bool > m_in_use{ true };
+
+		//! Next record in the global list.
+		thread_record_t * m_next{ nullptr };
+
+		//! Protection from false sharing with a neighbour record.
+		char m_padding[ 64 ];
+	};
+
+//! The current epoch.
+std::atomic< std::uint64_t > g_epoch{ 1 };
+
+//! The head of the list of all records.
+std::atomic< thread_record_t * > g_records{ nullptr };
+
+//! Record of the current thread.
+thread_local thread_record_t * t_record = nullptr;
+
+//! Nesting level of read-side sections of the current thread.
+thread_local unsigned int t_nesting = 0;
+
+//! Has the record of the current thread been released already?
+/*!
+ * Read-side section can be entered during destruction of some
+ * thread-local object after releasing of the record. The record is
+ * acquired just for the section's duration in that case.
+ */
+thread_local bool t_released = false;
+
+thread_record_t *
+acquire_record()
+	{
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			{
+				bool expected = false;
+				if( !r->m_in_use.load( std::memory_order_relaxed ) &&
+						r->m_in_use.compare_exchange_strong( expected, true ) )
+					return r;
+			}
+
+		auto r = new thread_record_t();
+		auto head = g_records.load( std::memory_order_relaxed );
+		do
+			{
+				r->m_next = head;
+			}
+		while( !g_records.compare_exchange_weak( head, r,
+				std::memory_order_release, std::memory_order_relaxed ) );
+
+		return r;
+	}
+
+void
+release_record( thread_record_t * r ) SO_5_NOEXCEPT
+	{
+		r->m_in_use.store( false, std::memory_order_release );
+	}
+
+//
+// record_releaser_t
+//
+/*!
+ * \brief A thread-local object which releases the thread's record
+ * at the end of the thread.
+ */
+struct record_releaser_t
+	{
+		~record_releaser_t()
+			{
+				t_released = true;
+				if( t_record && !t_nesting )
+					{
+						release_record( t_record );
+						t_record = nullptr;
+					}
+			}
+	};
+
+void
+acquire_record_for_current_thread()
+	{
+		t_record = acquire_record();
+		if( !t_released )
+			{
+				static thread_local record_releaser_t releaser;
+				(void)&releaser;
+			}
+	}
+
+} /* namespace anonymous */
+
+void
+enter_read_section()
+	{
+		if( 0 == t_nesting )
+			{
+				if( !t_record )
+					acquire_record_for_current_thread();
+
+				t_record->m_epoch.store(
+						g_epoch.load( std::memory_order_seq_cst ),
+						std::memory_order_seq_cst );
+			}
+
+		++t_nesting;
+	}
+
+void
+leave_read_section() SO_5_NOEXCEPT
+	{
+		if( 0 == --t_nesting )
+			{
+				t_record->m_epoch.store( 0, std::memory_order_release );
+				if( t_released )
+					{
+						release_record( t_record );
+						t_record = nullptr;
+					}
+			}
+	}
+
+void
+synchronize() SO_5_NOEXCEPT
+	{
+		// Readers which announced this or a previous epoch can see
+		// the old version of data. Readers which will announce the next
+		// epoch will see the new version.
+		const auto epoch = g_epoch.fetch_add( 1, std::memory_order_seq_cst );
+
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			{
+				yield_backoff_t backoff;
+				for(;;)
+					{
+						const auto announced =
+								r->m_epoch.load( std::memory_order_seq_cst );
+						if( !announced || announced > epoch )
+							break;
+
+						backoff();
+					}
+			}
+	}
+
+} /* namespace rcu */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
@@ -310,18 +310,27 @@ class env_infrastructure_t
 		register_coop(
 			coop_unique_ptr_t coop ) override;
 
+		virtual void
+		register_coops(
+			std::vector< coop_unique_ptr_t > coops ) override;
+
 		virtual void
 		deregister_coop(
 			nonempty_name_t name,
 			coop_dereg_reason_t dereg_reason ) override;
 
+		virtual void
+		deregister_coop(
+			coop_id_t id,
+			coop_dereg_reason_t dereg_reason ) override;
+
 		virtual void
 		ready_to_deregister_notify(
 			coop_t * coop ) override;
 
 		virtual bool
 		final_deregister_coop(
-			std::string coop_name ) override;
+			coop_id_t coop_id ) override;
 
 		virtual so_5::timer_id_t
 		schedule_timer(
@@ -471,6 +480,14 @@ env_infrastructure_t< Activity_Tracker >::register_coop(
 		m_coop_repo.register_coop( std::move(coop) );
 	}
 
+template< typename Activity_Tracker >
+void
+env_infrastructure_t< Activity_Tracker >::register_coops(
+	std::vector< coop_unique_ptr_t > coops )
+	{
+		m_coop_repo.register_coops( std::move(coops) );
+	}
+
 template< typename Activity_Tracker >
 void
 env_infrastructure_t< Activity_Tracker >::deregister_coop(
@@ -480,6 +497,15 @@ env_infrastructure_t< Activity_Tracker >::deregister_coop(
 		m_coop_repo.deregister_coop( std::move(name), dereg_reason );
 	}
 
+template< typename Activity_Tracker >
+void
+env_infrastructure_t< Activity_Tracker >::deregister_coop(
+	coop_id_t id,
+	coop_dereg_reason_t dereg_reason )
+	{
+		m_coop_repo.deregister_coop( id, dereg_reason );
+	}
+
 template< typename Activity_Tracker >
 void
 env_infrastructure_t< Activity_Tracker >::ready_to_deregister_notify(
@@ -494,9 +520,9 @@ env_infrastructure_t< Activity_Tracker >::ready_to_deregister_notify(
 template< typename Activity_Tracker >
 bool
 env_infrastructure_t< Activity_Tracker >::final_deregister_coop(
-	std::string coop_name )
+	coop_id_t coop_id )
 	{
-		return m_coop_repo.final_deregister_coop( std::move(coop_name) )
+		return m_coop_repo.final_deregister_coop( coop_id )
 				.m_has_live_coop;
 	}
 
@@ -94,6 +94,9 @@ class storage_t : public subscription_storage_t
 		std::size_t
 		query_subscriptions_count() const override;
 
+		void
+		freeze() override;
+
 	private :
 		const std::size_t m_threshold;
 
@@ -222,6 +225,12 @@ storage_t::query_subscriptions_count() const
 		return m_current_storage->query_subscriptions_count();
 	}
 
+void
+storage_t::freeze()
+	{
+		m_current_storage->freeze();
+	}
+
 void
 storage_t::try_switch_to_smaller_storage()
 	{
@@ -0,0 +1,526 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \file
+ * \brief A storage for agent's subscriptions information which
+ * can be frozen after the start of the agent.
+ */
+
+#include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief A storage for agent's subscriptions information which
+ * can be frozen after the start of the agent.
+ */
+namespace frozen_subscr_storage
+{
+
+//
+// compiled_table_t
+//
+/*!
+ * \brief Immutable table for fast search of event handlers.
+ *
+ * Subscriptions are grouped by (mbox_id, state) pairs. Handlers of
+ * a group are stored in a contiguous block sorted by message type.
+ *
+ * Groups are found via an open-addressing hash table. The hash
+ * function depends on a seed. During the building of the table
+ * several seeds and table sizes are tried to get a table without
+ * collisions (perfect hash). If there is no such seed the table with
+ * linear probing is used.
+ *
+ * The message type doesn't participate in the hash value because
+ * calculation of hash for std::type_index can be expensive.
+ */
+class compiled_table_t
+	{
+	public :
+		//! Build the table from subscriptions information.
+		/*!
+		 * Provides strong exception guarantee.
+		 */
+		void
+		build( const subscription_storage_common::subscr_info_vector_t & info );
+
+		//! Remove all content.
+		void
+		clear() SO_5_NOEXCEPT
+			{
+				m_groups.clear();
+				m_handlers.clear();
+				m_slots.clear();
+			}
+
+		const event_handler_data_t *
+		find(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			const state_t * state ) const SO_5_NOEXCEPT
+			{
+				auto slot = slot_index( mbox_id, state, m_seed, m_mask );
+				for(;;)
+					{
+						const auto g = m_slots[ slot ];
+						if( !g )
+							return nullptr;
+
+						const auto & group = m_groups[ g - 1 ];
+						if( group.m_mbox_id == mbox_id && group.m_state == state )
+							return find_in_group( group, msg_type );
+
+						if( m_perfect )
+							return nullptr;
+
+						slot = (slot + 1) & m_mask;
+					}
+			}
+
+	private :
+		//! Handlers for one (mbox_id, state) pair.
+		struct group_t
+			{
+				mbox_id_t m_mbox_id;
+				const state_t * m_state;
+				//! Index of the first handler in m_handlers.
+				std::size_t m_first;
+				//! Count of handlers.
+				std::size_t m_count;
+			};
+
+		//! Handler for one message type.
+		struct handler_t
+			{
+				std::type_index m_msg_type;
+				event_handler_data_t m_handler;
+			};
+
+		//! Max count of handlers in a group to be scanned linearly.
+		static const std::size_t linear_search_limit = 8;
+
+		std::vector< group_t > m_groups;
+		std::vector< handler_t > m_handlers;
+
+		//! Hash table with indexes of groups.
+		/*!
+		 * Index of a group plus 1 or 0 for empty slot.
+		 */
+		std::vector< std::uint32_t > m_slots;
+
+		std::uint64_t m_seed{ 0 };
+		std::size_t m_mask{ 0 };
+
+		//! Is there no collisions in the hash table?
+		bool m_perfect{ false };
+
+		static std::size_t
+		slot_index(
+			mbox_id_t mbox_id,
+			const state_t * state,
+			std::uint64_t seed,
+			std::size_t mask ) SO_5_NOEXCEPT
+			{
+				std::uint64_t x = static_cast< std::uint64_t >( mbox_id ) ^ seed;
+				x ^= static_cast< std::uint64_t >(
+						reinterpret_cast< std::uintptr_t >( state ) ) *
+						0x9e3779b97f4a7c15ull;
+				x ^= x >> 33;
+				x *= 0xff51afd7ed558ccdull;
+				x ^= x >> 33;
+				x *= 0xc4ceb9fe1a85ec53ull;
+				x ^= x >> 33;
+
+				return static_cast< std::size_t >( x ) & mask;
+			}
+
+		const event_handler_data_t *
+		find_in_group(
+			const group_t & group,
+			const std::type_index & msg_type ) const SO_5_NOEXCEPT
+			{
+				const auto first = m_handlers.begin() +
+						static_cast< std::ptrdiff_t >( group.m_first );
+				const auto last = first +
+						static_cast< std::ptrdiff_t >( group.m_count );
+
+				if( group.m_count <= linear_search_limit )
+					{
+						for( auto it = first; it != last; ++it )
+							if( it->m_msg_type == msg_type )
+								return &(it->m_handler);
+					}
+				else
+					{
+						auto it = std::lower_bound( first, last, msg_type,
+								[]( const handler_t & h, const std::type_index & t ) {
+									return h.m_msg_type < t;
+								} );
+						if( it != last && it->m_msg_type == msg_type )
+							return &(it->m_handler);
+					}
+
+				return nullptr;
+			}
+
+		//! Try to fill hash table without collisions.
+		bool
+		try_fill_slots(
+			std::vector< std::uint32_t > & slots,
+			std::uint64_t seed,
+			std::size_t mask,
+			bool allow_collisions ) const SO_5_NOEXCEPT
+			{
+				std::fill( slots.begin(), slots.end(), 0u );
+
+				for( std::size_t i = 0; i != m_groups.size(); ++i )
+					{
+						auto slot = slot_index(
+								m_groups[ i ].m_mbox_id,
+								m_groups[ i ].m_state,
+								seed,
+								mask );
+
+						while( slots[ slot ] )
+							{
+								if( !allow_collisions )
+									return false;
+								slot = (slot + 1) & mask;
+							}
+
+						slots[ slot ] = static_cast< std::uint32_t >( i + 1 );
+					}
+
+				return true;
+			}
+	};
+
+void
+compiled_table_t::build(
+	const subscription_storage_common::subscr_info_vector_t & info )
+	{
+		using namespace subscription_storage_common;
+
+		// Subscriptions must be grouped by (mbox_id, state) and
+		// ordered by message type inside a group.
+		std::vector< const subscr_info_t * > ordered;
+		ordered.reserve( info.size() );
+		for( const auto & i : info )
+			ordered.push_back( &i );
+
+		std::sort( ordered.begin(), ordered.end(),
+			[]( const subscr_info_t * a, const subscr_info_t * b ) {
+				const auto a_id = a->m_mbox->id();
+				const auto b_id = b->m_mbox->id();
+				if( a_id != b_id )
+					return a_id < b_id;
+				if( a->m_state != b->m_state )
+					return std::less< const state_t * >()( a->m_state, b->m_state );
+				return a->m_msg_type < b->m_msg_type;
+			} );
+
+		std::vector< group_t > groups;
+		std::vector< handler_t > handlers;
+		handlers.reserve( ordered.size() );
+
+		for( auto s : ordered )
+			{
+				const auto mbox_id = s->m_mbox->id();
+				if( groups.empty() ||
+						groups.back().m_mbox_id != mbox_id ||
+						groups.back().m_state != s->m_state )
+					groups.push_back(
+							group_t{ mbox_id, s->m_state, handlers.size(), 0u } );
+
+				handlers.push_back( handler_t{ s->m_msg_type, s->m_handler } );
+				++groups.back().m_count;
+			}
+
+		// Size of the hash table is at least twice as big as
+		// count of groups.
+		std::size_t min_size = 8;
+		while( min_size < groups.size() * 2 )
+			min_size *= 2;
+
+		std::vector< std::uint32_t > slots;
+		slots.reserve( min_size * 4 );
+
+		m_groups.swap( groups );
+		m_handlers.swap( handlers );
+
+		// Search for a perfect hash. Table can grow up to 4 times.
+		m_perfect = false;
+		for( std::size_t size = min_size;
+				!m_perfect && size <= min_size * 4; size *= 2 )
+			{
+				slots.resize( size );
+				for( std::uint64_t attempt = 0; attempt != 8; ++attempt )
+					{
+						const auto seed = attempt * 0x9e3779b97f4a7c15ull;
+						if( try_fill_slots( slots, seed, size - 1, false ) )
+							{
+								m_perfect = true;
+								m_seed = seed;
+								m_mask = size - 1;
+								break;
+							}
+					}
+			}
+
+		if( !m_perfect )
+			{
+				slots.resize( min_size );
+				m_seed = 0;
+				m_mask = min_size - 1;
+				try_fill_slots( slots, m_seed, m_mask, true );
+			}
+
+		m_slots.swap( slots );
+	}
+
+//
+// storage_t
+//
+/*!
+ * \brief A storage which can be frozen after the start of the agent.
+ *
+ * All subscriptions are stored in an ordinary mutable storage. When
+ * the agent is started (after the completion of so_evt_start())
+ * subscriptions are compiled into compiled_table_t and all
+ * following searches of event handlers are performed in the
+ * compiled table.
+ *
+ * Any change of subscriptions after that drops the compiled table
+ * and the storage works as the mutable one. The storage isn't frozen
+ * again.
+ */
+class storage_t : public subscription_storage_t
+	{
+	public :
+		storage_t(
+			agent_t * owner,
+			subscription_storage_unique_ptr_t mutable_storage );
+
+		virtual void
+		create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const message_limit::control_block_t * limit,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety ) override;
+
+		virtual void
+		drop_subscription(
+			const mbox_t & mbox,
+			const std::type_index & msg_type,
+			const state_t & target_state ) override;
+
+		void
+		drop_subscription_for_all_states(
+			const mbox_t & mbox,
+			const std::type_index & msg_type ) override;
+
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			const state_t & current_state ) const SO_5_NOEXCEPT override;
+
+		void
+		debug_dump( std::ostream & to ) const override;
+
+		void
+		drop_content() override;
+
+		subscription_storage_common::subscr_info_vector_t
+		query_content() const override;
+
+		void
+		setup_content(
+			subscription_storage_common::subscr_info_vector_t && info ) override;
+
+		std::size_t
+		query_subscriptions_count() const override;
+
+		void
+		freeze() override;
+
+	private :
+		//! Storage for all subscriptions.
+		subscription_storage_unique_ptr_t m_mutable_storage;
+
+		//! Table for search of event handlers in frozen state.
+		compiled_table_t m_compiled;
+
+		//! Is the storage frozen?
+		bool m_frozen{ false };
+
+		void
+		unfreeze() SO_5_NOEXCEPT
+			{
+				if( m_frozen )
+					{
+						m_frozen = false;
+						m_compiled.clear();
+					}
+			}
+	};
+
+storage_t::storage_t(
+	agent_t * owner,
+	subscription_storage_unique_ptr_t mutable_storage )
+	:	subscription_storage_t( owner )
+	,	m_mutable_storage( std::move( mutable_storage ) )
+	{}
+
+void
+storage_t::create_event_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const message_limit::control_block_t * limit,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety )
+	{
+		m_mutable_storage->create_event_subscription(
+				mbox,
+				msg_type,
+				limit,
+				target_state,
+				method,
+				thread_safety );
+
+		unfreeze();
+	}
+
+void
+storage_t::drop_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const state_t & target_state )
+	{
+		unfreeze();
+
+		m_mutable_storage->drop_subscription( mbox, msg_type, target_state );
+	}
+
+void
+storage_t::drop_subscription_for_all_states(
+	const mbox_t & mbox,
+	const std::type_index & msg_type )
+	{
+		unfreeze();
+
+		m_mutable_storage->drop_subscription_for_all_states( mbox, msg_type );
+	}
+
+const event_handler_data_t *
+storage_t::find_handler(
+	mbox_id_t mbox_id,
+	const std::type_index & msg_type,
+	const state_t & current_state ) const SO_5_NOEXCEPT
+	{
+		if( m_frozen )
+			return m_compiled.find( mbox_id, msg_type, &current_state );
+		else
+			return m_mutable_storage->find_handler(
+					mbox_id,
+					msg_type,
+					current_state );
+	}
+
+void
+storage_t::debug_dump( std::ostream & to ) const
+	{
+		m_mutable_storage->debug_dump( to );
+	}
+
+void
+storage_t::drop_content()
+	{
+		unfreeze();
+
+		m_mutable_storage->drop_content();
+	}
+
+subscription_storage_common::subscr_info_vector_t
+storage_t::query_content() const
+	{
+		return m_mutable_storage->query_content();
+	}
+
+void
+storage_t::setup_content(
+	subscription_storage_common::subscr_info_vector_t && info )
+	{
+		unfreeze();
+
+		m_mutable_storage->setup_content( std::move( info ) );
+	}
+
+std::size_t
+storage_t::query_subscriptions_count() const
+	{
+		return m_mutable_storage->query_subscriptions_count();
+	}
+
+void
+storage_t::freeze()
+	{
+		if( m_frozen )
+			return;
+
+		// The storage remains mutable if the compilation fails.
+		try
+			{
+				m_compiled.build( m_mutable_storage->query_content() );
+				m_frozen = true;
+			}
+		catch( ... )
+			{}
+	}
+
+} /* namespace frozen_subscr_storage */
+
+} /* namespace impl */
+
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory(
+	const subscription_storage_factory_t & mutable_storage_factory )
+	{
+		return [mutable_storage_factory]( agent_t * owner ) {
+			return impl::subscription_storage_unique_ptr_t(
+					new impl::frozen_subscr_storage::storage_t(
+							owner,
+							mutable_storage_factory( owner ) ) );
+		};
+	}
+
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory()
+	{
+		return frozen_subscription_storage_factory(
+				default_subscription_storage_factory() );
+	}
+
+} /* namespace so_5 */
+
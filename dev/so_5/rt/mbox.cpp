@@ -23,6 +23,18 @@ abstract_message_box_t::do_deliver_enveloped_msg(
 			"do_deliver_enveloped_msg is not implemented by default" );
 }
 
+void
+abstract_message_box_t::do_deliver_messages(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep ) const
+{
+	for( std::size_t i = 0; i != count; ++i )
+		this->do_deliver_message(
+				msg_type, messages[ i ], overlimit_reaction_deep );
+}
+
 void
 abstract_message_box_t::do_deliver_message_from_timer(
 	const std::type_index & msg_type,
@@ -23,6 +23,33 @@ abstract_message_chain_t::as_mbox()
 		return mbox_t{ this };
 	}
 
+mchain_props::extraction_status_t
+abstract_message_chain_t::extract(
+	mchain_props::demand_t * dest,
+	std::size_t max_demands,
+	std::size_t & extracted,
+	mchain_props::duration_t empty_queue_timeout )
+	{
+		using namespace mchain_props;
+
+		extracted = 0u;
+		if( !max_demands )
+			return extraction_status_t::no_messages;
+
+		const auto status = extract( dest[ 0 ], empty_queue_timeout );
+		if( extraction_status_t::msg_extracted == status )
+			{
+				extracted = 1u;
+				while( extracted != max_demands &&
+						extraction_status_t::msg_extracted == extract(
+								dest[ extracted ],
+								mchain_props::details::no_wait_special_timevalue() ) )
+					++extracted;
+			}
+
+		return status;
+	}
+
 mchain_props::extraction_status_t
 abstract_message_chain_t::extract(
 	mchain_props::demand_t & /*dest*/,
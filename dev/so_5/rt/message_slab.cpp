@@ -0,0 +1,261 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Slab allocator for small message instances.
+ *
+ * \since
+ * v.5.5.25
+ */
+
+#include <so_5/rt/h/message_slab.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <mutex>
+#include <new>
+
+namespace so_5
+{
+
+namespace message_slab
+{
+
+namespace
+{
+
+//! Granularity of block sizes.
+const std::size_t block_granularity = 16;
+
+//! Count of size classes.
+const std::size_t size_class_count = max_block_size / block_granularity;
+
+//! Max count of free blocks of one size class in a thread cache.
+const std::size_t max_thread_cache_size = 128;
+
+//! Count of blocks to be moved between a thread cache and the depot.
+const std::size_t transfer_batch_size = 32;
+
+//! Max count of free blocks of one size class in the global depot.
+const std::size_t max_depot_size = 4096;
+
+//! Free block.
+struct free_block_t
+	{
+		free_block_t * m_next;
+	};
+
+//! List of free blocks of the same size.
+struct free_list_t
+	{
+		free_block_t * m_head{ nullptr };
+		std::size_t m_count{ 0 };
+
+		void
+		push( void * block ) SO_5_NOEXCEPT
+			{
+				auto b = static_cast< free_block_t * >( block );
+				b->m_next = m_head;
+				m_head = b;
+				++m_count;
+			}
+
+		void *
+		pop() SO_5_NOEXCEPT
+			{
+				auto b = m_head;
+				m_head = b->m_next;
+				--m_count;
+				return b;
+			}
+
+		//! Move up to \a count blocks to \a to.
+		void
+		move_to( free_list_t & to, std::size_t count ) SO_5_NOEXCEPT
+			{
+				while( m_head && count )
+					{
+						to.push( pop() );
+						--count;
+					}
+			}
+	};
+
+inline std::size_t
+size_class_index( std::size_t size )
+	{
+		return (size + block_granularity - 1) / block_granularity - 1;
+	}
+
+inline std::size_t
+size_class_block_size( std::size_t index )
+	{
+		return (index + 1) * block_granularity;
+	}
+
+//
+// depot_t
+//
+/*!
+ * \brief Global storage of free blocks.
+ *
+ * Thread caches exchange blocks with the depot by batches.
+ */
+class depot_t
+	{
+	public :
+		//! Try to get a batch of blocks.
+		void
+		take( std::size_t index, free_list_t & to ) SO_5_NOEXCEPT
+			{
+				std::lock_guard< default_spinlock_t > lock{ m_lock };
+				m_lists[ index ].move_to( to, transfer_batch_size );
+			}
+
+		//! Store up to \a count blocks from \a from.
+		/*!
+		 * Blocks which don't fit into the depot are deallocated.
+		 */
+		void
+		put( std::size_t index, free_list_t & from, std::size_t count ) SO_5_NOEXCEPT
+			{
+				free_list_t batch;
+				from.move_to( batch, count );
+
+				{
+					std::lock_guard< default_spinlock_t > lock{ m_lock };
+					auto & list = m_lists[ index ];
+					while( batch.m_head && list.m_count < max_depot_size )
+						list.push( batch.pop() );
+				}
+
+				// The rest must be deallocated outside of the lock.
+				while( batch.m_head )
+					::operator delete( batch.pop() );
+			}
+
+	private :
+		default_spinlock_t m_lock;
+		free_list_t m_lists[ size_class_count ];
+	};
+
+/*!
+ * \brief Access to the global depot.
+ *
+ * \note The depot is never destroyed because messages can be
+ * released during destruction of global objects.
+ */
+depot_t &
+depot()
+	{
+		static depot_t * instance = new depot_t();
+		return *instance;
+	}
+
+/*!
+ * \brief Is the cache of the current thread already destroyed?
+ *
+ * A message can be released during destruction of some other
+ * thread-local object after the destruction of the cache. The global
+ * operators new/delete are used in that case.
+ */
+thread_local bool g_thread_cache_destroyed = false;
+
+//
+// thread_cache_t
+//
+/*!
+ * \brief Cache of free blocks of the current thread.
+ */
+class thread_cache_t
+	{
+	public :
+		thread_cache_t() = default;
+		thread_cache_t( const thread_cache_t & ) = delete;
+		thread_cache_t & operator=( const thread_cache_t & ) = delete;
+
+		~thread_cache_t()
+			{
+				g_thread_cache_destroyed = true;
+
+				// All cached blocks are returned to the depot.
+				for( std::size_t i = 0; i != size_class_count; ++i )
+					depot().put( i, m_lists[ i ], m_lists[ i ].m_count );
+			}
+
+		void *
+		allocate( std::size_t index )
+			{
+				auto & list = m_lists[ index ];
+				if( !list.m_head )
+					depot().take( index, list );
+
+				if( list.m_head )
+					return list.pop();
+
+				return ::operator new( size_class_block_size( index ) );
+			}
+
+		void
+		deallocate( std::size_t index, void * block ) SO_5_NOEXCEPT
+			{
+				auto & list = m_lists[ index ];
+				list.push( block );
+
+				if( list.m_count > max_thread_cache_size )
+					depot().put( index, list, transfer_batch_size );
+			}
+
+	private :
+		free_list_t m_lists[ size_class_count ];
+	};
+
+//! Get the cache of the current thread.
+/*!
+ * \retval nullptr if the cache is already destroyed.
+ */
+thread_cache_t *
+thread_cache()
+	{
+		if( g_thread_cache_destroyed )
+			return nullptr;
+
+		static thread_local thread_cache_t cache;
+		return &cache;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void *
+allocate( std::size_t size )
+	{
+		auto cache = ( size && size <= max_block_size ) ? thread_cache() : nullptr;
+		if( cache )
+			return cache->allocate( size_class_index( size ) );
+
+		// A small block allocated without the thread cache has the same
+		// size as a block from the slab. It allows to put it into a cache
+		// of another thread later.
+		return ::operator new(
+				size && size <= max_block_size ?
+						size_class_block_size( size_class_index( size ) ) : size );
+	}
+
+SO_5_FUNC void
+deallocate( void * block, std::size_t size ) SO_5_NOEXCEPT
+	{
+		if( !block )
+			return;
+
+		auto cache = ( size && size <= max_block_size ) ? thread_cache() : nullptr;
+		if( cache )
+			cache->deallocate( size_class_index( size ), block );
+		else
+			::operator delete( block );
+	}
+
+} /* namespace message_slab */
+
+} /* namespace so_5 */
@@ -24,6 +24,8 @@ namespace so_5
 namespace stats
 {
 
+class snapshot_collector_t;
+
 /*!
  * \since
  * v.5.5.4
@@ -64,6 +66,26 @@ class SO_5_TYPE controller_t
 			//! New period value.
 			std::chrono::steady_clock::duration period ) = 0;
 
+		//! Take the current values of all data sources.
+		/*!
+		 * Values are read synchronously on the context of the caller.
+		 * No messages are sent. This method can be used regardless of
+		 * turn_on()/turn_off() status.
+		 *
+		 * The content of \a collector is cleared before the snapshot.
+		 *
+		 * \note Data sources are locked during the snapshot. It means that
+		 * a snapshot and distribution of values can't be performed at
+		 * the same time.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		take_snapshot(
+			//! Receiver for values.
+			snapshot_collector_t & collector ) = 0;
+
 	protected :
 		/*!
 		 * \brief Default distribution period.
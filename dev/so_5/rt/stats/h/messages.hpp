@@ -18,6 +18,9 @@
 
 #include <so_5/rt/stats/h/prefix.hpp>
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
+#include <so_5/rt/stats/h/queueing_delay.hpp>
+
+#include <typeindex>
 
 #if defined( SO_5_MSVC )
 	#pragma warning(push)
@@ -119,6 +122,86 @@ struct SO_5_TYPE work_thread_activity : public message_t
 			{}
 	};
 
+/*!
+ * \brief Latency histograms for one work thread.
+ *
+ * This message is sent with work_thread_activity message for every
+ * work thread for which activity tracking is turned on.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct SO_5_TYPE work_thread_latency : public message_t
+	{
+		//! Prefix of data_source name.
+		prefix_t m_prefix;
+		//! Suffix of data_source name.
+		suffix_t m_suffix;
+
+		//! ID of the thread.
+		so_5::current_thread_id_t m_thread_id;
+
+		//! Actual value.
+		work_thread_latency_stats_t m_stats;
+
+		work_thread_latency(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			const so_5::current_thread_id_t & thread_id,
+			const work_thread_latency_stats_t & stats )
+			:	m_prefix( prefix )
+			,	m_suffix( suffix )
+			,	m_thread_id( thread_id )
+			,	m_stats( stats )
+			{}
+	};
+
+/*!
+ * \brief Queueing delays of demands of one type for one agent.
+ *
+ * This message is sent only if queueing delay tracking is turned on
+ * for SObjectizer Environment.
+ *
+ * \see so_5::environment_params_t::turn_queueing_delay_tracking_on().
+ *
+ * \since
+ * v.5.5.25
+ */
+struct SO_5_TYPE queueing_delay : public message_t
+	{
+		//! Prefix of data_source name.
+		prefix_t m_prefix;
+		//! Suffix of data_source name.
+		suffix_t m_suffix;
+
+		//! Receiver of demands.
+		/*!
+		 * \attention This pointer must not be dereferenced: the agent
+		 * can be already destroyed at the moment of processing of
+		 * that message. It can be used only as an identifier.
+		 */
+		const agent_t * m_agent;
+
+		//! Type of message for demands.
+		std::type_index m_msg_type;
+
+		//! Actual value.
+		queueing_delay_stats_t m_stats;
+
+		queueing_delay(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			const agent_t * agent,
+			const std::type_index & msg_type,
+			const queueing_delay_stats_t & stats )
+			:	m_prefix( prefix )
+			,	m_suffix( suffix )
+			,	m_agent( agent )
+			,	m_msg_type( msg_type )
+			,	m_stats( stats )
+			{}
+	};
+
 } /* namespace messages */
 
 } /* namespace stats */
@@ -0,0 +1,91 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.5.25
+ *
+ * \brief Data types for stats of queueing delays of demands.
+ */
+
+#pragma once
+
+#include <so_5/rt/stats/h/work_thread_activity.hpp>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+/*!
+ * \brief Statistics of queueing delays for some kind of demands.
+ *
+ * Queueing delay is the time between pushing a demand to an event
+ * queue and the start of its processing.
+ *
+ * \note Values are cumulative: they are accumulated from the start
+ * of tracking for the agent.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct queueing_delay_stats_t
+	{
+		//! Count of processed demands.
+		std::uint_fast64_t m_count{};
+
+		//! Total time spent by demands in event queues.
+		duration_t m_total_time{};
+
+		//! The max time spent by a demand in an event queue.
+		duration_t m_max_time{};
+
+		//! Average time spent by a demand in an event queue.
+		duration_t
+		avg_time() const
+			{
+				return m_count ?
+						m_total_time / static_cast< duration_t::rep >( m_count ) :
+						duration_t::zero();
+			}
+
+		//! Add yet another value.
+		void
+		add( duration_t delay )
+			{
+				m_count += 1;
+				m_total_time += delay;
+				if( m_max_time < delay )
+					m_max_time = delay;
+			}
+	};
+
+/*!
+ * \brief Helper for printing value of queueing_delay_stats.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline std::ostream &
+operator<<( std::ostream & to, const queueing_delay_stats_t & what )
+{
+	auto to_ms = []( const duration_t & d ) {
+		return std::chrono::duration_cast< std::chrono::nanoseconds >( d )
+				.count() / 1000000.0;
+	};
+
+	to << "[count=" << what.m_count
+		<< ";total=" << to_ms(what.m_total_time)
+		<< "ms;avg=" << to_ms(what.avg_time())
+		<< "ms;max=" << to_ms(what.m_max_time) << "ms]";
+
+	return to;
+}
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
@@ -29,6 +29,8 @@ namespace so_5
 namespace stats
 {
 
+class snapshot_collector_t;
+
 /*!
  * \since
  * v.5.5.4
@@ -55,6 +57,22 @@ class SO_5_TYPE source_t
 			//! Target mbox for the appropriate message.
 			const mbox_t & distribution_mbox ) = 0;
 
+		//! Store the current values into a snapshot.
+		/*!
+		 * This method is used for pull-based reading of monitoring
+		 * data. It is called by controller_t::take_snapshot().
+		 *
+		 * The default implementation does nothing. It means that
+		 * values of data source are available only via distribute().
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		virtual void
+		collect(
+			//! Receiver for values.
+			snapshot_collector_t & collector );
+
 	private :
 		//! Previous item in the data sources list.
 		source_t * m_prev{};
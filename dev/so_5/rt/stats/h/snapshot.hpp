@@ -0,0 +1,243 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.5.25
+ *
+ * \brief Types for pull-based reading of run-time monitoring data.
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+
+#include <so_5/rt/stats/h/prefix.hpp>
+#include <so_5/rt/stats/h/work_thread_activity.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+#if defined( SO_5_MSVC )
+	#pragma warning(push)
+	#pragma warning(disable: 4251)
+#endif
+
+namespace so_5
+{
+
+namespace stats
+{
+
+/*!
+ * \brief Type of identifier of an interned name.
+ *
+ * \since
+ * v.5.5.25
+ */
+using name_id_t = std::uint32_t;
+
+/*!
+ * \brief A registry of interned names of data sources.
+ *
+ * Every unique string receives its own identifier. Identifiers are
+ * assigned sequentially starting from zero.
+ *
+ * A memory is allocated only when a new name is added to the registry.
+ * Lookup of an already known name does not allocate.
+ *
+ * \attention This class is not thread safe.
+ *
+ * \since
+ * v.5.5.25
+ */
+class SO_5_TYPE name_registry_t
+	{
+	public :
+		name_registry_t( const name_registry_t & ) = delete;
+		name_registry_t & operator=( const name_registry_t & ) = delete;
+
+		name_registry_t();
+
+		//! Get an identifier for a name.
+		/*!
+		 * A new identifier is created if \a name is not known yet.
+		 */
+		name_id_t
+		intern( const char * name );
+
+		//! Get a name by its identifier.
+		/*!
+		 * \attention \a id must be obtained from this registry.
+		 */
+		const char *
+		name( name_id_t id ) const
+			{
+				return m_names[ id ].c_str();
+			}
+
+		//! Count of names in the registry.
+		std::size_t
+		size() const
+			{
+				return m_names.size();
+			}
+
+	private :
+		//! Names in order of their registration.
+		/*!
+		 * std::deque is used because it doesn't move existing items
+		 * at the growth.
+		 */
+		std::deque< std::string > m_names;
+
+		//! Index of names by hash values.
+		std::unordered_multimap< std::size_t, name_id_t > m_index;
+	};
+
+/*!
+ * \brief One numeric value from a snapshot of monitoring data.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct snapshot_record_t
+	{
+		//! Identifier of data source prefix.
+		name_id_t m_prefix;
+		//! Identifier of data source suffix.
+		name_id_t m_suffix;
+		//! The value itself.
+		std::uint64_t m_value;
+	};
+
+/*!
+ * \brief A receiver of monitoring data during a snapshot.
+ *
+ * Stores records into a buffer provided by the caller. If there is
+ * no more space in the buffer then remaining records are counted
+ * but not stored (see dropped()).
+ *
+ * Usage example:
+ * \code
+	so_5::stats::name_registry_t names;
+	std::vector< so_5::stats::snapshot_record_t > buffer( 1024 );
+	...
+	so_5::stats::snapshot_collector_t collector{
+			names, buffer.data(), buffer.size() };
+	env.stats_controller().take_snapshot( collector );
+	for( const auto & r : collector )
+		std::cout << names.name( r.m_prefix ) << names.name( r.m_suffix )
+			<< ": " << r.m_value << std::endl;
+ * \endcode
+ *
+ * The same collector can be used for several snapshots. Its content
+ * is cleared at the start of every snapshot.
+ *
+ * \since
+ * v.5.5.25
+ */
+class SO_5_TYPE snapshot_collector_t
+	{
+	public :
+		snapshot_collector_t( const snapshot_collector_t & ) = delete;
+		snapshot_collector_t & operator=( const snapshot_collector_t & ) = delete;
+
+		//! Initializing constructor.
+		snapshot_collector_t(
+			//! Registry for names of data sources.
+			//! Must outlive the collector.
+			name_registry_t & names,
+			//! Buffer for records.
+			snapshot_record_t * buffer,
+			//! Capacity of the buffer.
+			std::size_t capacity );
+
+		//! Drop all stored records.
+		void
+		clear()
+			{
+				m_size = 0u;
+				m_dropped = 0u;
+			}
+
+		//! Store yet another value.
+		void
+		add(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			std::uint64_t value );
+
+		//! Store values of work thread activity.
+		/*!
+		 * Four records are stored. Their suffixes are made from \a suffix
+		 * by addition of ".working.count", ".working.total_ns",
+		 * ".waiting.count" and ".waiting.total_ns".
+		 */
+		void
+		add(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			const work_thread_activity_stats_t & stats );
+
+		//! Registry of names.
+		name_registry_t &
+		names() const
+			{
+				return m_names;
+			}
+
+		//! Count of stored records.
+		std::size_t
+		size() const
+			{
+				return m_size;
+			}
+
+		//! Count of records which were not stored due to lack of space.
+		std::size_t
+		dropped() const
+			{
+				return m_dropped;
+			}
+
+		const snapshot_record_t *
+		begin() const
+			{
+				return m_buffer;
+			}
+
+		const snapshot_record_t *
+		end() const
+			{
+				return m_buffer + m_size;
+			}
+
+	private :
+		name_registry_t & m_names;
+
+		snapshot_record_t * const m_buffer;
+		const std::size_t m_capacity;
+
+		std::size_t m_size{ 0u };
+		std::size_t m_dropped{ 0u };
+
+		void
+		store(
+			name_id_t prefix,
+			name_id_t suffix,
+			std::uint64_t value );
+	};
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
+#if defined( SO_5_MSVC )
+	#pragma warning(pop)
+#endif
+
@@ -50,6 +50,16 @@ mbox_repository();
 SO_5_FUNC prefix_t
 timer_thread();
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Prefix of data sources with statistics for queueing delays
+ * of demands.
+ */
+SO_5_FUNC prefix_t
+queueing_delay();
+
 } /* namespace prefixes */
 
 namespace suffixes {
@@ -129,6 +139,24 @@ work_thread_queue_size();
 SO_5_FUNC suffix_t
 work_thread_activity();
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Suffix for data source with work thread latency histograms.
+ */
+SO_5_FUNC suffix_t
+work_thread_latency();
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Suffix for data source with queueing delays of demands.
+ */
+SO_5_FUNC suffix_t
+queueing_delay();
+
 /*!
  * \since
  * v.5.5.4
@@ -167,6 +195,30 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Suffix for data source with count of demand nodes taken from
+ * the pool of a work thread.
+ *
+ * This suffix is used in thread_pool and adv_thread_pool dispatchers.
+ */
+SO_5_FUNC suffix_t
+demand_pool_hits();
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief Suffix for data source with count of demand nodes which were
+ * allocated by operator new because the pool of a work thread was empty.
+ *
+ * This suffix is used in thread_pool and adv_thread_pool dispatchers.
+ */
+SO_5_FUNC suffix_t
+demand_pool_misses();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <chrono>
 #include <iostream>
@@ -100,6 +101,239 @@ struct work_thread_activity_stats_t
 		activity_stats_t m_waiting_stats{};
 	};
 
+/*!
+ * \brief A histogram of durations of some activity.
+ *
+ * Uses log-linear layout of buckets (like HDR histogram): values
+ * less than sub_bucket_count nanoseconds have their own buckets, every
+ * next power of two range is split to sub_bucket_count buckets of equal
+ * width. It means that relative error of a value does not exceed
+ * 1/sub_bucket_count (6.25%).
+ *
+ * Values greater than max_trackable_value() go to the last bucket.
+ *
+ * \note Counters are cumulative: they are accumulated from the start
+ * of a work thread. Use operator-=() to get counters for some period
+ * of time between two snapshots.
+ *
+ * \since
+ * v.5.5.25
+ */
+class latency_histogram_t
+	{
+	public :
+		//! Count of bits for sub-buckets.
+		static const unsigned int sub_bucket_bits = 4;
+		//! Count of sub-buckets in every power of two range.
+		static const std::size_t sub_bucket_count = 1u << sub_bucket_bits;
+		//! Count of power of two ranges (including the linear one).
+		static const std::size_t range_count = 39;
+		//! Total count of buckets.
+		static const std::size_t bucket_count =
+				range_count * sub_bucket_count;
+
+		//! Type of counter in a bucket.
+		using counter_t = std::uint64_t;
+
+		//! Max value which can be stored without a loss of precision.
+		static duration_t
+		max_trackable_value()
+			{
+				return std::chrono::duration_cast< duration_t >(
+						std::chrono::nanoseconds(
+								bucket_upper_bound( bucket_count - 1 ) ) );
+			}
+
+		//! Get an index of bucket for a value in nanoseconds.
+		static std::size_t
+		bucket_index( std::uint64_t nanoseconds )
+			{
+				if( nanoseconds < sub_bucket_count )
+					return static_cast< std::size_t >( nanoseconds );
+
+				const unsigned int exponent =
+						most_significant_bit( nanoseconds ) - sub_bucket_bits + 1;
+				if( exponent >= range_count )
+					return bucket_count - 1;
+
+				return exponent * sub_bucket_count +
+						static_cast< std::size_t >(
+								(nanoseconds >> (exponent - 1)) - sub_bucket_count );
+			}
+
+		//! Get the lowest value (in nanoseconds) for a bucket.
+		static std::uint64_t
+		bucket_lower_bound( std::size_t index )
+			{
+				if( index < sub_bucket_count )
+					return index;
+
+				const auto exponent = index / sub_bucket_count;
+				const auto sub_bucket = index % sub_bucket_count;
+				return static_cast< std::uint64_t >( sub_bucket_count + sub_bucket )
+						<< (exponent - 1);
+			}
+
+		//! Get the highest value (in nanoseconds) for a bucket.
+		static std::uint64_t
+		bucket_upper_bound( std::size_t index )
+			{
+				if( index < sub_bucket_count )
+					return index;
+
+				return bucket_lower_bound( index ) +
+						(std::uint64_t{1} << (index / sub_bucket_count - 1)) - 1;
+			}
+
+		//! Get a counter for a bucket.
+		counter_t
+		bucket( std::size_t index ) const
+			{
+				return m_buckets[ index ];
+			}
+
+		//! Set a counter for a bucket.
+		void
+		set_bucket( std::size_t index, counter_t value )
+			{
+				m_buckets[ index ] = value;
+			}
+
+		//! Add one value to the histogram.
+		void
+		add( duration_t value )
+			{
+				m_buckets[ bucket_index( to_nanoseconds( value ) ) ] += 1;
+			}
+
+		//! Total count of values in the histogram.
+		counter_t
+		total_count() const
+			{
+				counter_t result = 0;
+				for( auto c : m_buckets )
+					result += c;
+				return result;
+			}
+
+		//! Get a value for a percentile.
+		/*!
+		 * Returns the highest value of a bucket which contains
+		 * the specified percentile. Returns zero for an empty histogram.
+		 */
+		duration_t
+		value_at_percentile(
+			//! Percentile in range [0.0, 100.0].
+			double percentile ) const
+			{
+				const auto total = total_count();
+				if( !total )
+					return duration_t::zero();
+
+				if( percentile > 100.0 )
+					percentile = 100.0;
+				auto required = static_cast< counter_t >(
+						percentile / 100.0 * static_cast< double >( total ) + 0.5 );
+				if( !required )
+					required = 1;
+
+				counter_t accumulated = 0;
+				std::size_t index = 0;
+				for( ; index != bucket_count; ++index )
+					{
+						accumulated += m_buckets[ index ];
+						if( accumulated >= required )
+							break;
+					}
+
+				return std::chrono::duration_cast< duration_t >(
+						std::chrono::nanoseconds( bucket_upper_bound( index ) ) );
+			}
+
+		//! Get the highest value stored in the histogram.
+		duration_t
+		max_value() const
+			{
+				return value_at_percentile( 100.0 );
+			}
+
+		//! Subtract counters of a previous snapshot.
+		latency_histogram_t &
+		operator-=( const latency_histogram_t & previous )
+			{
+				for( std::size_t i = 0; i != bucket_count; ++i )
+					m_buckets[ i ] -= previous.m_buckets[ i ];
+				return *this;
+			}
+
+		//! Helper for conversion of a duration to nanoseconds.
+		static std::uint64_t
+		to_nanoseconds( duration_t value )
+			{
+				const auto ns = std::chrono::duration_cast<
+						std::chrono::nanoseconds >( value ).count();
+				return ns > 0 ? static_cast< std::uint64_t >( ns ) : 0u;
+			}
+
+	private :
+		//! Counters.
+		counter_t m_buckets[ bucket_count ] = {};
+
+		//! Index of the most significant bit of non-zero value.
+		static unsigned int
+		most_significant_bit( std::uint64_t v )
+			{
+				unsigned int result = 0;
+				if( v >> 32 ) { v >>= 32; result += 32; }
+				if( v >> 16 ) { v >>= 16; result += 16; }
+				if( v >> 8 ) { v >>= 8; result += 8; }
+				if( v >> 4 ) { v >>= 4; result += 4; }
+				if( v >> 2 ) { v >>= 2; result += 2; }
+				if( v >> 1 ) { result += 1; }
+				return result;
+			}
+	};
+
+/*!
+ * \brief Helper for printing value of latency_histogram.
+ *
+ * Prints only count of values and several percentiles.
+ *
+ * \since
+ * v.5.5.25
+ */
+inline std::ostream &
+operator<<( std::ostream & to, const latency_histogram_t & what )
+{
+	auto to_ms = []( const duration_t & d ) {
+		return std::chrono::duration_cast< std::chrono::nanoseconds >( d )
+				.count() / 1000000.0;
+	};
+
+	to << "[count=" << what.total_count()
+		<< ";p50=" << to_ms(what.value_at_percentile( 50.0 ))
+		<< "ms;p99=" << to_ms(what.value_at_percentile( 99.0 ))
+		<< "ms;p99.9=" << to_ms(what.value_at_percentile( 99.9 ))
+		<< "ms;max=" << to_ms(what.max_value()) << "ms]";
+
+	return to;
+}
+
+/*!
+ * \brief Latency histograms for a work thread.
+ *
+ * \since
+ * v.5.5.25
+ */
+struct work_thread_latency_stats_t
+	{
+		//! Histogram of event service times.
+		latency_histogram_t m_working_histogram{};
+
+		//! Histogram of waiting periods.
+		latency_histogram_t m_waiting_histogram{};
+	};
+
 namespace details
 {
 
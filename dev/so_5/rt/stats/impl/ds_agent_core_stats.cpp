@@ -14,6 +14,7 @@
 
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -58,6 +59,30 @@ ds_agent_core_stats_t::distribute(
 				stats.m_final_dereg_coop_count );
 	}
 
+void
+ds_agent_core_stats_t::collect(
+	snapshot_collector_t & collector )
+	{
+		auto stats = m_what.query_coop_repository_stats();
+		const auto prefix = prefixes::coop_repository();
+
+		collector.add( prefix,
+				suffixes::coop_reg_count(),
+				stats.m_registered_coop_count );
+
+		collector.add( prefix,
+				suffixes::coop_dereg_count(),
+				stats.m_deregistered_coop_count );
+
+		collector.add( prefix,
+				suffixes::agent_count(),
+				stats.m_total_agent_count );
+
+		collector.add( prefix,
+				suffixes::coop_final_dereg_count(),
+				stats.m_final_dereg_coop_count );
+	}
+
 } /* namespace impl */
 
 } /* namespace stats */
@@ -14,6 +14,7 @@
 
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -43,6 +44,17 @@ ds_mbox_core_stats_t::distribute(
 				stats.m_named_mbox_count );
 	}
 
+void
+ds_mbox_core_stats_t::collect(
+	snapshot_collector_t & collector )
+	{
+		auto stats = m_what.query_stats();
+
+		collector.add( prefixes::mbox_repository(),
+				suffixes::named_mbox_count(),
+				stats.m_named_mbox_count );
+	}
+
 } /* namespace impl */
 
 } /* namespace stats */
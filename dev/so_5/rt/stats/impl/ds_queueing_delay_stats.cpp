@@ -0,0 +1,116 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \file
+ * \brief A data source class for run-time monitoring of queueing delays.
+ */
+
+#include <so_5/rt/stats/impl/h/ds_queueing_delay_stats.hpp>
+
+#include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/std_names.hpp>
+
+#include <so_5/rt/h/send_functions.hpp>
+
+#include <so_5/details/h/ios_helpers.hpp>
+
+#include <mutex>
+#include <sstream>
+
+namespace so_5 {
+
+namespace stats {
+
+namespace impl {
+
+namespace
+{
+
+prefix_t
+make_agent_prefix( const agent_t * agent )
+	{
+		std::ostringstream ss;
+		ss << prefixes::queueing_delay().c_str() << "/a/"
+				<< so_5::details::ios_helpers::pointer{ agent };
+
+		return prefix_t{ ss.str() };
+	}
+
+} /* namespace anonymous */
+
+//
+// ds_queueing_delay_stats_t
+//
+ds_queueing_delay_stats_t::ds_queueing_delay_stats_t()
+	{}
+
+void
+ds_queueing_delay_stats_t::record(
+	const agent_t * agent,
+	const std::type_index & msg_type,
+	duration_t delay )
+	{
+		auto & shard = shard_for( agent );
+
+		std::lock_guard< default_spinlock_t > lock{ shard.m_lock };
+		shard.m_values[ key_t{ agent, msg_type } ].add( delay );
+	}
+
+void
+ds_queueing_delay_stats_t::forget_agent( const agent_t * agent ) SO_5_NOEXCEPT
+	{
+		auto & shard = shard_for( agent );
+
+		std::lock_guard< default_spinlock_t > lock{ shard.m_lock };
+		for( auto it = shard.m_values.begin(); it != shard.m_values.end(); )
+			{
+				if( it->first.m_agent == agent )
+					it = shard.m_values.erase( it );
+				else
+					++it;
+			}
+	}
+
+void
+ds_queueing_delay_stats_t::distribute(
+	const mbox_t & distribution_mbox )
+	{
+		// Values are copied under the lock but sent without it.
+		m_snapshot.clear();
+		for( auto & shard : m_shards )
+			{
+				std::lock_guard< default_spinlock_t > lock{ shard.m_lock };
+				m_snapshot.insert( m_snapshot.end(),
+						shard.m_values.begin(), shard.m_values.end() );
+			}
+
+		const agent_t * last_agent = nullptr;
+		prefix_t prefix;
+		for( const auto & item : m_snapshot )
+			{
+				if( last_agent != item.first.m_agent )
+					{
+						last_agent = item.first.m_agent;
+						prefix = make_agent_prefix( last_agent );
+					}
+
+				send< messages::queueing_delay >( distribution_mbox,
+						prefix,
+						suffixes::queueing_delay(),
+						item.first.m_agent,
+						item.first.m_msg_type,
+						item.second );
+			}
+	}
+
+} /* namespace impl */
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
@@ -14,6 +14,7 @@
 
 #include <so_5/rt/stats/h/messages.hpp>
 #include <so_5/rt/stats/h/std_names.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -48,6 +49,21 @@ ds_timer_thread_stats_t::distribute(
 				stats.m_periodic_count );
 	}
 
+void
+ds_timer_thread_stats_t::collect(
+	snapshot_collector_t & collector )
+	{
+		const auto stats = m_what.query_timer_thread_stats();
+
+		collector.add( prefixes::timer_thread(),
+				suffixes::timer_single_shot_count(),
+				stats.m_single_shot_count );
+
+		collector.add( prefixes::timer_thread(),
+				suffixes::timer_periodic_count(),
+				stats.m_periodic_count );
+	}
+
 } /* namespace impl */
 
 } /* namespace stats */
@@ -17,6 +17,8 @@
 
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
 
+#include <atomic>
+
 namespace so_5
 {
 
@@ -156,6 +158,62 @@ struct null_lock
 		null_lock() {}
 	};
 
+/*!
+ * \brief Lock-free collector for latency histogram.
+ *
+ * Values are added by a work thread and are read by stats distribution
+ * thread. Atomic counters with relaxed memory ordering are used, so
+ * there is no locking on the hot path.
+ *
+ * \note A snapshot returned by take() is not an atomic one: values
+ * added during creation of snapshot can be partially present in it.
+ * It is not a problem for statistics.
+ *
+ * \since
+ * v.5.5.25
+ */
+class latency_histogram_collector_t
+	{
+		using histogram_t = so_5::stats::latency_histogram_t;
+
+	public :
+		latency_histogram_collector_t()
+			{
+				for( auto & b : m_buckets )
+					b.store( 0, std::memory_order_relaxed );
+			}
+
+		latency_histogram_collector_t(
+				const latency_histogram_collector_t & ) = delete;
+		latency_histogram_collector_t &
+		operator=( const latency_histogram_collector_t & ) = delete;
+
+		//! Add a value to the histogram.
+		void
+		add( so_5::stats::duration_t value ) SO_5_NOEXCEPT
+			{
+				m_buckets[ histogram_t::bucket_index(
+						histogram_t::to_nanoseconds( value ) ) ]
+					.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+		//! Get the current content of the histogram.
+		histogram_t
+		take() const
+			{
+				histogram_t result;
+				for( std::size_t i = 0; i != histogram_t::bucket_count; ++i )
+					result.set_bucket( i,
+							m_buckets[ i ].load( std::memory_order_relaxed ) );
+
+				return result;
+			}
+
+	private :
+		std::atomic< histogram_t::counter_t >
+				m_buckets[ histogram_t::bucket_count ];
+	};
+
 /*!
  * \brief Helper for collecting activity stats.
  *
@@ -201,12 +259,22 @@ class stats_collector_t : protected Lock_Holder
 		void
 		stop()
 			{
-				typename Lock_Holder::start_stop_lock_t lock{ lock_holder() };
+				so_5::stats::duration_t last_duration;
 
-				m_is_in_working = false;
-				so_5::stats::details::update_stats_from_current_time(
-						m_work_activity,
-						m_work_started_at );
+				{
+					typename Lock_Holder::start_stop_lock_t lock{ lock_holder() };
+
+					m_is_in_working = false;
+					last_duration =
+							so_5::stats::clock_type_t::now() - m_work_started_at;
+					so_5::stats::details::update_stats_from_duration(
+							m_work_activity,
+							last_duration );
+				}
+
+				// Since v.5.5.25 there is also a histogram of durations.
+				// It doesn't require a lock.
+				m_histogram.add( last_duration );
 			}
 
 		so_5::stats::activity_stats_t
@@ -232,6 +300,18 @@ class stats_collector_t : protected Lock_Holder
 				return result;
 			}
 
+		/*!
+		 * \brief Get the histogram of durations of completed activities.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		so_5::stats::latency_histogram_t
+		take_histogram() const
+			{
+				return m_histogram.take();
+			}
+
 	private :
 		//! A flag for indicating work activity.
 		bool m_is_in_working{ false };
@@ -242,6 +322,14 @@ class stats_collector_t : protected Lock_Holder
 		//! A statistics for work activity.
 		so_5::stats::activity_stats_t m_work_activity{};
 
+		/*!
+		 * \brief A histogram of durations of completed activities.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		latency_histogram_collector_t m_histogram;
+
 		void
 		do_start()
 			{
@@ -44,6 +44,10 @@ class ds_agent_core_stats_t final : public source_t
 		distribute(
 			const mbox_t & distribution_mbox ) override;
 
+		void
+		collect(
+			snapshot_collector_t & collector ) override;
+
 	private :
 		so_5::environment_infrastructure_t & m_what;
 	};
@@ -44,6 +44,10 @@ class ds_mbox_core_stats_t : public source_t
 		distribute(
 			const mbox_t & distribution_mbox ) override;
 
+		void
+		collect(
+			snapshot_collector_t & collector ) override;
+
 	private :
 		so_5::impl::mbox_core_t & m_what;
 	};
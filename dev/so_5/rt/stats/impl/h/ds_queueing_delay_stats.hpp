@@ -0,0 +1,132 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \file
+ * \brief A data source class for run-time monitoring of queueing delays.
+ */
+
+#pragma once
+
+#include <so_5/rt/stats/h/repository.hpp>
+#include <so_5/rt/stats/h/queueing_delay.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace so_5 {
+
+namespace stats {
+
+namespace impl {
+
+//
+// ds_queueing_delay_stats_t
+//
+/*!
+ * \since
+ * v.5.5.25
+ *
+ * \brief A data source for collecting and distributing information
+ * about queueing delays of demands.
+ *
+ * Values are collected for every pair (agent, message type). Storage
+ * of values is split into several shards to reduce contention between
+ * work threads.
+ */
+class ds_queueing_delay_stats_t : public source_t
+	{
+	public :
+		ds_queueing_delay_stats_t();
+
+		//! Add yet another value for an agent and a message type.
+		void
+		record(
+			const agent_t * agent,
+			const std::type_index & msg_type,
+			duration_t delay );
+
+		//! Remove all values for an agent.
+		/*!
+		 * Must be called at the end of agent's work.
+		 */
+		void
+		forget_agent( const agent_t * agent ) SO_5_NOEXCEPT;
+
+		void
+		distribute(
+			const mbox_t & distribution_mbox ) override;
+
+	private :
+		//! Key for a value.
+		struct key_t
+			{
+				const agent_t * m_agent;
+				std::type_index m_msg_type;
+
+				bool
+				operator==( const key_t & o ) const
+					{
+						return m_agent == o.m_agent && m_msg_type == o.m_msg_type;
+					}
+			};
+
+		//! Hash function for key.
+		struct key_hash_t
+			{
+				std::size_t
+				operator()( const key_t & k ) const
+					{
+						return std::hash< const void * >{}( k.m_agent ) ^
+								k.m_msg_type.hash_code();
+					}
+			};
+
+		//! Count of shards.
+		static const std::size_t shard_count = 16;
+
+		//! One shard of values.
+		struct shard_t
+			{
+				default_spinlock_t m_lock;
+				std::unordered_map< key_t, queueing_delay_stats_t, key_hash_t >
+						m_values;
+			};
+
+		//! Type of one item of snapshot for distribution.
+		using snapshot_item_t = std::pair< key_t, queueing_delay_stats_t >;
+
+		shard_t m_shards[ shard_count ];
+
+		//! Snapshot of values for distribution.
+		/*!
+		 * It is stored in data source to reuse memory between
+		 * distributions.
+		 */
+		std::vector< snapshot_item_t > m_snapshot;
+
+		//! Get a shard for an agent.
+		/*!
+		 * All values for an agent are stored in the same shard.
+		 */
+		shard_t &
+		shard_for( const agent_t * agent ) SO_5_NOEXCEPT
+			{
+				return m_shards[
+						std::hash< const void * >{}( agent ) % shard_count ];
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
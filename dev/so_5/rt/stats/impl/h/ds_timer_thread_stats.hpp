@@ -44,6 +44,10 @@ class ds_timer_thread_stats_t : public source_t
 		distribute(
 			const mbox_t & distribution_mbox ) override;
 
+		void
+		collect(
+			snapshot_collector_t & collector ) override;
+
 	private :
 		so_5::environment_infrastructure_t & m_what;
 	};
@@ -62,6 +62,10 @@ class std_controller_t final
 		set_distribution_period(
 			std::chrono::steady_clock::duration period ) override;
 
+		virtual void
+		take_snapshot(
+			snapshot_collector_t & collector ) override;
+
 		// Implementation of repository_t interface.
 		virtual void
 		add( source_t & what ) override;
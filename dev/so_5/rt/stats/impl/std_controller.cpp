@@ -13,6 +13,7 @@
 #include <so_5/rt/stats/impl/h/std_controller.hpp>
 
 #include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/snapshot.hpp>
 
 #include <so_5/rt/h/send_functions.hpp>
 
@@ -91,6 +92,23 @@ std_controller_t::set_distribution_period(
 		return ret_value;
 	}
 
+void
+std_controller_t::take_snapshot(
+	snapshot_collector_t & collector )
+	{
+		std::lock_guard< std::mutex > lock{ m_data_lock };
+
+		collector.clear();
+
+		source_t * s = m_head;
+		while( s )
+			{
+				s->collect( collector );
+
+				s = source_list_next( *s );
+			}
+	}
+
 void
 std_controller_t::add( source_t & what )
 	{
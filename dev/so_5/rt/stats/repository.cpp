@@ -18,6 +18,15 @@ namespace so_5
 namespace stats
 {
 
+//
+// source_t
+//
+void
+source_t::collect( snapshot_collector_t & )
+	{
+		/* Nothing to do by default. */
+	}
+
 //
 // repository_t
 //
@@ -0,0 +1,171 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.5.25
+ *
+ * \brief Types for pull-based reading of run-time monitoring data.
+ */
+
+#include <so_5/rt/stats/h/snapshot.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+namespace
+{
+
+//! FNV-1a hash for a null-terminated string.
+std::size_t
+hash_of( const char * name )
+	{
+		std::uint64_t result = 14695981039346656037ull;
+		for( ; *name; ++name )
+			{
+				result ^= static_cast< unsigned char >( *name );
+				result *= 1099511628211ull;
+			}
+
+		return static_cast< std::size_t >( result );
+	}
+
+//! Max length of a suffix for a part of work thread activity.
+const std::size_t max_activity_suffix_length = 127;
+
+//! Make a suffix for a part of work thread activity.
+/*!
+ * Suffix is made in a buffer on the stack, the result is truncated
+ * if it is too long.
+ */
+void
+make_activity_suffix(
+	char (&buffer)[ max_activity_suffix_length + 1 ],
+	const char * base,
+	const char * part )
+	{
+		char * pos = buffer;
+		char * const last = buffer + max_activity_suffix_length;
+		for( ; *base && pos != last; ++pos, ++base )
+			*pos = *base;
+		for( ; *part && pos != last; ++pos, ++part )
+			*pos = *part;
+		*pos = 0;
+	}
+
+} /* namespace anonymous */
+
+//
+// name_registry_t
+//
+name_registry_t::name_registry_t()
+	{}
+
+name_id_t
+name_registry_t::intern( const char * name )
+	{
+		const auto hash = hash_of( name );
+
+		const auto range = m_index.equal_range( hash );
+		const auto it = std::find_if( range.first, range.second,
+				[&]( const std::pair< const std::size_t, name_id_t > & p ) {
+					return 0 == std::strcmp( m_names[ p.second ].c_str(), name );
+				} );
+		if( it != range.second )
+			return it->second;
+
+		const auto id = static_cast< name_id_t >( m_names.size() );
+		m_names.emplace_back( name );
+		try
+			{
+				m_index.emplace( hash, id );
+			}
+		catch( ... )
+			{
+				m_names.pop_back();
+				throw;
+			}
+
+		return id;
+	}
+
+//
+// snapshot_collector_t
+//
+snapshot_collector_t::snapshot_collector_t(
+	name_registry_t & names,
+	snapshot_record_t * buffer,
+	std::size_t capacity )
+	:	m_names( names )
+	,	m_buffer( buffer )
+	,	m_capacity( capacity )
+	{}
+
+void
+snapshot_collector_t::add(
+	const prefix_t & prefix,
+	const suffix_t & suffix,
+	std::uint64_t value )
+	{
+		store(
+				m_names.intern( prefix.c_str() ),
+				m_names.intern( suffix.c_str() ),
+				value );
+	}
+
+void
+snapshot_collector_t::add(
+	const prefix_t & prefix,
+	const suffix_t & suffix,
+	const work_thread_activity_stats_t & stats )
+	{
+		const auto prefix_id = m_names.intern( prefix.c_str() );
+
+		char buffer[ max_activity_suffix_length + 1 ];
+		auto store_part = [&]( const char * part, std::uint64_t value ) {
+			make_activity_suffix( buffer, suffix.c_str(), part );
+			store( prefix_id, m_names.intern( buffer ), value );
+		};
+
+		store_part( ".working.count",
+				static_cast< std::uint64_t >( stats.m_working_stats.m_count ) );
+		store_part( ".working.total_ns",
+				latency_histogram_t::to_nanoseconds(
+						stats.m_working_stats.m_total_time ) );
+		store_part( ".waiting.count",
+				static_cast< std::uint64_t >( stats.m_waiting_stats.m_count ) );
+		store_part( ".waiting.total_ns",
+				latency_histogram_t::to_nanoseconds(
+						stats.m_waiting_stats.m_total_time ) );
+	}
+
+void
+snapshot_collector_t::store(
+	name_id_t prefix,
+	name_id_t suffix,
+	std::uint64_t value )
+	{
+		if( m_size < m_capacity )
+			{
+				auto & r = m_buffer[ m_size ];
+				r.m_prefix = prefix;
+				r.m_suffix = suffix;
+				r.m_value = value;
+				++m_size;
+			}
+		else
+			++m_dropped;
+	}
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
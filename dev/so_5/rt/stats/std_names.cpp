@@ -36,6 +36,12 @@ timer_thread()
 		return prefix_t( "timer_thread" );
 	}
 
+SO_5_FUNC prefix_t
+queueing_delay()
+	{
+		return prefix_t( "queueing_delay" );
+	}
+
 } /* namespace prefixes */
 
 namespace suffixes {
@@ -92,6 +98,18 @@ work_thread_activity()
 		IMPL_SUFFIX( "/thread.activity" )
 	}
 
+SO_5_FUNC suffix_t
+work_thread_latency()
+	{
+		IMPL_SUFFIX( "/thread.latency" )
+	}
+
+SO_5_FUNC suffix_t
+queueing_delay()
+	{
+		IMPL_SUFFIX( "/queueing.delay" )
+	}
+
 SO_5_FUNC suffix_t
 disp_thread_count()
 	{
@@ -116,6 +134,18 @@ demand_quote()
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+demand_pool_hits()
+	{
+		IMPL_SUFFIX( "/demand_pool.hits" )
+	}
+
+SO_5_FUNC suffix_t
+demand_pool_misses()
+	{
+		IMPL_SUFFIX( "/demand_pool.misses" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
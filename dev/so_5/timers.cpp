@@ -20,6 +20,11 @@
 
 #include <timertt/all.hpp>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace so_5
 {
 
@@ -94,6 +99,29 @@ class actual_timer_t : public timer_t
 		timer_holder_t m_timer;
 	};
 
+//
+// coalesced_tick_t
+//
+/*!
+ * \brief An interface of shared tick for coalesced periodic timers.
+ *
+ * \since
+ * v.5.5.25
+ */
+class coalesced_tick_t
+	:	public so_5::atomic_refcounted_t
+	{
+	public :
+		virtual ~coalesced_tick_t() SO_5_NOEXCEPT = default;
+
+		//! Deliver messages for the current tick.
+		virtual void
+		fire() SO_5_NOEXCEPT = 0;
+	};
+
+//! Alias for smart pointer to coalesced_tick.
+using coalesced_tick_ref_t = intrusive_ptr_t< coalesced_tick_t >;
+
 //
 // timer_action_for_timer_thread_t
 //
@@ -101,6 +129,9 @@ class actual_timer_t : public timer_t
  * \brief A functor to be used as timer action in implementation
  * of timer thread.
  *
+ * \note Since v.5.5.25 this action can be an action for a shared
+ * tick of coalesced periodic timers.
+ *
  * \since
  * v.5.5.20
  */
@@ -110,6 +141,15 @@ class timer_action_for_timer_thread_t
 		mbox_t m_mbox;
 		message_ref_t m_msg;
 
+		//! Shared tick for coalesced timers.
+		/*!
+		 * If it is not null then all other fields are not used.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		coalesced_tick_ref_t m_tick;
+
 	public:
 		timer_action_for_timer_thread_t(
 			std::type_index type_index,
@@ -120,11 +160,373 @@ class timer_action_for_timer_thread_t
 			,	m_msg( std::move(msg) )
 			{}
 
+		/*!
+		 * \brief Initializing constructor for shared tick.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		timer_action_for_timer_thread_t(
+			coalesced_tick_ref_t tick )
+			:	m_type_index( typeid(void) )
+			,	m_tick( std::move(tick) )
+			{}
+
 		void
 		operator()() SO_5_NOEXCEPT
 			{
-				::so_5::rt::impl::mbox_iface_for_timers_t{ m_mbox }
-						.deliver_message_from_timer( m_type_index, m_msg );
+				if( m_tick )
+					m_tick->fire();
+				else
+					::so_5::rt::impl::mbox_iface_for_timers_t{ m_mbox }
+							.deliver_message_from_timer( m_type_index, m_msg );
+			}
+	};
+
+//
+// timer_coalescer_t
+//
+/*!
+ * \brief A storage of groups of coalesced periodic timers.
+ *
+ * Every group has a period and one shared periodic timer. All periodic
+ * messages from the group are delivered on every tick of that shared
+ * timer. There can be several groups with the same period, but with
+ * different phases.
+ *
+ * A new periodic message joins a group with the same period if the
+ * nearest tick of the group which is not earlier than the required time
+ * of the first delivery is within the slack. Otherwise a new group is
+ * created.
+ *
+ * The shared timer of a group is deactivated when the last message
+ * is removed from the group.
+ *
+ * \tparam Timer_Thread A type of timertt-based thread which implements timers.
+ *
+ * \since
+ * v.5.5.25
+ */
+template< class Timer_Thread >
+class timer_coalescer_t
+	{
+		using duration = std::chrono::steady_clock::duration;
+		using time_point = std::chrono::steady_clock::time_point;
+
+		//! The actual type of timer holder for timertt.
+		using timer_holder_t = timertt::timer_object_holder<
+				typename Timer_Thread::thread_safety >;
+
+		//! Description of one periodic message inside a group.
+		struct member_t
+			{
+				//! Index of the first tick for that message.
+				std::uint64_t m_first_tick;
+				std::type_index m_type_index;
+				mbox_t m_mbox;
+				message_ref_t m_msg;
+			};
+
+		//! A group of coalesced timers.
+		class group_t final : public coalesced_tick_t
+			{
+			public :
+				group_t(
+					timer_coalescer_t & coalescer,
+					duration period,
+					time_point origin )
+					:	m_coalescer( coalescer )
+					,	m_period( period )
+					,	m_origin( origin )
+					{}
+
+				virtual void
+				fire() SO_5_NOEXCEPT override
+					{
+						m_coalescer.fire( *this );
+					}
+
+				timer_coalescer_t & m_coalescer;
+
+				//! Period of the group.
+				const duration m_period;
+
+				//! Time of the first tick of the group.
+				const time_point m_origin;
+
+				//! Count of ticks already fired.
+				std::uint64_t m_ticks_fired{ 0 };
+
+				//! Members of the group.
+				std::map< std::uint64_t, member_t > m_members;
+
+				//! Shared timer of the group.
+				timer_holder_t m_timer;
+
+				//! Messages to be delivered on the current tick.
+				/*!
+				 * \note Is used only on the context of the timer thread.
+				 * Memory is reused from tick to tick.
+				 */
+				std::vector< member_t > m_to_deliver;
+			};
+
+		using group_ref_t = intrusive_ptr_t< group_t >;
+
+		//! Actual implementation of timer_id for coalesced timer.
+		class member_timer_t final : public timer_t
+			{
+			public :
+				member_timer_t(
+					timer_coalescer_t & coalescer,
+					group_ref_t group,
+					std::uint64_t id )
+					:	m_coalescer( coalescer )
+					,	m_group( std::move(group) )
+					,	m_id( id )
+					{}
+				virtual ~member_timer_t() SO_5_NOEXCEPT override
+					{
+						release();
+					}
+
+				virtual bool
+				is_active() const SO_5_NOEXCEPT override
+					{
+						std::lock_guard< std::mutex > lock{ m_coalescer.m_lock };
+						return static_cast< bool >( m_group );
+					}
+
+				virtual void
+				release() SO_5_NOEXCEPT override
+					{
+						m_coalescer.remove( m_group, m_id );
+					}
+
+			private :
+				timer_coalescer_t & m_coalescer;
+
+				//! Group of the timer.
+				/*!
+				 * Is null if the timer is released.
+				 *
+				 * \note Protected by the lock of the coalescer.
+				 */
+				group_ref_t m_group;
+
+				//! ID of the timer inside the group.
+				const std::uint64_t m_id;
+			};
+
+	public :
+		timer_coalescer_t( Timer_Thread & thread )
+			:	m_thread( thread )
+			{}
+		~timer_coalescer_t() SO_5_NOEXCEPT
+			{
+				// Shared timers hold references to groups. These cycles
+				// must be broken. Timers will be destroyed by the timer thread.
+				for( auto & g : m_groups )
+					{
+						timer_holder_t timer;
+						std::swap( timer, g.second->m_timer );
+					}
+			}
+
+		//! Add new periodic message.
+		timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			duration pause,
+			duration period,
+			duration slack )
+			{
+				const auto first_delivery_at =
+						std::chrono::steady_clock::now() + pause;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				group_ref_t group;
+				std::uint64_t first_tick = 0;
+
+				auto range = m_groups.equal_range( period.count() );
+				for( auto it = range.first; it != range.second; ++it )
+					{
+						const auto tick = nearest_tick( *(it->second),
+								first_delivery_at );
+						const auto tick_at = it->second->m_origin +
+								period * static_cast< duration::rep >( tick );
+						if( tick_at - first_delivery_at <= slack )
+							{
+								group = it->second;
+								first_tick = tick;
+								break;
+							}
+					}
+
+				const auto id = ++m_last_id;
+				if( !group )
+					group = make_group( pause, period, first_delivery_at );
+
+				group->m_members.emplace( id,
+						member_t{ first_tick, type_index, mbox, msg } );
+				++m_members_count;
+
+				return timer_id_t{ new member_timer_t{ *this, group, id } };
+			}
+
+		//! Count of groups.
+		std::size_t
+		groups_count()
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				return m_groups.size();
+			}
+
+		//! Count of coalesced periodic messages.
+		std::size_t
+		members_count()
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				return m_members_count;
+			}
+
+	private :
+		//! Timer thread for shared timers.
+		Timer_Thread & m_thread;
+
+		//! Object lock.
+		std::mutex m_lock;
+
+		//! Groups of coalesced timers.
+		/*!
+		 * Count of ticks in the period is used as a key.
+		 */
+		std::multimap< duration::rep, group_ref_t > m_groups;
+
+		//! Counter for IDs of timers.
+		std::uint64_t m_last_id{ 0 };
+
+		//! Count of coalesced periodic messages.
+		std::size_t m_members_count{ 0 };
+
+		//! Get the index of the nearest tick of the group
+		//! which is not earlier than the specified time.
+		static std::uint64_t
+		nearest_tick(
+			const group_t & group,
+			time_point at )
+			{
+				std::uint64_t tick = group.m_ticks_fired;
+				if( at > group.m_origin )
+					{
+						const auto since_origin = (at - group.m_origin).count();
+						const auto period = group.m_period.count();
+						const auto required = static_cast< std::uint64_t >(
+								(since_origin + period - 1) / period );
+						tick = (std::max)( tick, required );
+					}
+
+				return tick;
+			}
+
+		//! Create a new group and activate its shared timer.
+		/*!
+		 * \attention Must be called when m_lock is acquired.
+		 */
+		group_ref_t
+		make_group(
+			duration pause,
+			duration period,
+			time_point origin )
+			{
+				group_ref_t group{ new group_t{ *this, period, origin } };
+				group->m_timer = m_thread.allocate();
+
+				auto it = m_groups.emplace( period.count(), group );
+				try
+					{
+						m_thread.activate( group->m_timer,
+								pause,
+								period,
+								timer_action_for_timer_thread_t(
+										coalesced_tick_ref_t{ group.get() } ) );
+					}
+				catch( ... )
+					{
+						m_groups.erase( it );
+						throw;
+					}
+
+				return group;
+			}
+
+		//! Remove periodic message from the group.
+		/*!
+		 * The group is destroyed if it becomes empty.
+		 *
+		 * \note Group pointer is reset.
+		 */
+		void
+		remove(
+			group_ref_t & group_ref,
+			std::uint64_t id ) SO_5_NOEXCEPT
+			{
+				timer_holder_t timer_to_deactivate;
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					if( !group_ref )
+						return;
+
+					group_ref_t group;
+					group.swap( group_ref );
+
+					group->m_members.erase( id );
+					--m_members_count;
+
+					if( group->m_members.empty() )
+						{
+							auto range = m_groups.equal_range(
+									group->m_period.count() );
+							for( auto it = range.first; it != range.second; ++it )
+								if( it->second.get() == group.get() )
+									{
+										m_groups.erase( it );
+										break;
+									}
+
+							// Shared timer holds a reference to the group.
+							// This cycle will be broken after deactivation of the timer.
+							std::swap( timer_to_deactivate, group->m_timer );
+						}
+				}
+
+				// The deactivation is performed without holding the lock.
+				if( timer_to_deactivate )
+					m_thread.deactivate( timer_to_deactivate );
+			}
+
+		//! Deliver messages for the current tick of the group.
+		void
+		fire( group_t & group ) SO_5_NOEXCEPT
+			{
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+
+					const auto tick = group.m_ticks_fired++;
+					for( const auto & m : group.m_members )
+						if( m.second.m_first_tick <= tick )
+							group.m_to_deliver.push_back( m.second );
+				}
+
+				// Messages are delivered without holding the lock.
+				for( const auto & m : group.m_to_deliver )
+					::so_5::rt::impl::mbox_iface_for_timers_t{ m.m_mbox }
+							.deliver_message_from_timer( m.m_type_index, m.m_msg );
+
+				group.m_to_deliver.clear();
 			}
 	};
 
@@ -150,6 +552,7 @@ class actual_thread_t : public timer_thread_t
 			//! Real timer thread.
 			std::unique_ptr< Timer_Thread > thread )
 			:	m_thread( std::move( thread ) )
+			,	m_coalescer( *m_thread )
 			{}
 
 		virtual void
@@ -201,14 +604,41 @@ class actual_thread_t : public timer_thread_t
 			{
 				auto d = m_thread->get_timer_quantities();
 
+				// Shared timers of coalesced groups are replaced by
+				// the actual count of coalesced periodic messages.
+				const auto groups = m_coalescer.groups_count();
+				const auto members = m_coalescer.members_count();
+
 				return timer_thread_stats_t{
 						d.m_single_shot_count,
-						d.m_periodic_count
+						d.m_periodic_count - (std::min)( groups, d.m_periodic_count )
+								+ members
 					};
 			}
 
+		virtual timer_id_t
+		schedule_coalesced(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period,
+			timer_slack_t slack ) override
+			{
+				return m_coalescer.schedule(
+						type_index, mbox, msg, pause, period, slack.value() );
+			}
+
 	private :
 		std::unique_ptr< Timer_Thread > m_thread;
+
+		/*!
+		 * \brief Groups of coalesced periodic timers.
+		 *
+		 * \since
+		 * v.5.5.25
+		 */
+		timer_coalescer_t< Timer_Thread > m_coalescer;
 	};
 
 //
@@ -458,6 +888,13 @@ using timer_list_thread_t = timertt::timer_list_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel thread type.
+using timer_hierarchical_wheel_thread_t =
+		timertt::timer_hierarchical_wheel_thread_template<
+				timer_action_for_timer_thread_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
 //! timer_wheel manager type.
 using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
 		timertt::thread_safety::unsafe,
@@ -478,12 +915,36 @@ using timer_list_manager_t = timertt::timer_list_manager_template<
 		timer_action_for_timer_manager_t,
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel manager type.
+using timer_hierarchical_wheel_manager_t =
+		timertt::timer_hierarchical_wheel_manager_template<
+				timertt::thread_safety::unsafe,
+				timer_action_for_timer_manager_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
 /*!
  * \}
  */
 
 } /* namespace timers_details */
 
+//
+// timer_thread_t
+//
+timer_id_t
+timer_thread_t::schedule_coalesced(
+	const std::type_index & type_index,
+	const mbox_t & mbox,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period,
+	timer_slack_t /*slack*/ )
+	{
+		// There is no coalescing by default.
+		return schedule( type_index, mbox, msg, pause, period );
+	}
+
 SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_wheel_thread(
 	error_logger_shptr_t logger )
@@ -561,6 +1022,37 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+
+		return create_timer_hierarchical_wheel_thread(
+				std::move(logger),
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_wheel_manager(
 	error_logger_shptr_t logger,
@@ -650,5 +1142,41 @@ create_timer_list_manager(
 				collector );
 	}
 
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+
+		return create_timer_hierarchical_wheel_manager(
+				std::move(logger),
+				collector,
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+		using namespace timers_details;
+
+		auto manager = stdcpp::make_unique< timertt_manager_t >(
+				granularity,
+				create_error_logger_for_timertt( logger ),
+				create_exception_handler_for_timertt_manager( logger ) );
+
+		return stdcpp::make_unique< actual_manager_t< timertt_manager_t > >(
+				std::move( manager ),
+				collector );
+	}
+
 } /* namespace so_5 */
 
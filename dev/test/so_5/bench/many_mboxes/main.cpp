@@ -64,7 +64,7 @@ try_parse_cmdline(
 							"\noptions:\n"
 							"-m, --mboxes           count of mboxes\n"
 							"-a, --agents           count of agents\n"
-							"-t, --types            count of message types\n"
+							"-t, --types            count of message types (max 128)\n"
 							"-i, --iterations       count of iterations for every "
 									"message type\n"
 							"-s, --storage-type     type of subscription storage\n"
@@ -120,48 +120,56 @@ try_parse_cmdline(
 	return tmp_cfg;
 }
 
-#define DECLARE_SIGNAL_TYPE(I) \
-	struct msg_signal_##I : public so_5::signal_t {}
-
-DECLARE_SIGNAL_TYPE(0);
-DECLARE_SIGNAL_TYPE(1);
-DECLARE_SIGNAL_TYPE(2);
-DECLARE_SIGNAL_TYPE(3);
-DECLARE_SIGNAL_TYPE(4);
-DECLARE_SIGNAL_TYPE(5);
-DECLARE_SIGNAL_TYPE(6);
-DECLARE_SIGNAL_TYPE(7);
-DECLARE_SIGNAL_TYPE(8);
-DECLARE_SIGNAL_TYPE(9);
-DECLARE_SIGNAL_TYPE(10);
-DECLARE_SIGNAL_TYPE(11);
-DECLARE_SIGNAL_TYPE(12);
-DECLARE_SIGNAL_TYPE(13);
-DECLARE_SIGNAL_TYPE(14);
-DECLARE_SIGNAL_TYPE(15);
-DECLARE_SIGNAL_TYPE(16);
-DECLARE_SIGNAL_TYPE(17);
-DECLARE_SIGNAL_TYPE(18);
-DECLARE_SIGNAL_TYPE(19);
-DECLARE_SIGNAL_TYPE(20);
-DECLARE_SIGNAL_TYPE(21);
-DECLARE_SIGNAL_TYPE(22);
-DECLARE_SIGNAL_TYPE(23);
-DECLARE_SIGNAL_TYPE(24);
-DECLARE_SIGNAL_TYPE(25);
-DECLARE_SIGNAL_TYPE(26);
-DECLARE_SIGNAL_TYPE(27);
-DECLARE_SIGNAL_TYPE(28);
-DECLARE_SIGNAL_TYPE(29);
-DECLARE_SIGNAL_TYPE(30);
-DECLARE_SIGNAL_TYPE(31);
-
-#undef DECLARE_SIGNAL_TYPE
+template< std::size_t I >
+struct msg_signal : public so_5::signal_t {};
+
+//! Max count of message types.
+const std::size_t max_msg_types = 128;
 
 struct msg_start : public so_5::signal_t {};
 struct msg_shutdown : public so_5::signal_t {};
 struct msg_next_iteration : public so_5::signal_t {};
 
+/*
+ * Statistics for duration of send operations.
+ *
+ * NOTE: all agents work on the same thread, so there is no need
+ * in synchronization.
+ */
+struct delivery_stats_t
+	{
+		unsigned long long m_sends = 0;
+		std::chrono::steady_clock::duration m_total =
+				std::chrono::steady_clock::duration::zero();
+		std::chrono::steady_clock::duration m_max =
+				std::chrono::steady_clock::duration::zero();
+
+		void
+		add( std::size_t sends, std::chrono::steady_clock::duration d )
+			{
+				m_sends += sends;
+				m_total += d;
+				if( sends && m_max < d / sends )
+					m_max = d / sends;
+			}
+
+		void
+		show() const
+			{
+				using namespace std::chrono;
+
+				if( !m_sends )
+					return;
+
+				std::cout << "delivery latency: avg="
+						<< duration_cast< nanoseconds >( m_total ).count() /
+								m_sends
+						<< "ns, max avg per iteration="
+						<< duration_cast< nanoseconds >( m_max ).count()
+						<< "ns" << std::endl;
+			}
+	};
+
 class a_worker_t
 	:	public so_5::agent_t
 	{
@@ -195,11 +203,13 @@ class a_sender_t
 			const so_5::mbox_t & common_mbox,
 			std::size_t iterations,
 			const std::vector< so_5::mbox_t > & mboxes,
-			const std::vector< a_worker_t * > & workers )
+			const std::vector< a_worker_t * > & workers,
+			delivery_stats_t & stats )
 			:	so_5::agent_t( env + subscr_storage_factory )
 			,	m_common_mbox( common_mbox )
 			,	m_iterations_left( iterations )
 			,	m_mboxes( mboxes )
+			,	m_stats( stats )
 			{
 				for( auto a : workers )
 					for( auto & m : m_mboxes )
@@ -233,15 +243,21 @@ class a_sender_t
 		const so_5::mbox_t m_common_mbox;
 		std::size_t m_iterations_left;
 		const std::vector< so_5::mbox_t > & m_mboxes;
+		delivery_stats_t & m_stats;
 
 		void
 		try_start_next_iteration()
 			{
 				if( m_iterations_left )
 					{
+						const auto started_at = std::chrono::steady_clock::now();
+
 						for( auto & m : m_mboxes )
 							so_5::send< SIGNAL >( m );
 
+						m_stats.add( m_mboxes.size(),
+								std::chrono::steady_clock::now() - started_at );
+
 						initiate_next_iteration();
 
 						--m_iterations_left;
@@ -278,8 +294,6 @@ class a_starter_stopper_t
 				create_sender_factories();
 			}
 
-		static const std::size_t max_msg_types = 32;
-
 		virtual void
 		so_define_agent()
 			{
@@ -322,6 +336,7 @@ class a_starter_stopper_t
 								m_cfg.m_iterations;
 
 						m_benchmark.finish_and_show_stats( messages, "messages" );
+						m_stats.show();
 
 						so_environment().stop();
 					}
@@ -338,6 +353,8 @@ class a_starter_stopper_t
 
 		benchmarker_t m_benchmark;
 
+		delivery_stats_t m_stats;
+
 		std::vector< so_5::mbox_t > m_mboxes;
 		std::vector< a_worker_t * > m_workers;
 
@@ -346,57 +363,43 @@ class a_starter_stopper_t
 
 		std::vector< sender_factory_t > m_sender_factories;
 
+		// Adds factories for senders of msg_signal<I>..msg_signal<Last-1>.
+		template< std::size_t I, std::size_t Last >
+		struct sender_factories_filler
+			{
+				static void
+				fill( a_starter_stopper_t & self )
+					{
+						self.m_sender_factories.emplace_back(
+							[&self]() -> so_5::agent_t *
+							{
+								return new a_sender_t< msg_signal< I > >(
+										self.so_environment(),
+										self.m_subscr_storage_factory,
+										self.m_common_mbox,
+										self.m_cfg.m_iterations,
+										self.m_mboxes,
+										self.m_workers,
+										self.m_stats );
+							} );
+
+						sender_factories_filler< I + 1, Last >::fill( self );
+					}
+			};
+
+		template< std::size_t Last >
+		struct sender_factories_filler< Last, Last >
+			{
+				static void
+				fill( a_starter_stopper_t & ) {}
+			};
+
 		void
 		create_sender_factories()
 			{
-				m_sender_factories.reserve( m_cfg.m_msg_types );
-
-#define MAKE_SENDER_FACTORY(I)\
-				m_sender_factories.emplace_back( \
-						[this]() \
-						{ \
-							return new a_sender_t< msg_signal_##I >( so_environment(),  \
-									m_subscr_storage_factory, \
-									m_common_mbox, \
-									m_cfg.m_iterations, \
-									m_mboxes, \
-									m_workers ); \
-						} )
-
-				MAKE_SENDER_FACTORY(0);
-				MAKE_SENDER_FACTORY(1);
-				MAKE_SENDER_FACTORY(2);
-				MAKE_SENDER_FACTORY(3);
-				MAKE_SENDER_FACTORY(4);
-				MAKE_SENDER_FACTORY(5);
-				MAKE_SENDER_FACTORY(6);
-				MAKE_SENDER_FACTORY(7);
-				MAKE_SENDER_FACTORY(8);
-				MAKE_SENDER_FACTORY(9);
-				MAKE_SENDER_FACTORY(10);
-				MAKE_SENDER_FACTORY(11);
-				MAKE_SENDER_FACTORY(12);
-				MAKE_SENDER_FACTORY(13);
-				MAKE_SENDER_FACTORY(14);
-				MAKE_SENDER_FACTORY(15);
-				MAKE_SENDER_FACTORY(16);
-				MAKE_SENDER_FACTORY(17);
-				MAKE_SENDER_FACTORY(18);
-				MAKE_SENDER_FACTORY(19);
-				MAKE_SENDER_FACTORY(20);
-				MAKE_SENDER_FACTORY(21);
-				MAKE_SENDER_FACTORY(22);
-				MAKE_SENDER_FACTORY(23);
-				MAKE_SENDER_FACTORY(24);
-				MAKE_SENDER_FACTORY(25);
-				MAKE_SENDER_FACTORY(26);
-				MAKE_SENDER_FACTORY(27);
-				MAKE_SENDER_FACTORY(28);
-				MAKE_SENDER_FACTORY(29);
-				MAKE_SENDER_FACTORY(30);
-				MAKE_SENDER_FACTORY(31);
-
-#undef MAKE_SENDER_FACTORY
+				m_sender_factories.reserve( max_msg_types );
+
+				sender_factories_filler< 0, max_msg_types >::fill( *this );
 			}
 
 		void
@@ -463,13 +466,13 @@ main( int argc, char ** argv )
 	try
 	{
 		cfg_t cfg = try_parse_cmdline( argc, argv );
-		if( cfg.m_msg_types > a_starter_stopper_t::max_msg_types )
+		if( cfg.m_msg_types > max_msg_types )
 			{
 				std::ostringstream ss;
 				ss << "too many msg_types specified: "
 					<< cfg.m_msg_types
 					<< ", max avaliable msg_types: "
-					<< a_starter_stopper_t::max_msg_types;
+					<< max_msg_types;
 
 				throw std::logic_error( ss.str() );
 			}
@@ -92,8 +92,10 @@ init(
 void
 print_usage()
 {
-	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count>\n\n"
-			"<agent_count> and <send_count> must not be 0"
+	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count> "
+			"[lock-free]\n\n"
+			"<agent_count> and <send_count> must not be 0\n"
+			"lock-free turns lock-free mode for event queues on"
 			<< std::endl;
 }
 
@@ -112,7 +114,8 @@ main( int argc, char ** argv )
 		auto ensure_args_validity = []( bool p, const char * msg ) {
 			if( !p ) throw cmd_line_exception( msg );
 		};
-		ensure_args_validity( 3 == argc, "wrong number of arguments" );
+		ensure_args_validity( 3 == argc || 4 == argc,
+				"wrong number of arguments" );
 
 		const unsigned int agent_count = static_cast< unsigned int >(std::atoi( argv[1] ));
 		ensure_args_validity( agent_count != 0, "agent_count must not be 0" );
@@ -120,6 +123,10 @@ main( int argc, char ** argv )
 		const unsigned int send_count = static_cast< unsigned int >(std::atoi( argv[2] ));
 		ensure_args_validity( send_count != 0, "send_count must not be 0" );
 
+		const bool lock_free = 4 == argc;
+		ensure_args_validity( !lock_free || std::string( "lock-free" ) == argv[3],
+				"unknown argument, lock-free expected" );
+
 		benchmarker_t benchmark;
 		benchmark.start();
 
@@ -128,10 +135,20 @@ main( int argc, char ** argv )
 			{
 				init( env, agent_count, send_count );
 			},
-			[]( so_5::environment_params_t & params )
+			[lock_free]( so_5::environment_params_t & params )
 			{
+				params.default_disp_params(
+					so_5::disp::one_thread::disp_params_t{}.tune_queue_params(
+						[lock_free]( so_5::disp::one_thread::queue_traits::queue_params_t & p ) {
+							p.lock_free( lock_free );
+						} ) );
+
 				params.add_named_dispatcher( "active_obj",
-					so_5::disp::active_obj::create_disp() );
+					so_5::disp::active_obj::create_disp(
+						so_5::disp::active_obj::disp_params_t{}.tune_queue_params(
+							[lock_free]( so_5::disp::active_obj::queue_traits::queue_params_t & p ) {
+								p.lock_free( lock_free );
+							} ) ) );
 			} );
 
 		benchmark.finish_and_show_stats(
@@ -25,6 +25,7 @@ struct	cfg_t
 
 	bool	m_active_objects = false;
 	bool	m_simple_lock = false;
+	bool	m_lock_free = false;
 
 	bool	m_direct_mboxes = false;
 
@@ -56,6 +57,7 @@ try_parse_cmdline(
 							"-d, --direct-mboxes  use direct(mpsc) mboxes for agents\n"
 							"-l, --message-limits use message limits for agents\n"
 							"-s, --simple-lock    use simple lock factory for event queue\n"
+							"-F, --lock-free      use lock-free mode for event queue\n"
 							"-T, --track-activity turn work thread activity tracking on\n"
 							"-e, --env            environment infrastructure to be used:\n"
 							"                       default_mt (default),\n"
@@ -73,6 +75,8 @@ try_parse_cmdline(
 				tmp_cfg.m_message_limits = true;
 			else if( is_arg( *current, "-s", "--simple-lock" ) )
 				tmp_cfg.m_simple_lock = true;
+			else if( is_arg( *current, "-F", "--lock-free" ) )
+				tmp_cfg.m_lock_free = true;
 			else if( is_arg( *current, "-r", "--requests" ) )
 				mandatory_arg_to_value(
 						tmp_cfg.m_request_count, ++current, last,
@@ -255,6 +259,7 @@ show_cfg(
 			<< ", direct mboxes: " << ( cfg.m_direct_mboxes ? "yes" : "no" )
 			<< ", limits: " << ( cfg.m_message_limits ? "yes" : "no" )
 			<< ", locks: " << ( cfg.m_simple_lock ? "simple" : "combined" )
+			<< ", lock-free: " << ( cfg.m_lock_free ? "yes" : "no" )
 			<< ", requests: " << cfg.m_request_count
 			<< ", activity tracking: " << ( cfg.m_track_activity ? "on" : "off" )
 			<< ", env: " << ( env_type_t::default_mt == cfg.m_env ?
@@ -373,9 +378,17 @@ main( int argc, char ** argv )
 					params.queue_locks_defaults_manager(
 							so_5::make_defaults_manager_for_simple_locks() );
 
+				if( cfg.m_lock_free )
+					params.default_disp_params(
+							so_5::disp::one_thread::disp_params_t{}.tune_queue_params(
+									[]( so_5::disp::one_thread::queue_traits::queue_params_t & p ) {
+										p.lock_free( true );
+									} ) );
+
 				if( cfg.m_active_objects )
 				{
 					so_5::disp::active_obj::queue_traits::queue_params_t queue_params;
+					queue_params.lock_free( cfg.m_lock_free );
 
 					params.add_named_dispatcher(
 							"active_obj",
@@ -18,19 +18,39 @@ struct one {};
 struct two {};
 struct three {};
 
+using so_5::mchain_props::synchronization_t;
+
 so_5::mchain_t
-make_mchain( so_5::environment_t & env )
+make_mchain(
+	so_5::environment_t & env,
+	synchronization_t synchronization )
+{
+	return env.create_mchain(
+			so_5::make_limited_without_waiting_mchain_params( 2,
+					so_5::mchain_props::memory_usage_t::preallocated,
+					so_5::mchain_props::overflow_reaction_t::throw_exception )
+			.synchronization( synchronization ) );
+}
+
+const char *
+synchronization_name( synchronization_t synchronization )
 {
-	return so_5::create_mchain( env, 2,
-			so_5::mchain_props::memory_usage_t::preallocated,
-			so_5::mchain_props::overflow_reaction_t::throw_exception );
+	switch( synchronization )
+	{
+	case synchronization_t::mutex_based : return "mutex_based";
+	case synchronization_t::lock_free_mpmc : return "lock_free_mpmc";
+	case synchronization_t::lock_free_spsc : return "lock_free_spsc";
+	}
 
+	return "unknown";
 }
 
 void
-raw_receive_case( so_5::environment_t & env )
+raw_receive_case(
+	so_5::environment_t & env,
+	synchronization_t synchronization )
 {
-	auto ch1 = make_mchain( env );
+	auto ch1 = make_mchain( env, synchronization );
 
 	unsigned long long iterations = 0u;
 
@@ -48,13 +68,17 @@ raw_receive_case( so_5::environment_t & env )
 		++iterations;
 	}
 
-	bench.finish_and_show_stats( iterations, "raw_receive_case" );
+	bench.finish_and_show_stats( iterations,
+			std::string( "raw_receive_case, " ) +
+			synchronization_name( synchronization ) );
 }
 
 void
-prepared_receive_case( so_5::environment_t & env )
+prepared_receive_case(
+	so_5::environment_t & env,
+	synchronization_t synchronization )
 {
-	auto ch1 = make_mchain( env );
+	auto ch1 = make_mchain( env, synchronization );
 
 	unsigned long long iterations = 0u;
 
@@ -75,7 +99,9 @@ prepared_receive_case( so_5::environment_t & env )
 		++iterations;
 	}
 
-	bench.finish_and_show_stats( iterations, "prepared_receive_case" );
+	bench.finish_and_show_stats( iterations,
+			std::string( "prepared_receive_case, " ) +
+			synchronization_name( synchronization ) );
 }
 
 int
@@ -86,8 +112,12 @@ main()
 		so_5::launch(
 			[]( so_5::environment_t & env )
 			{
-				raw_receive_case( env );
-				prepared_receive_case( env );
+				for( auto s : { synchronization_t::mutex_based,
+						synchronization_t::lock_free_spsc } )
+				{
+					raw_receive_case( env, s );
+					prepared_receive_case( env, s );
+				}
 			} );
 	}
 	catch( const std::exception & ex )
@@ -21,6 +21,9 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/parent_child_2/prj.ut.rb" )
 	required_prj( "#{path}/parent_child_3/prj.ut.rb" )
 	required_prj( "#{path}/parent_child_4/prj.ut.rb" )
+	required_prj( "#{path}/parallel_reg_dereg/prj.ut.rb" )
+	required_prj( "#{path}/coop_id/prj.ut.rb" )
+	required_prj( "#{path}/register_coops/prj.ut.rb" )
 	required_prj( "#{path}/user_resource/prj.ut.rb" )
 	required_prj( "#{path}/introduce_coop/prj.ut.rb" )
 	required_prj( "#{path}/create_child_coop_5_5_8/prj.ut.rb" )
@@ -0,0 +1,398 @@
+/*
+ * A test for registration and deregistration of cooperations by ids.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <set>
+#include <tuple>
+
+using namespace std;
+
+class a_dummy_t final : public so_5::agent_t
+{
+public :
+	a_dummy_t( context_t ctx ) : so_5::agent_t( std::move(ctx) ) {}
+};
+
+class listener_t final : public so_5::coop_listener_t
+{
+public :
+	listener_t(
+		set< string > & registered,
+		atomic< int > & deregistered )
+		:	m_registered( registered )
+		,	m_deregistered( deregistered )
+	{}
+
+	virtual void
+	on_registered(
+		so_5::environment_t &,
+		const string & coop_name ) override
+	{
+		m_registered.insert( coop_name );
+	}
+
+	virtual void
+	on_deregistered(
+		so_5::environment_t &,
+		const string &,
+		const so_5::coop_dereg_reason_t & ) override
+	{
+		++m_deregistered;
+	}
+
+private :
+	set< string > & m_registered;
+	atomic< int > & m_deregistered;
+};
+
+string
+anonymous_name( so_5::coop_id_t id )
+{
+	return "__so5_autoname_" + to_string( id ) + "__";
+}
+
+so_5::coop_id_t
+register_coop(
+	so_5::environment_t & env,
+	so_5::coop_unique_ptr_t coop )
+{
+	coop->make_agent< a_dummy_t >();
+	return env.register_coop( std::move( coop ) );
+}
+
+void
+wait_deregistered( const atomic< int > & deregistered, int expected )
+{
+	while( expected != deregistered )
+		this_thread::yield();
+}
+
+void
+ensure_not_found( std::function< void() > action )
+{
+	try
+	{
+		action();
+		ensure_or_die( false, "an exception must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure_or_die(
+				so_5::rc_coop_has_not_found_among_registered_coop == x.error_code(),
+				"rc_coop_has_not_found_among_registered_coop expected!" );
+	}
+}
+
+template< typename Lambda >
+void
+run_with_env( const string & name, Lambda && lambda )
+{
+	run_with_time_limit(
+		[&lambda]()
+		{
+			set< string > registered;
+			atomic< int > deregistered{ 0 };
+
+			so_5::wrapped_env_t env{
+				[]( so_5::environment_t & ) {},
+				[&]( so_5::environment_params_t & params ) {
+					params.coop_listener(
+							so_5::coop_listener_unique_ptr_t{
+									new listener_t{ registered, deregistered } } );
+				} };
+
+			lambda( env.environment(), registered, deregistered );
+		},
+		20,
+		name );
+}
+
+UT_UNIT_TEST( test_anonymous_coop )
+{
+	run_with_env( "test_anonymous_coop",
+		[]( so_5::environment_t & env,
+			const set< string > & registered,
+			const atomic< int > & deregistered )
+		{
+			auto coop = env.create_coop( so_5::autoname );
+			UT_CHECK_CONDITION( coop->is_anonymous() );
+			const auto expected_id = coop->query_coop_id();
+			UT_CHECK_CONDITION( so_5::null_coop_id() != expected_id );
+
+			const auto id = register_coop( env, std::move( coop ) );
+			UT_CHECK_CONDITION( expected_id == id );
+			UT_CHECK_CONDITION( 1u == registered.count( anonymous_name( id ) ) );
+
+			env.deregister_coop( id, so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 1 );
+
+			ensure_not_found( [&] {
+					env.deregister_coop( id, so_5::dereg_reason::normal );
+				} );
+
+			// The name of an anonymous coop still can be used.
+			const auto id2 = register_coop( env, env.create_coop( so_5::autoname ) );
+			UT_CHECK_CONDITION( id != id2 );
+
+			env.deregister_coop( anonymous_name( id2 ), so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 2 );
+		} );
+}
+
+UT_UNIT_TEST( test_named_coop )
+{
+	run_with_env( "test_named_coop",
+		[]( so_5::environment_t & env,
+			const set< string > & registered,
+			const atomic< int > & deregistered )
+		{
+			auto coop = env.create_coop( "named" );
+			UT_CHECK_CONDITION( !coop->is_anonymous() );
+
+			const auto id = register_coop( env, std::move( coop ) );
+			UT_CHECK_CONDITION( 1u == registered.count( "named" ) );
+
+			// Named coop can't be found by the name of an anonymous coop.
+			ensure_not_found( [&] {
+					env.deregister_coop( anonymous_name( id ),
+							so_5::dereg_reason::normal );
+				} );
+
+			env.deregister_coop( id, so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 1 );
+
+			// The name can be reused after the deregistration.
+			register_coop( env, env.create_coop( "named" ) );
+			env.deregister_coop( "named", so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 2 );
+		} );
+}
+
+void
+ensure_already_registered( std::function< void() > action )
+{
+	try
+	{
+		action();
+		ensure_or_die( false, "an exception must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure_or_die(
+				so_5::rc_coop_with_specified_name_is_already_registered ==
+						x.error_code(),
+				"rc_coop_with_specified_name_is_already_registered expected!" );
+	}
+}
+
+UT_UNIT_TEST( test_name_of_anonymous_coop )
+{
+	run_with_env( "test_name_of_anonymous_coop",
+		[]( so_5::environment_t & env,
+			const set< string > & registered,
+			const atomic< int > & deregistered )
+		{
+			const auto id = register_coop( env,
+					env.create_coop( so_5::autoname ) );
+
+			// A named coop can't take the name of a live anonymous coop.
+			ensure_already_registered( [&] {
+					register_coop( env, env.create_coop( anonymous_name( id ) ) );
+				} );
+
+			// The same for the bulk registration.
+			ensure_already_registered( [&] {
+					vector< so_5::coop_unique_ptr_t > coops;
+					coops.push_back( env.create_coop( anonymous_name( id ) ) );
+					coops.back()->make_agent< a_dummy_t >();
+					env.register_coops( std::move( coops ) );
+				} );
+
+			// The same for an anonymous coop from the same batch.
+			ensure_already_registered( [&] {
+					vector< so_5::coop_unique_ptr_t > coops;
+					coops.push_back( env.create_coop( so_5::autoname ) );
+					coops.back()->make_agent< a_dummy_t >();
+					const auto batch_id = coops.back()->query_coop_id();
+					coops.push_back( env.create_coop( anonymous_name( batch_id ) ) );
+					coops.back()->make_agent< a_dummy_t >();
+					env.register_coops( std::move( coops ) );
+				} );
+
+			UT_CHECK_CONDITION( 1u == registered.size() );
+
+			// The name of an anonymous coop which doesn't exist
+			// can be used as in the previous versions.
+			const auto unused_name = anonymous_name( id + 1000u );
+			register_coop( env, env.create_coop( unused_name ) );
+			UT_CHECK_CONDITION( 1u == registered.count( unused_name ) );
+
+			env.deregister_coop( unused_name, so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 1 );
+
+			// The anonymous coop is still found by its name.
+			env.deregister_coop( anonymous_name( id ), so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 2 );
+		} );
+}
+
+UT_UNIT_TEST( test_children )
+{
+	run_with_env( "test_children",
+		[]( so_5::environment_t & env,
+			const set< string > &,
+			const atomic< int > & deregistered )
+		{
+			const auto parent_id = register_coop( env,
+					env.create_coop( so_5::autoname ) );
+
+			auto child = env.create_coop( so_5::autoname );
+			child->set_parent_coop_id( parent_id );
+			UT_CHECK_CONDITION( child->has_parent_coop() );
+			UT_CHECK_CONDITION( parent_id == child->parent_coop_id() );
+			const auto child_id = register_coop( env, std::move( child ) );
+
+			// Anonymous parent can be specified by its name.
+			auto grandchild = env.create_coop( "grandchild" );
+			grandchild->set_parent_coop_name( anonymous_name( child_id ) );
+			register_coop( env, std::move( grandchild ) );
+
+			// Parent with unknown id.
+			try
+			{
+				auto orphan = env.create_coop( so_5::autoname );
+				orphan->set_parent_coop_id( child_id + 1000u );
+				register_coop( env, std::move( orphan ) );
+				ensure_or_die( false, "an exception must be thrown!" );
+			}
+			catch( const so_5::exception_t & x )
+			{
+				UT_CHECK_CONDITION(
+						so_5::rc_parent_coop_not_found == x.error_code() );
+			}
+
+			env.deregister_coop( parent_id, so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 3 );
+
+			ensure_not_found( [&] {
+					env.deregister_coop( "grandchild", so_5::dereg_reason::normal );
+				} );
+		} );
+}
+
+class a_owner_t final : public so_5::agent_t
+{
+public :
+	a_owner_t( context_t ctx, atomic< int > & started )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_started( started )
+	{}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto child = so_5::create_child_coop( *this, so_5::autoname );
+		ensure_or_die( so_coop_id() == child->parent_coop_id(),
+				"the id of the parent coop expected!" );
+		ensure_or_die( so_coop_name() == child->parent_coop_name(),
+				"the name of the parent coop expected!" );
+		register_coop( so_environment(), std::move( child ) );
+
+		const auto & expected = so_coop_name();
+		so_5::introduce_child_coop( *this,
+			[&expected]( so_5::coop_t & coop ) {
+				ensure_or_die( expected == coop.parent_coop_name(),
+						"the name of the parent coop expected!" );
+				coop.make_agent< a_dummy_t >();
+			} );
+
+		++m_started;
+	}
+
+private :
+	atomic< int > & m_started;
+};
+
+UT_UNIT_TEST( test_parent_coop_name )
+{
+	run_with_env( "test_parent_coop_name",
+		[]( so_5::environment_t & env,
+			const set< string > &,
+			const atomic< int > & deregistered )
+		{
+			atomic< int > started{ 0 };
+
+			auto check_children = [&env, &started]( so_5::coop_t & parent ) {
+				parent.make_agent< a_owner_t >( std::ref( started ) );
+				const auto & expected = parent.query_coop_name();
+
+				auto c2 = so_5::create_child_coop( parent, so_5::autoname );
+				UT_CHECK_CONDITION( parent.query_coop_id() == c2->parent_coop_id() );
+				UT_CHECK_CONDITION( expected == c2->parent_coop_name() );
+
+				// Parent specified by id only.
+				auto c3 = env.create_coop( so_5::autoname );
+				c3->set_parent_coop_id( parent.query_coop_id() );
+				UT_CHECK_CONDITION( c3->parent_coop_name().empty() );
+
+				return std::make_tuple( std::move( c2 ), std::move( c3 ) );
+			};
+
+			auto named = env.create_coop( "named_parent" );
+			auto named_children = check_children( *named );
+			auto anonymous = env.create_coop( so_5::autoname );
+			const auto anonymous_id = anonymous->query_coop_id();
+			auto anonymous_children = check_children( *anonymous );
+
+			env.register_coop( std::move( named ) );
+			env.register_coop( std::move( anonymous ) );
+
+			register_coop( env, std::move( std::get< 0 >( named_children ) ) );
+			register_coop( env, std::move( std::get< 1 >( named_children ) ) );
+			register_coop( env, std::move( std::get< 0 >( anonymous_children ) ) );
+			register_coop( env, std::move( std::get< 1 >( anonymous_children ) ) );
+
+			// introduce_child_coop() specifies the name of the parent too.
+			atomic< bool > introduced{ false };
+			auto parent = env.create_coop( "introduced_parent" );
+			so_5::coop_t & parent_ref = *parent;
+			parent->define_agent().on_start( [&parent_ref, &introduced] {
+					so_5::introduce_child_coop( parent_ref,
+						[]( so_5::coop_t & child ) {
+							ensure_or_die(
+									"introduced_parent" == child.parent_coop_name(),
+									"the name of the parent coop expected!" );
+							child.make_agent< a_dummy_t >();
+						} );
+					introduced = true;
+				} );
+			env.register_coop( std::move( parent ) );
+
+			while( !introduced || 2 != started )
+				this_thread::yield();
+
+			env.deregister_coop( "named_parent", so_5::dereg_reason::normal );
+			env.deregister_coop( anonymous_id, so_5::dereg_reason::normal );
+			env.deregister_coop( "introduced_parent", so_5::dereg_reason::normal );
+			wait_deregistered( deregistered, 12 );
+		} );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_anonymous_coop )
+	UT_RUN_UNIT_TEST( test_named_coop )
+	UT_RUN_UNIT_TEST( test_name_of_anonymous_coop )
+	UT_RUN_UNIT_TEST( test_children )
+	UT_RUN_UNIT_TEST( test_parent_coop_name )
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * A test for parallel registration and deregistration of
+ * cooperations trees from several threads.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+
+class a_dummy_t final : public so_5::agent_t
+{
+public :
+	a_dummy_t( context_t ctx ) : so_5::agent_t( std::move(ctx) ) {}
+};
+
+class listener_t final : public so_5::coop_listener_t
+{
+public :
+	listener_t(
+		atomic< int > & registered,
+		atomic< int > & deregistered )
+		:	m_registered( registered )
+		,	m_deregistered( deregistered )
+	{}
+
+	virtual void
+	on_registered(
+		so_5::environment_t &,
+		const string & ) override
+	{
+		++m_registered;
+	}
+
+	virtual void
+	on_deregistered(
+		so_5::environment_t &,
+		const string &,
+		const so_5::coop_dereg_reason_t & ) override
+	{
+		++m_deregistered;
+	}
+
+private :
+	atomic< int > & m_registered;
+	atomic< int > & m_deregistered;
+};
+
+const int THREADS = 4;
+const int ITERATIONS = 300;
+// Root, three children and one grandchild.
+const int COOPS_IN_TREE = 5;
+
+void
+register_coop(
+	so_5::environment_t & env,
+	const string & name,
+	const string & parent )
+{
+	auto coop = env.create_coop( name );
+	if( !parent.empty() )
+		coop->set_parent_coop_name( parent );
+	coop->make_agent< a_dummy_t >();
+
+	env.register_coop( std::move( coop ) );
+}
+
+void
+do_trees( so_5::environment_t & env, int thread )
+{
+	for( int i = 0; i != ITERATIONS; ++i )
+	{
+		const auto root = "t" + to_string( thread ) + "_" + to_string( i );
+
+		register_coop( env, root, string() );
+		for( int c = 0; c != 3; ++c )
+			register_coop( env, root + "_" + to_string( c ), root );
+		register_coop( env, root + "_0_0", root + "_0" );
+
+		// A child can be deregistered in parallel with its parent.
+		if( 0 == i % 2 )
+			env.deregister_coop( root + "_1", so_5::dereg_reason::normal );
+
+		env.deregister_coop( root, so_5::dereg_reason::normal );
+
+		// Parent is being deregistered or is already deregistered.
+		// A new child can't be registered.
+		try
+		{
+			register_coop( env, root + "_late", root );
+			ensure_or_die( false, "an exception must be thrown!" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			ensure_or_die( so_5::rc_parent_coop_not_found == x.error_code(),
+					"rc_parent_coop_not_found expected!" );
+		}
+	}
+}
+
+void
+do_check( so_5::environment_t & env, const atomic< int > & deregistered )
+{
+	vector< thread > threads;
+	for( int t = 0; t != THREADS; ++t )
+		threads.emplace_back( [&env, t] { do_trees( env, t ); } );
+
+	for( auto & t : threads )
+		t.join();
+
+	const int expected = THREADS * ITERATIONS * COOPS_IN_TREE;
+	while( expected != deregistered )
+		this_thread::yield();
+}
+
+UT_UNIT_TEST( test_default_mt )
+{
+	run_with_time_limit(
+		[]()
+		{
+			atomic< int > registered{ 0 };
+			atomic< int > deregistered{ 0 };
+
+			{
+				so_5::wrapped_env_t env{
+					[]( so_5::environment_t & ) {},
+					[&]( so_5::environment_params_t & params ) {
+						params.coop_listener(
+								so_5::coop_listener_unique_ptr_t{
+										new listener_t{ registered, deregistered } } );
+					} };
+
+				do_check( env.environment(), deregistered );
+			}
+
+			UT_CHECK_CONDITION( THREADS * ITERATIONS * COOPS_IN_TREE == registered );
+			UT_CHECK_CONDITION( registered == deregistered );
+		},
+		60,
+		"test_default_mt" );
+}
+
+UT_UNIT_TEST( test_simple_mtsafe )
+{
+	run_with_time_limit(
+		[]()
+		{
+			atomic< int > registered{ 0 };
+			atomic< int > deregistered{ 0 };
+
+			{
+				so_5::wrapped_env_t env{
+					[]( so_5::environment_t & ) {},
+					[&]( so_5::environment_params_t & params ) {
+						params.coop_listener(
+								so_5::coop_listener_unique_ptr_t{
+										new listener_t{ registered, deregistered } } );
+						params.infrastructure_factory(
+								so_5::env_infrastructures::simple_mtsafe::factory() );
+					} };
+
+				do_check( env.environment(), deregistered );
+			}
+
+			UT_CHECK_CONDITION( THREADS * ITERATIONS * COOPS_IN_TREE == registered );
+			UT_CHECK_CONDITION( registered == deregistered );
+		},
+		60,
+		"test_simple_mtsafe" );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_default_mt )
+	UT_RUN_UNIT_TEST( test_simple_mtsafe )
+
+	return 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * A test for registration of several cooperations at once.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+
+struct started final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, so_5::mbox_t dest )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_dest( std::move(dest) )
+	{}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< started >( m_dest );
+	}
+
+private :
+	const so_5::mbox_t m_dest;
+};
+
+class a_throwing_t final : public so_5::agent_t
+{
+public :
+	a_throwing_t( context_t ctx ) : so_5::agent_t( std::move(ctx) ) {}
+
+	virtual void
+	so_define_agent() override
+	{
+		throw runtime_error( "a_throwing_t::so_define_agent" );
+	}
+};
+
+struct listener_data_t
+{
+	atomic< int > m_bulk_calls{ 0 };
+	atomic< int > m_registered{ 0 };
+	atomic< int > m_deregistered{ 0 };
+	vector< string > m_last_bulk;
+};
+
+class listener_t final : public so_5::coop_listener_t
+{
+public :
+	listener_t( listener_data_t & data ) : m_data( data ) {}
+
+	virtual void
+	on_registered(
+		so_5::environment_t &,
+		const string & ) override
+	{
+		++m_data.m_registered;
+	}
+
+	virtual void
+	on_registered_bulk(
+		so_5::environment_t &,
+		const vector< string > & coop_names ) override
+	{
+		++m_data.m_bulk_calls;
+		m_data.m_registered += static_cast< int >( coop_names.size() );
+		m_data.m_last_bulk = coop_names;
+	}
+
+	virtual void
+	on_deregistered(
+		so_5::environment_t &,
+		const string &,
+		const so_5::coop_dereg_reason_t & ) override
+	{
+		++m_data.m_deregistered;
+	}
+
+private :
+	listener_data_t & m_data;
+};
+
+so_5::coop_unique_ptr_t
+make_coop(
+	so_5::environment_t & env,
+	const string & name,
+	const so_5::mchain_t & ch )
+{
+	auto coop = name.empty() ?
+			env.create_coop( so_5::autoname ) : env.create_coop( name );
+	coop->make_agent< a_test_t >( ch->as_mbox() );
+	return coop;
+}
+
+void
+wait_deregistered( const listener_data_t & data, int expected )
+{
+	while( expected != data.m_deregistered )
+		this_thread::yield();
+}
+
+void
+ensure_error(
+	int expected_error,
+	std::function< void() > action )
+{
+	try
+	{
+		action();
+		ensure_or_die( false, "an exception must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure_or_die( expected_error == x.error_code(),
+				"unexpected error code: " + to_string( x.error_code() ) );
+	}
+}
+
+// Checks that nothing from a failed batch was started.
+void
+ensure_nothing_started( const so_5::mchain_t & ch )
+{
+	auto r = receive( from( ch ).empty_timeout( chrono::milliseconds(50) ),
+			[]( so_5::mhood_t< started > ) {} );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+}
+
+template< typename Lambda >
+void
+run_with_env(
+	const string & name,
+	so_5::environment_infrastructure_factory_t factory,
+	Lambda && lambda )
+{
+	run_with_time_limit(
+		[&]()
+		{
+			listener_data_t data;
+
+			so_5::wrapped_env_t env{
+				[]( so_5::environment_t & ) {},
+				[&]( so_5::environment_params_t & params ) {
+					params.coop_listener(
+							so_5::coop_listener_unique_ptr_t{
+									new listener_t{ data } } );
+					params.infrastructure_factory( factory );
+				} };
+
+			lambda( env.environment(), data );
+		},
+		20,
+		name );
+}
+
+void
+do_check_tree( so_5::environment_t & env, listener_data_t & data )
+{
+	const int CHILDREN = 100;
+
+	auto ch = create_mchain( env );
+
+	vector< so_5::coop_unique_ptr_t > coops;
+	coops.push_back( make_coop( env, "parent", ch ) );
+	for( int i = 0; i != CHILDREN; ++i )
+	{
+		auto child = make_coop( env, string(), ch );
+		child->set_parent_coop_name( "parent" );
+		coops.push_back( std::move( child ) );
+	}
+
+	// A grandchild is specified by the id of its parent.
+	const auto first_child_id = coops[ 1 ]->query_coop_id();
+	auto grandchild = make_coop( env, "grandchild", ch );
+	grandchild->set_parent_coop_id( first_child_id );
+	coops.push_back( std::move( grandchild ) );
+
+	const auto ids = env.register_coops( std::move( coops ) );
+	UT_CHECK_CONDITION( static_cast< size_t >(CHILDREN + 2) == ids.size() );
+	UT_CHECK_CONDITION( first_child_id == ids[ 1 ] );
+
+	UT_CHECK_CONDITION( 1 == data.m_bulk_calls );
+	UT_CHECK_CONDITION( CHILDREN + 2 == data.m_registered );
+	UT_CHECK_CONDITION( "parent" == data.m_last_bulk.front() );
+	UT_CHECK_CONDITION( "grandchild" == data.m_last_bulk.back() );
+
+	auto r = receive(
+			from( ch ).handle_n( CHILDREN + 2 ).empty_timeout( chrono::seconds(5) ),
+			[]( so_5::mhood_t< started > ) {} );
+	UT_CHECK_CONDITION( static_cast< size_t >(CHILDREN + 2) == r.handled() );
+
+	// Names from the batch are registered.
+	ensure_error( so_5::rc_coop_with_specified_name_is_already_registered,
+		[&] { env.register_coop( make_coop( env, "grandchild", ch ) ); } );
+
+	env.deregister_coop( ids.front(), so_5::dereg_reason::normal );
+	wait_deregistered( data, CHILDREN + 2 );
+}
+
+void
+do_check_failed_batches( so_5::environment_t & env, listener_data_t & data )
+{
+	auto ch = create_mchain( env );
+
+	env.register_coop( make_coop( env, "existing", ch ) );
+	receive( from( ch ).handle_n( 1 ), []( so_5::mhood_t< started > ) {} );
+
+	auto make_batch = [&]( const vector< string > & names ) {
+		vector< so_5::coop_unique_ptr_t > coops;
+		for( const auto & n : names )
+			coops.push_back( make_coop( env, n, ch ) );
+		return coops;
+	};
+
+	// Duplicate name inside the batch.
+	ensure_error( so_5::rc_coop_with_specified_name_is_already_registered,
+		[&] { env.register_coops( make_batch( { "a", "b", "a" } ) ); } );
+
+	// Name which is already registered.
+	ensure_error( so_5::rc_coop_with_specified_name_is_already_registered,
+		[&] { env.register_coops( make_batch( { "a", "existing" } ) ); } );
+
+	// Exception from so_define_agent in the last coop.
+	ensure_error( so_5::rc_coop_define_agent_failed,
+		[&] {
+			auto coops = make_batch( { "a", "b" } );
+			coops.back()->set_parent_coop_name( "a" );
+			auto bad = env.create_coop( "c" );
+			bad->set_parent_coop_name( "b" );
+			bad->make_agent< a_throwing_t >();
+			coops.push_back( std::move( bad ) );
+
+			env.register_coops( std::move( coops ) );
+		} );
+
+	// Child precedes its parent.
+	ensure_error( so_5::rc_parent_coop_not_found,
+		[&] {
+			auto coops = make_batch( { "b", "a" } );
+			coops.front()->set_parent_coop_name( "a" );
+
+			env.register_coops( std::move( coops ) );
+		} );
+
+	// Null pointer in the batch.
+	ensure_error( so_5::rc_zero_ptr_to_coop,
+		[&] {
+			auto coops = make_batch( { "a" } );
+			coops.emplace_back();
+
+			env.register_coops( std::move( coops ) );
+		} );
+
+	ensure_nothing_started( ch );
+	UT_CHECK_CONDITION( 0 == data.m_bulk_calls );
+	UT_CHECK_CONDITION( 1 == data.m_registered );
+
+	// All names from failed batches are still free.
+	env.register_coops( make_batch( { "a", "b", "c" } ) );
+	UT_CHECK_CONDITION( 1 == data.m_bulk_calls );
+	UT_CHECK_CONDITION( 4 == data.m_registered );
+
+	// An empty batch is not an error.
+	env.register_coops( vector< so_5::coop_unique_ptr_t >{} );
+
+	for( const auto & n : { "existing", "a", "b", "c" } )
+		env.deregister_coop( n, so_5::dereg_reason::normal );
+	wait_deregistered( data, 4 );
+}
+
+UT_UNIT_TEST( test_default_mt )
+{
+	run_with_env( "test_default_mt: tree",
+			so_5::env_infrastructures::default_mt::factory(),
+			do_check_tree );
+	run_with_env( "test_default_mt: failed batches",
+			so_5::env_infrastructures::default_mt::factory(),
+			do_check_failed_batches );
+}
+
+UT_UNIT_TEST( test_simple_mtsafe )
+{
+	run_with_env( "test_simple_mtsafe: tree",
+			so_5::env_infrastructures::simple_mtsafe::factory(),
+			do_check_tree );
+	run_with_env( "test_simple_mtsafe: failed batches",
+			so_5::env_infrastructures::simple_mtsafe::factory(),
+			do_check_failed_batches );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_default_mt )
+	UT_RUN_UNIT_TEST( test_simple_mtsafe )
+
+	return 0;
+}
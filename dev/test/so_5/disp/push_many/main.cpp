@@ -0,0 +1,260 @@
+/*
+ * A test for pushing several demands to event queues of various
+ * dispatchers by one operation.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct item
+	{
+		unsigned int m_value;
+	};
+
+struct done final : public so_5::signal_t {};
+
+const unsigned int batch_size = 1000;
+const unsigned int batch_count = 10;
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t( context_t ctx, so_5::mbox_t collector )
+			:	so_5::agent_t( ctx )
+			,	m_collector( std::move(collector) )
+			{
+				so_subscribe_self().event( &a_receiver_t::on_item );
+			}
+
+	private :
+		const so_5::mbox_t m_collector;
+
+		unsigned int m_received{ 0 };
+
+		void
+		on_item( mhood_t< item > cmd )
+			{
+				ensure_or_die( m_received % batch_size == cmd->m_value,
+						"items must be received in the original order" );
+
+				if( batch_size * batch_count == ++m_received )
+					so_5::send< done >( m_collector );
+			}
+	};
+
+class a_collector_t final : public so_5::agent_t
+	{
+	public :
+		a_collector_t( context_t ctx, std::size_t receivers )
+			:	so_5::agent_t( ctx )
+			,	m_receivers( receivers )
+			{
+				so_subscribe_self().event< done >( [this] {
+						if( 0 == --m_receivers )
+							so_environment().stop();
+					} );
+			}
+
+	private :
+		std::size_t m_receivers;
+	};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t( context_t ctx, std::vector< so_5::mbox_t > receivers )
+			:	so_5::agent_t( ctx )
+			,	m_receivers( std::move(receivers) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				std::vector< item > items;
+				for( unsigned int i = 0; i != batch_size; ++i )
+					items.push_back( item{ i } );
+
+				for( unsigned int i = 0; i != batch_count; ++i )
+					for( const auto & r : m_receivers )
+						so_5::send_batch< item >( r, items );
+			}
+
+	private :
+		const std::vector< so_5::mbox_t > m_receivers;
+	};
+
+//
+// Event queue proxy which forwards push_many to the original queue.
+//
+std::atomic< std::size_t > g_push_many_calls{ 0 };
+
+class test_event_queue_t final : public so_5::event_queue_t
+	{
+		so_5::event_queue_t * m_actual;
+
+	public :
+		test_event_queue_t( so_5::event_queue_t * actual )
+			:	m_actual( actual )
+			{}
+
+		void
+		push( so_5::execution_demand_t demand ) override
+			{
+				m_actual->push( std::move(demand) );
+			}
+
+		void
+		push_many(
+			so_5::execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				++g_push_many_calls;
+				m_actual->push_many( demands, count );
+			}
+	};
+
+class test_event_queue_hook_t final : public so_5::event_queue_hook_t
+	{
+	public :
+		SO_5_NODISCARD
+		so_5::event_queue_t *
+		on_bind(
+			so_5::agent_t * /*agent*/,
+			so_5::event_queue_t * original_queue ) SO_5_NOEXCEPT override
+			{
+				return new test_event_queue_t( original_queue );
+			}
+
+		void
+		on_unbind(
+			so_5::agent_t * /*agent*/,
+			so_5::event_queue_t * queue ) SO_5_NOEXCEPT override
+			{
+				delete queue;
+			}
+	};
+
+using binder_maker_t = std::function<
+		so_5::disp_binder_unique_ptr_t( so_5::environment_t & ) >;
+
+std::vector< binder_maker_t >
+make_binder_makers()
+	{
+		std::vector< binder_maker_t > result;
+
+		result.push_back( []( so_5::environment_t & env ) {
+				return so_5::disp::one_thread::create_private_disp( env )->binder();
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::one_thread;
+				return create_private_disp(
+						env,
+						std::string(),
+						disp_params_t{}.tune_queue_params(
+							[]( so_5::disp::mpsc_queue_traits::queue_params_t & p ) {
+								p.lock_free( true );
+							} ) )->binder();
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				return so_5::disp::active_obj::create_private_disp( env )->binder();
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				return so_5::disp::active_group::create_private_disp( env )
+						->binder( "group" );
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::thread_pool;
+				return create_private_disp( env, 2 )->binder( bind_params_t{} );
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::adv_thread_pool;
+				return create_private_disp( env, 2 )->binder( bind_params_t{} );
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::prio_one_thread::strictly_ordered;
+				return create_private_disp( env )->binder();
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::prio_one_thread::quoted_round_robin;
+				return create_private_disp( env, quotes_t{ 10 } )->binder();
+			} );
+		result.push_back( []( so_5::environment_t & env ) {
+				using namespace so_5::disp::prio_dedicated_threads::one_per_prio;
+				return create_private_disp( env )->binder();
+			} );
+
+		return result;
+	}
+
+void
+run_test( bool use_hook )
+	{
+		const auto binder_makers = make_binder_makers();
+
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto collector = coop.make_agent< a_collector_t >(
+								binder_makers.size() );
+
+						std::vector< so_5::mbox_t > receivers;
+						for( const auto & maker : binder_makers )
+							receivers.push_back(
+									coop.make_agent_with_binder< a_receiver_t >(
+											maker( env ),
+											collector->so_direct_mbox() )
+										->so_direct_mbox() );
+
+						coop.make_agent_with_binder< a_sender_t >(
+								so_5::disp::one_thread::create_private_disp( env )
+										->binder(),
+								std::move(receivers) );
+					} );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				if( use_hook )
+					params.event_queue_hook(
+							so_5::make_event_queue_hook< test_event_queue_hook_t >(
+									so_5::event_queue_hook_t::default_deleter ) );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				run_test( false );
+			},
+			20,
+			"push_many test" );
+
+		run_with_time_limit(
+			[]()
+			{
+				run_test( true );
+			},
+			20,
+			"push_many test with event_queue_hook" );
+
+		ensure_or_die( 0 != g_push_many_calls.load(),
+				"push_many must be forwarded by event queue proxy" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
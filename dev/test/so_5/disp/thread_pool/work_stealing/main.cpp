@@ -0,0 +1,229 @@
+/*
+ * A test for thread_pool dispatcher in work-stealing mode.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <atomic>
+#include <sstream>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+const std::size_t thread_count = 8;
+const std::size_t coop_count = 64;
+const std::size_t coop_size = 4;
+const unsigned int iterations = 1000;
+
+//
+// coop_guard_t
+//
+/*!
+ * Detects simultaneous execution of agents from one coop.
+ */
+struct coop_guard_t
+	{
+		std::atomic< int > m_active{ 0 };
+		std::atomic< bool > m_violated{ false };
+
+		void
+		enter()
+			{
+				if( 0 != m_active.fetch_add( 1, std::memory_order_acq_rel ) )
+					m_violated.store( true, std::memory_order_release );
+			}
+
+		void
+		leave()
+			{
+				m_active.fetch_sub( 1, std::memory_order_acq_rel );
+			}
+	};
+
+struct msg_seq
+	{
+		unsigned int m_value;
+	};
+
+struct msg_poke : public so_5::signal_t {};
+
+struct msg_done : public so_5::signal_t {};
+
+class a_test_t : public so_5::agent_t
+	{
+	public :
+		a_test_t(
+			context_t ctx,
+			coop_guard_t * guard,
+			so_5::mbox_t finisher )
+			:	so_5::agent_t( std::move(ctx) )
+			,	m_guard( guard )
+			,	m_finisher( std::move(finisher) )
+			{}
+
+		void
+		set_neighbor( so_5::mbox_t neighbor )
+			{
+				m_neighbor = std::move(neighbor);
+			}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event( &a_test_t::on_seq )
+					.event< msg_poke >( &a_test_t::on_poke );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_seq >( *this, 0u );
+			}
+
+	private :
+		coop_guard_t * m_guard;
+		const so_5::mbox_t m_finisher;
+		so_5::mbox_t m_neighbor;
+
+		unsigned int m_expected{ 0 };
+
+		void
+		on_seq( const msg_seq & msg )
+			{
+				m_guard->enter();
+
+				if( m_expected != msg.m_value )
+					{
+						std::ostringstream ss;
+						ss << "unexpected seq value: " << msg.m_value
+								<< ", expected: " << m_expected;
+						throw std::runtime_error( ss.str() );
+					}
+
+				++m_expected;
+				if( m_expected < iterations )
+					{
+						so_5::send< msg_seq >( *this, m_expected );
+						// Activates a queue from another coop on the context
+						// of the current work thread.
+						so_5::send< msg_poke >( m_neighbor );
+					}
+				else
+					so_5::send< msg_done >( m_finisher );
+
+				m_guard->leave();
+			}
+
+		void
+		on_poke()
+			{
+				m_guard->enter();
+				m_guard->leave();
+			}
+	};
+
+class a_finisher_t : public so_5::agent_t
+	{
+	public :
+		a_finisher_t( context_t ctx, std::size_t working_agents )
+			:	so_5::agent_t( std::move(ctx) )
+			,	m_working_agents( working_agents )
+			{
+				so_subscribe_self().event< msg_done >( [this] {
+						if( !--m_working_agents )
+							so_environment().stop();
+					} );
+			}
+
+	private :
+		std::size_t m_working_agents;
+	};
+
+void
+run_and_check(
+	tp_disp::queue_traits::lock_factory_t factory )
+	{
+		std::vector< coop_guard_t > guards( coop_count );
+
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				using namespace tp_disp;
+
+				auto disp = create_private_disp( env,
+						disp_params_t{}
+							.thread_count( thread_count )
+							.set_queue_params(
+								queue_traits::queue_params_t{}
+									.lock_factory( factory )
+									.work_stealing( true ) ),
+						std::string() );
+
+				auto finisher = env.create_coop( "finisher" );
+				auto finisher_mbox = finisher->make_agent< a_finisher_t >(
+						coop_count * coop_size )->so_direct_mbox();
+				env.register_coop( std::move(finisher) );
+
+				std::vector< so_5::coop_unique_ptr_t > coops;
+				std::vector< a_test_t * > agents;
+				for( std::size_t i = 0; i != coop_count; ++i )
+					{
+						coops.push_back( env.create_coop(
+								so_5::autoname,
+								disp->binder( bind_params_t{}
+										.fifo( fifo_t::cooperation )
+										.max_demands_at_once( 4 ) ) ) );
+
+						for( std::size_t a = 0; a != coop_size; ++a )
+							agents.push_back( coops.back()->make_agent< a_test_t >(
+									&guards[ i ], finisher_mbox ) );
+					}
+
+				// Every agent pokes an agent from another coop.
+				for( std::size_t i = 0; i != agents.size(); ++i )
+					agents[ i ]->set_neighbor(
+							agents[ (i + coop_size + 1) % agents.size() ]
+									->so_direct_mbox() );
+
+				for( auto & c : coops )
+					env.register_coop( std::move(c) );
+			} );
+
+		for( const auto & g : guards )
+			if( g.m_violated.load( std::memory_order_acquire ) )
+				throw std::runtime_error(
+						"agents from the same coop worked in parallel" );
+	}
+
+int
+main()
+	{
+		try
+			{
+				for_each_lock_factory(
+					[]( tp_disp::queue_traits::lock_factory_t factory ) {
+						run_with_time_limit(
+							[&]() {
+								run_and_check( factory );
+							},
+							120,
+							"work_stealing thread_pool test" );
+					} );
+			}
+		catch( const std::exception & ex )
+			{
+				std::cerr << "Error: " << ex.what() << std::endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
@@ -7,4 +7,6 @@ MxxRu::Cpp::composite_target {
 
 	required_prj "#{path}/simple_mtsafe_st/build_tests.rb"
 	required_prj "#{path}/simple_not_mtsafe_st/build_tests.rb"
+	required_prj "#{path}/default_mt/build_tests.rb"
+	required_prj "#{path}/legacy_infrastructure/prj.ut.rb"
 }
@@ -0,0 +1,10 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::composite_target {
+
+	path = 'test/so_5/env_infrastructure/default_mt'
+
+	required_prj "#{path}/disp_driven_timers/prj.ut.rb"
+	required_prj "#{path}/final_dereg_pool/prj.ut.rb"
+}
@@ -0,0 +1,185 @@
+/*
+ * A test for default_mt_env_infrastructure with timers which are
+ * processed by the work thread of the default dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+class a_test_t final : public so_5::agent_t
+{
+	struct delayed final : public so_5::signal_t {};
+	struct cancelled final : public so_5::signal_t {};
+	struct tick final : public so_5::signal_t {};
+	struct finish final : public so_5::signal_t {};
+
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t( std::move(ctx) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::on_delayed )
+			.event< cancelled >( [] {
+					ensure_or_die( false, "cancelled timer must not be fired" );
+				} )
+			.event( &a_test_t::on_tick )
+			.event( &a_test_t::on_finish );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		m_started_at = steady_clock::now();
+
+		// Delayed message must be delivered while the work thread
+		// sleeps on the empty queue.
+		so_5::send_delayed< delayed >( *this, milliseconds(150) );
+
+		m_cancelled = so_5::send_periodic< cancelled >( *this,
+				milliseconds(100), milliseconds::zero() );
+		m_cancelled.release();
+	}
+
+private :
+	steady_clock::time_point m_started_at;
+
+	so_5::timer_id_t m_cancelled;
+	so_5::timer_id_t m_periodic;
+	int m_ticks{ 0 };
+
+	thread m_outside_thread;
+
+	void
+	on_delayed( mhood_t< delayed > )
+	{
+		// There can be an error in one step of timer_wheel.
+		ensure_or_die( steady_clock::now() - m_started_at >= milliseconds(140),
+				"delayed message is received too early" );
+
+		m_periodic = so_5::send_periodic< tick >( *this,
+				milliseconds(10), milliseconds(20) );
+	}
+
+	void
+	on_tick( mhood_t< tick > )
+	{
+		if( 5 == ++m_ticks )
+		{
+			m_periodic.release();
+
+			// The work thread now sleeps for a long time because there
+			// is no more timers. Timer from outside must wake it up.
+			auto & env = so_environment();
+			const auto target = so_direct_mbox();
+			m_outside_thread = thread( [&env, target] {
+					this_thread::sleep_for( milliseconds(100) );
+					so_5::send_delayed< finish >( env, target, milliseconds(50) );
+				} );
+		}
+	}
+
+	void
+	on_finish( mhood_t< finish > )
+	{
+		m_outside_thread.join();
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+using queue_tuner_t = function<
+		void(so_5::disp::one_thread::queue_traits::queue_params_t &) >;
+
+void
+launch_with(
+	const string & factory_name,
+	so_5::timer_manager_factory_t timer_factory,
+	queue_tuner_t queue_tuner )
+{
+	run_with_time_limit(
+		[timer_factory, queue_tuner]() {
+			so_5::launch(
+				[&]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >();
+					} );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					params.default_disp_params(
+							so_5::disp::one_thread::disp_params_t{}
+									.tune_queue_params( queue_tuner ) );
+					params.infrastructure_factory(
+							so_5::env_infrastructures::default_mt::factory(
+									so_5::env_infrastructures::default_mt::params_t{}
+											.timer_manager( timer_factory ) ) );
+				} );
+		},
+		5,
+		factory_name + ": timers on default dispatcher" );
+}
+
+int
+main()
+{
+	try
+	{
+		struct timer_info_t {
+			string m_name;
+			so_5::timer_manager_factory_t m_factory;
+		};
+
+		timer_info_t timers[] = {
+			{ "timer_wheel", so_5::timer_wheel_manager_factory() },
+			{ "timer_heap", so_5::timer_heap_manager_factory() },
+			{ "timer_list", so_5::timer_list_manager_factory() },
+			{ "timer_hierarchical_wheel",
+					so_5::timer_hierarchical_wheel_manager_factory() }
+		};
+
+		using namespace so_5::disp::one_thread::queue_traits;
+
+		struct queue_info_t {
+			string m_name;
+			queue_tuner_t m_tuner;
+		};
+
+		queue_info_t queues[] = {
+			{ "combined_lock", []( queue_params_t & p ) {
+					p.lock_factory( combined_lock_factory() );
+				} },
+			{ "simple_lock", []( queue_params_t & p ) {
+					p.lock_factory( simple_lock_factory() );
+				} },
+			{ "lock_free", []( queue_params_t & p ) {
+					p.lock_free( true );
+				} }
+		};
+
+		for( const auto & q : queues )
+			for( const auto & t : timers )
+			{
+				const auto name = q.m_name + "/" + t.m_name;
+				cout << name << " -> " << flush;
+				launch_with( name, t.m_factory, q.m_tuner );
+				cout << "OK" << endl;
+			}
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * A test for final deregistration of coops by a pool of threads.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <map>
+
+using namespace std;
+
+const int ROOTS = 10;
+const int CHILDREN = 10;
+const int GRANDCHILDREN = 5;
+const int TOTAL_COOPS = ROOTS * (1 + CHILDREN * (1 + GRANDCHILDREN));
+
+// A log of final deregistration events.
+class event_log_t
+{
+public :
+	void
+	add( const string & coop_name )
+	{
+		lock_guard< mutex > lock{ m_lock };
+		m_events.push_back( coop_name );
+	}
+
+	vector< string >
+	events()
+	{
+		lock_guard< mutex > lock{ m_lock };
+		return m_events;
+	}
+
+private :
+	mutex m_lock;
+	vector< string > m_events;
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, event_log_t & log, string coop_name )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_log( log )
+		,	m_coop_name( std::move(coop_name) )
+	{}
+
+	~a_test_t()
+	{
+		m_log.add( m_coop_name );
+	}
+
+private :
+	event_log_t & m_log;
+	const string m_coop_name;
+};
+
+class listener_t final : public so_5::coop_listener_t
+{
+public :
+	listener_t( event_log_t & log, atomic< int > & deregistered )
+		:	m_log( log )
+		,	m_deregistered( deregistered )
+	{}
+
+	virtual void
+	on_registered(
+		so_5::environment_t &,
+		const string & ) override
+	{}
+
+	virtual void
+	on_deregistered(
+		so_5::environment_t &,
+		const string & coop_name,
+		const so_5::coop_dereg_reason_t & ) override
+	{
+		m_log.add( coop_name );
+		++m_deregistered;
+	}
+
+private :
+	event_log_t & m_log;
+	atomic< int > & m_deregistered;
+};
+
+void
+register_coop(
+	so_5::environment_t & env,
+	event_log_t & log,
+	map< string, string > & parents,
+	const string & name,
+	const string & parent )
+{
+	auto coop = env.create_coop( name );
+	if( !parent.empty() )
+		coop->set_parent_coop_name( parent );
+	coop->make_agent< a_test_t >( ref(log), name );
+	coop->make_agent< a_test_t >( ref(log), name );
+
+	env.register_coop( std::move( coop ) );
+
+	parents[ name ] = parent;
+}
+
+void
+do_check( size_t thread_count )
+{
+	event_log_t log;
+	atomic< int > deregistered{ 0 };
+	map< string, string > parents;
+
+	{
+		so_5::wrapped_env_t env{
+			[]( so_5::environment_t & ) {},
+			[&]( so_5::environment_params_t & params ) {
+				params.coop_listener( so_5::coop_listener_unique_ptr_t{
+						new listener_t{ log, deregistered } } );
+				params.infrastructure_factory(
+						so_5::env_infrastructures::default_mt::factory(
+								so_5::env_infrastructures::default_mt::params_t{}
+										.final_dereg_thread_count( thread_count ) ) );
+			} };
+
+		for( int r = 0; r != ROOTS; ++r )
+		{
+			const auto root = "r" + to_string( r );
+			register_coop( env.environment(), log, parents, root, string() );
+
+			for( int c = 0; c != CHILDREN; ++c )
+			{
+				const auto child = root + "_c" + to_string( c );
+				register_coop( env.environment(), log, parents, child, root );
+
+				for( int g = 0; g != GRANDCHILDREN; ++g )
+					register_coop( env.environment(), log, parents,
+							child + "_g" + to_string( g ), child );
+			}
+		}
+
+		for( int r = 0; r != ROOTS; ++r )
+			env.environment().deregister_coop( "r" + to_string( r ),
+					so_5::dereg_reason::normal );
+
+		while( TOTAL_COOPS != deregistered )
+			this_thread::yield();
+	}
+
+	// Every coop must be completely destroyed before the final
+	// deregistration of its parent is started.
+	const auto events = log.events();
+	UT_CHECK_CONDITION( static_cast< size_t >(TOTAL_COOPS * 3) == events.size() );
+
+	map< string, size_t > first_event;
+	map< string, size_t > last_event;
+	for( size_t i = 0; i != events.size(); ++i )
+	{
+		first_event.emplace( events[ i ], i );
+		last_event[ events[ i ] ] = i;
+	}
+
+	for( const auto & p : parents )
+		if( !p.second.empty() )
+			ensure_or_die( last_event[ p.first ] < first_event[ p.second ],
+					"child must be destroyed before its parent, child: " +
+					p.first + ", parent: " + p.second );
+}
+
+UT_UNIT_TEST( test_final_dereg_pool )
+{
+	const size_t thread_counts[] = { 1u, 4u, 0u };
+	for( auto c : thread_counts )
+	{
+		cout << "threads: " << c << endl;
+
+		run_with_time_limit(
+			[c]() { do_check( c ); },
+			20,
+			"test_final_dereg_pool: " + to_string( c ) );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_final_dereg_pool )
+
+	return 0;
+}
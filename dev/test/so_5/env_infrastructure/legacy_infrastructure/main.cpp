@@ -0,0 +1,250 @@
+/*
+ * A test for environment infrastructure which supports only
+ * names of cooperations (like infrastructures written before v.5.5.25).
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <map>
+#include <mutex>
+#include <atomic>
+
+using namespace std;
+
+atomic< int > g_dereg_by_name{ 0 };
+atomic< int > g_final_dereg_by_name{ 0 };
+
+//
+// legacy_infrastructure_t
+//
+/*!
+ * Implements only the methods from the previous versions.
+ * The actual work is delegated to the default infrastructure.
+ */
+class legacy_infrastructure_t final
+	:	public so_5::environment_infrastructure_t
+{
+public :
+	legacy_infrastructure_t(
+		so_5::environment_infrastructure_unique_ptr_t actual )
+		:	m_actual( std::move(actual) )
+	{}
+
+	virtual void
+	launch( env_init_t init_fn ) override
+	{
+		m_actual->launch( std::move(init_fn) );
+	}
+
+	virtual void
+	stop() override
+	{
+		m_actual->stop();
+	}
+
+	virtual void
+	register_coop( so_5::coop_unique_ptr_t coop ) override
+	{
+		const string name = coop->query_coop_name();
+		{
+			lock_guard< mutex > lock{ m_lock };
+			m_ids[ name ] = coop->query_coop_id();
+		}
+
+		m_actual->register_coop( std::move(coop) );
+	}
+
+	virtual void
+	deregister_coop(
+		so_5::nonempty_name_t name,
+		so_5::coop_dereg_reason_t dereg_reason ) override
+	{
+		++g_dereg_by_name;
+		m_actual->deregister_coop( std::move(name), dereg_reason );
+	}
+
+	virtual void
+	ready_to_deregister_notify( so_5::coop_t * coop ) override
+	{
+		m_actual->ready_to_deregister_notify( coop );
+	}
+
+	virtual bool
+	final_deregister_coop( string coop_name ) override
+	{
+		++g_final_dereg_by_name;
+
+		so_5::coop_id_t id;
+		{
+			lock_guard< mutex > lock{ m_lock };
+			auto it = m_ids.find( coop_name );
+			ensure_or_die( m_ids.end() != it, "unknown coop: " + coop_name );
+			id = it->second;
+			m_ids.erase( it );
+		}
+
+		return m_actual->final_deregister_coop( id );
+	}
+
+	virtual so_5::timer_id_t
+	schedule_timer(
+		const std::type_index & type_wrapper,
+		const so_5::message_ref_t & msg,
+		const so_5::mbox_t & mbox,
+		std::chrono::steady_clock::duration pause,
+		std::chrono::steady_clock::duration period ) override
+	{
+		return m_actual->schedule_timer(
+				type_wrapper, msg, mbox, pause, period );
+	}
+
+	virtual void
+	single_timer(
+		const std::type_index & type_wrapper,
+		const so_5::message_ref_t & msg,
+		const so_5::mbox_t & mbox,
+		std::chrono::steady_clock::duration pause ) override
+	{
+		m_actual->single_timer( type_wrapper, msg, mbox, pause );
+	}
+
+	virtual so_5::stats::controller_t &
+	stats_controller() SO_5_NOEXCEPT override
+	{
+		return m_actual->stats_controller();
+	}
+
+	virtual so_5::stats::repository_t &
+	stats_repository() SO_5_NOEXCEPT override
+	{
+		return m_actual->stats_repository();
+	}
+
+	virtual so_5::dispatcher_t &
+	query_default_dispatcher() override
+	{
+		return m_actual->query_default_dispatcher();
+	}
+
+	virtual coop_repository_stats_t
+	query_coop_repository_stats() override
+	{
+		return m_actual->query_coop_repository_stats();
+	}
+
+	virtual so_5::timer_thread_stats_t
+	query_timer_thread_stats() override
+	{
+		return m_actual->query_timer_thread_stats();
+	}
+
+	virtual so_5::disp_binder_unique_ptr_t
+	make_default_disp_binder() override
+	{
+		return m_actual->make_default_disp_binder();
+	}
+
+private :
+	so_5::environment_infrastructure_unique_ptr_t m_actual;
+
+	mutex m_lock;
+	map< string, so_5::coop_id_t > m_ids;
+};
+
+class a_child_t final : public so_5::agent_t
+{
+public :
+	a_child_t( context_t ctx ) : so_5::agent_t( std::move(ctx) ) {}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_deregister_agent_coop_normally();
+	}
+};
+
+class a_parent_t final : public so_5::agent_t
+{
+	struct msg_finish : public so_5::signal_t {};
+
+public :
+	a_parent_t( context_t ctx ) : so_5::agent_t( std::move(ctx) )
+	{
+		so_subscribe_self().event< msg_finish >( [this] {
+				so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::introduce_child_coop( *this, []( so_5::coop_t & coop ) {
+				coop.make_agent< a_child_t >();
+			} );
+		so_5::introduce_child_coop( *this, "named_child",
+			[]( so_5::coop_t & coop ) {
+				coop.make_agent< a_child_t >();
+			} );
+
+		// Deregistration by id can't be done by legacy infrastructure.
+		try
+		{
+			so_environment().deregister_coop( so_coop_id(),
+					so_5::dereg_reason::normal );
+			ensure_or_die( false, "an exception must be thrown!" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			ensure_or_die(
+					so_5::rc_coop_id_not_supported_by_env_infrastructure ==
+							x.error_code(),
+					"rc_coop_id_not_supported_by_env_infrastructure expected!" );
+		}
+
+		so_5::send_delayed< msg_finish >( *this,
+				std::chrono::milliseconds( 25 ) );
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_parent_t >();
+						} );
+				},
+				[]( so_5::environment_params_t & params ) {
+					auto actual_factory =
+							so_5::env_infrastructures::default_mt::factory();
+					params.infrastructure_factory(
+						[actual_factory](
+							so_5::environment_t & env,
+							so_5::environment_params_t & env_params,
+							so_5::mbox_t stats_mbox )
+						{
+							return so_5::environment_infrastructure_unique_ptr_t(
+								new legacy_infrastructure_t(
+										actual_factory(
+												env, env_params, stats_mbox ) ),
+								so_5::environment_infrastructure_t::default_deleter() );
+						} );
+				} );
+		},
+		20,
+		"legacy environment infrastructure" );
+
+	// Parent, two children and autoshutdown guard coop of the environment.
+	ensure_or_die( 4 == g_dereg_by_name, "4 deregistrations expected!" );
+	ensure_or_die( 4 == g_final_dereg_by_name,
+			"4 final deregistrations expected!" );
+
+	return 0;
+}
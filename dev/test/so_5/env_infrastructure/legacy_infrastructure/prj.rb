@@ -0,0 +1,10 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'so_5/prj.rb'
+
+	target '_unit.test.env_infrastructure.legacy_infrastructure'
+
+	cpp_source 'main.cpp'
+}
@@ -10,6 +10,10 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/simple_named_mbox_count/prj.ut.rb"
 	required_prj "#{path}/simple_timer_thread/prj.ut.rb"
 	required_prj "#{path}/simple_work_thread_activity/prj.ut.rb"
+	required_prj "#{path}/work_thread_latency/prj.ut.rb"
+	required_prj "#{path}/queueing_delay/prj.ut.rb"
+	required_prj "#{path}/snapshot/prj.ut.rb"
+	required_prj "#{path}/demand_pool/prj.ut.rb"
 
 	required_prj "#{path}/all_dispatchers/prj.rb"
 }
@@ -0,0 +1,199 @@
+/*
+ * A simple test for getting stats about pools of demand nodes
+ * of thread_pool and adv_thread_pool dispatchers.
+ */
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+struct msg_ping
+	{
+		unsigned int m_remaining;
+	};
+
+struct msg_ping_pong_finished : public so_5::signal_t {};
+
+class a_ping_pong_t : public so_5::agent_t
+	{
+	public :
+		a_ping_pong_t(
+			context_t ctx,
+			so_5::mbox_t finish_mbox,
+			bool starter )
+			:	so_5::agent_t( ctx )
+			,	m_finish_mbox( std::move(finish_mbox) )
+			,	m_starter( starter )
+			{}
+
+		void
+		set_partner( so_5::mbox_t partner )
+			{
+				m_partner = std::move(partner);
+			}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_ping_pong_t::evt_ping );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				if( m_starter )
+					so_5::send< msg_ping >( m_partner, 1000u );
+			}
+
+	private :
+		const so_5::mbox_t m_finish_mbox;
+		const bool m_starter;
+		so_5::mbox_t m_partner;
+
+		void
+		evt_ping( const msg_ping & evt )
+			{
+				if( evt.m_remaining )
+					so_5::send< msg_ping >( m_partner, evt.m_remaining - 1 );
+				else
+					so_5::send< msg_ping_pong_finished >( m_finish_mbox );
+			}
+	};
+
+class a_test_t : public so_5::agent_t
+	{
+	public :
+		a_test_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe_self().event< msg_ping_pong_finished >(
+						&a_test_t::evt_ping_pong_finished );
+
+				so_default_state().event(
+						so_environment().stats_controller().mbox(),
+						&a_test_t::evt_quantity );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				make_ping_pong_coop( "tp",
+						so_5::disp::thread_pool::create_disp_binder(
+								"tp",
+								so_5::disp::thread_pool::bind_params_t{}.fifo(
+										so_5::disp::thread_pool::fifo_t::individual ) ) );
+				make_ping_pong_coop( "atp",
+						so_5::disp::adv_thread_pool::create_disp_binder(
+								"atp",
+								so_5::disp::adv_thread_pool::bind_params_t{}.fifo(
+										so_5::disp::adv_thread_pool::fifo_t::individual ) ) );
+			}
+
+	private :
+		unsigned int m_finished_ping_pongs = { 0 };
+
+		std::set< std::string > m_hits_found;
+		std::set< std::string > m_misses_found;
+
+		void
+		make_ping_pong_coop(
+			const std::string & name,
+			so_5::disp_binder_unique_ptr_t binder )
+			{
+				so_environment().introduce_coop( name, std::move(binder),
+					[this]( so_5::coop_t & coop ) {
+						auto a = coop.make_agent< a_ping_pong_t >(
+								so_direct_mbox(), true );
+						auto b = coop.make_agent< a_ping_pong_t >(
+								so_direct_mbox(), false );
+
+						a->set_partner( b->so_direct_mbox() );
+						b->set_partner( a->so_direct_mbox() );
+					} );
+			}
+
+		void
+		evt_ping_pong_finished()
+			{
+				++m_finished_ping_pongs;
+				if( 2 == m_finished_ping_pongs )
+					so_environment().stats_controller().turn_on();
+			}
+
+		void
+		evt_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				namespace stats = so_5::stats;
+
+				const std::string prefix{ evt.m_prefix.c_str() };
+				const std::string disp_type =
+						0 == prefix.find( "disp/tp/" ) ? "tp" :
+						( 0 == prefix.find( "disp/atp/" ) ? "atp" : "" );
+				if( disp_type.empty() )
+					return;
+
+				if( stats::suffixes::demand_pool_hits() == evt.m_suffix )
+					{
+						std::cout << evt.m_prefix << evt.m_suffix << ": "
+								<< evt.m_value << std::endl;
+						if( evt.m_value )
+							m_hits_found.insert( disp_type );
+					}
+				else if( stats::suffixes::demand_pool_misses() == evt.m_suffix )
+					{
+						// Count of misses can be zero. So only the presence
+						// of the value is checked.
+						std::cout << evt.m_prefix << evt.m_suffix << ": "
+								<< evt.m_value << std::endl;
+						m_misses_found.insert( disp_type );
+					}
+
+				if( 2 == m_hits_found.size() && 2 == m_misses_found.size() )
+					so_environment().stop();
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch(
+					[]( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								so_5::autoname,
+								env.make_agent< a_test_t >() );
+					},
+					[]( so_5::environment_params_t & params ) {
+						params.add_named_dispatcher( "tp",
+								so_5::disp::thread_pool::create_disp( 2 ) );
+						params.add_named_dispatcher( "atp",
+								so_5::disp::adv_thread_pool::create_disp( 2 ) );
+					} );
+			},
+			20,
+			"demand pool monitoring test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * A test for queueing delays of demands.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+#include <typeindex>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std::chrono;
+
+const unsigned int slow_count = 10;
+const auto slow_duration = milliseconds( 10 );
+
+struct slow final : public so_5::signal_t {};
+struct fast final : public so_5::signal_t {};
+struct done final : public so_5::signal_t {};
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t( context_t ctx, so_5::mbox_t monitor )
+			:	so_5::agent_t( ctx )
+			,	m_monitor( std::move(monitor) )
+			{
+				so_subscribe_self()
+					.event< slow >( [] {
+						std::this_thread::sleep_for( slow_duration );
+					} )
+					.event< fast >( [this] {
+						so_5::send< done >( m_monitor );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				// All demands are in the queue before the processing
+				// of the first one.
+				for( unsigned int i = 0; i != slow_count; ++i )
+					so_5::send< slow >( *this );
+				so_5::send< fast >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_monitor;
+	};
+
+class a_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_monitor_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe_self().event< done >( [this] {
+						m_receiver_finished = true;
+					} );
+
+				so_subscribe( so_environment().stats_controller().mbox() )
+					.event( &a_monitor_t::on_queueing_delay )
+					.event( &a_monitor_t::on_distribution_finished );
+			}
+
+		void
+		set_receiver( const so_5::agent_t * receiver )
+			{
+				m_receiver = receiver;
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 100 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		const so_5::agent_t * m_receiver{ nullptr };
+		bool m_receiver_finished{ false };
+
+		bool m_slow_found{ false };
+		bool m_fast_found{ false };
+
+		void
+		on_queueing_delay(
+			mhood_t< so_5::stats::messages::queueing_delay > evt )
+			{
+				if( !m_receiver_finished || m_receiver != evt->m_agent )
+					return;
+
+				std::cout << evt->m_prefix << evt->m_suffix
+						<< " [" << evt->m_msg_type.name() << "] -> "
+						<< evt->m_stats << std::endl;
+
+				if( std::type_index( typeid(slow) ) == evt->m_msg_type )
+					{
+						ensure_or_die( slow_count == evt->m_stats.m_count,
+								"unexpected count of slow demands" );
+						m_slow_found = true;
+					}
+				else if( std::type_index( typeid(fast) ) == evt->m_msg_type )
+					{
+						ensure_or_die( 1u == evt->m_stats.m_count,
+								"unexpected count of fast demands" );
+						ensure_or_die(
+								evt->m_stats.m_max_time >= slow_duration * slow_count,
+								"fast demand must wait for all slow demands" );
+						m_fast_found = true;
+					}
+			}
+
+		void
+		on_distribution_finished(
+			mhood_t< so_5::stats::messages::distribution_finished > )
+			{
+				if( m_slow_found && m_fast_found )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+init( so_5::environment_t & env )
+	{
+		env.introduce_coop( [&env]( so_5::coop_t & coop ) {
+			auto monitor = coop.make_agent< a_monitor_t >();
+			auto receiver = coop.make_agent_with_binder< a_receiver_t >(
+					so_5::disp::one_thread::create_private_disp( env )->binder(),
+					monitor->so_direct_mbox() );
+			monitor->set_receiver( receiver );
+		} );
+	}
+
+class a_no_tracking_t final : public so_5::agent_t
+	{
+	public :
+		a_no_tracking_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe( so_environment().stats_controller().mbox() )
+					.event( []( mhood_t< so_5::stats::messages::queueing_delay > ) {
+						throw std::runtime_error(
+								"queueing_delay must not be distributed" );
+					} )
+					.event( [this](
+							mhood_t< so_5::stats::messages::distribution_finished > ) {
+						if( 3 == ++m_distributions )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 100 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		unsigned int m_distributions{ 0 };
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init,
+					[]( so_5::environment_params_t & params ) {
+						params.turn_queueing_delay_tracking_on();
+					} );
+			},
+			20,
+			"queueing delay test" );
+
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_no_tracking_t >();
+							} );
+					} );
+			},
+			20,
+			"queueing delay test without tracking" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,169 @@
+/*
+ * A test for pull-based reading of run-time stats.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+namespace stats = so_5::stats;
+
+const stats::snapshot_record_t *
+find_record(
+	const stats::snapshot_collector_t & collector,
+	const char * prefix,
+	const char * suffix )
+	{
+		const auto & names = collector.names();
+		for( const auto & r : collector )
+			if( 0 == std::strcmp( prefix, names.name( r.m_prefix ) ) &&
+					0 == std::strcmp( suffix, names.name( r.m_suffix ) ) )
+				return &r;
+
+		return nullptr;
+	}
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe( so_environment().stats_controller().mbox() )
+					.event( []( mhood_t< stats::messages::quantity< std::size_t > > ) {
+						throw std::runtime_error(
+								"no messages must be sent by take_snapshot" );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				stats::name_registry_t names;
+				std::vector< stats::snapshot_record_t > buffer( 256 );
+
+				stats::snapshot_collector_t collector{
+						names, buffer.data(), buffer.size() };
+
+				so_environment().stats_controller().take_snapshot( collector );
+
+				for( const auto & r : collector )
+					std::cout << names.name( r.m_prefix ) << names.name( r.m_suffix )
+							<< ": " << r.m_value << std::endl;
+
+				ensure_or_die( 0u == collector.dropped(),
+						"there must be enough space for all records" );
+
+				auto coop_count = find_record( collector,
+						stats::prefixes::coop_repository().c_str(),
+						stats::suffixes::coop_reg_count().c_str() );
+				ensure_or_die( nullptr != coop_count,
+						"coop_repository/coop.reg.count must be present" );
+				ensure_or_die( 1u <= coop_count->m_value,
+						"at least one coop must be registered" );
+
+				ensure_or_die( nullptr != find_record( collector,
+								stats::prefixes::mbox_repository().c_str(),
+								stats::suffixes::named_mbox_count().c_str() ),
+						"mbox_repository/named_mbox.count must be present" );
+
+				auto agents = find_record( collector,
+						"disp/ot/snapshot",
+						stats::suffixes::agent_count().c_str() );
+				ensure_or_die( nullptr != agents,
+						"disp/ot/snapshot/agent.count must be present" );
+				ensure_or_die( 1u == agents->m_value,
+						"one agent must be bound to the dispatcher" );
+
+				const std::string working_count =
+						std::string( stats::suffixes::work_thread_activity().c_str() ) +
+						".working.count";
+				ensure_or_die( nullptr != find_record( collector,
+								"disp/ot/snapshot", working_count.c_str() ),
+						"activity of dispatcher's thread must be present" );
+
+				// Names are not registered again in the next snapshot.
+				const auto records = collector.size();
+				const auto names_count = names.size();
+
+				so_environment().stats_controller().take_snapshot( collector );
+
+				ensure_or_die( records == collector.size(),
+						"count of records must be the same" );
+				ensure_or_die( names_count == names.size(),
+						"no new names must be registered" );
+
+				// Records which don't fit into the buffer are dropped.
+				stats::snapshot_collector_t small{ names, buffer.data(), 2 };
+				so_environment().stats_controller().take_snapshot( small );
+
+				ensure_or_die( 2u == small.size(),
+						"small buffer must be full" );
+				ensure_or_die( records - 2u == small.dropped(),
+						"other records must be dropped" );
+
+				so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+init( so_5::environment_t & env )
+	{
+		env.introduce_coop(
+			so_5::disp::one_thread::create_private_disp( env, "snapshot" )->binder(),
+			[]( so_5::coop_t & coop ) {
+				coop.make_agent< a_test_t >();
+			} );
+	}
+
+void
+run_test(
+	const char * description,
+	std::function< void(so_5::environment_params_t &) > tuner )
+	{
+		std::cout << "=== " << description << " ===" << std::endl;
+
+		run_with_time_limit(
+			[&]()
+			{
+				so_5::launch( &init,
+					[&]( so_5::environment_params_t & params ) {
+						params.turn_work_thread_activity_tracking_on();
+						tuner( params );
+					} );
+			},
+			20,
+			description );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_test( "default infrastructure",
+				[]( so_5::environment_params_t & ) {} );
+
+		run_test( "simple_mtsafe infrastructure",
+				[]( so_5::environment_params_t & params ) {
+					params.infrastructure_factory(
+							so_5::env_infrastructures::simple_mtsafe::factory() );
+				} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,223 @@
+/*
+ * A test for latency histograms of work threads.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std::chrono;
+
+const unsigned int events_count = 20;
+const auto event_duration = milliseconds( 2 );
+
+void
+check_histogram_layout()
+	{
+		using histogram_t = so_5::stats::latency_histogram_t;
+
+		const std::uint64_t values[] = {
+				0, 1, 15, 16, 17, 31, 32, 33, 1000, 1023, 1024,
+				123456789, 1000000000000ull };
+
+		for( auto v : values )
+			{
+				const auto index = histogram_t::bucket_index( v );
+				ensure_or_die( index < histogram_t::bucket_count,
+						"index must be in range" );
+				ensure_or_die( histogram_t::bucket_lower_bound( index ) <= v &&
+						v <= histogram_t::bucket_upper_bound( index ),
+						"value must be in bounds of its bucket: " +
+						std::to_string( v ) );
+				ensure_or_die( histogram_t::bucket_upper_bound( index ) - v <=
+						v / histogram_t::sub_bucket_count,
+						"relative error is too big for " + std::to_string( v ) );
+			}
+
+		for( std::size_t i = 1; i != histogram_t::bucket_count; ++i )
+			ensure_or_die( histogram_t::bucket_upper_bound( i - 1 ) + 1 ==
+					histogram_t::bucket_lower_bound( i ),
+					"buckets must be adjacent" );
+
+		histogram_t h;
+		ensure_or_die( so_5::stats::duration_t::zero() == h.value_at_percentile( 99.0 ),
+				"empty histogram must return zero" );
+
+		for( int i = 0; i != 99; ++i )
+			h.add( microseconds( 10 ) );
+		h.add( milliseconds( 10 ) );
+
+		ensure_or_die( 100u == h.total_count(), "total count mismatch" );
+		ensure_or_die( h.value_at_percentile( 50.0 ) >= microseconds( 10 ) &&
+				h.value_at_percentile( 50.0 ) < microseconds( 11 ),
+				"unexpected p50" );
+		ensure_or_die( h.value_at_percentile( 99.0 ) < microseconds( 11 ),
+				"unexpected p99" );
+		ensure_or_die( h.max_value() >= milliseconds( 10 ) &&
+				h.max_value() < milliseconds( 11 ),
+				"unexpected max" );
+
+		auto delta = h;
+		delta -= h;
+		ensure_or_die( 0u == delta.total_count(),
+				"delta of the same snapshots must be empty" );
+	}
+
+struct next final : public so_5::signal_t {};
+struct done final : public so_5::signal_t {};
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		a_worker_t( context_t ctx, so_5::mbox_t monitor )
+			:	so_5::agent_t( ctx )
+			,	m_monitor( std::move(monitor) )
+			{
+				so_subscribe_self().event< next >( [this] {
+						std::this_thread::sleep_for( event_duration );
+						if( ++m_received == events_count )
+							so_5::send< done >( m_monitor );
+						else
+							so_5::send< next >( *this );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< next >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_monitor;
+		unsigned int m_received{ 0 };
+	};
+
+class a_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_monitor_t( context_t ctx, unsigned int workers )
+			:	so_5::agent_t( ctx )
+			,	m_workers( workers )
+			{
+				so_subscribe_self().event< done >( [this] {
+						--m_workers_in_progress;
+					} );
+
+				auto stats_mbox = so_environment().stats_controller().mbox();
+				so_subscribe( stats_mbox )
+					.event( &a_monitor_t::on_distribution_started )
+					.event( &a_monitor_t::on_latency )
+					.event( &a_monitor_t::on_distribution_finished );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 100 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		const unsigned int m_workers;
+		unsigned int m_workers_in_progress{ m_workers };
+
+		unsigned int m_busy_threads{ 0 };
+
+		void
+		on_distribution_started(
+			mhood_t< so_5::stats::messages::distribution_started > )
+			{
+				m_busy_threads = 0;
+			}
+
+		void
+		on_latency(
+			mhood_t< so_5::stats::messages::work_thread_latency > evt )
+			{
+				const auto & working = evt->m_stats.m_working_histogram;
+				if( working.total_count() >= events_count &&
+						working.value_at_percentile( 50.0 ) >= event_duration )
+					{
+						std::cout << evt->m_prefix << evt->m_suffix
+								<< " [" << evt->m_thread_id << "] ->\n"
+								<< "  working: " << working << "\n"
+								<< "  waiting: " << evt->m_stats.m_waiting_histogram
+								<< std::endl;
+
+						++m_busy_threads;
+					}
+			}
+
+		void
+		on_distribution_finished(
+			mhood_t< so_5::stats::messages::distribution_finished > )
+			{
+				if( !m_workers_in_progress && m_busy_threads >= m_workers )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+init( so_5::environment_t & env )
+	{
+		env.introduce_coop( [&env]( so_5::coop_t & coop ) {
+			auto monitor = coop.make_agent< a_monitor_t >( 5u );
+			const auto mbox = monitor->so_direct_mbox();
+
+			coop.make_agent_with_binder< a_worker_t >(
+					so_5::disp::one_thread::create_private_disp( env )->binder(),
+					mbox );
+			coop.make_agent_with_binder< a_worker_t >(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					mbox );
+			coop.make_agent_with_binder< a_worker_t >(
+					so_5::disp::thread_pool::create_private_disp( env, 1 )->binder(
+							so_5::disp::thread_pool::bind_params_t{} ),
+					mbox );
+			coop.make_agent_with_binder< a_worker_t >(
+					so_5::disp::adv_thread_pool::create_private_disp( env, 1 )->binder(
+							so_5::disp::adv_thread_pool::bind_params_t{} ),
+					mbox );
+			coop.make_agent_with_binder< a_worker_t >(
+					so_5::disp::prio_one_thread::strictly_ordered::create_private_disp(
+							env )->binder(),
+					mbox );
+		} );
+	}
+
+int
+main()
+{
+	try
+	{
+		check_histogram_layout();
+
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init,
+					[]( so_5::environment_params_t & params ) {
+						params.turn_work_thread_activity_tracking_on();
+					} );
+			},
+			20,
+			"work thread latency histograms test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
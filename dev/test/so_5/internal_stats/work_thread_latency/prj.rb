@@ -0,0 +1,11 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'so_5/prj.rb'
+
+	target '_unit.test.internal_stats.work_thread_latency'
+
+	cpp_source 'main.cpp'
+}
+
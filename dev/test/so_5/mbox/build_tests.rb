@@ -9,11 +9,15 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/drop_subscription/prj.ut.rb" )
 	required_prj( "#{path}/drop_subscr_when_demand_in_queue/prj.ut.rb" )
 	required_prj( "#{path}/adaptive_subscr_storage/prj.ut.rb" )
+	required_prj( "#{path}/frozen_subscr_storage/prj.ut.rb" )
 	required_prj( "#{path}/mpsc_mbox/prj.ut.rb" )
 	required_prj( "#{path}/mpsc_mbox_illegal_subscriber/prj.ut.rb" )
 	required_prj( "#{path}/mpsc_mbox_stress/prj.ut.rb" )
 	required_prj( "#{path}/hanging_subscriptions/prj.ut.rb" )
 	required_prj( "#{path}/delivery_filters/build_tests.rb" )
 	required_prj( "#{path}/local_mbox_growth/prj.ut.rb" )
+	required_prj( "#{path}/many_msg_types/prj.ut.rb" )
+	required_prj( "#{path}/rcu_local_mbox/prj.ut.rb" )
+	required_prj( "#{path}/named_mbox_handle/prj.ut.rb" )
 	required_prj( "#{path}/custom_mbox_simple/prj.ut.rb" )
 }
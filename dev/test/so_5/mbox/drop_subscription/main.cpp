@@ -337,6 +337,9 @@ do_test()
 	,	{ "adaptive[3]", so_5::adaptive_subscription_storage_factory( 3 ) }
 	,	{ "adaptive[8]", so_5::adaptive_subscription_storage_factory( 8 ) }
 	,	{ "default", so_5::default_subscription_storage_factory() }
+	,	{ "frozen", so_5::frozen_subscription_storage_factory() }
+	,	{ "frozen[map]", so_5::frozen_subscription_storage_factory(
+				so_5::map_based_subscription_storage_factory() ) }
 	}; 
 
 	for( auto & f : factories )
@@ -0,0 +1,177 @@
+/*
+ * A test for frozen subscription storage.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+template< int I >
+struct msg final : public so_5::signal_t {};
+
+struct late_msg final : public so_5::signal_t {};
+struct not_handled final : public so_5::signal_t {};
+struct finish final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+	{
+		state_t st_parent{ this, "parent" };
+		state_t st_child{ initial_substate_of{ st_parent }, "child" };
+		state_t st_other{ this, "other" };
+
+	public :
+		a_test_t( context_t ctx, so_5::subscription_storage_factory_t factory )
+			:	so_5::agent_t( ctx + std::move(factory) )
+			,	m_mbox( so_environment().create_mbox() )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				// There are more than 8 message types in the group for
+				// direct mbox and the parent state.
+				subscribe_many< 0 >( so_direct_mbox() );
+
+				so_subscribe( m_mbox ).in( st_parent )
+					.event< msg< 0 > >( [this] { m_trace += "p0;"; } );
+				so_subscribe( m_mbox ).in( st_child )
+					.event< msg< 1 > >( [this] { m_trace += "c1;"; } );
+				so_subscribe( m_mbox ).in( st_other )
+					.event< msg< 0 > >( [this] { m_trace += "o0;"; } );
+
+				so_subscribe_deadletter_handler( m_mbox,
+						[this]( mhood_t< msg< 2 > > ) { m_trace += "d2;"; } );
+
+				so_subscribe_self().in( st_parent ).in( st_other )
+					.event< finish >( &a_test_t::on_finish );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( int i = 0; i != 3; ++i )
+					{
+						send_all();
+						this >>= st_child;
+						send_all();
+						this >>= st_other;
+						send_all();
+						this >>= so_default_state();
+					}
+
+				this >>= st_parent;
+				so_5::send< finish >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_mbox;
+
+		std::string m_trace;
+
+		template< int I >
+		void
+		subscribe_many( const so_5::mbox_t & from,
+			typename std::enable_if< (I < 12) >::type * = nullptr )
+			{
+				so_subscribe( from ).in( st_parent ).event< msg< I > >( [this] {
+						m_trace += "m" + std::to_string( I ) + ";";
+					} );
+				subscribe_many< I + 1 >( from );
+			}
+
+		template< int I >
+		void
+		subscribe_many( const so_5::mbox_t &,
+			typename std::enable_if< (I >= 12) >::type * = nullptr )
+			{}
+
+		// Messages are handled after the return from so_evt_start.
+		// The storage is frozen at that moment.
+		void
+		send_all()
+			{
+				so_5::send< msg< 0 > >( *this );
+				so_5::send< msg< 11 > >( *this );
+				so_5::send< msg< 5 > >( *this );
+				so_5::send< msg< 0 > >( m_mbox );
+				so_5::send< msg< 1 > >( m_mbox );
+				so_5::send< msg< 2 > >( m_mbox );
+				so_5::send< not_handled >( *this );
+				so_5::send< not_handled >( m_mbox );
+			}
+
+		void
+		on_finish()
+			{
+				// Messages are handled in the state which is current at
+				// the moment of processing. It is st_child for all of them.
+				std::string expected;
+				for( int i = 0; i != 9; ++i )
+					expected += "m0;m11;m5;p0;c1;d2;";
+
+				ensure_or_die( expected == m_trace,
+						"unexpected trace: " + m_trace + ", expected: " + expected );
+
+				// Change of subscriptions when the storage is frozen.
+				so_subscribe_self().in( st_parent )
+					.event< late_msg >( [this] {
+							ensure_or_die( "p0;" == m_trace,
+									"unexpected trace after unfreezing: " + m_trace );
+							so_deregister_agent_coop_normally();
+						} );
+				so_drop_subscription< msg< 1 > >( m_mbox, st_child );
+
+				m_trace.clear();
+				so_5::send< msg< 1 > >( m_mbox );
+				so_5::send< msg< 0 > >( m_mbox );
+				so_5::send< late_msg >( *this );
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		using factory_info_t =
+				std::pair< std::string, so_5::subscription_storage_factory_t >;
+
+		factory_info_t factories[] = {
+			{ "frozen", so_5::frozen_subscription_storage_factory() }
+		,	{ "frozen[vector]", so_5::frozen_subscription_storage_factory(
+					so_5::vector_based_subscription_storage_factory( 4 ) ) }
+		,	{ "frozen[hash_table]", so_5::frozen_subscription_storage_factory(
+					so_5::hash_table_based_subscription_storage_factory() ) }
+		};
+
+		for( auto & f : factories )
+		{
+			std::cout << "checking factory: " << f.first << " -> " << std::flush;
+
+			run_with_time_limit(
+				[&f] {
+					so_5::launch( [&f]( so_5::environment_t & env ) {
+							env.introduce_coop( [&f]( so_5::coop_t & coop ) {
+									coop.make_agent< a_test_t >( f.second );
+								} );
+						} );
+				},
+				20,
+				"checking factory " + f.first );
+
+			std::cout << "OK" << std::endl;
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
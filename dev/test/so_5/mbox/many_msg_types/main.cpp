@@ -0,0 +1,231 @@
+/*
+ * A test for local_mbox with many message types.
+ */
+
+#include <iostream>
+#include <array>
+#include <functional>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+const std::size_t msg_types = 40;
+
+template< std::size_t I >
+struct msg_signal final : public so_5::signal_t {};
+
+struct check final : public so_5::signal_t {};
+
+// Calls f.template apply<I>() for every I in [0, msg_types).
+template< std::size_t I = 0 >
+struct for_each_type
+	{
+		template< typename F >
+		static void
+		call( F & f )
+			{
+				f.template apply< I >();
+				for_each_type< I + 1 >::call( f );
+			}
+	};
+
+template<>
+struct for_each_type< msg_types >
+	{
+		template< typename F >
+		static void
+		call( F & ) {}
+	};
+
+class a_test_t final : public so_5::agent_t
+	{
+		using predicate_t = std::function< bool( std::size_t ) >;
+
+	public :
+		a_test_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			,	m_mbox( so_environment().create_mbox() )
+			{
+				m_received.fill( 0u );
+
+				so_subscribe_self().event< check >( &a_test_t::on_check );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				m_step = 0;
+				next_step();
+			}
+
+	private :
+		struct subscriber_t
+			{
+				a_test_t & m_self;
+				predicate_t m_pred;
+
+				template< std::size_t I >
+				void
+				apply()
+					{
+						auto self = &m_self;
+						if( m_pred( I ) )
+							self->so_subscribe( self->m_mbox ).template event<
+									msg_signal< I > >( [self] {
+										++self->m_received[ I ];
+									} );
+					}
+			};
+
+		struct unsubscriber_t
+			{
+				a_test_t & m_self;
+				predicate_t m_pred;
+
+				template< std::size_t I >
+				void
+				apply()
+					{
+						if( m_pred( I ) )
+							m_self.so_drop_subscription< msg_signal< I > >(
+									m_self.m_mbox );
+					}
+			};
+
+		struct sender_t
+			{
+				a_test_t & m_self;
+
+				template< std::size_t I >
+				void
+				apply()
+					{
+						so_5::send< msg_signal< I > >( m_self.m_mbox );
+					}
+			};
+
+		const so_5::mbox_t m_mbox;
+
+		std::array< unsigned int, msg_types > m_received;
+
+		//! Which message types are expected to be received on this step.
+		predicate_t m_expected;
+
+		unsigned int m_step{ 0 };
+
+		void
+		subscribe( predicate_t pred )
+			{
+				subscriber_t f{ *this, std::move(pred) };
+				for_each_type<>::call( f );
+			}
+
+		void
+		unsubscribe( predicate_t pred )
+			{
+				unsubscriber_t f{ *this, std::move(pred) };
+				for_each_type<>::call( f );
+			}
+
+		void
+		send_all_and_check( predicate_t expected )
+			{
+				m_received.fill( 0u );
+				m_expected = std::move(expected);
+
+				sender_t f{ *this };
+				for_each_type<>::call( f );
+
+				so_5::send< check >( *this );
+			}
+
+		void
+		on_check()
+			{
+				for( std::size_t i = 0; i != msg_types; ++i )
+					{
+						const unsigned int expected = m_expected( i ) ? 1u : 0u;
+						if( expected != m_received[ i ] )
+							{
+								std::cerr << "step: " << m_step << ", type: " << i
+										<< ", expected: " << expected
+										<< ", received: " << m_received[ i ]
+										<< std::endl;
+								std::abort();
+							}
+					}
+
+				++m_step;
+				next_step();
+			}
+
+		void
+		next_step()
+			{
+				switch( m_step )
+					{
+					case 0 :
+						subscribe( []( std::size_t ) { return true; } );
+						send_all_and_check( []( std::size_t ) { return true; } );
+					break;
+
+					case 1 :
+						unsubscribe( []( std::size_t i ) { return 0 != i % 2; } );
+						send_all_and_check(
+								[]( std::size_t i ) { return 0 == i % 2; } );
+					break;
+
+					case 2 :
+						subscribe( []( std::size_t i ) { return 0 != i % 2; } );
+						unsubscribe( []( std::size_t i ) { return 0 == i % 3; } );
+						send_all_and_check(
+								[]( std::size_t i ) { return 0 != i % 3; } );
+					break;
+
+					case 3 :
+						unsubscribe( []( std::size_t i ) { return i > 2; } );
+						send_all_and_check( []( std::size_t i ) {
+								return 0 != i % 3 && i <= 2;
+							} );
+					break;
+
+					case 4 :
+						subscribe( []( std::size_t i ) { return i > 10; } );
+						send_all_and_check( []( std::size_t i ) {
+								return i > 10 || ( 0 != i % 3 && i <= 2 );
+							} );
+					break;
+
+					default :
+						so_deregister_agent_coop_normally();
+					}
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop( so_5::autoname,
+								env.make_agent< a_test_t >() );
+					} );
+			},
+			20,
+			"many_msg_types" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
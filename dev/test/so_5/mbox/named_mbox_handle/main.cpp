@@ -0,0 +1,120 @@
+/*
+ * A test for creation of named mboxes by name handles.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+const std::size_t name_count = 1000;
+const std::size_t thread_count = 4;
+
+std::vector< so_5::mbox_name_handle_t >
+make_names()
+	{
+		std::vector< so_5::mbox_name_handle_t > result;
+		result.reserve( name_count );
+		for( std::size_t i = 0; i != name_count; ++i )
+			result.emplace_back( "mbox_" + std::to_string( i ) );
+
+		return result;
+	}
+
+void
+check_same_mboxes(
+	so_5::environment_t & env,
+	const std::vector< so_5::mbox_name_handle_t > & names )
+	{
+		for( const auto & n : names )
+			{
+				auto m1 = env.create_mbox( n );
+				auto m2 = env.create_mbox( n.query_name() );
+				auto m3 = env.create_mbox( so_5::mbox_name_handle_t{ n.query_name() } );
+
+				ensure_or_die( m1->id() == m2->id(),
+						"mboxes from handle and from string must be the same" );
+				ensure_or_die( m1->id() == m3->id(),
+						"mboxes from different handles must be the same" );
+				ensure_or_die( n.query_name() == m1->query_name(),
+						"unexpected mbox name" );
+			}
+	}
+
+void
+check_concurrent_creation(
+	so_5::environment_t & env,
+	const std::vector< so_5::mbox_name_handle_t > & names )
+	{
+		std::vector< std::vector< so_5::mbox_t > > mboxes( thread_count );
+
+		std::vector< std::thread > threads;
+		for( std::size_t t = 0; t != thread_count; ++t )
+			threads.emplace_back( [&env, &names, &mboxes, t] {
+					// Every thread goes through the names in its own order.
+					// Strides must be coprime with name_count.
+					const std::size_t strides[ thread_count ] = { 1, 3, 7, 9 };
+
+					auto & dest = mboxes[ t ];
+					dest.resize( names.size() );
+					for( std::size_t i = 0; i != names.size(); ++i )
+						{
+							const auto index = (i * strides[ t ]) % names.size();
+							dest[ index ] = env.create_mbox( names[ index ] );
+						}
+				} );
+
+		for( auto & t : threads )
+			t.join();
+
+		for( std::size_t i = 0; i != names.size(); ++i )
+			for( std::size_t t = 1; t != thread_count; ++t )
+				ensure_or_die( mboxes[ 0 ][ i ]->id() == mboxes[ t ][ i ]->id(),
+						"all threads must receive the same mbox" );
+
+		// Mboxes must be destroyed after the release of all references.
+		std::vector< so_5::mbox_id_t > ids;
+		for( const auto & m : mboxes[ 0 ] )
+			ids.push_back( m->id() );
+
+		mboxes.clear();
+
+		for( std::size_t i = 0; i != names.size(); ++i )
+			ensure_or_die( ids[ i ] != env.create_mbox( names[ i ] )->id(),
+					"a new mbox must be created for the released name" );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						const auto names = make_names();
+
+						check_same_mboxes( env, names );
+						check_concurrent_creation( env, names );
+
+						env.stop();
+					} );
+			},
+			20,
+			"named mbox handles" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
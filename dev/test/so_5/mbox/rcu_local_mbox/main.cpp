@@ -0,0 +1,286 @@
+/*
+ * A test for local mbox with read-copy-update synchronization.
+ */
+
+#include <iostream>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct msg final : public so_5::message_t
+	{
+		unsigned int m_value;
+
+		msg( unsigned int value ) : m_value{ value }
+			{}
+	};
+
+struct other final : public so_5::signal_t {};
+
+struct get_value final : public so_5::message_t
+	{
+		unsigned int m_value;
+
+		get_value( unsigned int value ) : m_value{ value }
+			{}
+	};
+
+struct done final : public so_5::signal_t {};
+struct next_turn final : public so_5::signal_t {};
+
+const so_5::mbox_params_t rcu_params =
+		so_5::mbox_params_t{}.sync( so_5::local_mbox_sync_t::rcu );
+
+//
+// Simple delivery.
+//
+
+const unsigned int simple_msg_count = 100;
+
+class a_simple_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_simple_receiver_t(
+			context_t ctx,
+			const so_5::mbox_t & mbox,
+			bool only_even )
+			:	so_5::agent_t( ctx )
+			,	m_only_even( only_even )
+			{
+				if( only_even )
+					so_set_delivery_filter( mbox, []( const msg & m ) {
+							return 0 == m.m_value % 2;
+						} );
+
+				so_subscribe( mbox )
+					.event( &a_simple_receiver_t::on_msg )
+					.event< done >( &a_simple_receiver_t::on_done );
+			}
+
+	private :
+		const bool m_only_even;
+		unsigned int m_received{ 0 };
+
+		void
+		on_msg( const msg & )
+			{
+				++m_received;
+			}
+
+		void
+		on_done()
+			{
+				const auto expected = m_only_even ?
+						simple_msg_count / 2 : simple_msg_count;
+				ensure_or_die( expected == m_received,
+						"unexpected count of received messages" );
+			}
+	};
+
+class a_service_t final : public so_5::agent_t
+	{
+	public :
+		a_service_t( context_t ctx, const so_5::mbox_t & mbox )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe( mbox ).event( []( const get_value & m ) {
+						return m.m_value * 2;
+					} );
+			}
+	};
+
+class a_simple_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_simple_sender_t( context_t ctx, so_5::mbox_t mbox )
+			:	so_5::agent_t( ctx )
+			,	m_mbox( std::move(mbox) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != simple_msg_count; ++i )
+					so_5::send< msg >( m_mbox, i );
+				so_5::send< done >( m_mbox );
+
+				const auto r = so_5::request_value< unsigned int, get_value >(
+						m_mbox, so_5::infinite_wait, 21u );
+				ensure_or_die( 42u == r, "unexpected result of service request" );
+
+				so_deregister_agent_coop_normally();
+			}
+
+	private :
+		const so_5::mbox_t m_mbox;
+	};
+
+void
+simple_delivery()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop( [&env]( so_5::coop_t & coop ) {
+						auto mbox = env.create_mbox( "shared", rcu_params );
+
+						coop.make_agent< a_simple_receiver_t >( mbox, false );
+						coop.make_agent< a_simple_receiver_t >( mbox, true );
+
+						coop.make_agent_with_binder< a_service_t >(
+								so_5::disp::one_thread::create_private_disp( env )
+										->binder(),
+								mbox );
+
+						coop.make_agent_with_binder< a_simple_sender_t >(
+								so_5::disp::one_thread::create_private_disp( env )
+										->binder(),
+								mbox );
+					} );
+			} );
+	}
+
+//
+// Concurrent delivery and change of subscriptions.
+//
+
+const unsigned int senders = 4;
+const unsigned int receivers = 2;
+const unsigned int messages_per_sender = 10000;
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t(
+			context_t ctx,
+			const so_5::mbox_t & mbox,
+			so_5::mbox_t collector )
+			:	so_5::agent_t( ctx )
+			,	m_collector( std::move(collector) )
+			{
+				so_subscribe( mbox ).event( &a_receiver_t::on_msg );
+			}
+
+	private :
+		const so_5::mbox_t m_collector;
+		unsigned int m_received{ 0 };
+
+		void
+		on_msg( const msg & )
+			{
+				if( senders * messages_per_sender == ++m_received )
+					so_5::send< done >( m_collector );
+			}
+	};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t( context_t ctx, so_5::mbox_t mbox )
+			:	so_5::agent_t( ctx )
+			,	m_mbox( std::move(mbox) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != messages_per_sender; ++i )
+					so_5::send< msg >( m_mbox, i );
+			}
+
+	private :
+		const so_5::mbox_t m_mbox;
+	};
+
+// Changes subscriptions to the mbox until the end of the test.
+class a_churner_t final : public so_5::agent_t
+	{
+	public :
+		a_churner_t( context_t ctx, so_5::mbox_t mbox )
+			:	so_5::agent_t( ctx )
+			,	m_mbox( std::move(mbox) )
+			{
+				so_subscribe_self().event< next_turn >(
+						&a_churner_t::on_next_turn );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< next_turn >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_mbox;
+		bool m_subscribed{ false };
+
+		void
+		on_next_turn()
+			{
+				if( m_subscribed )
+					so_drop_subscription< other >( m_mbox );
+				else
+					so_subscribe( m_mbox ).event< other >( [] {} );
+
+				m_subscribed = !m_subscribed;
+
+				so_5::send< next_turn >( *this );
+			}
+	};
+
+class a_collector_t final : public so_5::agent_t
+	{
+	public :
+		a_collector_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe_self().event< done >( [this] {
+						if( receivers == ++m_done )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+	private :
+		unsigned int m_done{ 0 };
+	};
+
+void
+concurrent_delivery()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					[&env]( so_5::coop_t & coop ) {
+						auto mbox = env.create_mbox( rcu_params );
+
+						auto collector = coop.make_agent< a_collector_t >();
+
+						for( unsigned int i = 0; i != receivers; ++i )
+							coop.make_agent< a_receiver_t >(
+									mbox, collector->so_direct_mbox() );
+
+						coop.make_agent< a_churner_t >( mbox );
+
+						for( unsigned int i = 0; i != senders; ++i )
+							coop.make_agent< a_sender_t >( mbox );
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( simple_delivery, 20, "simple_delivery" );
+		run_with_time_limit( concurrent_delivery, 60, "concurrent_delivery" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
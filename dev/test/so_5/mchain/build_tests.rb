@@ -15,12 +15,15 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/limited_app_abort/prj.ut.rb" )
 	required_prj( "#{path}/adv_receive/prj.ut.rb" )
 	required_prj( "#{path}/adv_prepared_receive/prj.ut.rb" )
+	required_prj( "#{path}/receive_batch/prj.ut.rb" )
 	required_prj( "#{path}/not_empty_notify/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive_close/prj.ut.rb" )
+	required_prj( "#{path}/lock_free/prj.ut.rb" )
 
 	required_prj( "#{path}/select_simple/prj.ut.rb" )
 	required_prj( "#{path}/prepared_select_simple/prj.ut.rb" )
+	required_prj( "#{path}/select_set/prj.ut.rb" )
 	required_prj( "#{path}/select_simple_close/prj.ut.rb" )
 	required_prj( "#{path}/select_count_messages/prj.ut.rb" )
 	required_prj( "#{path}/select_mthread_close/prj.ut.rb" )
@@ -0,0 +1,264 @@
+/*
+ * Test for specific features of lock-free mchains.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+namespace props = so_5::mchain_props;
+
+void
+do_check_creation_error(
+	so_5::environment_t & env,
+	const char * case_name,
+	const so_5::mchain_params_t & params,
+	int expected_error )
+{
+	cout << case_name << ": " << std::flush;
+
+	try
+	{
+		env.create_mchain( params );
+		ensure_or_die( false, "An exception must be throw before this line!" );
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		UT_CHECK_CONDITION( expected_error == ex.error_code() );
+	}
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_creation_errors( so_5::environment_t & env )
+{
+	do_check_creation_error( env, "unlimited mpmc",
+			so_5::make_unlimited_mchain_params()
+				.synchronization( props::synchronization_t::lock_free_mpmc ),
+			so_5::rc_lock_free_mchain_must_be_size_limited );
+
+	do_check_creation_error( env, "unlimited spsc",
+			so_5::make_unlimited_mchain_params()
+				.synchronization( props::synchronization_t::lock_free_spsc ),
+			so_5::rc_lock_free_mchain_must_be_size_limited );
+
+	do_check_creation_error( env, "spsc with remove_oldest",
+			so_5::make_limited_without_waiting_mchain_params(
+					3,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::remove_oldest )
+				.synchronization( props::synchronization_t::lock_free_spsc ),
+			so_5::rc_remove_oldest_not_supported_by_spsc_mchain );
+}
+
+void
+do_check_remove_oldest( so_5::environment_t & env )
+{
+	cout << "remove_oldest: " << std::flush;
+
+	auto ch = env.create_mchain(
+			so_5::make_limited_without_waiting_mchain_params(
+					3,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::remove_oldest )
+			.synchronization( props::synchronization_t::lock_free_mpmc ) );
+
+	so_5::send< int >( ch, 1 );
+	so_5::send< int >( ch, 2 );
+	so_5::send< int >( ch, 3 );
+	so_5::send< int >( ch, 4 );
+
+	UT_CHECK_CONDITION( 3u == ch->size() );
+
+	int expected = 2;
+	receive( from(ch).handle_n(4).empty_timeout(so_5::no_wait),
+			[&expected]( int i ) { UT_CHECK_CONDITION( expected++ == i ); } );
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_throw_exception(
+	so_5::environment_t & env,
+	props::synchronization_t synchronization )
+{
+	cout << "throw_exception: " << std::flush;
+
+	auto ch = env.create_mchain(
+			so_5::make_limited_with_waiting_mchain_params(
+					2,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					milliseconds(100) )
+			.synchronization( synchronization ) );
+
+	so_5::send< int >( ch, 1 );
+	so_5::send< int >( ch, 2 );
+	try
+	{
+		so_5::send< int >( ch, 3 );
+		ensure_or_die( false, "An exception must be throw before this line!" );
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		UT_CHECK_CONDITION( so_5::rc_msg_chain_overflow == ex.error_code() );
+	}
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_spsc_drop_content( so_5::environment_t & env )
+{
+	cout << "spsc close with drop_content: " << std::flush;
+
+	auto ch = env.create_mchain(
+			so_5::make_limited_without_waiting_mchain_params(
+					3,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::drop_newest )
+			.synchronization( props::synchronization_t::lock_free_spsc ) );
+
+	so_5::send< int >( ch, 1 );
+	so_5::send< int >( ch, 2 );
+
+	thread closer{ [&ch] { close_drop_content( ch ); } };
+	closer.join();
+
+	UT_CHECK_CONDITION( ch->empty() );
+
+	auto r = receive( from(ch).empty_timeout(so_5::no_wait),
+			[]( int ) { ensure_or_die( false, "no messages expected" ); } );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+	UT_CHECK_CONDITION( so_5::mchain_props::extraction_status_t::chain_closed ==
+			r.status() );
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_one_producer_and_consumer( so_5::environment_t & env )
+{
+	cout << "one producer and one consumer: " << std::flush;
+
+	const int MESSAGES = 100000;
+
+	auto ch = env.create_mchain(
+			so_5::make_limited_with_waiting_mchain_params(
+					16,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					seconds(5) )
+			.synchronization( props::synchronization_t::lock_free_spsc ) );
+
+	int expected = 1;
+	thread consumer{ [&] {
+			receive( from(ch),
+					[&expected]( int v ) {
+						ensure_or_die( expected == v, "messages must be ordered" );
+						++expected;
+					} );
+		} };
+
+	for( int v = 1; v <= MESSAGES; ++v )
+		so_5::send< int >( ch, v );
+
+	close_retain_content( ch );
+	consumer.join();
+
+	UT_CHECK_CONDITION( MESSAGES + 1 == expected );
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_many_producers_and_consumers( so_5::environment_t & env )
+{
+	cout << "many producers and consumers: " << std::flush;
+
+	const int THREADS_COUNT = 4;
+	const int MESSAGES_PER_PRODUCER = 20000;
+
+	// Producers must wait for free space, no messages must be lost.
+	auto ch = env.create_mchain(
+			so_5::make_limited_with_waiting_mchain_params(
+					16,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					seconds(5) )
+			.synchronization( props::synchronization_t::lock_free_mpmc ) );
+
+	atomic< long long > sum{ 0 };
+	atomic< int > received{ 0 };
+
+	vector< thread > consumers;
+	for( int i = 0; i != THREADS_COUNT; ++i )
+		consumers.emplace_back( [&] {
+				long long local_sum = 0;
+				int local_received = 0;
+				receive( from(ch),
+						[&]( int v ) { local_sum += v; ++local_received; } );
+				sum += local_sum;
+				received += local_received;
+			} );
+
+	vector< thread > producers;
+	for( int i = 0; i != THREADS_COUNT; ++i )
+		producers.emplace_back( [&ch] {
+				for( int v = 1; v <= MESSAGES_PER_PRODUCER; ++v )
+					so_5::send< int >( ch, v );
+			} );
+
+	for( auto & t : producers )
+		t.join();
+
+	close_retain_content( ch );
+
+	for( auto & t : consumers )
+		t.join();
+
+	const long long expected_sum =
+			static_cast< long long >( THREADS_COUNT ) *
+			MESSAGES_PER_PRODUCER * (MESSAGES_PER_PRODUCER + 1) / 2;
+
+	UT_CHECK_CONDITION( THREADS_COUNT * MESSAGES_PER_PRODUCER == received );
+	UT_CHECK_CONDITION( expected_sum == sum );
+
+	cout << "OK" << std::endl;
+}
+
+UT_UNIT_TEST( test_lock_free_mchain )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			do_check_creation_errors( env.environment() );
+			do_check_remove_oldest( env.environment() );
+			do_check_throw_exception( env.environment(),
+					props::synchronization_t::lock_free_mpmc );
+			do_check_throw_exception( env.environment(),
+					props::synchronization_t::lock_free_spsc );
+			do_check_many_producers_and_consumers( env.environment() );
+			do_check_spsc_drop_content( env.environment() );
+			do_check_one_producer_and_consumer( env.environment() );
+		},
+		20,
+		"test_lock_free_mchain" );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_lock_free_mchain )
+
+	return 0;
+}
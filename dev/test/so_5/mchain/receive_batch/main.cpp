@@ -0,0 +1,185 @@
+/*
+ * A test for receive of a batch of messages.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include "../mchain_params.hpp"
+
+using namespace std;
+using namespace chrono;
+
+namespace props = so_5::mchain_props;
+
+void
+do_check_partial_batches( const so_5::mchain_t & chain )
+{
+	so_5::send< int >( chain, 0 );
+	so_5::send< int >( chain, 1 );
+	so_5::send< string >( chain, "hello!" );
+
+	props::demand_t buffer[ 2 ];
+
+	int expected = 0;
+	auto r = so_5::receive_batch( chain, so_5::no_wait, buffer,
+			[&expected]( int v ) { UT_CHECK_CONDITION( expected++ == v ); } );
+
+	UT_CHECK_CONDITION( 2 == r.extracted() );
+	UT_CHECK_CONDITION( 2 == r.handled() );
+	UT_CHECK_CONDITION( props::extraction_status_t::msg_extracted == r.status() );
+
+	// Messages must not be held in the buffer.
+	UT_CHECK_CONDITION( !buffer[ 0 ].m_message_ref );
+	UT_CHECK_CONDITION( !buffer[ 1 ].m_message_ref );
+
+	r = so_5::receive_batch( chain, so_5::no_wait, buffer,
+			[]( int ) {} );
+
+	UT_CHECK_CONDITION( 1 == r.extracted() );
+	UT_CHECK_CONDITION( 0 == r.handled() );
+
+	r = so_5::receive_batch( chain, milliseconds(100), buffer,
+			[]( int ) {} );
+
+	UT_CHECK_CONDITION( 0 == r.extracted() );
+	UT_CHECK_CONDITION( props::extraction_status_t::no_messages == r.status() );
+
+	close_retain_content( chain );
+
+	r = so_5::receive_batch( chain, so_5::infinite_wait, buffer,
+			[]( int ) {} );
+
+	UT_CHECK_CONDITION( 0 == r.extracted() );
+	UT_CHECK_CONDITION( props::extraction_status_t::chain_closed == r.status() );
+}
+
+UT_UNIT_TEST( test_partial_batches )
+{
+	auto params = build_mchain_params();
+	for( const auto & p : params )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_check_partial_batches(
+						env.environment().create_mchain( p.second ) );
+			},
+			20,
+			"test_partial_batches: " + p.first );
+	}
+}
+
+void
+do_check_exception_from_handler( const so_5::mchain_t & chain )
+{
+	so_5::send< int >( chain, 0 );
+	so_5::send< int >( chain, 1 );
+
+	vector< props::demand_t > buffer( 4 );
+
+	try
+	{
+		so_5::receive_batch( chain, so_5::no_wait, buffer,
+				[]( int ) { throw runtime_error( "handler failure" ); } );
+		ensure_or_die( false, "An exception must be throw before this line!" );
+	}
+	catch( const runtime_error & )
+	{}
+
+	for( const auto & d : buffer )
+		UT_CHECK_CONDITION( !d.m_message_ref );
+
+	UT_CHECK_CONDITION( chain->empty() );
+}
+
+UT_UNIT_TEST( test_exception_from_handler )
+{
+	auto params = build_mchain_params();
+	for( const auto & p : params )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_check_exception_from_handler(
+						env.environment().create_mchain( p.second ) );
+			},
+			20,
+			"test_exception_from_handler: " + p.first );
+	}
+}
+
+void
+do_check_consumer_thread( const so_5::mchain_t & chain )
+{
+	const int MESSAGES = 10000;
+
+	int received = 0;
+	std::thread child{ [&] {
+		vector< props::demand_t > buffer( 16 );
+		for(;;)
+		{
+			auto r = so_5::receive_batch( chain, so_5::infinite_wait, buffer,
+					[&received]( int v ) {
+						ensure_or_die( received++ == v, "messages must be ordered" );
+					} );
+			if( props::extraction_status_t::chain_closed == r.status() )
+				break;
+		}
+	} };
+
+	for( int i = 0; i != MESSAGES; ++i )
+	{
+		// Size-limited chains can drop new messages if they are full.
+		while( chain->size() >= 5u )
+			this_thread::yield();
+		so_5::send< int >( chain, i );
+	}
+
+	close_retain_content( chain );
+	child.join();
+
+	UT_CHECK_CONDITION( MESSAGES == received );
+}
+
+UT_UNIT_TEST( test_consumer_thread )
+{
+	auto params = build_mchain_params();
+	for( const auto & p : params )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_check_consumer_thread(
+						env.environment().create_mchain( p.second ) );
+			},
+			20,
+			"test_consumer_thread: " + p.first );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_partial_batches )
+	UT_RUN_UNIT_TEST( test_exception_from_handler )
+	UT_RUN_UNIT_TEST( test_consumer_thread )
+
+	return 0;
+}
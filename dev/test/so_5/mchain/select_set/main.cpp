@@ -0,0 +1,263 @@
+/*
+ * A test for select on persistent mchain_set.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include "../mchain_params.hpp"
+
+using namespace std;
+using namespace chrono;
+
+namespace props = so_5::mchain_props;
+
+void
+do_check_many_chains(
+	so_5::environment_t & env,
+	const so_5::mchain_params_t & params )
+{
+	const int CHAINS = 100;
+
+	vector< so_5::mchain_t > chains;
+	so_5::mchain_set_t set;
+
+	int sum = 0;
+	for( int i = 0; i != CHAINS; ++i )
+	{
+		chains.push_back( env.create_mchain( params ) );
+		set.add( so_5::case_( chains.back(),
+				[&sum]( int v ) { sum += v; } ) );
+	}
+
+	UT_CHECK_CONDITION( static_cast< size_t >(CHAINS) == set.size() );
+
+	// Nothing to receive.
+	auto r = so_5::select( so_5::from_all().empty_timeout( so_5::no_wait ), set );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+	UT_CHECK_CONDITION( props::extraction_status_t::no_messages == r.status() );
+
+	for( int round = 1; round != 10; ++round )
+	{
+		so_5::send< int >( chains[ round * 7 ], round );
+		so_5::send< int >( chains[ round * 3 ], round );
+
+		r = so_5::select(
+				so_5::from_all().handle_n( 2 ).empty_timeout( milliseconds(100) ),
+				set );
+		UT_CHECK_CONDITION( 2u == r.handled() );
+	}
+
+	UT_CHECK_CONDITION( 2 * (1+2+3+4+5+6+7+8+9) == sum );
+
+	// A message sent from another thread must wake up select.
+	thread sender{ [&chains] {
+			this_thread::sleep_for( milliseconds(50) );
+			so_5::send< int >( chains[ 42 ], 1000 );
+		} };
+
+	r = so_5::select( so_5::from_all().handle_n( 1 ), set );
+	sender.join();
+
+	UT_CHECK_CONDITION( 1u == r.handled() );
+	UT_CHECK_CONDITION( 2 * (1+2+3+4+5+6+7+8+9) + 1000 == sum );
+}
+
+void
+do_check_leftovers(
+	so_5::environment_t & env,
+	const so_5::mchain_params_t & params )
+{
+	auto ch1 = env.create_mchain( params );
+	auto ch2 = env.create_mchain( params );
+	auto ch3 = env.create_mchain( params );
+
+	int received = 0;
+	so_5::mchain_set_t set{
+			so_5::case_( ch1, [&received]( int ) { ++received; } ),
+			so_5::case_( ch2, [&received]( int ) { ++received; } ),
+			so_5::case_( ch3, [&received]( int ) { ++received; } ) };
+
+	so_5::send< int >( ch1, 1 );
+	so_5::send< int >( ch2, 2 );
+	so_5::send< int >( ch3, 3 );
+
+	// Only one message is handled by every select. Other ready mchains
+	// must not be lost.
+	for( int i = 1; i <= 3; ++i )
+	{
+		auto r = so_5::select(
+				so_5::from_all().handle_n( 1 ).empty_timeout( so_5::no_wait ),
+				set );
+		UT_CHECK_CONDITION( 1u == r.handled() );
+		UT_CHECK_CONDITION( i == received );
+	}
+
+	auto r = so_5::select(
+			so_5::from_all().handle_n( 1 ).empty_timeout( so_5::no_wait ),
+			set );
+	UT_CHECK_CONDITION( 0u == r.handled() );
+}
+
+void
+do_check_add_remove(
+	so_5::environment_t & env,
+	const so_5::mchain_params_t & params )
+{
+	auto ch1 = env.create_mchain( params );
+	auto ch2 = env.create_mchain( params );
+
+	int received = 0;
+	so_5::mchain_set_t set{
+			so_5::case_( ch1, [&received]( int v ) { received = v; } ) };
+
+	so_5::send< int >( ch1, 1 );
+	so_5::send< int >( ch2, 2 );
+
+	auto r = so_5::select( so_5::from_all().empty_timeout( so_5::no_wait ), set );
+	UT_CHECK_CONDITION( 1u == r.handled() );
+	UT_CHECK_CONDITION( 1 == received );
+
+	set.add( so_5::case_( ch2, [&received]( int v ) { received = v; } ) );
+	UT_CHECK_CONDITION( 2u == set.size() );
+
+	r = so_5::select( so_5::from_all().empty_timeout( so_5::no_wait ), set );
+	UT_CHECK_CONDITION( 1u == r.handled() );
+	UT_CHECK_CONDITION( 2 == received );
+
+	// Removed mchain must not be handled by select.
+	so_5::send< int >( ch1, 3 );
+	set.remove( ch1 );
+	UT_CHECK_CONDITION( 1u == set.size() );
+
+	r = so_5::select( so_5::from_all().empty_timeout( so_5::no_wait ), set );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+	UT_CHECK_CONDITION( 1u == ch1->size() );
+
+	set.remove( ch2 );
+	UT_CHECK_CONDITION( set.empty() );
+
+	// Remove of unknown mchain does nothing.
+	set.remove( ch2 );
+	UT_CHECK_CONDITION( set.empty() );
+}
+
+void
+do_check_closed_chains(
+	so_5::environment_t & env,
+	const so_5::mchain_params_t & params )
+{
+	auto ch1 = env.create_mchain( params );
+	auto ch2 = env.create_mchain( params );
+
+	int closed = 0;
+	const auto select_params = so_5::from_all()
+			.empty_timeout( milliseconds(100) )
+			.on_close( [&closed]( const so_5::mchain_t & ) { ++closed; } );
+
+	so_5::mchain_set_t set{
+			so_5::case_( ch1, []( int ) {} ),
+			so_5::case_( ch2, []( int ) {} ) };
+
+	close_retain_content( ch1 );
+
+	auto r = so_5::select( select_params, set );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+	UT_CHECK_CONDITION( props::extraction_status_t::no_messages == r.status() );
+	UT_CHECK_CONDITION( 1 == closed );
+
+	close_retain_content( ch2 );
+
+	r = so_5::select( select_params, set );
+	UT_CHECK_CONDITION( props::extraction_status_t::chain_closed == r.status() );
+	UT_CHECK_CONDITION( 2 == closed );
+
+	// All mchains are closed, select must return immediately
+	// even with infinite wait.
+	r = so_5::select( so_5::from_all(), set );
+	UT_CHECK_CONDITION( props::extraction_status_t::chain_closed == r.status() );
+	UT_CHECK_CONDITION( 2 == closed );
+
+	// Closed mchain can be removed and another one can be added.
+	set.remove( ch1 );
+	auto ch3 = env.create_mchain( params );
+	int received = 0;
+	set.add( so_5::case_( ch3, [&received]( int v ) { received = v; } ) );
+
+	so_5::send< int >( ch3, 3 );
+	r = so_5::select( so_5::from_all().handle_n( 1 ), set );
+	UT_CHECK_CONDITION( 1u == r.handled() );
+	UT_CHECK_CONDITION( 3 == received );
+}
+
+void
+do_check_exception_from_handler(
+	so_5::environment_t & env,
+	const so_5::mchain_params_t & params )
+{
+	auto ch1 = env.create_mchain( params );
+	auto ch2 = env.create_mchain( params );
+
+	int received = 0;
+	so_5::mchain_set_t set{
+			so_5::case_( ch1,
+					[]( int ) { throw runtime_error( "handler failure" ); } ),
+			so_5::case_( ch2, [&received]( int ) { ++received; } ) };
+
+	so_5::send< int >( ch2, 1 );
+	so_5::send< int >( ch1, 1 );
+	so_5::send< int >( ch2, 2 );
+
+	int failures = 0;
+	for( int i = 0; i != 3; ++i )
+	{
+		try
+		{
+			so_5::select(
+					so_5::from_all().handle_n( 1 ).empty_timeout( so_5::no_wait ),
+					set );
+		}
+		catch( const runtime_error & )
+		{
+			++failures;
+		}
+	}
+
+	UT_CHECK_CONDITION( 1 == failures );
+	UT_CHECK_CONDITION( 2 == received );
+}
+
+UT_UNIT_TEST( test_select_set )
+{
+	auto params = build_mchain_params();
+	for( const auto & p : params )
+	{
+		cout << "=== " << p.first << " ===" << endl;
+
+		run_with_time_limit(
+			[&p]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_check_many_chains( env.environment(), p.second );
+				do_check_leftovers( env.environment(), p.second );
+				do_check_add_remove( env.environment(), p.second );
+				do_check_closed_chains( env.environment(), p.second );
+				do_check_exception_from_handler( env.environment(), p.second );
+			},
+			20,
+			"test_select_set: " + p.first );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_select_set )
+
+	return 0;
+}
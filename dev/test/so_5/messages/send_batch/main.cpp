@@ -0,0 +1,216 @@
+/*
+ * A test for sending a batch of messages by one call.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct item
+	{
+		unsigned int m_value;
+	};
+
+struct classical_msg final : public so_5::message_t
+	{
+		unsigned int m_value;
+
+		classical_msg( unsigned int value ) : m_value{ value }
+			{}
+	};
+
+struct finish final : public so_5::signal_t {};
+
+const unsigned int batch_size = 100;
+const unsigned int limit = 10;
+
+class a_ordered_t final : public so_5::agent_t
+	{
+	public :
+		a_ordered_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe_self()
+					.event( &a_ordered_t::on_item )
+					.event( &a_ordered_t::on_classical )
+					.event< finish >( &a_ordered_t::on_finish );
+			}
+
+	private :
+		unsigned int m_items{ 0 };
+		unsigned int m_classicals{ 0 };
+
+		void
+		on_item( mhood_t< item > cmd )
+			{
+				ensure_or_die( m_items++ == cmd->m_value,
+						"items must be received in the original order" );
+			}
+
+		void
+		on_classical( mhood_t< classical_msg > cmd )
+			{
+				ensure_or_die( m_classicals++ == cmd->m_value,
+						"messages must be received in the original order" );
+			}
+
+		void
+		on_finish()
+			{
+				ensure_or_die( batch_size == m_items,
+						"all items must be received" );
+				ensure_or_die( batch_size == m_classicals,
+						"all messages must be received" );
+			}
+	};
+
+class a_limited_t final : public so_5::agent_t
+	{
+	public :
+		a_limited_t( context_t ctx, const so_5::mbox_t & shared )
+			:	so_5::agent_t( ctx
+					+ limit_then_drop< item >( limit )
+					+ limit_then_drop< finish >( 1 ) )
+			{
+				so_subscribe( shared )
+					.event( &a_limited_t::on_item )
+					.event< finish >( &a_limited_t::on_finish );
+			}
+
+	private :
+		unsigned int m_items{ 0 };
+
+		void
+		on_item( mhood_t< item > cmd )
+			{
+				ensure_or_die( m_items++ == cmd->m_value,
+						"items must be received in the original order" );
+			}
+
+		void
+		on_finish()
+			{
+				ensure_or_die( limit == m_items,
+						"extra items must be dropped by message limit" );
+			}
+	};
+
+class a_filtered_t final : public so_5::agent_t
+	{
+	public :
+		a_filtered_t( context_t ctx, const so_5::mbox_t & shared )
+			:	so_5::agent_t( ctx )
+			{
+				so_set_delivery_filter( shared, []( const item & msg ) {
+						return 0 == msg.m_value % 2;
+					} );
+
+				so_subscribe( shared )
+					.event( &a_filtered_t::on_item )
+					.event< finish >( &a_filtered_t::on_finish );
+			}
+
+	private :
+		unsigned int m_items{ 0 };
+
+		void
+		on_item( mhood_t< item > cmd )
+			{
+				ensure_or_die( m_items * 2 == cmd->m_value,
+						"only even items must be received" );
+				++m_items;
+			}
+
+		void
+		on_finish()
+			{
+				ensure_or_die( batch_size / 2 == m_items,
+						"odd items must be rejected by delivery filter" );
+			}
+	};
+
+struct shutdown final : public so_5::signal_t {};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t(
+			context_t ctx,
+			so_5::mbox_t ordered,
+			so_5::mbox_t shared )
+			:	so_5::agent_t( ctx )
+			,	m_ordered( std::move(ordered) )
+			,	m_shared( std::move(shared) )
+			{
+				so_subscribe_self().event< shutdown >( [this] {
+						so_environment().stop();
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				std::vector< item > items;
+				std::vector< unsigned int > values;
+				for( unsigned int i = 0; i != batch_size; ++i )
+					{
+						items.push_back( item{ i } );
+						values.push_back( i );
+					}
+
+				// All agents work on the same thread. Because of that
+				// all messages will be in event queue before processing
+				// of the first one.
+				so_5::send_batch< item >( m_ordered, items );
+				so_5::send_batch< classical_msg >(
+						m_ordered, values.begin(), values.end() );
+				so_5::send_batch< item >( m_shared, items.begin(), items.end() );
+
+				// An empty batch must be ignored.
+				so_5::send_batch< item >( m_shared, std::vector< item >{} );
+
+				so_5::send< finish >( m_ordered );
+				so_5::send< finish >( m_shared );
+				so_5::send< shutdown >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_ordered;
+		const so_5::mbox_t m_shared;
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( [&env]( so_5::coop_t & coop ) {
+							auto shared = env.create_mbox( "shared" );
+
+							auto ordered = coop.make_agent< a_ordered_t >();
+							coop.make_agent< a_limited_t >( shared );
+							coop.make_agent< a_filtered_t >( shared );
+							coop.make_agent< a_sender_t >(
+									ordered->so_direct_mbox(), shared );
+						} );
+					} );
+			},
+			20,
+			"send_batch test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * A test for allocation of messages from the slab.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <atomic>
+#include <array>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct small_user_msg
+	{
+		unsigned int m_value;
+	};
+
+struct big_user_msg
+	{
+		std::array< unsigned int, 128 > m_values;
+	};
+
+namespace so_5
+{
+
+template<>
+struct use_slab_allocation< small_user_msg > : public std::true_type {};
+
+template<>
+struct use_slab_allocation< big_user_msg > : public std::true_type {};
+
+} /* namespace so_5 */
+
+std::atomic< int > g_live_classical_msgs{ 0 };
+
+struct classical_msg final : public so_5::slab_message_t
+	{
+		unsigned int m_value;
+
+		classical_msg( unsigned int value ) : m_value{ value }
+			{
+				++g_live_classical_msgs;
+			}
+
+		~classical_msg() SO_5_NOEXCEPT override
+			{
+				--g_live_classical_msgs;
+			}
+	};
+
+const unsigned int message_count = 10000;
+
+class a_receiver_t : public so_5::agent_t
+	{
+	public :
+		a_receiver_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe_self()
+					.event( &a_receiver_t::on_small )
+					.event( &a_receiver_t::on_big )
+					.event( &a_receiver_t::on_classical );
+			}
+
+	private :
+		unsigned int m_small{ 0 };
+		unsigned int m_big{ 0 };
+		unsigned int m_classical{ 0 };
+
+		static void
+		check( unsigned int expected, unsigned int actual )
+			{
+				if( expected != actual )
+					{
+						std::ostringstream ss;
+						ss << "unexpected value: " << actual
+								<< ", expected: " << expected;
+						throw std::runtime_error( ss.str() );
+					}
+			}
+
+		void
+		on_small( mhood_t< small_user_msg > cmd )
+			{
+				check( m_small++, cmd->m_value );
+				try_finish();
+			}
+
+		void
+		on_big( mhood_t< big_user_msg > cmd )
+			{
+				check( m_big, cmd->m_values.front() );
+				check( m_big, cmd->m_values.back() );
+				++m_big;
+				try_finish();
+			}
+
+		void
+		on_classical( mhood_t< classical_msg > cmd )
+			{
+				check( m_classical++, cmd->m_value );
+				try_finish();
+			}
+
+		void
+		try_finish()
+			{
+				if( message_count == m_small && message_count == m_big &&
+						message_count == m_classical )
+					so_environment().stop();
+			}
+	};
+
+class a_sender_t : public so_5::agent_t
+	{
+	public :
+		a_sender_t( context_t ctx, so_5::mbox_t receiver )
+			:	so_5::agent_t( ctx )
+			,	m_receiver( std::move(receiver) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != message_count; ++i )
+					{
+						so_5::send< small_user_msg >( m_receiver, i );
+
+						big_user_msg big;
+						big.m_values.fill( i );
+						so_5::send< big_user_msg >( m_receiver, big );
+
+						so_5::send< classical_msg >( m_receiver, i );
+					}
+			}
+
+	private :
+		const so_5::mbox_t m_receiver;
+	};
+
+void
+check_block_reuse()
+	{
+		void * first = so_5::message_slab::allocate( 24 );
+		so_5::message_slab::deallocate( first, 24 );
+
+		void * second = so_5::message_slab::allocate( 24 );
+		ensure_or_die( first == second,
+				"a block should be reused by the same thread" );
+		so_5::message_slab::deallocate( second, 24 );
+	}
+
+int
+main()
+{
+	try
+	{
+		check_block_reuse();
+
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( [&env]( so_5::coop_t & coop ) {
+							auto receiver = coop.make_agent< a_receiver_t >();
+							coop.make_agent_with_binder< a_sender_t >(
+									so_5::disp::one_thread::create_private_disp( env )
+											->binder(),
+									receiver->so_direct_mbox() );
+						} );
+					} );
+			},
+			20,
+			"slab allocation test" );
+
+		ensure_or_die( 0 == g_live_classical_msgs.load(),
+				"all classical messages must be destroyed" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
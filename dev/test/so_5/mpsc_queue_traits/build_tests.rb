@@ -7,4 +7,6 @@ MxxRu::Cpp::composite_target {
 
 	required_prj "#{path}/locks/prj.ut.rb"
 	required_prj "#{path}/agent_ring/prj.ut.rb"
+	required_prj "#{path}/lock_free/prj.ut.rb"
+	required_prj "#{path}/lock_free_shutdown/prj.ut.rb"
 }
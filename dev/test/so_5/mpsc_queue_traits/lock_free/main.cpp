@@ -0,0 +1,209 @@
+/*
+ * A test for lock-free mode of demand queues.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using lock_factory_t = so_5::disp::mpsc_queue_traits::lock_factory_t;
+
+const unsigned int producer_count = 8;
+const unsigned int messages_per_producer = 10000;
+
+struct msg_value
+	{
+		unsigned int m_producer;
+		unsigned int m_value;
+	};
+
+class a_consumer_t : public so_5::agent_t
+	{
+	public :
+		a_consumer_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			,	m_expected( producer_count, 0u )
+			{
+				so_subscribe_self().event( &a_consumer_t::on_value );
+			}
+
+	private :
+		std::vector< unsigned int > m_expected;
+		unsigned int m_received{ 0 };
+
+		void
+		on_value( const msg_value & msg )
+			{
+				auto & expected = m_expected[ msg.m_producer ];
+				if( expected != msg.m_value )
+					{
+						std::ostringstream ss;
+						ss << "unexpected value from producer " << msg.m_producer
+								<< ": " << msg.m_value << ", expected: " << expected;
+						throw std::runtime_error( ss.str() );
+					}
+				++expected;
+
+				if( producer_count * messages_per_producer == ++m_received )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+class a_producer_t : public so_5::agent_t
+	{
+	public :
+		a_producer_t(
+			context_t ctx,
+			unsigned int id,
+			so_5::mbox_t consumer )
+			:	so_5::agent_t( ctx )
+			,	m_id( id )
+			,	m_consumer( std::move(consumer) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != messages_per_producer; ++i )
+					so_5::send< msg_value >( m_consumer, m_id, i );
+			}
+
+	private :
+		const unsigned int m_id;
+		const so_5::mbox_t m_consumer;
+	};
+
+template< typename P >
+P
+setup_queue( P params, const lock_factory_t & factory )
+	{
+		params.tune_queue_params(
+			[&]( so_5::disp::mpsc_queue_traits::queue_params_t & p ) {
+				p.lock_factory( factory ).lock_free( true );
+			} );
+
+		return params;
+	}
+
+using binder_maker_t = std::function<
+		so_5::disp_binder_unique_ptr_t(
+				so_5::environment_t &, const lock_factory_t & ) >;
+
+void
+run_case(
+	const binder_maker_t & binder_maker,
+	const lock_factory_t & factory,
+	so_5::work_thread_activity_tracking_t tracking )
+	{
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				env.introduce_coop(
+					binder_maker( env, factory ),
+					[&]( so_5::coop_t & coop ) {
+						auto consumer = coop.make_agent< a_consumer_t >()
+								->so_direct_mbox();
+
+						auto producers_disp = so_5::disp::active_obj::create_private_disp(
+								env,
+								std::string(),
+								setup_queue(
+										so_5::disp::active_obj::disp_params_t{},
+										factory ) );
+						for( unsigned int i = 0; i != producer_count; ++i )
+							coop.make_agent_with_binder< a_producer_t >(
+									producers_disp->binder(), i, consumer );
+					} );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				params.work_thread_activity_tracking( tracking );
+			} );
+	}
+
+void
+do_test()
+	{
+		struct case_info_t
+			{
+				std::string m_name;
+				binder_maker_t m_maker;
+			};
+		std::vector< case_info_t > cases;
+		cases.push_back( case_info_t{ "one_thread",
+				[]( so_5::environment_t & env, const lock_factory_t & f ) {
+					using namespace so_5::disp::one_thread;
+					return create_private_disp( env, std::string(),
+							setup_queue( disp_params_t{}, f ) )->binder();
+				} } );
+		cases.push_back( case_info_t{ "active_obj",
+				[]( so_5::environment_t & env, const lock_factory_t & f ) {
+					using namespace so_5::disp::active_obj;
+					return create_private_disp( env, std::string(),
+							setup_queue( disp_params_t{}, f ) )->binder();
+				} } );
+		cases.push_back( case_info_t{ "active_group",
+				[]( so_5::environment_t & env, const lock_factory_t & f ) {
+					using namespace so_5::disp::active_group;
+					return create_private_disp( env, std::string(),
+							setup_queue( disp_params_t{}, f ) )->binder( "group" );
+				} } );
+		cases.push_back( case_info_t{ "prio::one_per_prio",
+				[]( so_5::environment_t & env, const lock_factory_t & f ) {
+					using namespace so_5::disp::prio_dedicated_threads::one_per_prio;
+					return create_private_disp( env, std::string(),
+							setup_queue( disp_params_t{}, f ) )->binder();
+				} } );
+
+		struct lock_factory_info_t
+			{
+				std::string m_name;
+				lock_factory_t m_factory;
+			};
+		std::vector< lock_factory_info_t > factories;
+		factories.push_back( lock_factory_info_t{
+				"combined_lock", so_5::disp::mpsc_queue_traits::combined_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"simple_lock",
+				so_5::disp::mpsc_queue_traits::simple_lock_factory() } );
+
+		for( const auto & c : cases )
+			for( const auto & f : factories )
+				for( auto tracking : { so_5::work_thread_activity_tracking_t::off,
+						so_5::work_thread_activity_tracking_t::on } )
+				{
+					const std::string name = c.m_name + "+" + f.m_name +
+							(so_5::work_thread_activity_tracking_t::on == tracking ?
+								"+tracking" : "");
+
+					std::cout << "--- " << name << "---" << std::endl;
+
+					run_with_time_limit( [&] {
+								run_case( c.m_maker, f.m_factory, tracking );
+							},
+							100,
+							"case: " + name );
+
+					std::cout << "--- DONE ---" << std::endl;
+				}
+	}
+
+int
+main()
+{
+	try
+	{
+		do_test();
+
+		return 0;
+	}
+	catch( const std::exception & x )
+	{
+		std::cerr << "*** Exception caught: " << x.what() << std::endl;
+	}
+
+	return 2;
+}
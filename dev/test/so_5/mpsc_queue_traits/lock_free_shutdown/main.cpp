@@ -0,0 +1,182 @@
+/*
+ * A stress test for shutdown of demand queue in lock-free mode
+ * while producers are pushing new demands.
+ */
+
+#include <so_5/disp/reuse/work_thread/h/work_thread.hpp>
+
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace so_5::disp::reuse::work_thread;
+
+const unsigned int producer_count = 4;
+const unsigned int iterations = 2000;
+
+std::atomic< bool > g_double_notify{ false };
+
+//
+// checking_lock_t
+//
+/*!
+ * A lock which detects the second notification of the waiting thread
+ * before the thread reacquires the lock. Such notification leads to
+ * a deadlock with combined_lock.
+ *
+ * Like combined_lock it uses a separate mutex for waiting. The waiting
+ * thread reacquires the lock with a delay after the notification to make
+ * the dangerous period longer.
+ */
+class checking_lock_t final : public queue_traits::lock_t
+{
+public :
+	virtual void
+	lock() SO_5_NOEXCEPT override
+	{
+		m_lock.lock();
+	}
+
+	virtual void
+	unlock() SO_5_NOEXCEPT override
+	{
+		m_lock.unlock();
+	}
+
+protected :
+	virtual void
+	wait_for_notify() SO_5_NOEXCEPT override
+	{
+		m_waiting = true;
+
+		{
+			std::unique_lock< std::mutex > wait_lock{ m_wait_mutex };
+			m_lock.unlock();
+
+			m_condition.wait( wait_lock, [this]{ return m_signaled; } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+
+		m_lock.lock();
+
+		m_waiting = false;
+		m_signaled = false;
+	}
+
+	virtual void
+	notify_one() SO_5_NOEXCEPT override
+	{
+		if( m_waiting )
+		{
+			std::lock_guard< std::mutex > wait_lock{ m_wait_mutex };
+
+			if( m_signaled )
+				g_double_notify.store( true, std::memory_order_release );
+
+			m_signaled = true;
+			m_condition.notify_one();
+		}
+	}
+
+private :
+	std::mutex m_lock;
+	std::mutex m_wait_mutex;
+	std::condition_variable m_condition;
+
+	bool m_waiting{ false };
+	bool m_signaled{ false };
+};
+
+void
+run_iteration(
+	const queue_traits::lock_factory_t & factory,
+	unsigned int iteration )
+{
+	demand_queue_no_activity_tracking_t queue{
+			factory(), true, queue_traits::idle_handler_shptr_t{} };
+	queue.start_service();
+
+	std::thread consumer{ [&queue] {
+			demand_queue_details::demand_batch_t demands;
+			demands_counter_t counter{ 0 };
+			while( extraction_result_t::demand_extracted ==
+					queue.pop( demands, counter ) )
+				while( !demands.empty() )
+					demands.pop_front();
+		} };
+
+	// Producers push their demands at the same time as the queue is
+	// being stopped.
+	std::atomic< bool > go{ false };
+	std::vector< std::thread > producers;
+	for( unsigned int i = 0; i != producer_count; ++i )
+		producers.emplace_back( [&queue, &go] {
+				while( !go.load( std::memory_order_acquire ) )
+					std::this_thread::yield();
+
+				queue.push( so_5::execution_demand_t{} );
+			} );
+
+	// The consumer must fall asleep on the empty queue.
+	std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+
+	go.store( true, std::memory_order_release );
+	// Different delays to hit producers and the consumer in different states.
+	std::this_thread::sleep_for( std::chrono::microseconds( iteration % 50 ) );
+
+	queue.stop_service();
+	consumer.join();
+
+	for( auto & p : producers )
+		p.join();
+}
+
+void
+run_with_factory(
+	const std::string & name,
+	const queue_traits::lock_factory_t & factory )
+{
+	std::cout << "--- " << name << " ---" << std::endl;
+
+	run_with_time_limit( [&] {
+				for( unsigned int i = 0; i != iterations; ++i )
+					run_iteration( factory, i );
+			},
+			120,
+			"lock_free_shutdown: " + name );
+
+	if( g_double_notify.load( std::memory_order_acquire ) )
+	{
+		std::cerr << "*** consumer is notified twice, " << name << std::endl;
+		std::abort();
+	}
+
+	std::cout << "--- DONE ---" << std::endl;
+}
+
+int
+main()
+{
+	// Zero spinning time leads the consumer directly to waiting
+	// on the mutex and condition variable.
+	run_with_factory( "combined_lock(0)",
+			queue_traits::combined_lock_factory(
+					std::chrono::high_resolution_clock::duration::zero() ) );
+	run_with_factory( "combined_lock",
+			queue_traits::combined_lock_factory() );
+	run_with_factory( "simple_lock",
+			queue_traits::simple_lock_factory() );
+	run_with_factory( "checking_lock",
+			[] { return queue_traits::lock_unique_ptr_t{ new checking_lock_t{} }; } );
+
+	return 0;
+}
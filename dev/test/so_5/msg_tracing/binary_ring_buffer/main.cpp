@@ -0,0 +1,227 @@
+/*
+ * A test for binary message delivery tracing to ring buffers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <sstream>
+
+using namespace std;
+
+struct tick final : public so_5::message_t
+{
+	int m_value;
+
+	tick( int value ) : m_value( value ) {}
+};
+
+struct finish final : public so_5::signal_t {};
+
+const int TICKS = 100;
+
+class a_sender_t final : public so_5::agent_t
+{
+public :
+	a_sender_t( context_t ctx, so_5::mbox_t dest )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_dest( std::move(dest) )
+	{}
+
+	virtual void
+	so_evt_start() override
+	{
+		for( int i = 0; i != TICKS; ++i )
+			so_5::send< tick >( m_dest, i );
+		so_5::send< finish >( m_dest );
+	}
+
+private :
+	const so_5::mbox_t m_dest;
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx, so_5::mbox_t src, int senders )
+		:	so_5::agent_t( std::move(ctx) )
+		,	m_src( std::move(src) )
+		,	m_senders( senders )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( m_src )
+			.event( []( const tick & ) {} )
+			.event< finish >( [this] {
+					if( 0 == --m_senders )
+						so_deregister_agent_coop_normally();
+				} );
+	}
+
+private :
+	const so_5::mbox_t m_src;
+	int m_senders;
+};
+
+void
+run_senders(
+	so_5::msg_tracing::binary_trace_storage_shptr_t storage,
+	int senders )
+{
+	so_5::launch(
+		[senders]( so_5::environment_t & env ) {
+			env.introduce_coop( [senders]( so_5::coop_t & coop ) {
+					auto mbox = coop.environment().create_mbox();
+					coop.make_agent< a_receiver_t >( mbox, senders );
+					for( int i = 0; i != senders; ++i )
+						coop.make_agent_with_binder< a_sender_t >(
+								so_5::disp::one_thread::create_private_disp(
+										coop.environment() )->binder(),
+								mbox );
+				} );
+		},
+		[storage]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer(
+					so_5::msg_tracing::binary_tracer( storage ) );
+		} );
+}
+
+vector< string >
+decode( const so_5::msg_tracing::binary_trace_storage_t & storage )
+{
+	stringstream binary;
+	storage.dump( binary );
+
+	stringstream text;
+	so_5::msg_tracing::decode_binary_trace( binary, text );
+
+	vector< string > lines;
+	string line;
+	while( getline( text, line ) )
+		lines.push_back( line );
+
+	return lines;
+}
+
+size_t
+count_lines( const vector< string > & lines, const string & what )
+{
+	size_t result = 0u;
+	for( const auto & l : lines )
+		if( string::npos != l.find( what ) )
+			++result;
+
+	return result;
+}
+
+UT_UNIT_TEST( test_all_records )
+{
+	run_with_time_limit(
+		[]()
+		{
+			const int SENDERS = 3;
+
+			auto storage = so_5::msg_tracing::ring_buffer_trace_storage( 10000u );
+			run_senders( storage, SENDERS );
+
+			const auto lines = decode( *storage );
+
+			const string push_to_queue = " deliver_message.push_to_queue ";
+			const string tick_type = string( "[msg_type=" ) +
+					typeid( tick ).name() + "]";
+
+			UT_CHECK_CONDITION(
+					static_cast< size_t >(SENDERS * (TICKS + 1)) ==
+							count_lines( lines, push_to_queue ) );
+			UT_CHECK_CONDITION(
+					static_cast< size_t >(SENDERS * TICKS) ==
+							count_lines( lines, push_to_queue + tick_type ) );
+
+			// Records are ordered by timestamp.
+			unsigned long long prev = 0u;
+			for( const auto & l : lines )
+			{
+				const auto ts = stoull( l.substr( 4 ) );
+				UT_CHECK_CONDITION( prev <= ts );
+				prev = ts;
+			}
+		},
+		20,
+		"test_all_records" );
+}
+
+UT_UNIT_TEST( test_overwritten_records )
+{
+	run_with_time_limit(
+		[]()
+		{
+			const size_t CAPACITY = 8u;
+			const int SENDERS = 2;
+
+			auto storage = so_5::msg_tracing::ring_buffer_trace_storage( CAPACITY );
+			run_senders( storage, SENDERS );
+
+			const auto lines = decode( *storage );
+
+			// There are at least two threads for senders. But the count of
+			// threads in the environment is unknown. So only the lower bound
+			// can be checked.
+			UT_CHECK_CONDITION( lines.size() >= SENDERS * CAPACITY );
+			UT_CHECK_CONDITION(
+					lines.size() < static_cast< size_t >(SENDERS * (TICKS + 1)) );
+		},
+		20,
+		"test_overwritten_records" );
+}
+
+UT_UNIT_TEST( test_errors )
+{
+	try
+	{
+		so_5::msg_tracing::ring_buffer_trace_storage( 0u );
+		ensure_or_die( false, "an exception must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		UT_CHECK_CONDITION(
+				so_5::rc_invalid_binary_trace_storage_size == x.error_code() );
+	}
+
+	auto ensure_invalid_trace = []( const string & content ) {
+		try
+		{
+			stringstream binary{ content };
+			stringstream text;
+			so_5::msg_tracing::decode_binary_trace( binary, text );
+			ensure_or_die( false, "an exception must be thrown!" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			UT_CHECK_CONDITION(
+					so_5::rc_invalid_binary_trace == x.error_code() );
+		}
+	};
+
+	ensure_invalid_trace( "not a trace at all" );
+
+	// Truncated trace.
+	stringstream binary;
+	so_5::msg_tracing::ring_buffer_trace_storage( 4u )->dump( binary );
+	ensure_invalid_trace( binary.str().substr( 0, binary.str().size() - 1 ) );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_all_records )
+	UT_RUN_UNIT_TEST( test_overwritten_records )
+	UT_RUN_UNIT_TEST( test_errors )
+
+	return 0;
+}
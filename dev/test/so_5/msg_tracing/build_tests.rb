@@ -20,4 +20,6 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/simple_deny_msg_filter/prj.ut.rb"
 	required_prj "#{path}/overlimit_redirect_with_filter/prj.ut.rb"
 	required_prj "#{path}/change_filter_1/prj.ut.rb"
+
+	required_prj "#{path}/binary_ring_buffer/prj.ut.rb"
 }
@@ -0,0 +1,196 @@
+/*
+ * A test for coalesced periodic messages.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+struct tick final : public so_5::message_t
+{
+	int m_index;
+
+	tick( int index ) : m_index( index ) {}
+};
+
+struct sig_tick final : public so_5::signal_t {};
+
+void
+do_check_mass_periodic( so_5::environment_t & env )
+{
+	const int TIMERS = 200;
+	const int TICKS = 3;
+
+	auto ch = create_mchain( env );
+
+	const auto sent_at = steady_clock::now();
+
+	vector< so_5::timer_id_t > timers;
+	for( int i = 0; i != TIMERS; ++i )
+		timers.push_back( so_5::send_periodic< tick >( ch,
+				milliseconds(50), milliseconds(50),
+				so_5::timer_slack( milliseconds(20) ),
+				i ) );
+
+	vector< int > received( TIMERS, 0 );
+	int completed = 0;
+	auto r = receive(
+			from( ch ).empty_timeout( seconds(2) ).stop_on(
+					[&completed] { return TIMERS == completed; } ),
+			[&]( const tick & msg ) {
+				if( 0 == received[ msg.m_index ] )
+					// There can be an error in one step of timer_wheel.
+					ensure_or_die(
+							steady_clock::now() - sent_at >= milliseconds(40),
+							"message is received too early, index: " +
+							to_string( msg.m_index ) );
+
+				if( TICKS == ++received[ msg.m_index ] )
+					++completed;
+			} );
+
+	UT_CHECK_CONDITION( TIMERS == completed );
+	UT_CHECK_CONDITION( r.handled() >= static_cast< size_t >(TIMERS * TICKS) );
+
+	// Only odd timers must survive.
+	for( int i = 0; i < TIMERS; i += 2 )
+	{
+		timers[ i ].release();
+		UT_CHECK_CONDITION( !timers[ i ].is_active() );
+	}
+
+	// Messages which are already sent are ignored.
+	this_thread::sleep_for( milliseconds(60) );
+	receive( from( ch ).empty_timeout( so_5::no_wait ), []( const tick & ) {} );
+
+	r = receive( from( ch ).total_time( milliseconds(200) ),
+			[]( const tick & msg ) {
+				ensure_or_die( 1 == msg.m_index % 2,
+						"only odd timers expected, index: " +
+						to_string( msg.m_index ) );
+			} );
+	UT_CHECK_CONDITION( r.handled() >= static_cast< size_t >(TIMERS / 2) );
+
+	timers.clear();
+
+	this_thread::sleep_for( milliseconds(60) );
+	receive( from( ch ).empty_timeout( so_5::no_wait ), []( const tick & ) {} );
+
+	r = receive( from( ch ).total_time( milliseconds(150) ),
+			[]( const tick & ) {} );
+	UT_CHECK_CONDITION( 0u == r.extracted() );
+}
+
+void
+do_check_signal_and_new_group( so_5::environment_t & env )
+{
+	auto ch = create_mchain( env );
+
+	// The first timer creates a group.
+	auto first = so_5::send_periodic< sig_tick >( ch,
+			milliseconds(10), milliseconds(20),
+			so_5::timer_slack( milliseconds(5) ) );
+
+	auto r = receive( from( ch ).handle_n( 3 ).empty_timeout( seconds(1) ),
+			[]( so_5::mhood_t< sig_tick > ) {} );
+	UT_CHECK_CONDITION( 3u == r.handled() );
+
+	first.release();
+
+	// The group is destroyed. A new one must be created.
+	auto second = so_5::send_periodic< sig_tick >( env, ch->as_mbox(),
+			milliseconds(10), milliseconds(20),
+			so_5::timer_slack( milliseconds(5) ) );
+
+	r = receive( from( ch ).handle_n( 5 ).empty_timeout( seconds(1) ),
+			[]( so_5::mhood_t< sig_tick > ) {} );
+	UT_CHECK_CONDITION( 5u == r.handled() );
+}
+
+void
+do_check_delayed_with_slack( so_5::environment_t & env )
+{
+	auto ch = create_mchain( env );
+
+	// Zero period means ordinary delayed message.
+	auto timer = so_5::send_periodic< tick >( ch,
+			milliseconds(20), milliseconds::zero(),
+			so_5::timer_slack( milliseconds(100) ),
+			42 );
+
+	auto r = receive( from( ch ).empty_timeout( milliseconds(200) ),
+			[]( const tick & msg ) {
+				UT_CHECK_CONDITION( 42 == msg.m_index );
+			} );
+	UT_CHECK_CONDITION( 1u == r.handled() );
+}
+
+void
+do_check_negative_slack( so_5::environment_t & env )
+{
+	auto ch = create_mchain( env );
+
+	try
+	{
+		(void)so_5::send_periodic< sig_tick >( ch,
+				milliseconds(10), milliseconds(20),
+				so_5::timer_slack( -milliseconds(5) ) );
+		ensure_or_die( false, "an exeption must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		UT_CHECK_CONDITION(
+				so_5::rc_negative_value_for_timer_slack == x.error_code() );
+	}
+}
+
+UT_UNIT_TEST( test_coalesced_periodic )
+{
+	struct timer_info_t {
+		string m_name;
+		so_5::timer_thread_factory_t m_factory;
+	};
+
+	timer_info_t timers[] = {
+		{ "timer_wheel", so_5::timer_wheel_factory() },
+		{ "timer_heap", so_5::timer_heap_factory() },
+		{ "timer_list", so_5::timer_list_factory() },
+		{ "timer_hierarchical_wheel", so_5::timer_hierarchical_wheel_factory() }
+	};
+
+	for( const auto & t : timers )
+	{
+		cout << "=== " << t.m_name << " ===" << endl;
+
+		run_with_time_limit(
+			[&t]()
+			{
+				so_5::wrapped_env_t env{
+					[]( so_5::environment_t & ) {},
+					[&t]( so_5::environment_params_t & params ) {
+						params.timer_thread( t.m_factory );
+					} };
+
+				do_check_mass_periodic( env.environment() );
+				do_check_signal_and_new_group( env.environment() );
+				do_check_delayed_with_slack( env.environment() );
+				do_check_negative_slack( env.environment() );
+			},
+			20,
+			"test_coalesced_periodic: " + t.m_name );
+	}
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_coalesced_periodic )
+
+	return 0;
+}
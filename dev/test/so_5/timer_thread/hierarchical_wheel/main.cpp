@@ -0,0 +1,174 @@
+/*
+ * A test for hierarchical timer_wheel thread.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+using namespace chrono;
+
+struct delayed final : public so_5::message_t
+{
+	int m_index;
+	steady_clock::time_point m_sent_at;
+
+	delayed( int index, steady_clock::time_point sent_at )
+		:	m_index( index ), m_sent_at( sent_at )
+	{}
+};
+
+struct tick final : public so_5::signal_t {};
+
+void
+do_check_delayed_order( so_5::environment_t & env )
+{
+	auto ch = create_mchain( env );
+
+	// Timeouts are stored in different levels of the wheels.
+	const milliseconds timeouts[] = {
+			milliseconds(700), milliseconds(3), milliseconds(300),
+			milliseconds(40), milliseconds(260), milliseconds(1) };
+
+	const auto sent_at = steady_clock::now();
+	for( const auto & t : timeouts )
+		so_5::send_delayed< delayed >( ch, t,
+				static_cast< int >( t.count() ), sent_at );
+
+	int last_index = 0;
+	auto r = receive( from( ch ).handle_n( 6 ).empty_timeout( seconds(5) ),
+			[&last_index]( const delayed & msg ) {
+				const auto elapsed = duration_cast< milliseconds >(
+						steady_clock::now() - msg.m_sent_at );
+
+				ensure_or_die( last_index < msg.m_index,
+						"timers must be executed in order of their timeouts" );
+				// There can be an error in one time step.
+				ensure_or_die( elapsed.count() + 1 >= msg.m_index,
+						"timer must not be executed too early, index: " +
+						to_string( msg.m_index ) + ", elapsed: " +
+						to_string( elapsed.count() ) );
+
+				last_index = msg.m_index;
+			} );
+
+	UT_CHECK_CONDITION( 6u == r.handled() );
+	UT_CHECK_CONDITION( 700 == last_index );
+}
+
+void
+do_check_periodic( so_5::environment_t & env )
+{
+	auto ch = create_mchain( env );
+
+	auto timer = so_5::send_periodic< tick >( ch,
+			milliseconds(10), milliseconds(20) );
+
+	auto r = receive( from( ch ).handle_n( 10 ).empty_timeout( seconds(1) ),
+			[]( so_5::mhood_t< tick > ) {} );
+	timer.release();
+
+	UT_CHECK_CONDITION( 10u == r.handled() );
+}
+
+void
+do_check_mass_cancellation( so_5::environment_t & env )
+{
+	const int TIMERS = 100000;
+
+	auto ch = create_mchain( env );
+
+	vector< so_5::timer_id_t > timers;
+	timers.reserve( TIMERS );
+	for( int i = 0; i != TIMERS; ++i )
+		timers.push_back( so_5::send_periodic< delayed >( ch,
+				milliseconds( 500 + i % 1000 ), milliseconds::zero(),
+				i, steady_clock::now() ) );
+
+	// Only one timer must survive.
+	for( int i = 1; i != TIMERS; ++i )
+		timers[ i ].release();
+
+	auto r = receive( from( ch ).empty_timeout( seconds(2) ),
+			[]( const delayed & msg ) {
+				ensure_or_die( 0 == msg.m_index, "only first timer expected" );
+			} );
+
+	UT_CHECK_CONDITION( 1u == r.handled() );
+}
+
+void
+do_check_short_timer_behind_long_one()
+{
+	so_5::wrapped_env_t env{
+		[]( so_5::environment_t & ) {},
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread(
+					so_5::timer_hierarchical_wheel_factory(
+							milliseconds(10) ) );
+		} };
+
+	auto ch = create_mchain( env );
+
+	// Timer thread will sleep until this timer.
+	so_5::send_delayed< delayed >( ch, seconds(2), 2000, steady_clock::now() );
+
+	this_thread::sleep_for( milliseconds(100) );
+
+	// Timer thread must be woken up for this timer.
+	so_5::send_delayed< delayed >( ch, milliseconds(20), 20,
+			steady_clock::now() );
+
+	auto r = receive( from( ch ).handle_n( 1 ).empty_timeout( seconds(5) ),
+			[]( const delayed & msg ) {
+				const auto elapsed = duration_cast< milliseconds >(
+						steady_clock::now() - msg.m_sent_at );
+
+				ensure_or_die( 20 == msg.m_index,
+						"short timer must be executed first" );
+				// There can be an error in one time step.
+				ensure_or_die( elapsed.count() + 10 >= 20,
+						"short timer is executed too early, elapsed: " +
+						to_string( elapsed.count() ) );
+				ensure_or_die( elapsed.count() < 500,
+						"short timer is executed too late, elapsed: " +
+						to_string( elapsed.count() ) );
+			} );
+
+	UT_CHECK_CONDITION( 1u == r.handled() );
+}
+
+UT_UNIT_TEST( test_hierarchical_wheel )
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env{
+				[]( so_5::environment_t & ) {},
+				[]( so_5::environment_params_t & params ) {
+					params.timer_thread(
+							so_5::timer_hierarchical_wheel_factory(
+									milliseconds(1) ) );
+				} };
+
+			do_check_delayed_order( env.environment() );
+			do_check_periodic( env.environment() );
+			do_check_mass_cancellation( env.environment() );
+
+			do_check_short_timer_behind_long_one();
+		},
+		20,
+		"test_hierarchical_wheel" );
+}
+
+int
+main()
+{
+	UT_RUN_UNIT_TEST( test_hierarchical_wheel )
+
+	return 0;
+}
@@ -127,6 +127,11 @@ main()
 		check_factory( "timer_heap_factory", so_5::timer_heap_factory() );
 		check_factory( "timer_heap_factory(2048)",
 				so_5::timer_heap_factory( 2048 ) );
+		check_factory( "timer_hierarchical_wheel_factory",
+				so_5::timer_hierarchical_wheel_factory() );
+		check_factory( "timer_hierarchical_wheel_factory(1ms)",
+				so_5::timer_hierarchical_wheel_factory(
+						std::chrono::milliseconds(1) ) );
 
 		return 0;
 	}
@@ -65,7 +65,7 @@
  * \since
  * v.1.2.1
  */
-#define TIMERTT_VERSION 1002002u
+#define TIMERTT_VERSION 1002003u
 
 /*!
  * \brief Top-level project's namespace.
@@ -2742,6 +2742,810 @@ private :
 	 */
 };
 
+//
+// timer_hierarchical_wheel_engine_defaults
+//
+/*!
+ * \brief Container for static method with default values for
+ * timer_hierarchical_wheel engine.
+ *
+ * \since
+ * v.1.2.3
+ */
+struct timer_hierarchical_wheel_engine_defaults
+{
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
+};
+
+//
+// timer_hierarchical_wheel_engine
+//
+
+/*!
+ * \brief An engine for hierarchical timer wheel mechanism.
+ *
+ * This class uses hierarchical timing wheels (the scheme 7 from
+ * <a href="http://www.cs.columbia.edu/~nahum/w6998/papers/ton97-timing-wheels.pdf">Varghese and Lauck paper</a>).
+ * There are several wheels (levels) with different resolution. The first
+ * level has 256 slots and every slot is one time step. Every slot on the
+ * next levels covers the whole previous level. There are four levels, so
+ * timers with timeouts up to 2^26 time steps are stored directly. Timers
+ * with longer timeouts are placed into the last level and are moved
+ * again until they reach its time.
+ *
+ * Activation and deactivation of a timer are O(1) operations: the slot for
+ * the timer is calculated from its expiration time step and the timer is
+ * stored in a double-linked list. Timers from a slot of a higher level are
+ * redistributed to lower levels only when the first level completes its
+ * turn (cascade on demand). It means that timers which are deactivated
+ * before their expiration (for example, timeouts of requests which were
+ * completed in time) are never touched by timer thread at all.
+ *
+ * Unlike timer_wheel engine the timer thread does not wake up on every
+ * time step. It sleeps until the nearest non-empty slot of the first level
+ * or until the end of the first level turn.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_engine
+	:	public engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >;
+
+	struct timer_type;
+
+public :
+	//! Type with default parameters for this engine.
+	using defaults_type = timer_hierarchical_wheel_engine_defaults;
+
+	//! Alias for timer_action type.
+	using timer_action = typename base_type::timer_action;	
+
+	//! Alias for scoped timer object.
+	using scoped_timer_object =
+			scoped_timer_object_holder< timer_type >;
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_engine(
+		//! Size of time step for the wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_granularity( granularity )
+	{
+		for( unsigned int level = 0; level != levels_count; ++level )
+			m_levels[ level ].resize( level_size( level ) );
+
+		m_next_tick_time = monotonic_clock::now() + m_granularity;
+	}
+
+	//! Destructor.
+	~timer_hierarchical_wheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< Thread_Safety >
+	allocate()
+	{
+		return timer_object_holder< Thread_Safety >( new timer_type() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned when the timer is added to
+	 * the empty engine or when the timer must be executed before the
+	 * current value of nearest_time_point(). In both cases timer thread
+	 * must be woken up to recalculate its sleeping time.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		wheel_timer->m_action.assign( std::move(action) );
+
+		// If there is no timers then there is no need to process
+		// all time steps elapsed since the last timer. Time steps
+		// can be counted from now.
+		if( this->empty() )
+			m_next_tick_time = monotonic_clock::now() + m_granularity;
+
+		// Timer must be taken under control.
+		timer_object< Thread_Safety >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		return perform_insertion_into_wheels( wheel_timer, pause, period );
+	}
+
+	/*!
+	 * \brief Perform an attempt to reschedule a timer.
+	 *
+	 * \note
+	 * This operation can fail if the timer to be rescheduled is in processing.
+	 * Because of that it is recommended to use such operation for
+	 * timer_managers only. But even with timer_managers this operation
+	 * should be used with care.
+	 *
+	 * \attention
+	 * It move operator for a timer_action throws then timer will be
+	 * deactivated. The state for a timer_action itself will be unknown.
+	 * 
+	 * \return The same value as activate(): \a true if timer thread
+	 * must be woken up to recalculate its sleeping time.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is in processing right now.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	reschedule(
+		//! Timer to be rescheduled. Must be in activated or deactivated state.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		// If timer is deactivated the usual activation logic can be used.
+		if( timer_status::deactivated == wheel_timer->m_status )
+			return this->activate(
+					std::move(timer), pause, period, std::move(action) );
+		else if( timer_status::active != wheel_timer->m_status )
+		{
+			// Timer which is in processing now can't be reactivated.
+			throw std::runtime_error( "timer is in processing now, "
+					"it can't be rescheduled" );
+		}
+
+		// Timer must be removed from the wheel first.
+		this->remove_timer_from_wheel( wheel_timer );
+		this->dec_timer_count( wheel_timer->kind() );
+
+		// If this assigment throws then we must deactivate the timer.
+		try
+		{
+			wheel_timer->m_action.assign( std::move(action) );
+		}
+		catch(...)
+		{
+			wheel_timer->m_status = timer_status::deactivated;
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+			// Exception must be rethrown;
+			throw;
+		}
+
+		return this->perform_insertion_into_wheels(
+				wheel_timer, pause, period );
+	}
+
+	//! Deactivate timer and remove it from the wheel.
+	void
+	deactivate( timer_object_holder< Thread_Safety > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_wheel( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Process all elapsed time steps.
+	 *
+	 * Several time steps can be processed at once because timer thread
+	 * sleeps while there are no timers in the slots of the first level.
+	 */
+	template< typename Unique_Lock >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		Unique_Lock & lock )
+	{
+		const auto now = monotonic_clock::now();
+		while( now >= m_next_tick_time && !this->empty() )
+		{
+			process_next_tick( lock );
+			m_next_tick_time += m_granularity;
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next timer.
+	 *
+	 * It is the time point of the nearest non-empty slot of the first
+	 * level or the time point of the next cascade operation.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		const auto first_slot = slot_index( 0, m_next_tick );
+		// Cascade must be performed at the start of the first level turn.
+		if( !first_slot )
+			return m_next_tick_time;
+
+		const auto & level = m_levels[ 0 ];
+		for( std::size_t i = first_slot; i != level.size(); ++i )
+			if( level[ i ].m_head )
+				return m_next_tick_time +
+						static_cast< monotonic_clock::duration::rep >(
+								i - first_slot ) * m_granularity;
+
+		return m_next_tick_time +
+				static_cast< monotonic_clock::duration::rep >(
+						level.size() - first_slot ) * m_granularity;
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & level : m_levels )
+			for( auto & item : level )
+			{
+				timer_type * timer = item.m_head;
+				item = wheel_item();
+
+				while( timer )
+				{
+					timer_type * t = timer;
+					timer = timer->m_next;
+
+					t->m_status = timer_status::deactivated;
+					timer_object< Thread_Safety >::decrement_references( t );
+				}
+			}
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_next_tick_time = monotonic_clock::now() + m_granularity;
+	}
+
+private :
+	//! Type for time step counter.
+	using tick_type = std::uint64_t;
+
+	/*!
+	 * \name Geometry of the wheels.
+	 * \{
+	 */
+	//! Count of wheels.
+	static const unsigned int levels_count = 4;
+	//! Count of bits for slot index in the first level.
+	static const unsigned int first_level_bits = 8;
+	//! Count of bits for slot index in the other levels.
+	static const unsigned int other_level_bits = 6;
+	/*!
+	 * \}
+	 */
+
+	//! Type of wheel timer.
+	struct timer_type : public timer_object< Thread_Safety >
+	{
+		//! Status of the timer.
+		typename threading_traits< Thread_Safety >::status_holder_type m_status;
+
+		//! Time step at which timer must be executed.
+		tick_type m_expiration_tick = 0;
+
+		//! Level of the wheel in which timer is stored.
+		unsigned int m_level = 0;
+		//! Slot in the wheel in which timer is stored.
+		std::size_t m_slot = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		tick_type m_period = 0;
+
+		//! Timer action.
+		timer_action_holder< timer_action > m_action;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		/*!
+		 * \brief Detect type of the timer (single-shot or periodic).
+		 */
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's item.
+	struct wheel_item
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! Number of the next time step to be processed.
+	tick_type m_next_tick = 0;
+
+	//! Time point at which the next time step must be processed.
+	monotonic_clock::time_point m_next_tick_time;
+
+	//! The wheels.
+	std::array< std::vector< wheel_item >, levels_count > m_levels;
+	/*!
+	 * \}
+	 */
+
+	//! Count of bits of time step number below the specified level.
+	static unsigned int
+	level_shift( unsigned int level )
+	{
+		return level ? first_level_bits + (level - 1) * other_level_bits : 0;
+	}
+
+	//! Count of slots in the specified level.
+	static std::size_t
+	level_size( unsigned int level )
+	{
+		return std::size_t{1} << (level ? other_level_bits : first_level_bits);
+	}
+
+	//! Index of slot for time step \a tick in the specified level.
+	static std::size_t
+	slot_index( unsigned int level, tick_type tick )
+	{
+		return static_cast< std::size_t >(
+				(tick >> level_shift( level )) & (level_size( level ) - 1) );
+	}
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	/*!
+	 * \brief Perform insertion of a timer into wheels data structure.
+	 *
+	 * \note
+	 * This method doesn't change reference count to timer object.
+	 *
+	 * \return \a true if the engine was empty or if the timer must be
+	 * executed before the old value of nearest_time_point().
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	perform_insertion_into_wheels(
+		//! Timer to be inserted.
+		timer_type * wheel_timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period )
+	{
+		// The timer with pause of one time step must be executed
+		// at the next time step. Time steps elapsed during the sleep
+		// of timer thread must be skipped too.
+		wheel_timer->m_expiration_tick =
+				m_next_tick + elapsed_ticks() + duration_to_ticks( pause ) - 1;
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		// This must be detected before the insertion because
+		// the new timer itself shouldn't be taken into account.
+		const bool nearest_changed = this->empty() ||
+				is_before_nearest_time_point( wheel_timer->m_expiration_tick );
+
+		// Timer now can be inserted into the wheel.
+		this->insert_demand_to_wheel( wheel_timer );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+
+		return nearest_changed;
+	}
+
+	/*!
+	 * \brief Count of time steps which are already in the past but
+	 * are not processed yet.
+	 *
+	 * Timer thread sleeps until nearest_time_point() and doesn't process
+	 * time steps during the sleep. So m_next_tick can be behind the
+	 * current time.
+	 */
+	tick_type
+	elapsed_ticks() const
+	{
+		const auto now = monotonic_clock::now();
+		if( now < m_next_tick_time )
+			return 0;
+
+		return static_cast< tick_type >(
+				(now - m_next_tick_time) / m_granularity ) + 1;
+	}
+
+
+	/*!
+	 * \brief Check that time step \a tick is earlier than
+	 * nearest_time_point().
+	 *
+	 * The nearest time point is never behind the end of the current
+	 * turn of the first level. Because of that only slots of the first
+	 * level from the next time step to \a tick are checked.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	bool
+	is_before_nearest_time_point( tick_type tick ) const
+	{
+		const auto first_slot = slot_index( 0, m_next_tick );
+		// Timer thread will wake up at the next time step for cascading.
+		if( !first_slot )
+			return false;
+
+		const auto & level = m_levels[ 0 ];
+		const tick_type delta = tick - m_next_tick;
+		if( delta >= level.size() - first_slot )
+			return false;
+
+		const auto last_slot = first_slot + static_cast< std::size_t >( delta );
+		for( std::size_t i = first_slot; i <= last_slot; ++i )
+			if( level[ i ].m_head )
+				return false;
+
+		return true;
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note This implementation performs rounding up for duration
+	 * values in the same way as timer_wheel engine.
+	 *
+	 * \note Never return 0.
+	 *
+	 * \tparam Duration actual type for duration representation.
+	 */
+	template< class Duration >
+	tick_type
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		Duration d ) const
+	{
+		auto d_units = 
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		tick_type r = d_units > 0 ?
+				static_cast< tick_type >( (d_units + g_units/2) / g_units ) : 0;
+		if( !r )
+			r = 1;
+		return r;
+	}
+
+	/*!
+	 * \brief Insert timer to the appropriate wheel.
+	 *
+	 * The level of wheel is detected by the distance between
+	 * the next time step and the expiration time step of the timer.
+	 */
+	void
+	insert_demand_to_wheel( timer_type * wheel_timer )
+	{
+		const tick_type delta = wheel_timer->m_expiration_tick - m_next_tick;
+
+		unsigned int level = 0;
+		while( level + 1 != levels_count &&
+				delta >= (tick_type{1} << level_shift( level + 1 )) )
+			++level;
+
+		// Timers with too long timeouts are stored in the last slot
+		// reachable for the last level. They will be redistributed
+		// when the slot will be cascaded.
+		const tick_type max_delta =
+				(tick_type{1} << (level_shift( level ) +
+						(level ? other_level_bits : first_level_bits))) - 1;
+		const tick_type position = delta > max_delta ?
+				m_next_tick + max_delta : wheel_timer->m_expiration_tick;
+
+		wheel_timer->m_level = level;
+		wheel_timer->m_slot = slot_index( level, position );
+
+		wheel_item & item = m_levels[ level ][ wheel_timer->m_slot ];
+		wheel_timer->m_next = nullptr;
+		wheel_timer->m_prev = item.m_tail;
+		if( item.m_tail )
+			item.m_tail->m_next = wheel_timer;
+		else
+			item.m_head = wheel_timer;
+		item.m_tail = wheel_timer;
+	}
+
+	/*!
+	 * \brief Remove timer from the wheel.
+	 */
+	void
+	remove_timer_from_wheel( timer_type * wheel_timer )
+	{
+		wheel_item & item =
+				m_levels[ wheel_timer->m_level ][ wheel_timer->m_slot ];
+
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			item.m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			item.m_tail = wheel_timer->m_prev;
+	}
+
+	/*!
+	 * \brief Move all timers from the slot of the specified level
+	 * to the lower levels.
+	 *
+	 * \return index of cascaded slot.
+	 */
+	std::size_t
+	cascade( unsigned int level )
+	{
+		const auto index = slot_index( level, m_next_tick );
+
+		wheel_item & item = m_levels[ level ][ index ];
+		timer_type * timer = item.m_head;
+		item = wheel_item();
+
+		while( timer )
+		{
+			timer_type * t = timer;
+			timer = timer->m_next;
+
+			insert_demand_to_wheel( t );
+		}
+
+		return index;
+	}
+
+	/*!
+	 * \brief Process the next time step.
+	 *
+	 * Object \a lock will be unlocked and then locked back if there
+	 * are timers to be executed.
+	 */
+	template< class Unique_Lock >
+	void
+	process_next_tick(
+		Unique_Lock & lock )
+	{
+		const auto index = slot_index( 0, m_next_tick );
+
+		// Timers from higher levels must be cascaded at the start of
+		// the new turn of the lower level.
+		if( !index )
+			for( unsigned int level = 1;
+					level != levels_count && !cascade( level ); ++level )
+			{}
+
+		// All timers in the current slot must be executed.
+		wheel_item & item = m_levels[ 0 ][ index ];
+		timer_type * head = item.m_head;
+		item = wheel_item();
+
+		++m_next_tick;
+
+		if( head )
+		{
+			for( timer_type * t = head; t; t = t->m_next )
+				t->m_status = timer_status::wait_for_execution;
+
+			exec_actions( lock, head );
+
+			utilize_exec_list( head );
+		}
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class Unique_Lock >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		Unique_Lock & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head )
+	{
+		lock.unlock();
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+					head->m_action.exec();
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__ 
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				// The current time step is already processed, so the new
+				// expiration time step can't be in the past.
+				t->m_expiration_tick += t->m_period;
+
+				insert_demand_to_wheel( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+	}
+};
+
 //
 // thread_unsafe_manager_mixin
 //
@@ -4106,5 +4910,170 @@ public :
 	{}
 };
 
+//
+// timer_hierarchical_wheel_thread_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * Please see description of details::timer_hierarchical_wheel_engine for
+ * the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						::timertt::thread_safety::safe,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > > 
+{
+	using base_type =
+			details::thread_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							::timertt::thread_safety::safe,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_thread_template()
+		:	timer_hierarchical_wheel_thread_template(
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with granularity parameter.
+	timer_hierarchical_wheel_thread_template(
+		//! Size of time step for the wheels.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_thread_template(
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Size of time step for the wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// timer_hierarchical_wheel_manager_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action = default_timer_action_type,
+	typename Error_Logger = default_error_logger,
+	typename Actor_Exception_Handler = default_actor_exception_handler >
+class timer_hierarchical_wheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						Thread_Safety,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > > 
+{
+	//! Shorthand for base type.
+	using base_type = 
+			details::manager_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							Thread_Safety,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_manager_template()
+		:	timer_hierarchical_wheel_manager_template(
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with granularity parameter.
+	timer_hierarchical_wheel_manager_template(
+		//! Size of time step for the wheels.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_manager_template(
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Size of time step for the wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
 } /* namespace timertt */
 